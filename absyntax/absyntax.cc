@@ -36,6 +36,8 @@
 #include <stdio.h>
 #include <stdlib.h>	/* required for exit() */
 #include <string.h>
+#include <strings.h>  /* required for strcasecmp() */
+#include <ctype.h>    /* required for toupper() */
 
 #include "absyntax.hh"
 //#include "../stage1_2/iec.hh" /* required for BOGUS_TOKEN_ID, etc... */
@@ -45,6 +47,37 @@
 
 
 
+/* The side tables in which the annotations are stored (see side_table.hh).
+ * These are accessed through functions, so they are guaranteed to have been constructed
+ * even when used by the constructors of static objects.
+ * They are also never destroyed, since the destructors of static symbols (e.g. get_datatype_info_c::invalid_type_name)
+ * still access them at exit, possibly after the destructors of any static tables have already run.
+ */
+static side_table_c<symbol_c::candidate_datatypes_t> &candidate_datatypes_table(void) {static side_table_c<symbol_c::candidate_datatypes_t> *table = new side_table_c<symbol_c::candidate_datatypes_t>; return *table;}
+static side_table_c<const_value_c>                   &const_value_table        (void) {static side_table_c<const_value_c>                   *table = new side_table_c<const_value_c>;                   return *table;}
+/* One table for each stage 4 annotation key. Since these annotations are simple pointers, they are stored directly
+ * in a dense array indexed by the symbol's id (a NULL pointer meaning the annotation is not set).
+ */
+static std::vector<symbol_c *> &anotations_table(symbol_c::anotation_key_t key) {
+  static std::vector<symbol_c *> *tables = new std::vector<symbol_c *>[symbol_c::anotations_count];
+  return tables[key];
+}
+
+/* NOTE: incremented atomically, as stage 3 may create new symbols from several threads (see stage3/pou_executor.hh) */
+static unsigned int next_symbol_id = 0;
+
+__thread unsigned long int symbol_c::accept_count = 0;
+
+
+/* copy the entry of table associated to from_id (if any) to to_id */
+template<typename value_type>
+static void copy_entry(side_table_c<value_type> &table, unsigned int from_id, unsigned int to_id) {
+  value_type *from = table.find(from_id);
+  if (NULL == from) table.erase(to_id);
+  else              table[to_id] = *from;
+}
+
+
 /* The base class of all symbols */
 symbol_c::symbol_c(
                    int first_line, int first_column, const char *ffile, long int first_order,
@@ -61,6 +94,166 @@ symbol_c::symbol_c(
   this->token        = NULL;
   this->datatype     = NULL;
   this->scope        = NULL;
+  this->id           = __sync_fetch_and_add(&next_symbol_id, 1);
+}
+
+
+symbol_c::symbol_c(const symbol_c &symbol) {
+  this->id = __sync_fetch_and_add(&next_symbol_id, 1);
+  *this = symbol;
+}
+
+
+symbol_c &symbol_c::operator=(const symbol_c &symbol) {
+  if (this == &symbol) return *this;
+  this->first_file   = symbol.first_file;
+  this->first_line   = symbol.first_line;
+  this->first_column = symbol.first_column;
+  this->first_order  = symbol.first_order;
+  this->last_file    = symbol.last_file;
+  this->last_line    = symbol.last_line;
+  this->last_column  = symbol.last_column;
+  this->last_order   = symbol.last_order;
+  this->parent       = symbol.parent;
+  this->token        = symbol.token;
+  this->datatype     = symbol.datatype;
+  this->scope        = symbol.scope;
+  /* NOTE: this->id is not changed! */
+  copy_entry(candidate_datatypes_table(), symbol.id, this->id);
+  copy_entry(const_value_table        (), symbol.id, this->id);
+  for (int key = 0; key < anotations_count; key++)
+    set_anotation((anotation_key_t)key, symbol.get_anotation((anotation_key_t)key));
+  return *this;
+}
+
+
+symbol_c::~symbol_c(void) {
+  candidate_datatypes_table().erase(id);
+  const_value_table        ().erase(id);
+  for (int key = 0; key < anotations_count; key++)
+    set_anotation((anotation_key_t)key, NULL);
+}
+
+
+symbol_c::candidate_datatypes_t &symbol_c::candidate_datatypes(void) {return candidate_datatypes_table()[id];}
+const_value_c                   &symbol_c::const_value        (void) {return const_value_table        ()[id];}
+
+
+const symbol_c::candidate_datatypes_t &symbol_c::get_candidate_datatypes(void) const {
+  static const candidate_datatypes_t empty_list;
+  const candidate_datatypes_t *entry = candidate_datatypes_table().find(id);
+  return (NULL == entry)? empty_list : *entry;
+}
+
+const const_value_c &symbol_c::get_const_value(void) const {
+  static const const_value_c undefined_value;
+  const const_value_c *entry = const_value_table().find(id);
+  return (NULL == entry)? undefined_value : *entry;
+}
+
+
+symbol_c *symbol_c::get_anotation(anotation_key_t key) const {
+  std::vector<symbol_c *> &table = anotations_table(key);
+  return (id < table.size())? table[id] : NULL;
+}
+
+
+void symbol_c::set_anotation(anotation_key_t key, symbol_c *value) {
+  std::vector<symbol_c *> &table = anotations_table(key);
+  if (id >= table.size()) {
+    if (NULL == value) return;  /* nothing to do... */
+    table.resize(id + 1, NULL);
+  }
+  table[id] = value;
+}
+
+
+static size_t candidate_datatypes_bytes(const symbol_c::candidate_datatypes_t &candidates) {return candidates.get_allocated_bytes();}
+
+symbol_c::annotation_stats_t symbol_c::get_annotation_stats(void) {
+  annotation_stats_t stats;
+  stats.symbols             = next_symbol_id;
+  stats.candidate_datatypes = candidate_datatypes_table().get_used();
+  stats.const_value         = const_value_table        ().get_used();
+  stats.anotations          = 0;
+  stats.candidate_datatypes_bytes = candidate_datatypes_table().get_memory_bytes(candidate_datatypes_bytes);
+  stats.const_value_bytes         = const_value_table        ().get_memory_bytes();
+  stats.anotations_bytes          = 0;
+  for (int key = 0; key < anotations_count; key++) {
+    std::vector<symbol_c *> &table = anotations_table((anotation_key_t)key);
+    for (size_t i = 0; i < table.size(); i++)
+      if (NULL != table[i]) stats.anotations++;
+    stats.anotations_bytes += table.capacity() * sizeof(symbol_c *);
+  }
+  return stats;
+}
+
+
+
+/* The list of candidate datatypes of a symbol */
+/* The elementary datatypes that get a bit of their own in the elementary_set. These are the same
+ * datatypes that get_datatype_info_c::is_ANY_ELEMENTARY_compatible() considers elementary.
+ */
+static const symbol_kind_t elementary_datatype_kinds[] = {
+  kind_time_type_name_c,     kind_bool_type_name_c,     kind_sint_type_name_c,     kind_int_type_name_c,
+  kind_dint_type_name_c,     kind_lint_type_name_c,     kind_usint_type_name_c,    kind_uint_type_name_c,
+  kind_udint_type_name_c,    kind_ulint_type_name_c,    kind_real_type_name_c,     kind_lreal_type_name_c,
+  kind_date_type_name_c,     kind_tod_type_name_c,      kind_dt_type_name_c,       kind_byte_type_name_c,
+  kind_word_type_name_c,     kind_lword_type_name_c,    kind_dword_type_name_c,    kind_string_type_name_c,
+  kind_wstring_type_name_c,
+  kind_safetime_type_name_c, kind_safebool_type_name_c, kind_safesint_type_name_c, kind_safeint_type_name_c,
+  kind_safedint_type_name_c, kind_safelint_type_name_c, kind_safeusint_type_name_c,kind_safeuint_type_name_c,
+  kind_safeudint_type_name_c,kind_safeulint_type_name_c,kind_safereal_type_name_c, kind_safelreal_type_name_c,
+  kind_safedate_type_name_c, kind_safetod_type_name_c,  kind_safedt_type_name_c,   kind_safebyte_type_name_c,
+  kind_safeword_type_name_c, kind_safelword_type_name_c,kind_safedword_type_name_c,kind_safestring_type_name_c,
+  kind_safewstring_type_name_c
+};
+
+
+int candidate_datatypes_c::get_elementary_count(void) {
+  return sizeof(elementary_datatype_kinds) / sizeof(elementary_datatype_kinds[0]);
+}
+
+
+/* The index of each kind of symbol in elementary_datatype_kinds[], or -1 if not an elementary datatype */
+static signed char elementary_indexes[kind_count];
+
+static bool init_elementary_indexes(void) {
+  if (candidate_datatypes_c::get_elementary_count() > (int)(8 * sizeof(candidate_datatypes_c::elementary_set_t))) ERROR;
+  for (int i = 0; i < kind_count;                                    i++) elementary_indexes[i] = -1;
+  for (int i = 0; i < candidate_datatypes_c::get_elementary_count(); i++) elementary_indexes[elementary_datatype_kinds[i]] = i;
+  return true;
+}
+
+/* NOTE: The table is filled in before main() is called, and therefore before any other thread is started (see stage3/pou_executor.hh),
+ *       unless it is needed even earlier, by the constructor of some other static object.
+ */
+static bool elementary_indexes_initialized = init_elementary_indexes();
+
+
+int candidate_datatypes_c::get_elementary_index(symbol_c *datatype) {
+  if (!elementary_indexes_initialized) elementary_indexes_initialized = init_elementary_indexes();
+  if (NULL == datatype) return -1;
+  return elementary_indexes[datatype->get_kind()];
+}
+
+
+void candidate_datatypes_c::push_back(symbol_c *datatype) {
+  elementary_set_t bit = get_elementary_bit(datatype);
+  if (0 == bit) other_count++;
+  elementary_set |= bit;
+  datatypes.push_back(datatype);
+}
+
+
+void candidate_datatypes_c::erase(size_t pos) {
+  elementary_set_t bit = get_elementary_bit(datatypes[pos]);
+  datatypes.erase(datatypes.begin() + pos);
+  if (0 == bit) {other_count--; return;}
+  /* the same elementary datatype may appear more than once in the list */
+  for (size_t i = 0; i < datatypes.size(); i++)
+    if (get_elementary_bit(datatypes[i]) == bit) return;
+  elementary_set &= ~bit;
 }
 
 
@@ -78,15 +271,22 @@ token_c::token_c(const char *value,
 
 
 # define LIST_CAP_INIT 8
-# define LIST_CAP_INCR 8
+
+/* The array of elements is stored in the current arena (see arena.hh), and is therefore never free()'d.
+ * When growing it we double its capacity, so the memory left behind by all the previous
+ * (smaller) arrays is never larger than the current array.
+ */
+static void *alloc_elements(int capacity, size_t entry_size) {
+  return arena_c::get_current()->alloc(capacity * entry_size);
+}
 
 list_c::list_c(
                int fl, int fc, const char *ffile, long int forder,
                int ll, int lc, const char *lfile, long int lorder)
   :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder),c(LIST_CAP_INIT) {
   n = 0;
-  elements = (element_entry_t*)malloc(LIST_CAP_INIT*sizeof(element_entry_t));
-  if (NULL == elements) ERROR_MSG("out of memory");
+  index = NULL;
+  elements = (element_entry_t*)alloc_elements(LIST_CAP_INIT, sizeof(element_entry_t));
 }
 
 
@@ -95,17 +295,155 @@ list_c::list_c(symbol_c *elem,
                int ll, int lc, const char *lfile, long int lorder)
   :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder),c(LIST_CAP_INIT) { 
   n = 0;
-  elements = (element_entry_t*)malloc(LIST_CAP_INIT*sizeof(element_entry_t));
-  if (NULL == elements) ERROR_MSG("out of memory");
+  index = NULL;
+  elements = (element_entry_t*)alloc_elements(LIST_CAP_INIT, sizeof(element_entry_t));
   add_element(elem); 
 }
 
 
+list_c::list_c(const list_c &list)
+  :symbol_c(list), c(list.c), n(list.n), elements(list.elements), index(NULL) {}
+
+
+list_c &list_c::operator=(const list_c &list) {
+  if (this == &list) return *this;
+  symbol_c::operator=(list);
+  c        = list.c;
+  n        = list.n;
+  elements = list.elements;
+  free(index);
+  index    = NULL;
+  return *this;
+}
+
+
+list_c::~list_c(void) {
+  free(index);
+}
+
+
+
+/*********************************************************/
+/* hash index of the elements of large lists, by name    */
+/*********************************************************/
+/* Searching a list for an element with a given name is a linear scan over all its elements.
+ * Some lists (e.g. the library_c root, large VAR declaration lists, structure element lists) get
+ * rather large and are searched repeatedly, so once a list has more than LIST_INDEX_THRESHOLD
+ * elements, the first call to find_element() builds a hash index mapping each name (ignoring case) 
+ * to the position of the first element with that name.
+ *
+ * The index is then updated by add_element(). Inserting or removing elements anywhere other than
+ * at the end of the list changes the position of the elements that follow, so in that case the index
+ * is rebuilt (in place). Since shifting the elements of the list is already O(n), this does not
+ * change the complexity of those operations.
+ *
+ * NOTE: Several threads may call find_element() on the same list at the same time, but a list must
+ *       not be changed while other threads are searching it.
+ */
+# define LIST_INDEX_THRESHOLD 16
+
+typedef struct {
+  const char  *token_value;  /* NULL if entry is empty */
+  unsigned int hash;
+  int          pos;          /* position in the list of the first element with this token_value */
+} list_index_entry_t;
+
+struct list_index_s {
+  int size;  /* number of entries in the hash table. Always a power of 2 */
+  int used;  /* number of entries in use */
+  list_index_entry_t entries[1];  /* the hash table (size entries) */
+};
+
+
+/* FNV-1a of the upper case version of the name */
+static unsigned int list_index_hash(const char *token_value) {
+  unsigned int hash = 2166136261U;
+  for (; *token_value != '\0'; token_value++) {
+    hash ^= (unsigned char)toupper(*token_value);
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+
+/* returns the entry with token_value, or the empty entry where it should be stored
+ * NOTE: strcasecmp() gives the same result as nocasecmp_c, as identifiers only contain ASCII characters.
+ */
+static list_index_entry_t *list_index_lookup(struct list_index_s *index, const char *token_value, unsigned int hash) {
+  int mask = index->size - 1;
+  for (int i = hash & mask; ; i = (i + 1) & mask) {
+    list_index_entry_t *entry = &index->entries[i];
+    if (NULL == entry->token_value) return entry;
+    if (   (entry->hash == hash) 
+        && ((entry->token_value == token_value) || (strcasecmp(entry->token_value, token_value) == 0)))
+      return entry;
+  }
+}
+
+
+/* allocate an (empty) index large enough for n elements */
+static struct list_index_s *list_index_alloc(int n) {
+  int size = 16;
+  while (3*size < 4*n) size *= 2;  /* keep the table at most 3/4 full */
+
+  struct list_index_s *index = (struct list_index_s *)malloc(sizeof(struct list_index_s) + (size-1)*sizeof(list_index_entry_t));
+  if (NULL == index) ERROR_MSG("out of memory");
+  index->size = size;
+  index->used = 0;
+  memset(index->entries, 0, size*sizeof(list_index_entry_t));
+  return index;
+}
+
+
+/* add an element to the index (which must have room for it).
+ * Does nothing if an element with the same name, in a previous position, is already in the index.
+ */
+static void list_index_insert(struct list_index_s *index, const char *token_value, int pos) {
+  unsigned int hash = list_index_hash(token_value);
+  list_index_entry_t *entry = list_index_lookup(index, token_value, hash);
+  if (NULL != entry->token_value) return;  /* element with the same name already present in the list */
+  entry->token_value = token_value;
+  entry->hash        = hash;
+  entry->pos         = pos;
+  index->used++;
+}
+
+
+/* (re)build the index of all the elements in the list. Reuses the current index if it is large enough. */
+void list_c::build_index(void) {
+  if ((NULL != index) && (3*index->size >= 4*n)) {
+    memset(index->entries, 0, index->size*sizeof(list_index_entry_t));
+    index->used = 0;
+  } else {
+    free(index);
+    index = list_index_alloc(n);
+  }
+  for (int i = 0; i < n; i++) 
+    if (NULL != elements[i].token_value) list_index_insert(index, elements[i].token_value, i);
+}
+
+
+/* add the element in position pos to the index (the index must already exist). */
+void list_c::index_element(int pos) {
+  const char *token_value = elements[pos].token_value;
+  if (NULL == token_value) return;
+
+  if (4*(index->used + 1) > 3*index->size) {build_index(); return;}  /* table too full. build_index() will also add this element */
+  list_index_insert(index, token_value, pos);
+}
+
+
+
 /*******************************************/    
 /* get element in position pos of the list */
 /*******************************************/    
 symbol_c *list_c::get_element(int pos) {return elements[pos].symbol;}
 
+/*****************************************************************************/    
+/* get the token value associated to the element in position pos of the list */
+/*****************************************************************************/    
+const char *list_c::get_element_token_value(int pos) {return elements[pos].token_value;}
+
 
 
 /******************************************/    
@@ -118,11 +456,28 @@ symbol_c *list_c::find_element(symbol_c *token) {
 }
 
 symbol_c *list_c::find_element(const char *token_value) {
+  if ((NULL == index) && (n > LIST_INDEX_THRESHOLD)) {
+    /* Stage 3 may search the same list (e.g. the elements of a STRUCT declared in a TYPE ... END_TYPE)
+     * from several threads at once (see stage3/pou_executor.hh), so the index is fully built before
+     * it is published. If another thread published its own index in the meantime, we use that one.
+     */
+    struct list_index_s *new_index = list_index_alloc(n);
+    for (int i = 0; i < n; i++) 
+      if (NULL != elements[i].token_value) list_index_insert(new_index, elements[i].token_value, i);
+    if (!__sync_bool_compare_and_swap(&index, (struct list_index_s *)NULL, new_index)) free(new_index);
+  }
+  if (NULL != index) {
+    list_index_entry_t *entry = list_index_lookup(index, token_value, list_index_hash(token_value));
+    return (NULL == entry->token_value)? NULL : elements[entry->pos].symbol;
+  }
+
   // We could use strcasecmp(), but it's best to always use the same 
   // method of string comparison throughout matiec
+  // NOTE: nocasecmp_c is a 'less than' comparison, so equality requires testing both ways.
   nocasecmp_c ncc; 
   for (int i = 0; i < n; i++) 
-    if (!ncc(elements[i].token_value, token_value))
+    if (   (NULL != elements[i].token_value)
+        && !ncc(elements[i].token_value, token_value) && !ncc(token_value, elements[i].token_value))
       return elements[i].symbol;
 
   return NULL; // not found
@@ -140,13 +495,17 @@ void list_c::add_element(symbol_c *elem, symbol_c *token) {
 }
 
 void list_c::add_element(symbol_c *elem, const char *token_value) {
-  if (c <= n)
-    if (!(elements=(element_entry_t*)realloc(elements,(c+=LIST_CAP_INCR)*sizeof(element_entry_t))))
-      ERROR_MSG("out of memory");
+  if (c <= n) {
+    element_entry_t *new_elements = (element_entry_t*)alloc_elements(2*c, sizeof(element_entry_t));
+    memcpy(new_elements, elements, n*sizeof(element_entry_t));
+    elements = new_elements;
+    c *= 2;
+  }
   //elements[n++] = {token_value, elem};  // only available from C++11 onwards, best not use it for now.
   elements[n].symbol      = elem;
   elements[n].token_value = token_value;
   n++;
+  if (NULL != index) index_element(n-1);
   
   if (NULL == elem) return;
   /* Sometimes add_element() is called in stage3 or stage4 to temporarily add an AST symbol to the list.
@@ -203,16 +562,28 @@ void list_c::insert_element(symbol_c *elem, const char *token_value, int pos) {
   
   /* add new element to end of list. Basically alocate required memory... */
   /* will also increment n by 1 ! */
-  add_element(elem);
+  add_element(elem, token_value);
   /* if not inserting into end position, shift all elements up one position, to open up a slot in pos for new element */
   if(pos < (n-1)){ 
     for(int i=n-2 ; i>=pos ; --i) elements[i+1] = elements[i];
     elements[pos].symbol      = elem;
     elements[pos].token_value = token_value;
+    if (NULL != index) build_index();  /* position of the following elements changed */
   }
 }
 
 
+/*****************************************/    
+/* replace the element at position pos.  */
+/*****************************************/    
+void list_c::set_element(int pos, symbol_c *elem) {
+  if((pos<0) || (n<=pos)) ERROR;
+  
+  elements[pos].symbol = elem;
+  if (NULL != index) build_index();
+}
+
+
 /***********************************/    
 /* remove element at position pos. */
 /***********************************/    
@@ -223,6 +594,7 @@ void list_c::remove_element(int pos) {
   for (int i = pos; i < n-1; i++) elements[i] = elements[i+1];
   /* corrent the new size */
   n--;
+  if (NULL != index) build_index();  /* position of the following elements changed */
   /* elements = (symbol_c **)realloc(elements, n * sizeof(element_entry_t)); */
   /* TODO: adjust the location parameters, taking into account the removed element. */
 }
@@ -233,6 +605,7 @@ void list_c::remove_element(int pos) {
 /**********************************/    
 void list_c::clear(void) {
   n = 0;
+  if (NULL != index) build_index();
   /* TODO: adjust the location parameters, taking into account the removed element. */
 }
 
@@ -246,21 +619,21 @@ class_name_c::class_name_c(symbol_c *elem, 							\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
 			:list_c(elem, fl, fc, ffile, forder, ll, lc, lfile, lorder) {}		\
-void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
+void *class_name_c::accept(visitor_c &visitor) {accept_count++; return visitor.visit(this);}
 
 #define SYM_TOKEN(class_name_c, ...)								\
 class_name_c::class_name_c(const char *value, 							\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
 			:token_c(value, fl, fc, ffile, forder, ll, lc, lfile, lorder) {}	\
-void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
+void *class_name_c::accept(visitor_c &visitor) {accept_count++; return visitor.visit(this);}
 
 #define SYM_REF0(class_name_c, ...)								\
 class_name_c::class_name_c(									\
                            int fl, int fc, const char *ffile, long int forder,			\
                            int ll, int lc, const char *lfile, long int lorder)			\
 			  :symbol_c(fl, fc, ffile, forder, ll, lc, lfile, lorder) {}		\
-void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
+void *class_name_c::accept(visitor_c &visitor) {accept_count++; return visitor.visit(this);}
 
 
 #define SYM_REF1(class_name_c, ref1, ...)							\
@@ -271,7 +644,7 @@ class_name_c::class_name_c(symbol_c *ref1,							\
   this->ref1 = ref1;										\
   if  (NULL != ref1)   ref1->parent = this;							\
 }												\
-void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
+void *class_name_c::accept(visitor_c &visitor) {accept_count++; return visitor.visit(this);}
 
 
 #define SYM_REF2(class_name_c, ref1, ref2, ...)							\
@@ -285,7 +658,7 @@ class_name_c::class_name_c(symbol_c *ref1,							\
   if  (NULL != ref1)   ref1->parent = this;							\
   if  (NULL != ref2)   ref2->parent = this;										\
 }												\
-void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
+void *class_name_c::accept(visitor_c &visitor) {accept_count++; return visitor.visit(this);}
 
 
 #define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)						\
@@ -302,7 +675,7 @@ class_name_c::class_name_c(symbol_c *ref1,							\
   if  (NULL != ref2)   ref2->parent = this;							\
   if  (NULL != ref3)   ref3->parent = this;							\
 }												\
-void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
+void *class_name_c::accept(visitor_c &visitor) {accept_count++; return visitor.visit(this);}
 
 
 #define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)					\
@@ -322,7 +695,7 @@ class_name_c::class_name_c(symbol_c *ref1,							\
   if  (NULL != ref3)   ref3->parent = this;							\
   if  (NULL != ref4)   ref4->parent = this;							\
 }												\
-void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
+void *class_name_c::accept(visitor_c &visitor) {accept_count++; return visitor.visit(this);}
 
 
 #define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)				\
@@ -345,7 +718,7 @@ class_name_c::class_name_c(symbol_c *ref1,							\
   if  (NULL != ref4)   ref4->parent = this;							\
   if  (NULL != ref5)   ref5->parent = this;							\
 }												\
-void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
+void *class_name_c::accept(visitor_c &visitor) {accept_count++; return visitor.visit(this);}
 
 
 
@@ -372,7 +745,7 @@ class_name_c::class_name_c(symbol_c *ref1,							\
   if  (NULL != ref5)   ref5->parent = this;							\
   if  (NULL != ref6)   ref6->parent = this;							\
 }												\
-void *class_name_c::accept(visitor_c &visitor) {return visitor.visit(this);}
+void *class_name_c::accept(visitor_c &visitor) {accept_count++; return visitor.visit(this);}
 
 
 
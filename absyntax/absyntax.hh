@@ -52,6 +52,9 @@
 #include <string>
 #include <stdint.h>  // required for uint64_t, etc...
 #include "../main.hh" // required for uint8_t, real_64_t, ..., and the macros INT8_MAX, REAL32_MAX, ... */
+#include "strpool.hh"  // required for strpool_c (the interned token values)
+#include "arena.hh"    // required for arena_c (the memory in which the AST is stored)
+#include "side_table.hh"  // required for side_table_c (where the annotations are stored)
 
 
 
@@ -118,18 +121,18 @@ class const_value_c {
       public:
       const_value__(void): status(cs_undefined), value(0) {};
       
-      value_type get(void)              {return value;}
+      value_type get(void)        const {return value;}
       void       set(value_type value_) {status = cs_const_value; value = value_;}
       void       set_overflow(void)     {status = cs_overflow   ;}
       void       set_nonconst(void)     {status = cs_non_const  ;}
-      bool       is_valid    (void)     {return (status == cs_const_value);}
-      bool       is_overflow (void)     {return (status == cs_overflow   );}
-      bool       is_nonconst (void)     {return (status == cs_non_const  );}
-      bool       is_undefined(void)     {return (status == cs_undefined  );}
-      bool       is_zero     (void)     {return (is_valid() && (get() == 0));}
+      bool       is_valid    (void) const {return (status == cs_const_value);}
+      bool       is_overflow (void) const {return (status == cs_overflow   );}
+      bool       is_nonconst (void) const {return (status == cs_non_const  );}
+      bool       is_undefined(void) const {return (status == cs_undefined  );}
+      bool       is_zero     (void) const {return (is_valid() && (get() == 0));}
 
       /* comparison operator */
-      bool operator==(const const_value__ cv) {
+      bool operator==(const const_value__ cv) const {
         return (    ((status!=cs_const_value) && (status==cv.status)) 
                  || ((status==cs_const_value) && (value ==cv.value )));
       }
@@ -146,17 +149,121 @@ class const_value_c {
     ~const_value_c(void) {};
     
     /* comparison operator */
-    bool operator==(const const_value_c cv)
+    bool operator==(const const_value_c cv) const
       {return ((_int64==cv._int64) && (_uint64==cv._uint64) && (_real64==cv._real64) && (_bool==cv._bool));}                                                     
       
     /* return true if at least one of the const values (int, real, ...) is a valid const value */
-    bool is_const(void) 
+    bool is_const(void) const
       {return (_int64.is_valid() || _uint64.is_valid() || _real64.is_valid() || _bool.is_valid());}   
 };
 
 // A forward declaration
 class token_c;
 
+
+
+/* A unique tag for every class of symbol (see symbol_c::get_kind()).
+ * All the list_c derived classes are listed after kind_list_c, and all the token_c derived
+ * classes after kind_token_c, so that is<list_c>() and is<token_c>() are simple range checks.
+ */
+#define SYM_LIST(class_name_c, ...)
+#define SYM_TOKEN(class_name_c, ...)
+#define SYM_REF0(class_name_c, ...)                                          kind_##class_name_c,
+#define SYM_REF1(class_name_c, ref1, ...)                                    kind_##class_name_c,
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                              kind_##class_name_c,
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                        kind_##class_name_c,
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                  kind_##class_name_c,
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)            kind_##class_name_c,
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)      kind_##class_name_c,
+typedef enum {
+  kind_symbol_c,
+  #include "absyntax.def"
+#undef  SYM_LIST
+#define SYM_LIST(class_name_c, ...)                                          kind_##class_name_c,
+#undef  SYM_REF0
+#undef  SYM_REF1
+#undef  SYM_REF2
+#undef  SYM_REF3
+#undef  SYM_REF4
+#undef  SYM_REF5
+#undef  SYM_REF6
+#define SYM_REF0(class_name_c, ...)
+#define SYM_REF1(class_name_c, ref1, ...)
+#define SYM_REF2(class_name_c, ref1, ref2, ...)
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)
+  kind_list_c,
+  #include "absyntax.def"
+#undef  SYM_LIST
+#undef  SYM_TOKEN
+#define SYM_LIST(class_name_c, ...)
+#define SYM_TOKEN(class_name_c, ...)                                         kind_##class_name_c,
+  kind_token_c,
+  #include "absyntax.def"
+  kind_count  /* number of kinds. This MUST be the last entry! */
+} symbol_kind_t;
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+
+
+
+/* The list of candidate datatypes of a symbol (see symbol_c::candidate_datatypes() ).
+ *
+ * Behaves just like a std::vector<symbol_c *>, keeping the datatypes in the order in which they were added,
+ * but also keeps a bitset with one bit for each elementary datatype (INT, SAFEINT, STRING, ...) in the list.
+ * Since most candidate datatypes are elementary datatypes, determining whether a datatype is in the
+ * list, or intersecting two lists, is usually reduced to bitwise operations on these bitsets
+ * (see search_in_candidate_datatype_list() and intersect_candidate_datatype_list() in stage 3).
+ *
+ * NOTE: The elements may not be changed through operator[], so the bitset is always kept up to date.
+ */
+class candidate_datatypes_c {
+  public:
+    typedef std::vector<symbol_c *>::const_iterator const_iterator;
+    typedef uint64_t                                elementary_set_t;
+
+  private:
+    std::vector<symbol_c *> datatypes;
+    elementary_set_t        elementary_set;  /* the bits of the elementary datatypes in the list    */
+    unsigned int            other_count;     /* number of datatypes in the list that are not elementary */
+
+  public:
+    candidate_datatypes_c(void): elementary_set(0), other_count(0) {}
+
+    /* The number of elementary datatypes (i.e. the number of bits used in the bitset) */
+    static int get_elementary_count(void);
+    /* The position of an elementary datatype in the bitset, or -1 if datatype is not an elementary datatype. */
+    static int get_elementary_index(symbol_c *datatype);
+    /* The bit of an elementary datatype in the bitset, or 0 if datatype is not an elementary datatype. */
+    static elementary_set_t get_elementary_bit(symbol_c *datatype)
+      {int index = get_elementary_index(datatype); return (index < 0)? 0 : ((elementary_set_t)1) << index;}
+
+    elementary_set_t get_elementary_set(void) const {return elementary_set;}
+    unsigned int     get_other_count   (void) const {return other_count;}
+    /* The memory allocated by the list on its own (i.e. not counting sizeof(candidate_datatypes_c)) */
+    size_t           get_allocated_bytes(void) const {return datatypes.capacity() * sizeof(symbol_c *);}
+
+    size_t         size     (void)            const {return datatypes.size();}
+    bool           empty    (void)            const {return datatypes.empty();}
+    symbol_c      *operator[](size_t pos)     const {return datatypes[pos];}
+    const_iterator begin    (void)            const {return datatypes.begin();}
+    const_iterator end      (void)            const {return datatypes.end();}
+    void           push_back(symbol_c *datatype);
+    void           erase    (size_t pos);
+    void           clear    (void)                  {datatypes.clear(); elementary_set = 0; other_count = 0;}
+};
+
+
+
 /* The base class of all symbols */
 class symbol_c {
 
@@ -164,6 +271,18 @@ class symbol_c {
     /* WARNING: only use this method for debugging purposes!! */
     virtual const char *absyntax_cname(void) {return "symbol_c";};
 
+    /* The kind of symbol, i.e. the class this object belongs to.
+     * Testing the kind of a symbol is much cheaper than using dynamic_cast<> or typeid(), so the
+     * following should be used instead:
+     *   symbol->is<xxx_c>()  -->  true if symbol is an object of class xxx_c (or derived from xxx_c)
+     *   symbol->as<xxx_c>()  -->  same as dynamic_cast<xxx_c *>(symbol)
+     * NOTE: unlike dynamic_cast<>, these may not be called on a NULL pointer!
+     */
+    virtual symbol_kind_t get_kind(void) {return kind_symbol_c;};
+    static  bool is_kind(symbol_kind_t kind) {return true;};
+    template<typename symbol_type> bool         is(void) {return symbol_type::is_kind(get_kind());}
+    template<typename symbol_type> symbol_type *as(void) {return symbol_type::is_kind(get_kind())? static_cast<symbol_type *>(this) : NULL;}
+
     /*
      * Annotations produced during stage 1_2
      */    
@@ -192,11 +311,25 @@ class symbol_c {
     long int last_order;    /* relative order in which it is read by lexcial analyser */
 
 
+    /* Unique identifier of this symbol. Used to index the side tables (see side_table.hh) in which
+     * the annotations that are not needed by every symbol are stored.
+     */
+    unsigned int id;
+
+
     /*
      * Annotations produced during stage 3
      */    
     /*** Data type analysis ***/
-    std::vector <symbol_c *> candidate_datatypes; /* All possible data types the expression/literal/etc. may take. Filled in stage3 by fill_candidate_datatypes_c class */
+    typedef candidate_datatypes_c candidate_datatypes_t;
+    /* All possible data types the expression/literal/etc. may take. Filled in stage3 by fill_candidate_datatypes_c class.
+     * Stored in a side table.
+     */
+    candidate_datatypes_t &candidate_datatypes(void);
+    /* Same as candidate_datatypes(), for read only access. Unlike candidate_datatypes(), it does not add an entry
+     * to the side table when the symbol has none, but returns an empty list instead.
+     */
+    const candidate_datatypes_t &get_candidate_datatypes(void) const;
     /* Data type of the expression/literal/etc. Filled in stage3 by narrow_candidate_datatypes_c 
      * If set to NULL, it means it has not yet been evaluated.
      * If it points to an object of type invalid_type_name_c, it means it is invalid.
@@ -211,8 +344,12 @@ class symbol_c {
     symbol_c *scope;    
 
     /*** constant folding ***/
-    /* If the symbol has a constant numerical value, this will be set to that value by constant_folding_c */
-    const_value_c const_value;
+    /* If the symbol has a constant numerical value, this will be set to that value by constant_folding_c
+     * Stored in a side table.
+     */
+    const_value_c &const_value(void);
+    /* Same as const_value(), for read only access. Returns an undefined const value if the symbol has none in the side table. */
+    const const_value_c &get_const_value(void) const;
     
     /*** Enumeration datatype checking ***/    
     /* Not all symbols will contain the following anotations, which is why they are not declared here in symbol_c
@@ -225,10 +362,17 @@ class symbol_c {
      */
     /* Since we support several distinct stage_4 implementations, having explicit entries for each
      * possible use would quickly get out of hand.
-     * We therefore simply add a map, that each stage 4 may use for all its needs.
+     * We therefore keep a list of all the annotations used by the stage 4 implementations, each identified
+     * by a fixed integer key. Each annotation is stored in its own side table, indexed by the symbol's id.
+     * To add a new annotation, simply add a new key to the following list.
      */
-    typedef std::map<std::string, symbol_c *> anotations_map_t;
-    anotations_map_t anotations_map;
+    typedef enum {
+      generate_c_annotaton__implicit_type_id,  /* generate_c: the identifier of the C datatype that was implicitly declared for this symbol */
+      anotations_count   /* the number of annotations. This MUST be the last entry! */
+    } anotation_key_t;
+
+    symbol_c *get_anotation(anotation_key_t key) const;  /* returns NULL if the annotation has not been set */
+    void      set_anotation(anotation_key_t key, symbol_c *value);
     
 
   public:
@@ -237,9 +381,39 @@ class symbol_c {
              int ll = 0, int lc = 0, const char *lfile = NULL /* filename */, long int lorder=0  /* order in which it is read by lexcial analyser */
             );
 
+    /* The copy constructor and assignment operator also copy the annotations stored in the side tables */
+    symbol_c(const symbol_c &symbol);
+    symbol_c &operator=(const symbol_c &symbol);
+
     /* default destructor */
     /* must be virtual so compiler does not complain... */ 
-    virtual ~symbol_c(void) {return;};
+    /* Also deletes the annotations stored in the side tables. */
+    virtual ~symbol_c(void);
+
+    /* Number of annotations of each kind currently stored in the side tables, and the memory
+     * used by each of the side tables (used for debugging the memory usage, see debug_c::print_census()).
+     */
+    typedef struct {
+      unsigned long int symbols;              /* number of ids handed out so far */
+      unsigned long int candidate_datatypes;
+      unsigned long int const_value;
+      unsigned long int anotations;           /* total for all the keys */
+      size_t            candidate_datatypes_bytes;
+      size_t            const_value_bytes;
+      size_t            anotations_bytes;     /* total for all the keys */
+    } annotation_stats_t;
+    static annotation_stats_t get_annotation_stats(void);
+
+    /* All symbols are allocated from the current arena (see arena.hh).
+     * The memory of a deleted symbol is only returned when the arena is released.
+     */
+    static void *operator new   (size_t size) {return arena_c::get_current()->alloc(size);}
+    static void  operator delete(void *ptr)   {}
+
+    /* The number of calls to accept() made by the calling thread, i.e. the number of AST nodes it has visited.
+     * Used by the phase profiler (see phase_profiler.hh).
+     */
+    static __thread unsigned long int accept_count;
 
     virtual void *accept(visitor_c &visitor) {return NULL;};
 };
@@ -252,6 +426,9 @@ class token_c: public symbol_c {
     /* WARNING: only use this method for debugging purposes!! */
     virtual const char *absyntax_cname(void) {return "token_c";};
 
+    virtual symbol_kind_t get_kind(void) {return kind_token_c;};
+    static  bool is_kind(symbol_kind_t kind) {return (kind >= kind_token_c) && (kind < kind_count);};
+
     /* the value of the symbol. */
     const char *value;
 
@@ -271,7 +448,10 @@ class list_c: public symbol_c {
     /* WARNING: only use this method for debugging purposes!! */
     virtual const char *absyntax_cname(void) {return "list_c";};
 
-    int c,n; /* c: current capacity of list (malloc'd memory);  n: current number of elements in list */
+    virtual symbol_kind_t get_kind(void) {return kind_list_c;};
+    static  bool is_kind(symbol_kind_t kind) {return (kind >= kind_list_c) && (kind < kind_token_c);};
+
+    int c,n; /* c: current capacity of list (memory allocated from the arena);  n: current number of elements in list */
   private:
 //     symbol_c **elements;
     typedef struct {
@@ -279,6 +459,12 @@ class list_c: public symbol_c {
       symbol_c   *symbol;
     } element_entry_t;
     element_entry_t *elements;
+    /* Hash index of the elements, by token value (ignoring case). Only built for large lists,
+     * the first time find_element() is called. NULL if the index has not been built.
+     */
+    struct list_index_s *index;
+    void build_index(void);
+    void index_element(int pos);
     
 
   public:
@@ -290,9 +476,17 @@ class list_c: public symbol_c {
            int fl = 0, int fc = 0, const char *ffile = NULL /* filename */, long int forder=0, /* order in which it is read by lexcial analyser */
            int ll = 0, int lc = 0, const char *lfile = NULL /* filename */, long int lorder=0  /* order in which it is read by lexcial analyser */
           );
+
+    /* The copy does not share the index (it will build its own, if needed) */
+    list_c(const list_c &list);
+    list_c &operator=(const list_c &list);
+    virtual ~list_c(void);
+
      /* get element in position pos of the list */
     virtual symbol_c *get_element(int pos);
-     /* find element associated to token value */
+     /* get the token value associated to the element in position pos of the list */
+    virtual const char *get_element_token_value(int pos);
+     /* find (first) element associated to token value */
     virtual symbol_c *find_element(symbol_c   *token);
     virtual symbol_c *find_element(const char *token_value);
      /* append a new element to the end of the list */
@@ -306,10 +500,15 @@ class list_c: public symbol_c {
     virtual void insert_element(symbol_c *elem, symbol_c   *token,       int pos = 0);
     virtual void insert_element(symbol_c *elem,                          int pos = 0);
     //virtual void insert_element(symbol_c *elem, int pos, std::string map_ref);
+     /* replace the element at position pos, keeping the token value associated to it. */
+    virtual void set_element(int pos, symbol_c *elem);
      /* remove element at position pos. */
     virtual void remove_element(int pos = 0);
      /* remove all elements from list. Does not delete the elements in the list! */ 
     virtual void clear(void);
+     /* memory used by the array of elements (allocated from the arena), and how much of it is not in use (the c - n free entries) */
+    size_t get_elements_bytes(void) const {return c       * sizeof(element_entry_t);}
+    size_t get_slack_bytes   (void) const {return (c - n) * sizeof(element_entry_t);}
 };
 
 
@@ -334,6 +533,8 @@ class class_name_c:	public list_c {											\
     virtual void *accept(visitor_c &visitor);										\
     /* WARNING: only use this method for debugging purposes!! */							\
     virtual const char *absyntax_cname(void) {return #class_name_c;};							\
+    virtual symbol_kind_t get_kind(void) {return kind_##class_name_c;};						\
+    static  bool is_kind(symbol_kind_t kind) {return kind == kind_##class_name_c;};					\
 };
 
 
@@ -348,6 +549,8 @@ class class_name_c: 	public token_c {										\
     virtual void *accept(visitor_c &visitor);										\
     /* WARNING: only use this method for debugging purposes!! */							\
     virtual const char *absyntax_cname(void) {return #class_name_c;};							\
+    virtual symbol_kind_t get_kind(void) {return kind_##class_name_c;};						\
+    static  bool is_kind(symbol_kind_t kind) {return kind == kind_##class_name_c;};					\
 };
 
 
@@ -362,6 +565,8 @@ class class_name_c: public symbol_c {											\
     virtual void *accept(visitor_c &visitor);										\
     /* WARNING: only use this method for debugging purposes!! */							\
     virtual const char *absyntax_cname(void) {return #class_name_c;};							\
+    virtual symbol_kind_t get_kind(void) {return kind_##class_name_c;};						\
+    static  bool is_kind(symbol_kind_t kind) {return kind == kind_##class_name_c;};					\
 };
 
 
@@ -377,6 +582,8 @@ class class_name_c: public symbol_c {											\
     virtual void *accept(visitor_c &visitor);										\
     /* WARNING: only use this method for debugging purposes!! */							\
     virtual const char *absyntax_cname(void) {return #class_name_c;};							\
+    virtual symbol_kind_t get_kind(void) {return kind_##class_name_c;};						\
+    static  bool is_kind(symbol_kind_t kind) {return kind == kind_##class_name_c;};					\
 };
 
 
@@ -394,6 +601,8 @@ class class_name_c: public symbol_c {											\
     virtual void *accept(visitor_c &visitor);										\
     /* WARNING: only use this method for debugging purposes!! */							\
     virtual const char *absyntax_cname(void) {return #class_name_c;};							\
+    virtual symbol_kind_t get_kind(void) {return kind_##class_name_c;};						\
+    static  bool is_kind(symbol_kind_t kind) {return kind == kind_##class_name_c;};					\
 };
 
 
@@ -413,6 +622,8 @@ class class_name_c: public symbol_c {											\
     virtual void *accept(visitor_c &visitor);										\
     /* WARNING: only use this method for debugging purposes!! */							\
     virtual const char *absyntax_cname(void) {return #class_name_c;};							\
+    virtual symbol_kind_t get_kind(void) {return kind_##class_name_c;};						\
+    static  bool is_kind(symbol_kind_t kind) {return kind == kind_##class_name_c;};					\
 };
 
 
@@ -434,6 +645,8 @@ class class_name_c: public symbol_c {											\
     virtual void *accept(visitor_c &visitor);										\
     /* WARNING: only use this method for debugging purposes!! */							\
     virtual const char *absyntax_cname(void) {return #class_name_c;};							\
+    virtual symbol_kind_t get_kind(void) {return kind_##class_name_c;};						\
+    static  bool is_kind(symbol_kind_t kind) {return kind == kind_##class_name_c;};					\
 };
 
 
@@ -457,6 +670,8 @@ class class_name_c: public symbol_c {											\
     virtual void *accept(visitor_c &visitor);										\
     /* WARNING: only use this method for debugging purposes!! */							\
     virtual const char *absyntax_cname(void) {return #class_name_c;};							\
+    virtual symbol_kind_t get_kind(void) {return kind_##class_name_c;};						\
+    static  bool is_kind(symbol_kind_t kind) {return kind == kind_##class_name_c;};					\
 };
 
 
@@ -482,6 +697,8 @@ class class_name_c: public symbol_c {											\
     virtual void *accept(visitor_c &visitor);										\
     /* WARNING: only use this method for debugging purposes!! */							\
     virtual const char *absyntax_cname(void) {return #class_name_c;};							\
+    virtual symbol_kind_t get_kind(void) {return kind_##class_name_c;};						\
+    static  bool is_kind(symbol_kind_t kind) {return kind == kind_##class_name_c;};					\
 };
 
 
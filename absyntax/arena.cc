@@ -0,0 +1,156 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * A memory arena for the abstract syntax tree (see arena.hh).
+ */
+
+
+#include <stdlib.h>
+#include "arena.hh"
+#include "../main.hh" // required for ERROR() and ERROR_MSG() macros.
+
+
+
+#define BLOCK_SIZE   (256*1024)  /* size of each block of memory allocated by the arena */
+#define ALIGNMENT    16          /* alignment of the memory returned by alloc(). Must be a power of 2! */
+
+#define ALIGN(size)  (((size) + (ALIGNMENT - 1)) & ~((size_t)(ALIGNMENT - 1)))
+/* size of the header of each block, rounded up so the memory following it is correctly aligned */
+#define HEADER_SIZE  ALIGN(sizeof(block_t))
+
+
+__thread arena_c *arena_c::current_arena = NULL;
+
+
+
+arena_c::arena_c(void) {
+  blocks          = NULL;
+  next_free       = NULL;
+  free_bytes      = 0;
+  allocated_bytes = 0;
+  reserved_bytes  = 0;
+}
+
+
+arena_c::~arena_c(void) {
+  if (current_arena == this) current_arena = NULL;
+  release();
+}
+
+
+void *arena_c::alloc(size_t size) {
+  size = ALIGN(size);
+  allocated_bytes += size;
+
+  if (size > free_bytes) {
+    /* Very large requests get a block of their own, which is placed behind the current block
+     * so that the free space remaining in the current block is not lost.
+     */
+    size_t block_size = (size > BLOCK_SIZE/4)? size : BLOCK_SIZE;
+    block_t *block = (block_t *)malloc(HEADER_SIZE + block_size);
+    if (NULL == block) ERROR_MSG("Out of memory. Bailing out!\n");
+    block->size = block_size;
+    reserved_bytes += HEADER_SIZE + block_size;
+
+    if ((block_size == size) && (NULL != blocks)) {
+      block->next  = blocks->next;
+      blocks->next = block;
+      return (char *)block + HEADER_SIZE;
+    }
+    block->next = blocks;
+    blocks      = block;
+    next_free   = (char *)block + HEADER_SIZE;
+    free_bytes  = block_size;
+  }
+
+  void *res   = next_free;
+  next_free  += size;
+  free_bytes -= size;
+  return res;
+}
+
+
+void arena_c::release(void) {
+  while (NULL != blocks) {
+    block_t *next = blocks->next;
+    free(blocks);
+    blocks = next;
+  }
+  next_free       = NULL;
+  free_bytes      = 0;
+  allocated_bytes = 0;
+  reserved_bytes  = 0;
+}
+
+
+
+void arena_c::adopt(arena_c *other) {
+  if ((NULL == other) || (this == other) || (NULL == other->blocks)) return;
+
+  if (NULL == blocks) {
+    /* simply take over the other arena, including the free space remaining in its current block */
+    blocks     = other->blocks;
+    next_free  = other->next_free;
+    free_bytes = other->free_bytes;
+  } else {
+    /* place the blocks of the other arena behind our current block, so the free space remaining in it is not lost */
+    block_t *last = other->blocks;
+    while (NULL != last->next) last = last->next;
+    last->next   = blocks->next;
+    blocks->next = other->blocks;
+  }
+  allocated_bytes += other->allocated_bytes;
+  reserved_bytes  += other->reserved_bytes;
+
+  other->blocks          = NULL;
+  other->next_free       = NULL;
+  other->free_bytes      = 0;
+  other->allocated_bytes = 0;
+  other->reserved_bytes  = 0;
+}
+
+
+
+arena_c *arena_c::get_current(void) {
+  /* NOTE: the default arena is never destroyed, as AST nodes may be referenced until the very end of the program. */
+  static arena_c *default_arena = new arena_c();
+  if (NULL == current_arena) current_arena = default_arena;
+  return current_arena;
+}
+
+
+arena_c *arena_c::set_current(arena_c *arena) {
+  arena_c *prev = get_current();
+  current_arena = arena;
+  return prev;
+}
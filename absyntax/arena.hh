@@ -0,0 +1,120 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * A memory arena (a.k.a. bump allocator) for the abstract syntax tree.
+ *
+ * Every symbol_c object (i.e. every node of the AST), as well as the array of elements of
+ * every list_c, is allocated from the current arena (see arena_c::get_current()).
+ * Allocating from the arena simply bumps a pointer in a large block of memory, so
+ * allocation is very cheap, and nodes created one after the other (which is what
+ * bison does) end up next to each other in memory, which helps the visitors that
+ * later walk the tree.
+ *
+ * The memory of an arena is only returned (all at once!) when the arena is released
+ * or destroyed. Deleting a symbol_c object will run its destructor, but its memory is
+ * not reused.
+ *
+ * NOTE: Releasing an arena does NOT run the destructors of the objects stored in it.
+ *       Any memory allocated on the heap by those objects (e.g. the std::vector used by some
+ *       of the symbols in absyntax.def, or the annotations stored in the side tables, see
+ *       side_table.hh) is therefore not reclaimed.
+ *
+ * NOTE: After an arena has been released, all the AST nodes that were allocated from it
+ *       become invalid, so no other object (symbol tables, annotations, ...) may still
+ *       be referencing them.
+ *
+ * Each thread has its own current arena, as an arena_c may only be used by one thread at a time.
+ * A thread that creates AST nodes while another thread is doing the same (see stage3/pou_executor.hh)
+ * must therefore allocate them from an arena of its own, whose memory may later be handed over to the
+ * arena of the main thread with adopt().
+ *
+ * To discard a whole AST in one go, allocate it from an arena of its own:
+ *
+ *     arena_c  arena;
+ *     arena_c *prev_arena = arena_c::set_current(&arena);
+ *     ... parse, and use the AST ...
+ *     arena_c::set_current(prev_arena);
+ *     arena.release();
+ */
+
+
+#ifndef _ARENA_HH
+#define _ARENA_HH
+
+#include <stddef.h>  // required for size_t
+
+
+
+class arena_c {
+  private:
+    typedef struct block_s {
+      struct block_s *next;
+      size_t          size;  /* usable bytes in this block, following the header */
+    } block_t;
+
+    block_t *blocks;      /* list of blocks, the most recently allocated first */
+    char    *next_free;   /* next free byte in the current block */
+    size_t   free_bytes;  /* number of free bytes remaining in the current block */
+
+    size_t   allocated_bytes;  /* memory handed out by alloc() */
+    size_t   reserved_bytes;   /* memory obtained from malloc() */
+
+    static __thread arena_c *current_arena;  /* one per thread */
+
+  public:
+    arena_c(void);
+   ~arena_c(void);
+
+    /* return size bytes of memory, aligned for any type of object. Never returns NULL. */
+    void *alloc(size_t size);
+    /* return all the memory in the arena, in a single go. */
+    void  release(void);
+    /* move all the memory of another arena into this arena, leaving the other arena empty.
+     * The objects allocated from the other arena will now only be released when this arena is released.
+     */
+    void  adopt(arena_c *other);
+
+    size_t get_allocated_bytes(void) {return allocated_bytes;}
+    size_t get_reserved_bytes (void) {return reserved_bytes;}
+
+    /* The arena from which all new AST nodes (symbol_c objects) are allocated by the calling thread.
+     * If none has been set, a default arena (that is never released) is used. Since the default arena is
+     * shared by all the threads, a thread running concurrently with other threads must set an arena of its own.
+     */
+    static arena_c *get_current(void);
+    /* Set the arena from which AST nodes are allocated by the calling thread. Returns the previous current arena. */
+    static arena_c *set_current(arena_c *arena);
+};
+
+
+#endif /* _ARENA_HH */
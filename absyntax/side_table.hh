@@ -0,0 +1,194 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * A side table, storing one object per symbol_c, indexed by the symbol's id.
+ *
+ * The annotations produced by stage 3 and stage 4 (candidate datatypes, constant values, ...)
+ * are only needed for a fraction of the symbols in the AST, and only after the parsing has
+ * completed. Instead of storing them inside every symbol_c object, they are stored in
+ * side tables, and each object in the side table is only created when it is first accessed.
+ *
+ * The table itself is a dense array of pointers, indexed by the symbol's id (see symbol_c::id).
+ * Since ids are handed out sequentially, and most symbols of any large enough region of the AST
+ * get annotated anyway, this costs much less than a hash table would.
+ *
+ * The array is split into pages of a fixed size, that are found through a directory of pages.
+ * Pages never move once they have been allocated. When the directory must grow, a larger copy
+ * of it is made, and the previous directory is only freed when the table is cleared, so a thread
+ * that is still reading the previous directory is never left dangling.
+ * This allows several threads to access (and create) the objects of distinct ids at the same
+ * time, which stage 3 does when checking several POUs concurrently (see stage3/pou_executor.hh).
+ *
+ * NOTE: Accessing the object of the same id from several threads, or calling erase() or clear()
+ *       while other threads are using the table, is NOT supported.
+ */
+
+
+#ifndef _SIDE_TABLE_HH
+#define _SIDE_TABLE_HH
+
+#include <stddef.h>  // required for size_t
+
+
+
+template<typename value_type> class side_table_c {
+  private:
+    static const unsigned int page_bits = 10;
+    static const unsigned int page_size = 1 << page_bits;  /* number of entries in each page */
+
+    typedef struct {
+      value_type *entries[page_size];
+    } page_t;
+
+    typedef struct directory_s {
+      size_t               page_count;
+      page_t             **pages;
+      struct directory_s  *prev;   /* the previous (smaller) directory, freed when the table is cleared */
+    } directory_t;
+
+    directory_t * volatile directory;
+    volatile long          used;   /* number of entries currently allocated */
+    volatile int           lock;   /* taken while adding pages to the table */
+
+    /* Returns where the object associated to id is stored, or NULL if that page has not been allocated (and create is false) */
+    value_type **get_slot(unsigned int id, bool create) {
+      size_t       page = id >> page_bits;
+      directory_t *dir  = directory;
+      if ((NULL == dir) || (page >= dir->page_count) || (NULL == dir->pages[page])) {
+        if (!create) return NULL;
+        dir = add_page(page);
+      }
+      return &(dir->pages[page]->entries[id & (page_size - 1)]);
+    }
+
+    directory_t *add_page(size_t page) {
+      while (__sync_lock_test_and_set(&lock, 1)) {/* spin */}
+      directory_t *dir = directory;
+      if ((NULL == dir) || (page >= dir->page_count)) {
+        /* grow the directory */
+        directory_t *new_dir = new directory_t;
+        new_dir->page_count  = (NULL == dir)? 16 : 2 * dir->page_count;
+        while (page >= new_dir->page_count) new_dir->page_count *= 2;
+        new_dir->pages = new page_t *[new_dir->page_count];
+        for (size_t i = 0; i < new_dir->page_count; i++)
+          new_dir->pages[i] = ((NULL != dir) && (i < dir->page_count))? dir->pages[i] : NULL;
+        new_dir->prev  = dir;
+        __sync_synchronize();  /* the new directory must be complete before it is published */
+        directory = dir = new_dir;
+      }
+      if (NULL == dir->pages[page]) {
+        page_t *new_page = new page_t;
+        for (unsigned int i = 0; i < page_size; i++) new_page->entries[i] = NULL;
+        __sync_synchronize();  /* the new page must be complete before it is published */
+        dir->pages[page] = new_page;
+      }
+      __sync_lock_release(&lock);
+      return dir;
+    }
+
+  public:
+    side_table_c(void): directory(NULL), used(0), lock(0) {}
+   ~side_table_c(void) {clear();}
+
+    /* Returns the object associated to id, creating it if it does not yet exist */
+    value_type &operator[](unsigned int id) {
+      value_type **slot = get_slot(id, true);
+      if (NULL == *slot) {
+        value_type *entry = new value_type();
+        if (__sync_bool_compare_and_swap(slot, (value_type *)NULL, entry)) __sync_fetch_and_add(&used, 1);
+        else delete entry;  /* another thread got there first */
+      }
+      return **slot;
+    }
+
+    /* Returns the object associated to id, or NULL if it does not exist */
+    value_type *find(unsigned int id) {
+      value_type **slot = get_slot(id, false);
+      return (NULL == slot)? NULL : *slot;
+    }
+
+    /* Delete the object associated to id (if any) */
+    void erase(unsigned int id) {
+      value_type **slot = get_slot(id, false);
+      if ((NULL == slot) || (NULL == *slot)) return;
+      delete *slot;
+      *slot = NULL;
+      __sync_fetch_and_sub(&used, 1);
+    }
+
+    /* Delete all the objects in the table */
+    void clear(void) {
+      directory_t *dir = directory;
+      if (NULL != dir)
+        for (size_t i = 0; i < dir->page_count; i++) {
+          if (NULL == dir->pages[i]) continue;
+          for (unsigned int j = 0; j < page_size; j++) delete dir->pages[i]->entries[j];
+          delete dir->pages[i];
+        }
+      while (NULL != dir) {
+        directory_t *prev = dir->prev;
+        delete [] dir->pages;
+        delete dir;
+        dir = prev;
+      }
+      directory = NULL;
+      used = 0;
+    }
+
+    size_t get_used    (void) {return used;}
+    size_t get_capacity(void) {return (NULL == directory)? 0 : directory->page_count * page_size;}
+
+    /* The memory used by the table (directories and pages) and by the objects stored in it.
+     * entry_bytes, if not NULL, returns the memory allocated by an object on its own (e.g. the storage of a std::vector).
+     * NOTE: must not be called while other threads are changing the table.
+     */
+    size_t get_memory_bytes(size_t (*entry_bytes)(const value_type &) = NULL) {
+      size_t bytes = 0;
+      for (directory_t *dir = directory; NULL != dir; dir = dir->prev)
+        bytes += sizeof(directory_t) + dir->page_count * sizeof(page_t *);
+      directory_t *dir = directory;
+      for (size_t i = 0; (NULL != dir) && (i < dir->page_count); i++) {
+        if (NULL == dir->pages[i]) continue;
+        bytes += sizeof(page_t);
+        for (unsigned int j = 0; j < page_size; j++) {
+          if (NULL == dir->pages[i]->entries[j]) continue;
+          bytes += sizeof(value_type);
+          if (NULL != entry_bytes) bytes += entry_bytes(*dir->pages[i]->entries[j]);
+        }
+      }
+      return bytes;
+    }
+};
+
+
+#endif /* _SIDE_TABLE_HH */
@@ -0,0 +1,136 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * The summaries of the classes of symbols in each subtree of the AST,
+ * used by the static visitors to skip the subtrees they have nothing to do in.
+ * See the comment in static_visitor.hh
+ */
+
+
+#include "static_visitor.hh"
+#include "../main.hh" // required for ERROR() and ERROR_MSG() macros.
+
+
+
+subtree_kinds_c::pass_mask_t              subtree_kinds_c::kind_passes[kind_count];
+subtree_kinds_c::pass_mask_t              subtree_kinds_c::registered_passes = 0;
+subtree_kinds_c::pass_mask_t              subtree_kinds_c::computed_passes   = 0;
+std::vector<subtree_kinds_c::pass_mask_t> subtree_kinds_c::summaries;
+
+
+
+subtree_kinds_c::pass_mask_t subtree_kinds_c::register_pass(const bool handled_kinds[kind_count]) {
+  /* find a free bit */
+  pass_mask_t pass = 1;
+  while ((0 != pass) && (0 != (registered_passes & pass))) pass <<= 1;
+  if (0 == pass) return 0;  /* too many static visitors. This one will never skip anything. */
+
+  registered_passes |= pass;
+  for (int kind = 0; kind < kind_count; kind++)
+    if (handled_kinds[kind]) kind_passes[kind] |= pass;
+  return pass;
+}
+
+
+
+/* Compute the summary of symbol, and of all the symbols below it, returning the summary of symbol.
+ * NOTE: This is called on every symbol of the AST, so it is not a visitor_c, to avoid the cost of the virtual calls.
+ */
+subtree_kinds_c::pass_mask_t subtree_kinds_c::compute_summary(symbol_c *symbol) {
+  symbol_kind_t kind    = symbol->get_kind();
+  pass_mask_t   summary = kind_passes[kind];
+
+  switch (kind) {
+#define SYM_LIST(class_name_c, ...)                                             \
+    case kind_##class_name_c: {                                                 \
+      list_c *list = static_cast<class_name_c *>(symbol);                      \
+      for (int i = 0; i < list->n; i++)                                         \
+        if (NULL != list->get_element(i)) summary |= compute_summary(list->get_element(i)); \
+      break;}
+#define SYM_TOKEN(class_name_c, ...)
+#define SYM_REF0(class_name_c, ...)
+#define SUMMARY_REF(ref)                                                        \
+      if (NULL != s->ref) summary |= compute_summary(s->ref);
+#define SYM_REF1(class_name_c, ref1, ...)                                       \
+    case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+      SUMMARY_REF(ref1)                                                         \
+      break;}
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 \
+    case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+      SUMMARY_REF(ref1) SUMMARY_REF(ref2)                                       \
+      break;}
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           \
+    case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+      SUMMARY_REF(ref1) SUMMARY_REF(ref2) SUMMARY_REF(ref3)                     \
+      break;}
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     \
+    case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+      SUMMARY_REF(ref1) SUMMARY_REF(ref2) SUMMARY_REF(ref3) SUMMARY_REF(ref4)   \
+      break;}
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               \
+    case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+      SUMMARY_REF(ref1) SUMMARY_REF(ref2) SUMMARY_REF(ref3) SUMMARY_REF(ref4)   \
+      SUMMARY_REF(ref5)                                                         \
+      break;}
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         \
+    case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+      SUMMARY_REF(ref1) SUMMARY_REF(ref2) SUMMARY_REF(ref3) SUMMARY_REF(ref4)   \
+      SUMMARY_REF(ref5) SUMMARY_REF(ref6)                                       \
+      break;}
+#include "absyntax.def"
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SUMMARY_REF
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+    default: break;
+  }
+
+  if (symbol->id >= summaries.size()) summaries.resize(2 * symbol->id + 1, (pass_mask_t)~0);
+  summaries[symbol->id] = summary;
+  return summary;
+}
+
+
+void subtree_kinds_c::compute(symbol_c *tree_root) {
+  if (NULL == tree_root) return;
+  /* The symbols not in the tree (e.g. the elementary datatypes, see get_datatype_info_c) are never skipped */
+  summaries.clear();
+  compute_summary(tree_root);
+  computed_passes = registered_passes;
+}
@@ -0,0 +1,290 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * A visitor with static dispatch, for the passes that visit the whole AST and need to do so fast.
+ *
+ * Visiting a symbol with a visitor_c costs two virtual calls (symbol->accept(visitor), that then
+ * calls visitor.visit(symbol)), and an iterator_visitor_c recurses into every child of every symbol,
+ * even when the algorithm only does something in a few classes of symbols.
+ *
+ * A visitor derived from static_iterator_visitor_c
+ *     class my_pass_c: public static_iterator_visitor_c<my_pass_c> {
+ *       public:
+ *         using static_iterator_visitor_c<my_pass_c>::visit;
+ *         void *visit(integer_c *symbol);
+ *         ...
+ *     };
+ * visits a symbol by calling dispatch(symbol) (instead of symbol->accept(*this)), which switches on
+ * the kind of the symbol (see symbol_c::get_kind()) and calls the visit() method of my_pass_c for that
+ * class directly (i.e. the visit() methods need not, and should not, be virtual). Like iterator_visitor_c,
+ * the default visit() methods visit the children of the symbol, in the order they appear in absyntax.def.
+ *
+ * Besides this, dispatch() skips any subtree of the AST that does not contain a single symbol for which the
+ * visitor has its own visit() method, as visiting such a subtree would do nothing at all. To know which
+ * subtrees these are, the subtree_kinds_c::compute() must have been called on the AST after the visitor was
+ * created (otherwise nothing is skipped).
+ *
+ * Since these visitors are not visitor_c's, symbol->accept() can not be used with them. get_visitor() returns
+ * a visitor_c that forwards to the static visitor, for the code that only knows about visitor_c's.
+ *
+ * NOTE: A visit() method that must be overridden by a class derived from the static visitor must be declared
+ *       virtual (the static dispatch always calls the visit() methods of the class given as the template parameter).
+ */
+
+
+#ifndef _STATIC_VISITOR_HH
+#define _STATIC_VISITOR_HH
+
+#include <vector>
+#include "absyntax.hh"
+#include "visitor.hh"
+
+
+
+/* A summary of the classes of symbols in each subtree of the AST.
+ *
+ * Each static visitor is given a bit (up to 8 of them), which is set in the summary of a symbol
+ * if the visitor has its own visit() method for the class of that symbol or of any symbol in its subtree.
+ */
+class subtree_kinds_c {
+  public:
+    typedef unsigned char pass_mask_t;
+
+    /* Register a static visitor, with its own visit() method for the kinds of symbols in which handled_kinds[kind] is true.
+     * Returns the bit assigned to the visitor, or 0 if there are too many visitors (in which case the visitor never skips any subtree).
+     */
+    static pass_mask_t register_pass(const bool handled_kinds[kind_count]);
+
+    /* Compute the summary of every symbol in the tree rooted at tree_root.
+     * Must be called again whenever the AST is changed, except for new symbols added to it
+     * (the symbols created after computing the summaries are never skipped).
+     */
+    static void compute(symbol_c *tree_root);
+
+    /* Does the subtree of symbol contain a symbol handled by the visitor(s) in pass_mask? */
+    static bool contains(symbol_c *symbol, pass_mask_t pass_mask) {
+      if ((0 == pass_mask) || ((pass_mask & computed_passes) != pass_mask)) return true;
+      if (symbol->id >= summaries.size())             return true;
+      return (summaries[symbol->id] & pass_mask) != 0;
+    }
+
+  private:
+    static pass_mask_t              kind_passes[kind_count];  /* the visitors that handle each kind of symbol */
+    static pass_mask_t              registered_passes;
+    static pass_mask_t              computed_passes;          /* the visitors registered when compute() was called */
+    static std::vector<pass_mask_t> summaries;                /* indexed by symbol_c::id */
+
+    static pass_mask_t compute_summary(symbol_c *symbol);
+};
+
+
+
+
+#define SYM_LIST(class_name_c, ...)                                             case kind_##class_name_c: return visitor->visit(static_cast<class_name_c *>(symbol));
+#define SYM_TOKEN(class_name_c, ...)                                            case kind_##class_name_c: return visitor->visit(static_cast<class_name_c *>(symbol));
+#define SYM_REF0(class_name_c, ...)                                             case kind_##class_name_c: return visitor->visit(static_cast<class_name_c *>(symbol));
+#define SYM_REF1(class_name_c, ref1, ...)                                       case kind_##class_name_c: return visitor->visit(static_cast<class_name_c *>(symbol));
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 case kind_##class_name_c: return visitor->visit(static_cast<class_name_c *>(symbol));
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           case kind_##class_name_c: return visitor->visit(static_cast<class_name_c *>(symbol));
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     case kind_##class_name_c: return visitor->visit(static_cast<class_name_c *>(symbol));
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               case kind_##class_name_c: return visitor->visit(static_cast<class_name_c *>(symbol));
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         case kind_##class_name_c: return visitor->visit(static_cast<class_name_c *>(symbol));
+
+template<typename visitor_t> class static_iterator_visitor_c {
+  public:
+    /* Visit symbol with the visit() method of visitor_t for the class of symbol */
+    void *dispatch(symbol_c *symbol) {
+      if (!subtree_kinds_c::contains(symbol, get_pass_mask())) return NULL;
+      symbol_c::accept_count++;  /* for the phase profiler */
+      visitor_t *visitor = static_cast<visitor_t *>(this);
+      switch (symbol->get_kind()) {
+        #include "absyntax.def"
+        default: return NULL;  /* symbol_c, list_c and token_c objects */
+      }
+    }
+
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+
+    /* A visitor_c that visits the symbols with this static visitor */
+    visitor_c *get_visitor(void) {return &adapter;}
+
+  protected:
+    static_iterator_visitor_c(void): adapter(this) {get_pass_mask();}
+
+    void *visit_list(list_c *list) {
+      for (int i = 0; i < list->n; i++)
+        dispatch(list->get_element(i));
+      return NULL;
+    }
+
+  public:
+#define SYM_LIST(class_name_c, ...)                                             \
+    void *visit(class_name_c *symbol) {return visit_list(symbol);}
+#define SYM_TOKEN(class_name_c, ...)                                            \
+    void *visit(class_name_c *symbol) {return NULL;}
+#define SYM_REF0(class_name_c, ...)                                             \
+    void *visit(class_name_c *symbol) {return NULL;}
+#define SYM_REF1(class_name_c, ref1, ...)                                       \
+    void *visit(class_name_c *symbol) {                                         \
+      if (symbol->ref1) dispatch(symbol->ref1);                                 \
+      return NULL;                                                              \
+    }
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 \
+    void *visit(class_name_c *symbol) {                                         \
+      if (symbol->ref1) dispatch(symbol->ref1);                                 \
+      if (symbol->ref2) dispatch(symbol->ref2);                                 \
+      return NULL;                                                              \
+    }
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           \
+    void *visit(class_name_c *symbol) {                                         \
+      if (symbol->ref1) dispatch(symbol->ref1);                                 \
+      if (symbol->ref2) dispatch(symbol->ref2);                                 \
+      if (symbol->ref3) dispatch(symbol->ref3);                                 \
+      return NULL;                                                              \
+    }
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     \
+    void *visit(class_name_c *symbol) {                                         \
+      if (symbol->ref1) dispatch(symbol->ref1);                                 \
+      if (symbol->ref2) dispatch(symbol->ref2);                                 \
+      if (symbol->ref3) dispatch(symbol->ref3);                                 \
+      if (symbol->ref4) dispatch(symbol->ref4);                                 \
+      return NULL;                                                              \
+    }
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               \
+    void *visit(class_name_c *symbol) {                                         \
+      if (symbol->ref1) dispatch(symbol->ref1);                                 \
+      if (symbol->ref2) dispatch(symbol->ref2);                                 \
+      if (symbol->ref3) dispatch(symbol->ref3);                                 \
+      if (symbol->ref4) dispatch(symbol->ref4);                                 \
+      if (symbol->ref5) dispatch(symbol->ref5);                                 \
+      return NULL;                                                              \
+    }
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         \
+    void *visit(class_name_c *symbol) {                                         \
+      if (symbol->ref1) dispatch(symbol->ref1);                                 \
+      if (symbol->ref2) dispatch(symbol->ref2);                                 \
+      if (symbol->ref3) dispatch(symbol->ref3);                                 \
+      if (symbol->ref4) dispatch(symbol->ref4);                                 \
+      if (symbol->ref5) dispatch(symbol->ref5);                                 \
+      if (symbol->ref6) dispatch(symbol->ref6);                                 \
+      return NULL;                                                              \
+    }
+#include "absyntax.def"
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+
+  private:
+    /* The bit of this visitor in the subtree summaries (see subtree_kinds_c) */
+    static subtree_kinds_c::pass_mask_t get_pass_mask(void) {
+      static subtree_kinds_c::pass_mask_t pass_mask = register_pass();
+      return pass_mask;
+    }
+
+    /* The kinds of symbols for which visitor_t has its own visit() method are the ones
+     * in which the address of visitor_t::visit() differs from the default visit() method.
+     */
+    static subtree_kinds_c::pass_mask_t register_pass(void) {
+      typedef static_iterator_visitor_c<visitor_t> base_t;
+      bool handled_kinds[kind_count];
+      for (int kind = 0; kind < kind_count; kind++) handled_kinds[kind] = false;
+#define SYM_LIST(class_name_c, ...)                                             \
+      handled_kinds[kind_##class_name_c] = (  static_cast<void *(visitor_t::*)(class_name_c *)>(&visitor_t::visit)    \
+                                            != static_cast<void *(visitor_t::*)(class_name_c *)>(&base_t::visit));
+#define SYM_TOKEN(class_name_c, ...)                                            SYM_LIST(class_name_c)
+#define SYM_REF0(class_name_c, ...)                                             SYM_LIST(class_name_c)
+#define SYM_REF1(class_name_c, ref1, ...)                                       SYM_LIST(class_name_c)
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 SYM_LIST(class_name_c)
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           SYM_LIST(class_name_c)
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     SYM_LIST(class_name_c)
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               SYM_LIST(class_name_c)
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         SYM_LIST(class_name_c)
+#include "absyntax.def"
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+      return subtree_kinds_c::register_pass(handled_kinds);
+    }
+
+
+    /* The visitor_c returned by get_visitor() */
+    class adapter_c: public visitor_c {
+      private:
+        static_iterator_visitor_c<visitor_t> *static_visitor;
+      public:
+        adapter_c(static_iterator_visitor_c<visitor_t> *static_visitor_): static_visitor(static_visitor_) {}
+#define SYM_LIST(class_name_c, ...)                                             void *visit(class_name_c *symbol) {return static_visitor->dispatch(symbol);}
+#define SYM_TOKEN(class_name_c, ...)                                            void *visit(class_name_c *symbol) {return static_visitor->dispatch(symbol);}
+#define SYM_REF0(class_name_c, ...)                                             void *visit(class_name_c *symbol) {return static_visitor->dispatch(symbol);}
+#define SYM_REF1(class_name_c, ref1, ...)                                       void *visit(class_name_c *symbol) {return static_visitor->dispatch(symbol);}
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 void *visit(class_name_c *symbol) {return static_visitor->dispatch(symbol);}
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           void *visit(class_name_c *symbol) {return static_visitor->dispatch(symbol);}
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     void *visit(class_name_c *symbol) {return static_visitor->dispatch(symbol);}
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               void *visit(class_name_c *symbol) {return static_visitor->dispatch(symbol);}
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         void *visit(class_name_c *symbol) {return static_visitor->dispatch(symbol);}
+#include "absyntax.def"
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+    };
+    adapter_c adapter;
+};
+
+
+#endif /* _STATIC_VISITOR_HH */
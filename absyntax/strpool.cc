@@ -0,0 +1,178 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * A pool of interned strings (see strpool.hh).
+ *
+ * The strings are stored back to back in large blocks of memory (so we do not pay the
+ * overhead of one malloc() per string), and are found through an open addressing
+ * hash table (linear probing) that stores the hash and length of each string, so
+ * most collisions are resolved without ever looking at the strings themselves.
+ *
+ * Stage 3 checks several POUs at the same time (see stage3/pou_executor.hh), and the symbol
+ * tables it fills in along the way intern their keys (see util/nocase_hashtable.cc), so
+ * the pool is protected by a lock.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "strpool.hh"
+#include "../main.hh" // required for ERROR() and ERROR_MSG() macros.
+
+
+
+#define BLOCK_SIZE       (64*1024)  /* size of each block of memory in which strings are stored */
+#define TABLE_INIT_SIZE  4096       /* initial number of entries in the hash table. Must be a power of 2! */
+
+
+typedef struct {
+  const char  *str;   /* NULL if entry is empty */
+  unsigned int hash;
+  unsigned int len;
+} entry_t;
+
+
+static entry_t *table       = NULL;
+static size_t   table_size  = 0;     /* number of entries in table (always a power of 2) */
+static size_t   table_used  = 0;     /* number of entries in use */
+static char    *block       = NULL;  /* the block of memory currently being filled up */
+static size_t   block_free  = 0;     /* number of free bytes remaining in the current block */
+static strpool_c::stats_t stats = {0, 0, 0, 0};
+static pthread_mutex_t    lock  = PTHREAD_MUTEX_INITIALIZER;  /* protects all of the above */
+
+
+
+/* FNV-1a */
+static unsigned int hash_str(const char *str, size_t len) {
+  unsigned int hash = 2166136261U;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= (unsigned char)str[i];
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+
+static void grow_table(void) {
+  size_t   new_size  = (table_size == 0)? TABLE_INIT_SIZE : 2*table_size;
+  entry_t *new_table = (entry_t *)calloc(new_size, sizeof(entry_t));
+  if (NULL == new_table) ERROR_MSG("Out of memory. Bailing out!\n");
+
+  for (size_t i = 0; i < table_size; i++) {
+    if (NULL == table[i].str) continue;
+    size_t pos = table[i].hash & (new_size - 1);
+    while (NULL != new_table[pos].str) pos = (pos + 1) & (new_size - 1);
+    new_table[pos] = table[i];
+  }
+  free(table);
+  table      = new_table;
+  table_size = new_size;
+}
+
+
+/* store a copy of the string in the current block (or in a block of its own, if very large) */
+static const char *store_str(const char *str, size_t len) {
+  char *res;
+  if (len + 1 > BLOCK_SIZE/4) {
+    res = (char *)malloc(len + 1);
+    if (NULL == res) ERROR_MSG("Out of memory. Bailing out!\n");
+  } else {
+    if (len + 1 > block_free) {
+      block = (char *)malloc(BLOCK_SIZE);
+      if (NULL == block) ERROR_MSG("Out of memory. Bailing out!\n");
+      block_free = BLOCK_SIZE;
+      stats.stored_bytes += BLOCK_SIZE;
+    }
+    res = block;
+    block      += len + 1;
+    block_free -= len + 1;
+  }
+  memcpy(res, str, len);
+  res[len] = '\0';
+  return res;
+}
+
+
+
+const char *strpool_c::intern(const char *str) {
+  return intern(str, strlen(str));
+}
+
+
+/* Returns the entry where the string is stored, or the empty entry where it should go if not found */
+static entry_t *find_entry(const char *str, size_t len, unsigned int hash) {
+  size_t pos = hash & (table_size - 1);
+  while (NULL != table[pos].str) {
+    if ((table[pos].hash == hash) && (table[pos].len == len) && (memcmp(table[pos].str, str, len) == 0))
+      break;
+    pos = (pos + 1) & (table_size - 1);
+  }
+  return &table[pos];
+}
+
+
+const char *strpool_c::intern(const char *str, size_t len) {
+  unsigned int hash = hash_str(str, len);
+
+  pthread_mutex_lock(&lock);
+  stats.requests++;
+  stats.requested_bytes += len + 1;
+
+  if (0 == table_size) grow_table();
+  entry_t *entry = find_entry(str, len, hash);
+  if (NULL == entry->str) {
+    /* not found. Keep the table at most 3/4 full */
+    if (4*(table_used + 1) > 3*table_size) {
+      grow_table();
+      entry = find_entry(str, len, hash);
+    }
+    entry->str  = store_str(str, len);
+    entry->hash = hash;
+    entry->len  = len;
+    table_used++;
+    stats.strings++;
+    if (len + 1 > BLOCK_SIZE/4) stats.stored_bytes += len + 1;
+  }
+  const char *res = entry->str;
+  pthread_mutex_unlock(&lock);
+  return res;
+}
+
+
+strpool_c::stats_t strpool_c::get_stats(void) {
+  pthread_mutex_lock(&lock);
+  strpool_c::stats_t res = stats;
+  pthread_mutex_unlock(&lock);
+  return res;
+}
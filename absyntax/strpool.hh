@@ -0,0 +1,77 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * A pool of interned strings.
+ *
+ * The lexical analyser stores the value of every identifier, literal and direct variable
+ * in this pool (see token_c::value), so that all the tokens with the exact same spelling
+ * share the same storage. Two interned strings are therefore equal if and only if they
+ * are the same pointer.
+ *
+ * NOTE: Interning is case sensitive (i.e. 'Foo' and 'FOO' are stored separately), so that
+ *       the spelling used in the source code is preserved. Since IEC 61131-3 identifiers are
+ *       case insensitive, comparing two identifiers for equality may short-circuit on pointer
+ *       equality, but must otherwise fall back to a case insensitive comparison (see
+ *       compare_identifiers() in absyntax_utils.hh).
+ *
+ * NOTE: Interned strings are never released, and must never be modified nor free()'d.
+ *
+ * NOTE: intern() may be called by several threads at the same time.
+ */
+
+
+#ifndef _STRPOOL_HH
+#define _STRPOOL_HH
+
+#include <stddef.h>  // required for size_t
+
+
+
+class strpool_c {
+  public:
+    /* Return the interned copy of the string str */
+    static const char *intern(const char *str);
+    /* Return the interned copy of the first len characters of str (str need not be '\0' terminated) */
+    static const char *intern(const char *str, size_t len);
+
+    typedef struct {
+      unsigned long int requests;        /* number of calls to intern()                              */
+      unsigned long int strings;         /* number of distinct strings stored in the pool            */
+      unsigned long int requested_bytes; /* memory that would have been used by strdup()'ing every string */
+      unsigned long int stored_bytes;    /* memory actually used to store the strings                */
+    } stats_t;
+    static stats_t get_stats(void);
+};
+
+
+#endif /* _STRPOOL_HH */
@@ -50,6 +50,8 @@
 #include <typeinfo>
 #include <list>
 #include <strings.h>
+#include <stdio.h>  /* required for fprintf() */
+#include <time.h>   /* required for clock_gettime() */
 // #include <string.h>  /* required for strlen() */
 // #include <stdlib.h>  /* required for atoi() */
 // #include <errno.h>   /* required for errno */
@@ -57,6 +59,7 @@
 #include "../util/symtable.hh"
 #include "../util/dsymtable.hh"
 #include "../absyntax/visitor.hh"
+#include "absyntax_utils.hh"
 #include "../main.hh" // required for ERROR() and ERROR_MSG() macros.
 
 
@@ -87,6 +90,12 @@ int compare_identifiers(symbol_c *ident1, symbol_c *ident2) {
     /* invalid identifiers... */
     return -1;
 
+  /* Token values produced by the lexical analyser are interned (see strpool.hh),
+   * so identical spellings share the same storage and we can skip the string comparison.
+   */
+  if (name1->value == name2->value)
+    return 0;
+
   if (strcasecmp(name1->value, name2->value) == 0)
     return 0;
 
@@ -277,9 +286,53 @@ class populate_symtables_c: public iterator_visitor_c {
 
 
 
-void absyntax_utils_init(symbol_c *tree_root) {
+void absyntax_utils_init(symbol_c *tree_root, int first_element) {
   populate_symtables_c populate_symbols;
 
-  tree_root->accept(populate_symbols);
+  /* the results memoized while compiling a previous program are no longer valid */
+  search_base_type_c  ::invalidate_all();
+  type_initial_value_c::invalidate_all();
+  get_datatype_info_c ::clear_type_ids();
+
+  library_c *library = tree_root->as<library_c>();
+  if ((0 == first_element) || (NULL == library)) {
+    tree_root->accept(populate_symbols);
+    return;
+  }
+  for (int i = first_element; i < library->n; i++)
+    library->get_element(i)->accept(populate_symbols);
+}
+
+
+
+
+/***********************************************************************/
+/***********************************************************************/
+/***********************************************************************/
+/***********************************************************************/
+
+
+double memo_stats_time(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+
+static void print_memo_stats(const char *stage_name, const char *cache_name, memo_stats_t stats) {
+  unsigned long lookups = stats.hits + stats.misses;
+  /* the time saved is estimated by assuming every cache hit would have taken as long as the average cache miss */
+  double saved_time = (0 == stats.misses)? 0 : stats.hits * stats.miss_time / stats.misses;
+  fprintf(stderr, "%s: %-20s %9lu lookups, %9lu hits (%5.1f%%), %7.3f ms spent on misses, ~%7.3f ms saved by hits\n",
+          stage_name, cache_name, lookups, stats.hits, (0 == lookups)? 0.0 : 100.0 * stats.hits / lookups,
+          stats.miss_time * 1e3, saved_time * 1e3);
+}
+
+
+void absyntax_utils_print_stats(const char *stage_name) {
+  print_memo_stats(stage_name, "search_base_type_c",   search_base_type_c  ::get_stats());
+  print_memo_stats(stage_name, "type_initial_value_c", type_initial_value_c::get_stats());
+  search_base_type_c  ::reset_stats();
+  type_initial_value_c::reset_stats();
 }
 
@@ -47,6 +47,7 @@
 // #include <stdio.h>  /* required for NULL */
 #include "../util/symtable.hh"
 #include "../util/dsymtable.hh"
+#include "../util/per_thread.hh"
 #include "../absyntax/absyntax.hh"
 #include "../absyntax/visitor.hh"
 
@@ -77,6 +78,19 @@ typedef symtable_c<symbol_c *> type_symtable_t;
 extern  type_symtable_t type_symtable;
 
 
+/* Statistics of the caches in which search_base_type_c and type_initial_value_c
+ * memoize the results of their searches (printed after each stage with the -S option).
+ */
+typedef struct {
+  unsigned long hits;
+  unsigned long misses;
+  double        miss_time;  /* seconds spent searching for the results not found in the cache (only measured with -S) */
+} memo_stats_t;
+
+/* current time, in seconds. Used to measure the time spent on cache misses. */
+double memo_stats_time(void);
+
+
 /***********************************************************************/
 /***********************************************************************/
 /***********************************************************************/
@@ -101,6 +115,11 @@ extern  type_symtable_t type_symtable;
 #include "get_var_name.hh"
 #include "get_datatype_info.hh"
 #include "debug_ast.hh"
+#include "serialize_ast.hh"
+#include "pou_dependency_graph.hh"
+#include "incremental_build.hh"
+#include "phase_profiler.hh"
+#include "hash_cons.hh"
 
 /***********************************************************************/
 /***********************************************************************/
@@ -111,7 +130,14 @@ extern  type_symtable_t type_symtable;
 
 
 
-void absyntax_utils_init(symbol_c *tree_root);
+/* Load the symbol tables above with the elements of the library (tree_root).
+ * The elements of the library before first_element are skipped, as they were already loaded by a previous call
+ * (e.g. the standard library, loaded once by the compile server, see compile_server.hh).
+ */
+void absyntax_utils_init(symbol_c *tree_root, int first_element = 0);
+
+/* print (to stderr), and then reset, the statistics of the caches used by search_base_type_c and type_initial_value_c */
+void absyntax_utils_print_stats(const char *stage_name);
 
 
 #endif /* _SEARCH_UTILS_HH */
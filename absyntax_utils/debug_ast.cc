@@ -43,6 +43,10 @@
 
 #include <unistd.h>
 #include <stdio.h>  /* required for NULL */
+#include <string.h>
+#include <set>
+#include <vector>
+#include <algorithm>
 #include "absyntax_utils.hh"
 #include "../absyntax/visitor.hh"
 
@@ -132,21 +136,21 @@ void print_symbol_c::dump_symbol(symbol_c* symbol) {
     fprintf(stderr, "%s", symbol->datatype->absyntax_cname());
   }
   fprintf(stderr, "\t<-{");
-  if (symbol->candidate_datatypes.size() == 0) {
+  if (symbol->get_candidate_datatypes().size() == 0) {
     fprintf(stderr, "\t\t\t\t\t");
-  } else if (symbol->candidate_datatypes.size() <= 2) {
+  } else if (symbol->get_candidate_datatypes().size() <= 2) {
     for (unsigned int i = 0; i < 2; i++)
-      if (i < symbol->candidate_datatypes.size())
-        fprintf(stderr, " %s,", symbol->candidate_datatypes[i]->absyntax_cname());
+      if (i < symbol->get_candidate_datatypes().size())
+        fprintf(stderr, " %s,", symbol->get_candidate_datatypes()[i]->absyntax_cname());
       else
         fprintf(stderr, "\t\t\t");
   } else {
-    fprintf(stderr, "(%lu)\t\t\t\t\t", (unsigned long int)symbol->candidate_datatypes.size());
+    fprintf(stderr, "(%lu)\t\t\t\t\t", (unsigned long int)symbol->get_candidate_datatypes().size());
   }
   fprintf(stderr, "}\t ");         
   
   /* print the const values... */
-  dump_cvalue(symbol->const_value);
+  dump_cvalue(symbol->get_const_value());
   fprintf(stderr, "\t");
 }
 
@@ -228,6 +232,195 @@ void print_ast_c::suffix_fcall(symbol_c* symbol) {}
 
 
 
+/*********************************/
+/* Class to take a census of the */
+/* memory used by an AST         */
+/*********************************/
+
+class ast_census_c: public fcall_iterator_visitor_c { 
+  public:
+    ast_census_c(void);
+    void take(symbol_c *root_symbol);
+    void print_table(FILE *file);
+    void print_json (FILE *file);
+    
+  protected:
+    void prefix_fcall(symbol_c *symbol);
+  
+  private:
+    typedef struct {
+      const char        *name;
+      unsigned long int  nodes;
+      size_t             bytes;        /* sizeof() the nodes, plus the array of elements of the lists */
+      unsigned long int  elements;     /* list_c only: the number of elements (n) ...                  */
+      unsigned long int  capacity;     /*               ... and of entries allocated (c)               */
+      size_t             slack_bytes;  /* list_c only: memory of the entries allocated but not in use  */
+    } class_census_t;
+
+    class_census_t         classes[kind_count];
+    class_census_t         total;
+    std::vector<bool>      visited;          /* by symbol id: a node reachable through several paths is only counted once */
+    unsigned long int      tokens;
+    size_t                 token_bytes;      /* the token strings, as if each token had its own copy */
+    std::set<const char *> token_values;     /* the distinct token strings */
+    size_t                 distinct_token_bytes;
+    symbol_c::annotation_stats_t annotation_stats;
+    strpool_c::stats_t           strpool_stats;
+
+    /* orders the kinds of symbols by the memory used by their nodes, the most first */
+    struct more_bytes_c {
+      const class_census_t *classes;
+      bool operator()(int kind1, int kind2) const {return classes[kind1].bytes > classes[kind2].bytes;}
+    };
+    std::vector<int> sorted_kinds(void);  /* the kinds of the nodes found in the AST */
+};
+
+
+
+/* sizeof() the objects of each class of symbol */
+static size_t symbol_size(symbol_kind_t kind) {
+  switch (kind) {
+    #define SYM_LIST(class_name_c, ...)                                        case kind_##class_name_c: return sizeof(class_name_c);
+    #define SYM_TOKEN(class_name_c, ...)                                       case kind_##class_name_c: return sizeof(class_name_c);
+    #define SYM_REF0(class_name_c, ...)                                        case kind_##class_name_c: return sizeof(class_name_c);
+    #define SYM_REF1(class_name_c, ref1, ...)                                  case kind_##class_name_c: return sizeof(class_name_c);
+    #define SYM_REF2(class_name_c, ref1, ref2, ...)                            case kind_##class_name_c: return sizeof(class_name_c);
+    #define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                      case kind_##class_name_c: return sizeof(class_name_c);
+    #define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                case kind_##class_name_c: return sizeof(class_name_c);
+    #define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)          case kind_##class_name_c: return sizeof(class_name_c);
+    #define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)    case kind_##class_name_c: return sizeof(class_name_c);
+    #include "../absyntax/absyntax.def"
+    #undef SYM_LIST
+    #undef SYM_TOKEN
+    #undef SYM_REF0
+    #undef SYM_REF1
+    #undef SYM_REF2
+    #undef SYM_REF3
+    #undef SYM_REF4
+    #undef SYM_REF5
+    #undef SYM_REF6
+    case kind_list_c:  return sizeof(list_c);
+    case kind_token_c: return sizeof(token_c);
+    default:           return sizeof(symbol_c);
+  }
+}
+
+
+
+ast_census_c::ast_census_c(void) {
+  memset(classes, 0, sizeof(classes));
+  memset(&total,  0, sizeof(total));
+  tokens = 0;
+  token_bytes = 0;
+  distinct_token_bytes = 0;
+}
+
+
+void ast_census_c::take(symbol_c *root_symbol) {
+  visited.assign(symbol_c::get_annotation_stats().symbols, false);
+  root_symbol->accept(*this);
+  for (int kind = 0; kind < kind_count; kind++) {
+    total.nodes       += classes[kind].nodes;
+    total.bytes       += classes[kind].bytes;
+    total.elements    += classes[kind].elements;
+    total.capacity    += classes[kind].capacity;
+    total.slack_bytes += classes[kind].slack_bytes;
+  }
+  /* taken after visiting the AST, as the visitors may create a few symbols of their own */
+  annotation_stats = symbol_c::get_annotation_stats();
+  strpool_stats    = strpool_c::get_stats();
+}
+
+
+void ast_census_c::prefix_fcall(symbol_c *symbol) {
+  if (symbol->id >= visited.size()) visited.resize(symbol->id + 1, false);
+  if (visited[symbol->id]) return;
+  visited[symbol->id] = true;
+
+  class_census_t &census = classes[symbol->get_kind()];
+  census.name   = symbol->absyntax_cname();
+  census.nodes++;
+  census.bytes += symbol_size(symbol->get_kind());
+
+  list_c *list = symbol->as<list_c>();
+  if (NULL != list) {
+    census.elements    += list->n;
+    census.capacity    += list->c;
+    census.bytes       += list->get_elements_bytes();
+    census.slack_bytes += list->get_slack_bytes();
+  }
+
+  token_c *token = symbol->as<token_c>();
+  if ((NULL != token) && (NULL != token->value)) {
+    tokens++;
+    token_bytes += strlen(token->value) + 1;
+    if (token_values.insert(token->value).second)
+      distinct_token_bytes += strlen(token->value) + 1;
+  }
+}
+
+
+std::vector<int> ast_census_c::sorted_kinds(void) {
+  std::vector<int> kinds;
+  for (int kind = 0; kind < kind_count; kind++)
+    if (classes[kind].nodes > 0) kinds.push_back(kind);
+  more_bytes_c more_bytes = {classes};
+  std::stable_sort(kinds.begin(), kinds.end(), more_bytes);
+  return kinds;
+}
+
+
+void ast_census_c::print_table(FILE *file) {
+  std::vector<int> kinds = sorted_kinds();
+  fprintf(file, "%-50s %10s %12s %12s %12s %12s\n", "class", "nodes", "bytes", "elements", "capacity", "slack bytes");
+  for (unsigned int i = 0; i < kinds.size(); i++) {
+    class_census_t &census = classes[kinds[i]];
+    if (list_c::is_kind((symbol_kind_t)kinds[i]))
+      fprintf(file, "%-50s %10lu %12zu %12lu %12lu %12zu\n", census.name, census.nodes, census.bytes, census.elements, census.capacity, census.slack_bytes);
+    else
+      fprintf(file, "%-50s %10lu %12zu\n", census.name, census.nodes, census.bytes);
+  }
+  fprintf(file, "%-50s %10lu %12zu %12lu %12lu %12zu\n", "total", total.nodes, total.bytes, total.elements, total.capacity, total.slack_bytes);
+
+  fprintf(file, "\n");
+  fprintf(file, "token strings:       %10lu tokens,  %12zu bytes (%zu bytes in %zu distinct strings)\n",
+          tokens, token_bytes, distinct_token_bytes, token_values.size());
+  fprintf(file, "string pool:         %10lu strings, %12lu bytes (%lu bytes requested)\n",
+          strpool_stats.strings, strpool_stats.stored_bytes, strpool_stats.requested_bytes);
+  fprintf(file, "candidate_datatypes: %10lu entries, %12zu bytes\n", annotation_stats.candidate_datatypes, annotation_stats.candidate_datatypes_bytes);
+  fprintf(file, "const_value:         %10lu entries, %12zu bytes\n", annotation_stats.const_value,         annotation_stats.const_value_bytes);
+  fprintf(file, "anotations:          %10lu entries, %12zu bytes\n", annotation_stats.anotations,          annotation_stats.anotations_bytes);
+  fprintf(file, "arena:               %10s          %12zu bytes allocated (%zu bytes reserved)\n", "",
+          arena_c::get_current()->get_allocated_bytes(), arena_c::get_current()->get_reserved_bytes());
+  fprintf(file, "symbols:             %10lu created, %10lu in the AST\n", annotation_stats.symbols, total.nodes);
+}
+
+
+void ast_census_c::print_json(FILE *file) {
+  std::vector<int> kinds = sorted_kinds();
+  fprintf(file, "{\"classes\": [");
+  for (unsigned int i = 0; i < kinds.size(); i++) {
+    class_census_t &census = classes[kinds[i]];
+    fprintf(file, "%s\n  {\"name\": \"%s\", \"nodes\": %lu, \"bytes\": %zu, \"elements\": %lu, \"capacity\": %lu, \"slack_bytes\": %zu}",
+            (0 == i)? "" : ",", census.name, census.nodes, census.bytes, census.elements, census.capacity, census.slack_bytes);
+  }
+  fprintf(file, "\n ],\n");
+  fprintf(file, " \"total\": {\"nodes\": %lu, \"bytes\": %zu, \"elements\": %lu, \"capacity\": %lu, \"slack_bytes\": %zu},\n",
+          total.nodes, total.bytes, total.elements, total.capacity, total.slack_bytes);
+  fprintf(file, " \"token_strings\": {\"tokens\": %lu, \"bytes\": %zu, \"distinct\": %zu, \"distinct_bytes\": %zu},\n",
+          tokens, token_bytes, token_values.size(), distinct_token_bytes);
+  fprintf(file, " \"string_pool\": {\"strings\": %lu, \"bytes\": %lu, \"requested_bytes\": %lu},\n",
+          strpool_stats.strings, strpool_stats.stored_bytes, strpool_stats.requested_bytes);
+  fprintf(file, " \"candidate_datatypes\": {\"entries\": %lu, \"bytes\": %zu},\n", annotation_stats.candidate_datatypes, annotation_stats.candidate_datatypes_bytes);
+  fprintf(file, " \"const_value\": {\"entries\": %lu, \"bytes\": %zu},\n",         annotation_stats.const_value,         annotation_stats.const_value_bytes);
+  fprintf(file, " \"anotations\": {\"entries\": %lu, \"bytes\": %zu},\n",          annotation_stats.anotations,          annotation_stats.anotations_bytes);
+  fprintf(file, " \"arena\": {\"allocated_bytes\": %zu, \"reserved_bytes\": %zu},\n",
+          arena_c::get_current()->get_allocated_bytes(), arena_c::get_current()->get_reserved_bytes());
+  fprintf(file, " \"symbols\": %lu\n}\n", annotation_stats.symbols);
+}
+
+
+
 /*********************************/
 /* The DEBUG class               */
 /*********************************/
@@ -251,6 +444,20 @@ void debug_c::print_ast(symbol_c *symbol) {
   print_ast_c::print(symbol);
 }
 
+int debug_c::print_census(symbol_c *symbol, const char *filename) {
+  ast_census_c census;
+  census.take(symbol);
+
+  bool   json = (strlen(filename) >= 5) && (strcmp(filename + strlen(filename) - 5, ".json") == 0);
+  FILE  *file = (strcmp(filename, "-") == 0)? stderr : fopen(filename, "w");
+  if (NULL == file) return -1;
+
+  if (json) census.print_json (file);
+  else      census.print_table(file);
+
+  if (stderr == file) return 0;
+  return (fclose(file) == 0)? 0 : -1;
+}
 
 
 
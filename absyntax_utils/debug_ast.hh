@@ -52,6 +52,13 @@ class debug_c {
 
     /* print the AST from this point downwards */
     static void print_ast(symbol_c *root_symbol);
+
+    /* Print a census of the memory used by the AST from this point downwards (the number of nodes of each
+     * class, the bytes they use, the slack in the lists, ...) and by the annotations, to filename ("-" for stderr).
+     * The census is printed in JSON format if the name of the file ends in ".json", as a table otherwise.
+     * Returns 0 on success, -1 on error.
+     */
+    static int print_census(symbol_c *root_symbol, const char *filename);
 };
 
 
@@ -42,12 +42,12 @@
  *    run the normal process.
  */
 #include "absyntax_utils.hh"
+#include <sstream>  /* required for std::ostringstream */
 
 #include "../main.hh" // required for ERROR() and ERROR_MSG() macros, as well as the runtime_options global variable
 
 
 
-#include <typeinfo>  // required for typeid
 
 
 /**********************************************************/
@@ -70,7 +70,7 @@
 /****************************************************************************************************/
 class get_datatype_id_c: null_visitor_c {
   private:
-    static get_datatype_id_c *singleton;
+    static __thread get_datatype_id_c *singleton;  /* one per thread */
     
   public:
     static symbol_c *get_id(symbol_c *symbol) {
@@ -146,8 +146,8 @@ class get_datatype_id_c: null_visitor_c {
     void *visit(string_type_declaration_c     *symbol)  {return symbol->string_type_name;}
     /* ref_type_decl: identifier ':' ref_spec_init */
     void *visit(ref_type_decl_c               *symbol)  {return symbol->ref_type_name;}
-    /* NOTE: DO NOT place any code here that references symbol->anotations_map["generate_c_annotaton__implicit_type_id"] !!
-     *       All anotations in the symbol->anotations_map[] are considered a stage4 construct. In the above example,
+    /* NOTE: DO NOT place any code here that references symbol->get_anotation(symbol_c::generate_c_annotaton__implicit_type_id) !!
+     *       All anotations stored with symbol->set_anotation() are considered a stage4 construct. In the above example,
      *       That anotation is specific to the generate_c stage4 code, and must therefore NOT be referenced
      *       in the absyntax_utils code, as this last code should be independent of the stage4 version!
      */ 
@@ -165,7 +165,7 @@ class get_datatype_id_c: null_visitor_c {
     
 }; // get_datatype_id_c 
 
-get_datatype_id_c *get_datatype_id_c::singleton = NULL;
+__thread get_datatype_id_c *get_datatype_id_c::singleton = NULL;
 
 
 
@@ -189,7 +189,7 @@ class get_datatype_id_str_c: public null_visitor_c {
 
   private:
     /* singleton class! */
-    static get_datatype_id_str_c *singleton;
+    static __thread get_datatype_id_str_c *singleton;  /* one per thread */
 
   public:
     static const char *get_id_str(symbol_c *symbol) {
@@ -286,8 +286,8 @@ class get_datatype_id_str_c: public null_visitor_c {
     void *visit(string_type_declaration_c     *symbol)  {return symbol->string_type_name->accept(*this);}
     /* ref_type_decl: identifier ':' ref_spec_init */
     void *visit(ref_type_decl_c               *symbol)  {return symbol->ref_type_name->accept(*this);}
-    /* NOTE: DO NOT place any code here that references symbol->anotations_map["generate_c_annotaton__implicit_type_id"] !!
-     *       All anotations in the symbol->anotations_map[] are considered a stage4 construct. In the above example,
+    /* NOTE: DO NOT place any code here that references symbol->get_anotation(symbol_c::generate_c_annotaton__implicit_type_id) !!
+     *       All anotations stored with symbol->set_anotation() are considered a stage4 construct. In the above example,
      *       That anotation is specific to the generate_c stage4 code, and must therefore NOT be referenced
      *       in the absyntax_utils code, as this last code should be independent of the stage4 version!
      */ 
@@ -311,7 +311,7 @@ class get_datatype_id_str_c: public null_visitor_c {
     void *visit(       program_declaration_c  *symbol)  {return symbol->program_type_name->accept(*this);} 
 };
 
-get_datatype_id_str_c *get_datatype_id_str_c::singleton = NULL;
+__thread get_datatype_id_str_c *get_datatype_id_str_c::singleton = NULL;
 
 
 
@@ -325,7 +325,7 @@ class get_struct_info_c : null_visitor_c {
   private:
     symbol_c *current_field;
     /* singleton class! */
-    static get_struct_info_c *singleton;
+    static __thread get_struct_info_c *singleton;  /* one per thread */
 
   public:
     get_struct_info_c(void) {current_field = NULL;}
@@ -418,7 +418,7 @@ class get_struct_info_c : null_visitor_c {
       
 }; // get_struct_info_c
 
-get_struct_info_c *get_struct_info_c::singleton = NULL;
+__thread get_struct_info_c *get_struct_info_c::singleton = NULL;
 
 
 
@@ -454,9 +454,11 @@ symbol_c *get_datatype_info_c::get_struct_field_type_id(symbol_c *struct_datatyp
 
 symbol_c *get_datatype_info_c::get_array_storedtype_id(symbol_c *type_symbol) {
   // returns the datatype of the variables stored in the array
-  array_specification_c *symbol = NULL;
-  if (NULL == symbol)  symbol = dynamic_cast<array_specification_c *>(type_symbol);
-  if (NULL == symbol)  symbol = dynamic_cast<array_specification_c *>(search_base_type_c::get_basetype_decl(type_symbol));
+  array_specification_c *symbol   = NULL;
+  symbol_c              *basetype = NULL;
+  if ((NULL == symbol) && (NULL != type_symbol))  symbol = type_symbol->as<array_specification_c>();
+  if ((NULL == symbol) && (NULL != (basetype = search_base_type_c::get_basetype_decl(type_symbol))))  
+                                                  symbol = basetype->as<array_specification_c>();
   if (NULL != symbol)  
     return symbol->non_generic_type_name;
   return NULL; // this is not an array!
@@ -581,37 +583,139 @@ symbol_c *get_datatype_info_c::get_array_storedtype_id(symbol_c *type_symbol) {
  *       relaxed datatype equivalince for REF_TO datatypes.
  */
 bool get_datatype_info_c::is_type_equal(symbol_c *first_type, symbol_c *second_type) {
-  if (!is_type_valid( first_type))                                   {return false;}
-  if (!is_type_valid(second_type))                                   {return false;}
+  /* The rules described above are applied when determining the type id of each datatype (see compute_type_id()) */
+  return is_type_id_equal(get_type_id(first_type), get_type_id(second_type));
+}
+
+
+
+/* Type ids
+ * ========
+ * Every datatype is mapped onto a small integer, its type id. Datatypes that are equivalent under the 
+ * datatype model in use (strict or relaxed) get the same type id, so is_type_equal() usually
+ * boils down to comparing two integers. The first datatype that gets a specific type id
+ * becomes the canonical datatype for that type id (see get_canonical_type()).
+ *
+ * The type ids are assigned (following the rules described above) as follows:
+ *   - invalid datatypes (NULL, invalid_type_name_c) get the invalid_type_id. They are not equal to any other datatype.
+ *   - the ANY generic datatype gets the any_type_id, and is equal to all other valid datatypes.
+ *   - elementary datatypes (INT, SAFEINT, STRING, ...) get one type id per elementary datatype.
+ *   - REF_TO datatypes get one type id per (type id of the) referenced datatype. They are also equal 
+ *     to other REF_TO datatypes whose referenced datatypes are equal (e.g. REF_TO ANY). REF_TO datatypes
+ *     whose referenced datatype is not valid get the unequal_type_id (they are only equal to ANY).
+ *   - in the relaxed datatype model, all array datatypes with the same subrange limits, and whose elements
+ *     are of the same datatype, get the same type id.
+ *   - all other datatypes get a type id of their own.
+ *
+ * The type id of each symbol is stored in a side table (indexed by symbol_c::id), so it is only
+ * determined the first time it is needed.
+ *
+ * NOTE: In the relaxed datatype model, the type id of an array datatype depends on the values of
+ *       the array subrange limits, as determined by the constant folding algorithm. The type ids must
+ *       therefore be discarded (with clear_type_ids()) after the constant folding algorithm has run.
+ *       See the comment in stage3.cc. 
+ *
+ * NOTE: Each thread has its own tables of type ids, so the threads that check several POUs at the same time
+ *       (see stage3/pou_executor.hh) need not synchronize when handing out new type ids. Since the threads are only
+ *       started after constant folding has completed, their type ids never need to be discarded.
+ */
+per_thread_c<get_datatype_info_c::type_id_tables_t> get_datatype_info_c::type_id_tables;
+
+
+void get_datatype_info_c::clear_type_ids(void) {
+  type_id_tables_t &tables = type_id_tables.get();
+  tables.type_id_table.clear();
+  tables.type_id_keys.clear();
+  tables.type_ids.clear();
+  /* the reserved type ids... */
+  new_type_id(NULL, -1);  // invalid_type_id
+  new_type_id(NULL, -1);  // any_type_id
+  new_type_id(NULL, -1);  // unequal_type_id
+}
+
+
+get_datatype_info_c::type_id_t get_datatype_info_c::new_type_id(symbol_c *type, type_id_t ref_to) {
+  std::vector<type_id_entry_t> &type_id_table = type_id_tables.get().type_id_table;
+  type_id_entry_t entry = {type, ref_to};
+  type_id_table.push_back(entry);
+  return type_id_table.size() - 1;
+}
+
+
+get_datatype_info_c::type_id_t get_datatype_info_c::get_type_id(symbol_c *type) {
+  if (NULL == type)                                                  {return invalid_type_id;}
+  type_id_tables_t &tables = type_id_tables.get();
+  if (tables.type_id_table.empty())   clear_type_ids();  /* create the reserved type ids */
+
+  type_id_t *type_id = tables.type_ids.find(type->id);
+  if (NULL != type_id)                                               {return *type_id;}
+  type_id_t res = compute_type_id(type);
+  tables.type_ids[type->id] = res;
+  return res;
+}
+
+
+symbol_c *get_datatype_info_c::get_canonical_type(symbol_c *type) {
+  type_id_t type_id = get_type_id(type);
+  if (type_id <= unequal_type_id)                                    {return type;}
+  return type_id_tables.get().type_id_table[type_id].canonical_type;
+}
+
+
+bool get_datatype_info_c::is_type_id_equal(type_id_t first_id, type_id_t second_id) {
+  if ((invalid_type_id == first_id) || (invalid_type_id == second_id)) {return false;}
+  if ((    any_type_id == first_id) || (    any_type_id == second_id)) {return true;}
+  if ((unequal_type_id == first_id) || (unequal_type_id == second_id)) {return false;}
+  if (first_id == second_id)                                         {return true;}
+
+  /* REF_TO datatypes referencing equal (but not identical, e.g. ANY) datatypes */
+  std::vector<type_id_entry_t> &type_id_table = type_id_tables.get().type_id_table;
+  type_id_t first_ref_to  = type_id_table[ first_id].ref_to;
+  type_id_t second_ref_to = type_id_table[second_id].ref_to;
+  if ((first_ref_to >= 0) && (second_ref_to >= 0))                   {return is_type_id_equal(first_ref_to, second_ref_to);}
+  return false;
+}
 
+
+/* Determine the type id of a datatype that does not yet have one */
+get_datatype_info_c::type_id_t get_datatype_info_c::compute_type_id(symbol_c *type) {
+  std::string key;
+  type_id_t   ref_to = -1;
+
+  if (!is_type_valid(type))                                          {return invalid_type_id;}
   /* GENERIC DATATYPES */
   /* For the moment, we only support the ANY generic datatype! */
-  if ((is_ANY_generic_type( first_type)) ||
-      (is_ANY_generic_type(second_type)))                            {return true;}
-      
+  if (is_ANY_generic_type(type))                                     {return any_type_id;}
+
   /* ANY_ELEMENTARY */
-  if ((is_ANY_ELEMENTARY_compatible(first_type)) &&
-      (typeid(*first_type) == typeid(*second_type)))                 {return true;}
-  if (   is_ANY_ELEMENTARY_compatible(first_type) 
-      || is_ANY_ELEMENTARY_compatible(second_type))                  {return false;}  
+  if (is_ANY_ELEMENTARY_compatible(type)) {
+    std::ostringstream ss;
+    ss << "E" << type->get_kind();
+    key = ss.str();
+  }
   
-  /* ANY_DERIVED  */
-  // from now on, we are sure both datatypes are derived...
-  if (is_ref_to(first_type) && is_ref_to(second_type)) {
-    return is_type_equal(search_base_type_c::get_basetype_decl(get_ref_to(first_type )),
-                         search_base_type_c::get_basetype_decl(get_ref_to(second_type)));
+  /* ANY_DERIVED */
+  else if (is_ref_to(type)) {
+    ref_to = get_type_id(search_base_type_c::get_basetype_decl(get_ref_to(type)));
+    if ((invalid_type_id == ref_to) || (unequal_type_id == ref_to))  {return unequal_type_id;}
+    std::ostringstream ss;
+    ss << "R" << ref_to;
+    key = ss.str();
   }
 
-    // check for same datatype
-  if (first_type == second_type)                                     {return true;}
-  
-    // remaining type equivalence rules are not applied in the strict datatype model
-  if (false == runtime_options.relaxed_datatype_model)               {return false;}
-  
-    // check for array equivalence usig the relaxed datatype model
-  if (is_arraytype_equal_relaxed(first_type, second_type))           {return true;}
+  /* check for array equivalence using the relaxed datatype model */
+  else if (   (false == runtime_options.relaxed_datatype_model)
+           || (false == get_arraytype_key_relaxed(type, key)))
+    /* every other datatype is a datatype of its own */
+    return new_type_id(type, -1);
 
-  return false;
+  std::map<std::string, type_id_t> &type_id_keys = type_id_tables.get().type_id_keys;
+  std::map<std::string, type_id_t>::iterator iter = type_id_keys.find(key);
+  if (iter != type_id_keys.end())                                    {return iter->second;}
+
+  type_id_t res = new_type_id(type, ref_to);
+  type_id_keys[key] = res;
+  return res;
 }
 
 
@@ -632,15 +736,18 @@ bool get_datatype_info_c::is_type_equal(symbol_c *first_type, symbol_c *second_t
  *        (e.g.: ARRAY [1..max] of INT, where max must be a constant variable)
  *       the symbol passed to this function may also be a symbolic_variable
  *       (or more correctly, a symbolic_constant_c).
- *       In this case we simply return the string itself.
+ *       In this case we simply return the string itself (in upper case, as case must be ignored).
+ *
+ * Returns false if the symbol is neither an integer nor a symbolic variable/constant.
  */
 #include <string.h>  /* required for strlen() */
-static std::string normalize_subrange_limit(symbol_c *symbol) {
+#include <ctype.h>   /* required for toupper() */
+static bool normalize_subrange_limit(symbol_c *symbol, std::string &str) {
+  str = "";
   // See if it is an integer...  
-  integer_c *integer = dynamic_cast<integer_c *>(symbol);
+  integer_c *integer = symbol->as<integer_c>();
   if (NULL != integer) {
     // handle it as an integer!
-    std::string str = "";
     bool leading_zero = true;
     unsigned int offset = 0;
 
@@ -659,7 +766,7 @@ static std::string normalize_subrange_limit(symbol_c *symbol) {
       if (!leading_zero && integer->value[i] != '_')
         str += integer->value[i];
     }
-    return str;
+    return true;
   }
   
   // See if it is an sybolic_variable_c or symbolic_constant_c...  
@@ -678,66 +785,82 @@ static std::string normalize_subrange_limit(symbol_c *symbol) {
    *        which means that the following code is really not needed. But it is best to have it here just in case...
    */
   token_c             *token    = NULL;
-  symbolic_constant_c *symconst = dynamic_cast<symbolic_constant_c *>(symbol);
-  symbolic_variable_c *symvar   = dynamic_cast<symbolic_variable_c *>(symbol);
+  symbolic_constant_c *symconst = symbol->as<symbolic_constant_c>();
+  symbolic_variable_c *symvar   = symbol->as<symbolic_variable_c>();
   if (NULL != symconst) token   = dynamic_cast<            token_c *>(symconst->var_name);
   if (NULL != symvar  ) token   = dynamic_cast<            token_c *>(symvar  ->var_name);
-  if (NULL != token)
+  if (NULL != token) {
     // handle it as a symbolic_variable/constant_c
-    return token->value;    
+    for (const char *c = token->value; *c != '\0'; c++)
+      str += toupper(*c);
+    return true;
+  }
   
-  ERROR;
-  return NULL; // humour the compiler...
+  return false;
+}
+
+
+/* A local helper function that appends to key the constant value of a subrange limit */
+template<typename value_type> static void append_const_value(std::ostringstream &key, const const_value_c::const_value__<value_type> &cvalue) {
+  if      (cvalue.is_valid    ()) key << "v" << cvalue.get() << ";";
+  else if (cvalue.is_overflow ()) key << "o;";
+  else if (cvalue.is_nonconst ()) key << "n;";
+  else                            key << "u;";
 }
 
 
-/* A helper method to get_datatype_info_c::is_type_equal()
- *  Assuming the relaxed datatype model, determine whether the two array datatypes are equal/equivalent
+/* A helper method to get_datatype_info_c::compute_type_id()
+ *  Assuming the relaxed datatype model, build a key that is identical for all equal/equivalent array datatypes.
+ *  Returns false if type is not an array datatype (or if the array datatype is not equal to any other array datatype).
+ *
+ *  Two array datatypes are equivalent if they have the same subrange limits, and the datatype of their elements is equal.
+ *  Subrange limits are compared using the result of the constant folding agorithm, or, if a limit has not been reduced to
+ *  a const value, using its (normalized) source code.
  */
-bool get_datatype_info_c::is_arraytype_equal_relaxed(symbol_c *first_type, symbol_c *second_type) {
-  symbol_c *basetype_1 = search_base_type_c::get_basetype_decl( first_type);
-  symbol_c *basetype_2 = search_base_type_c::get_basetype_decl(second_type);
-  array_specification_c *array_1 = dynamic_cast<array_specification_c *>(basetype_1);
-  array_specification_c *array_2 = dynamic_cast<array_specification_c *>(basetype_2);
-
-  // are they both array datatypes? 
-  if ((NULL == array_1) || (NULL == array_2))
+bool get_datatype_info_c::get_arraytype_key_relaxed(symbol_c *type, std::string &key) {
+  symbol_c *basetype = search_base_type_c::get_basetype_decl(type);
+  // is it an array datatype? 
+  if (NULL == basetype)
     return false;
-  
-  // number of subranges
-  array_subrange_list_c *subrange_list_1 = dynamic_cast<array_subrange_list_c *>(array_1->array_subrange_list);
-  array_subrange_list_c *subrange_list_2 = dynamic_cast<array_subrange_list_c *>(array_2->array_subrange_list);
-  if ((NULL == subrange_list_1) || (NULL == subrange_list_2)) ERROR;
-  if (subrange_list_1->n != subrange_list_2->n)
+  array_specification_c *array = basetype->as<array_specification_c>();
+  if (NULL == array)
     return false;
-  
-  // comparison of each subrange start and end elements
-  for (int i = 0; i < subrange_list_1->n; i++) {
-    subrange_c *subrange_1 = dynamic_cast<subrange_c *>(subrange_list_1->get_element(i));
-    subrange_c *subrange_2 = dynamic_cast<subrange_c *>(subrange_list_2->get_element(i));
-    if ((NULL == subrange_1) || (NULL == subrange_2)) ERROR;
-    
-    /* check whether the subranges have the same values, using the result of the constant folding agorithm.
-     * This method has the drawback that it inserts a dependency on having to run the constant folding algorithm before
-     *  the get_datatype_info_c::is_type_equal() method is called.
-     *  This is why we implement an alternative method in case the subrange limits have not yet been reduced to a cvalue!
-     */
-    if (    (subrange_1->lower_limit->const_value._int64.is_valid() || subrange_1->lower_limit->const_value._uint64.is_valid())
-         && (subrange_2->lower_limit->const_value._int64.is_valid() || subrange_2->lower_limit->const_value._uint64.is_valid())
-         && (subrange_1->upper_limit->const_value._int64.is_valid() || subrange_1->upper_limit->const_value._uint64.is_valid())
-         && (subrange_2->upper_limit->const_value._int64.is_valid() || subrange_2->upper_limit->const_value._uint64.is_valid())
-       ) {
-      if (! (subrange_1->lower_limit->const_value == subrange_2->lower_limit->const_value)) return false;
-      if (! (subrange_1->upper_limit->const_value == subrange_2->upper_limit->const_value)) return false;
-    } else {
-      // NOTE: nocasecmp_c() class is defined in absyntax.hh. nocasecmp_c() instantiates an object, and nocasecmp_c()() uses the () operator on that object. 
-      if (! nocasecmp_c()(normalize_subrange_limit(subrange_1->lower_limit), normalize_subrange_limit(subrange_2->lower_limit))) return false;
-      if (! nocasecmp_c()(normalize_subrange_limit(subrange_1->upper_limit), normalize_subrange_limit(subrange_2->upper_limit))) return false;
+  if (NULL == array->array_subrange_list)
+    return false;
+  array_subrange_list_c *subrange_list = array->array_subrange_list->as<array_subrange_list_c>();
+  if (NULL == subrange_list)
+    return false;
+
+  std::ostringstream ss;
+  ss << "A" << subrange_list->n << "[";
+  for (int i = 0; i < subrange_list->n; i++) {
+    subrange_c *subrange = subrange_list->get_element(i)->as<subrange_c>();
+    if (NULL == subrange)
+      return false;
+    symbol_c *limits[2] = {subrange->lower_limit, subrange->upper_limit};
+    for (int j = 0; j < 2; j++) {
+      const const_value_c &cvalue = limits[j]->get_const_value();
+      if (cvalue._int64.is_valid() || cvalue._uint64.is_valid()) {
+        append_const_value(ss, cvalue._int64 );
+        append_const_value(ss, cvalue._uint64);
+        append_const_value(ss, cvalue._real64);
+        append_const_value(ss, cvalue._bool  );
+      } else {
+        std::string str;
+        if (!normalize_subrange_limit(limits[j], str))
+          return false;
+        ss << "s" << str << ";";
+      }
+      ss << ((0 == j)? ".." : ",");
     }
   }
 
-  return is_type_equal(search_base_type_c::get_basetype_decl(array_1->non_generic_type_name),
-                       search_base_type_c::get_basetype_decl(array_2->non_generic_type_name));
+  type_id_t element_id = get_type_id(search_base_type_c::get_basetype_decl(array->non_generic_type_name));
+  if ((invalid_type_id == element_id) || (unequal_type_id == element_id))
+    return false;
+  ss << "]" << element_id;
+  key = ss.str();
+  return true;
 }
 
 
@@ -746,7 +869,7 @@ bool get_datatype_info_c::is_arraytype_equal_relaxed(symbol_c *first_type, symbo
 
 bool get_datatype_info_c::is_type_valid(symbol_c *type) {
   if (NULL == type)                                                  {return false;}
-  if (typeid(*type) == typeid(invalid_type_name_c))                  {return false;}
+  if (type->is<invalid_type_name_c>())                  {return false;}
   return true;
 }
 
@@ -758,13 +881,15 @@ bool get_datatype_info_c::is_type_valid(symbol_c *type) {
 
 /* returns the datatype the REF_TO datatype references/points to... */ 
 symbol_c *get_datatype_info_c::get_ref_to(symbol_c *type_symbol) {
-  ref_type_decl_c *type1 = dynamic_cast<ref_type_decl_c *>(type_symbol);
+  if (NULL == type_symbol) return NULL;
+
+  ref_type_decl_c *type1 = type_symbol->as<ref_type_decl_c>();
   if (NULL != type1) type_symbol = type1->ref_spec_init;
 
-  ref_spec_init_c *type2 = dynamic_cast<ref_spec_init_c *>(type_symbol);
+  ref_spec_init_c *type2 = type_symbol->as<ref_spec_init_c>();
   if (NULL != type2) type_symbol = type2->ref_spec;
 
-  ref_spec_c      *type3 = dynamic_cast<ref_spec_c      *>(type_symbol);
+  ref_spec_c      *type3 = type_symbol->as<ref_spec_c     >();
   if (NULL != type3) return type3->type_name;
   
   return NULL; /* this is not a ref datatype!! */
@@ -779,9 +904,9 @@ bool get_datatype_info_c::is_ref_to(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol);
   if (NULL == type_decl)                                                       {return false;}
   
-  if (typeid(*type_decl) == typeid(ref_type_decl_c))                           {return true;}   /* identifier ':' ref_spec_init */
-  if (typeid(*type_decl) == typeid(ref_spec_init_c))                           {return true;}   /* ref_spec [ ASSIGN ref_initialization ]; */
-  if (typeid(*type_decl) == typeid(ref_spec_c))                                {return true;}   /* REF_TO (non_generic_type_name | function_block_type_name) */
+  if (type_decl->is<ref_type_decl_c>())                           {return true;}   /* identifier ':' ref_spec_init */
+  if (type_decl->is<ref_spec_init_c>())                           {return true;}   /* ref_spec [ ASSIGN ref_initialization ]; */
+  if (type_decl->is<ref_spec_c>())                                {return true;}   /* REF_TO (non_generic_type_name | function_block_type_name) */
   return false;
 }
 
@@ -791,7 +916,7 @@ bool get_datatype_info_c::is_ref_to(symbol_c *type_symbol) {
 bool get_datatype_info_c::is_sfc_initstep(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol); 
   if (NULL == type_decl)                                             {return false;}
-  if (typeid(*type_decl) == typeid(initial_step_c))                  {return true;}   /* INITIAL_STEP step_name ':' action_association_list END_STEP */  /* A pseudo data type! */
+  if (type_decl->is<initial_step_c>())                  {return true;}   /* INITIAL_STEP step_name ':' action_association_list END_STEP */  /* A pseudo data type! */
   return false;
 }
 
@@ -800,8 +925,8 @@ bool get_datatype_info_c::is_sfc_initstep(symbol_c *type_symbol) {
 bool get_datatype_info_c::is_sfc_step(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol); 
   if (NULL == type_decl)                                             {return false;}
-  if (typeid(*type_decl) == typeid(initial_step_c))                  {return true;}   /* INITIAL_STEP step_name ':' action_association_list END_STEP */  /* A pseudo data type! */
-  if (typeid(*type_decl) == typeid(        step_c))                  {return true;}   /*         STEP step_name ':' action_association_list END_STEP */  /* A pseudo data type! */
+  if (type_decl->is<initial_step_c>())                  {return true;}   /* INITIAL_STEP step_name ':' action_association_list END_STEP */  /* A pseudo data type! */
+  if (type_decl->is<step_c>())                  {return true;}   /*         STEP step_name ':' action_association_list END_STEP */  /* A pseudo data type! */
   return false;
 }
 
@@ -811,7 +936,7 @@ bool get_datatype_info_c::is_sfc_step(symbol_c *type_symbol) {
 bool get_datatype_info_c::is_function_block(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol); 
   if (NULL == type_decl)                                             {return false;}
-  if (typeid(*type_decl) == typeid(function_block_declaration_c))    {return true;}   /*  FUNCTION_BLOCK derived_function_block_name io_OR_other_var_declarations function_block_body END_FUNCTION_BLOCK */
+  if (type_decl->is<function_block_declaration_c>())    {return true;}   /*  FUNCTION_BLOCK derived_function_block_name io_OR_other_var_declarations function_block_body END_FUNCTION_BLOCK */
   return false;
 }
 
@@ -823,11 +948,11 @@ bool get_datatype_info_c::is_subrange(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_equivtype_decl(type_symbol); /* NOTE: do NOT call search_base_type_c !! */
   if (NULL == type_decl)                                             {return false;}
   
-  if (typeid(*type_decl) == typeid(subrange_type_declaration_c))     {return true;}   /*  subrange_type_name ':' subrange_spec_init */
-  if (typeid(*type_decl) == typeid(subrange_spec_init_c))            {return true;}   /* subrange_specification ASSIGN signed_integer */
-  if (typeid(*type_decl) == typeid(subrange_specification_c))        {return true;}   /*  integer_type_name '(' subrange')' */
+  if (type_decl->is<subrange_type_declaration_c>())     {return true;}   /*  subrange_type_name ':' subrange_spec_init */
+  if (type_decl->is<subrange_spec_init_c>())            {return true;}   /* subrange_specification ASSIGN signed_integer */
+  if (type_decl->is<subrange_specification_c>())        {return true;}   /*  integer_type_name '(' subrange')' */
     
-  if (typeid(*type_decl) == typeid(subrange_c))                      {ERROR;}         /*  signed_integer DOTDOT signed_integer */
+  if (type_decl->is<subrange_c>())                      {ERROR;}         /*  signed_integer DOTDOT signed_integer */
   return false;
 }
 
@@ -839,11 +964,11 @@ bool get_datatype_info_c::is_enumerated(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol);
   if (NULL == type_decl)                                             {return false;}
   
-  if (typeid(*type_decl) == typeid(enumerated_type_declaration_c))   {return true;}   /*  enumerated_type_name ':' enumerated_spec_init */
-  if (typeid(*type_decl) == typeid(enumerated_spec_init_c))          {return true;}   /* enumerated_specification ASSIGN enumerated_value */
-  if (typeid(*type_decl) == typeid(enumerated_value_list_c))         {return true;}   /* enumerated_value_list ',' enumerated_value */        /* once we change the way we handle enums, this will probably become an ERROR! */
+  if (type_decl->is<enumerated_type_declaration_c>())   {return true;}   /*  enumerated_type_name ':' enumerated_spec_init */
+  if (type_decl->is<enumerated_spec_init_c>())          {return true;}   /* enumerated_specification ASSIGN enumerated_value */
+  if (type_decl->is<enumerated_value_list_c>())         {return true;}   /* enumerated_value_list ',' enumerated_value */        /* once we change the way we handle enums, this will probably become an ERROR! */
   
-  if (typeid(*type_decl) == typeid(enumerated_value_c))              {ERROR;}         /* enumerated_type_name '#' identifier */
+  if (type_decl->is<enumerated_value_c>())              {ERROR;}         /* enumerated_type_name '#' identifier */
   return false;
 }
 
@@ -855,13 +980,13 @@ bool get_datatype_info_c::is_array(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol);
   if (NULL == type_decl)                                             {return false;}
   
-  if (typeid(*type_decl) == typeid(array_type_declaration_c))        {return true;}   /*  identifier ':' array_spec_init */
-  if (typeid(*type_decl) == typeid(array_spec_init_c))               {return true;}   /* array_specification [ASSIGN array_initialization} */
-  if (typeid(*type_decl) == typeid(array_specification_c))           {return true;}   /* ARRAY '[' array_subrange_list ']' OF non_generic_type_name */
+  if (type_decl->is<array_type_declaration_c>())        {return true;}   /*  identifier ':' array_spec_init */
+  if (type_decl->is<array_spec_init_c>())               {return true;}   /* array_specification [ASSIGN array_initialization} */
+  if (type_decl->is<array_specification_c>())           {return true;}   /* ARRAY '[' array_subrange_list ']' OF non_generic_type_name */
   
-  if (typeid(*type_decl) == typeid(array_subrange_list_c))           {ERROR;}         /* array_subrange_list ',' subrange */
-  if (typeid(*type_decl) == typeid(array_initial_elements_list_c))   {ERROR;}         /* array_initialization:  '[' array_initial_elements_list ']' */  /* array_initial_elements_list ',' array_initial_elements */
-  if (typeid(*type_decl) == typeid(array_initial_elements_c))        {ERROR;}         /* integer '(' [array_initial_element] ')' */
+  if (type_decl->is<array_subrange_list_c>())           {ERROR;}         /* array_subrange_list ',' subrange */
+  if (type_decl->is<array_initial_elements_list_c>())   {ERROR;}         /* array_initialization:  '[' array_initial_elements_list ']' */  /* array_initial_elements_list ',' array_initial_elements */
+  if (type_decl->is<array_initial_elements_c>())        {ERROR;}         /* integer '(' [array_initial_element] ')' */
   return false;
 }
 
@@ -873,13 +998,13 @@ bool get_datatype_info_c::is_structure(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol);
   if (NULL == type_decl)                                                       {return false;}
   
-  if (typeid(*type_decl) == typeid(structure_type_declaration_c))              {return true;}   /*  structure_type_name ':' structure_specification */
-  if (typeid(*type_decl) == typeid(initialized_structure_c))                   {return true;}   /* structure_type_name ASSIGN structure_initialization */
-  if (typeid(*type_decl) == typeid(structure_element_declaration_list_c))      {return true;}   /* structure_declaration:  STRUCT structure_element_declaration_list END_STRUCT */ /* structure_element_declaration_list structure_element_declaration ';' */
+  if (type_decl->is<structure_type_declaration_c>())              {return true;}   /*  structure_type_name ':' structure_specification */
+  if (type_decl->is<initialized_structure_c>())                   {return true;}   /* structure_type_name ASSIGN structure_initialization */
+  if (type_decl->is<structure_element_declaration_list_c>())      {return true;}   /* structure_declaration:  STRUCT structure_element_declaration_list END_STRUCT */ /* structure_element_declaration_list structure_element_declaration ';' */
   
-  if (typeid(*type_decl) == typeid(structure_element_declaration_c))           {ERROR;}         /*  structure_element_name ':' *_spec_init */
-  if (typeid(*type_decl) == typeid(structure_element_initialization_list_c))   {ERROR;}         /* structure_initialization: '(' structure_element_initialization_list ')' */  /* structure_element_initialization_list ',' structure_element_initialization */
-  if (typeid(*type_decl) == typeid(structure_element_initialization_c))        {ERROR;}         /*  structure_element_name ASSIGN value */
+  if (type_decl->is<structure_element_declaration_c>())           {ERROR;}         /*  structure_element_name ':' *_spec_init */
+  if (type_decl->is<structure_element_initialization_list_c>())   {ERROR;}         /* structure_initialization: '(' structure_element_initialization_list ')' */  /* structure_element_initialization_list ',' structure_element_initialization */
+  if (type_decl->is<structure_element_initialization_c>())        {ERROR;}         /*  structure_element_name ASSIGN value */
   return false;
 }
 
@@ -889,7 +1014,7 @@ bool get_datatype_info_c::is_structure(symbol_c *type_symbol) {
 bool get_datatype_info_c::is_ANY_generic_type(symbol_c *type_symbol) {
   symbol_c *type_decl = search_base_type_c::get_basetype_decl(type_symbol);
   if (NULL == type_decl)                                             {return false;}  
-  if (typeid(*type_decl) == typeid(generic_type_any_c))              {return true;}   /*  The ANY keyword! */
+  if (type_decl->is<generic_type_any_c>())              {return true;}   /*  The ANY keyword! */
   return false;
 }
 
@@ -958,7 +1083,7 @@ bool get_datatype_info_c::is_ANY_MAGNITUDE_compatible(symbol_c *type_symbol) {
 
 bool get_datatype_info_c::is_ANY_signed_MAGNITUDE(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(time_type_name_c))        {return true;}
+  if (type_symbol->is<time_type_name_c>())        {return true;}
   if (is_ANY_signed_NUM(type_symbol))                          {return true;}
   return false;
 }
@@ -966,7 +1091,7 @@ bool get_datatype_info_c::is_ANY_signed_MAGNITUDE(symbol_c *type_symbol) {
 
 bool get_datatype_info_c::is_ANY_signed_SAFEMAGNITUDE(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safetime_type_name_c))    {return true;}
+  if (type_symbol->is<safetime_type_name_c>())    {return true;}
   return is_ANY_signed_SAFENUM(type_symbol);
 }
 
@@ -1072,20 +1197,20 @@ bool get_datatype_info_c::is_ANY_INT_compatible(symbol_c *type_symbol) {
 
 bool get_datatype_info_c::is_ANY_signed_INT(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(sint_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(int_type_name_c))         {return true;}
-  if (typeid(*type_symbol) == typeid(dint_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(lint_type_name_c))        {return true;}
+  if (type_symbol->is<sint_type_name_c>())        {return true;}
+  if (type_symbol->is<int_type_name_c>())         {return true;}
+  if (type_symbol->is<dint_type_name_c>())        {return true;}
+  if (type_symbol->is<lint_type_name_c>())        {return true;}
   return false;
 }
 
 
 bool get_datatype_info_c::is_ANY_signed_SAFEINT(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safesint_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safeint_type_name_c))     {return true;}
-  if (typeid(*type_symbol) == typeid(safedint_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safelint_type_name_c))    {return true;}
+  if (type_symbol->is<safesint_type_name_c>())    {return true;}
+  if (type_symbol->is<safeint_type_name_c>())     {return true;}
+  if (type_symbol->is<safedint_type_name_c>())    {return true;}
+  if (type_symbol->is<safelint_type_name_c>())    {return true;}
   return false;
 }
 
@@ -1107,20 +1232,20 @@ bool get_datatype_info_c::is_ANY_signed_INT_compatible(symbol_c *type_symbol) {
 
 bool get_datatype_info_c::is_ANY_unsigned_INT(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(usint_type_name_c))       {return true;}
-  if (typeid(*type_symbol) == typeid(uint_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(udint_type_name_c))       {return true;}
-  if (typeid(*type_symbol) == typeid(ulint_type_name_c))       {return true;}
+  if (type_symbol->is<usint_type_name_c>())       {return true;}
+  if (type_symbol->is<uint_type_name_c>())        {return true;}
+  if (type_symbol->is<udint_type_name_c>())       {return true;}
+  if (type_symbol->is<ulint_type_name_c>())       {return true;}
   return false;
 }
 
 
 bool get_datatype_info_c::is_ANY_unsigned_SAFEINT(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safeusint_type_name_c))   {return true;}
-  if (typeid(*type_symbol) == typeid(safeuint_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safeudint_type_name_c))   {return true;}
-  if (typeid(*type_symbol) == typeid(safeulint_type_name_c))   {return true;}
+  if (type_symbol->is<safeusint_type_name_c>())   {return true;}
+  if (type_symbol->is<safeuint_type_name_c>())    {return true;}
+  if (type_symbol->is<safeudint_type_name_c>())   {return true;}
+  if (type_symbol->is<safeulint_type_name_c>())   {return true;}
   return false;
 }
 
@@ -1141,16 +1266,16 @@ bool get_datatype_info_c::is_ANY_unsigned_INT_compatible(symbol_c *type_symbol)
 
 bool get_datatype_info_c::is_ANY_REAL(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(real_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(lreal_type_name_c))       {return true;}
+  if (type_symbol->is<real_type_name_c>())        {return true;}
+  if (type_symbol->is<lreal_type_name_c>())       {return true;}
   return false;
 }
 
 
 bool get_datatype_info_c::is_ANY_SAFEREAL(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safereal_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safelreal_type_name_c))   {return true;}
+  if (type_symbol->is<safereal_type_name_c>())    {return true;}
+  if (type_symbol->is<safelreal_type_name_c>())   {return true;}
   return false;
 }
 
@@ -1171,20 +1296,20 @@ bool get_datatype_info_c::is_ANY_REAL_compatible(symbol_c *type_symbol) {
 
 bool get_datatype_info_c::is_ANY_nBIT(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(byte_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(word_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(dword_type_name_c))       {return true;}
-  if (typeid(*type_symbol) == typeid(lword_type_name_c))       {return true;}
+  if (type_symbol->is<byte_type_name_c>())        {return true;}
+  if (type_symbol->is<word_type_name_c>())        {return true;}
+  if (type_symbol->is<dword_type_name_c>())       {return true;}
+  if (type_symbol->is<lword_type_name_c>())       {return true;}
   return false;
 }
 
 
 bool get_datatype_info_c::is_ANY_SAFEnBIT(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safebyte_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safeword_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safedword_type_name_c))   {return true;}
-  if (typeid(*type_symbol) == typeid(safelword_type_name_c))   {return true;}
+  if (type_symbol->is<safebyte_type_name_c>())    {return true;}
+  if (type_symbol->is<safeword_type_name_c>())    {return true;}
+  if (type_symbol->is<safedword_type_name_c>())   {return true;}
+  if (type_symbol->is<safelword_type_name_c>())   {return true;}
   return false;
 }
 
@@ -1207,14 +1332,14 @@ bool get_datatype_info_c::is_ANY_nBIT_compatible(symbol_c *type_symbol) {
 
 bool get_datatype_info_c::is_BOOL(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(bool_type_name_c))        {return true;}
+  if (type_symbol->is<bool_type_name_c>())        {return true;}
   return false;
 }
 
 
 bool get_datatype_info_c::is_SAFEBOOL(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safebool_type_name_c))    {return true;}
+  if (type_symbol->is<safebool_type_name_c>())    {return true;}
   return false;
 }
 
@@ -1266,14 +1391,14 @@ bool get_datatype_info_c::is_ANY_BIT_compatible(symbol_c *type_symbol) {
 
 bool get_datatype_info_c::is_TIME(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(time_type_name_c))        {return true;}
+  if (type_symbol->is<time_type_name_c>())        {return true;}
   return false;
 }
 
 
 bool get_datatype_info_c::is_SAFETIME(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safetime_type_name_c))    {return true;}
+  if (type_symbol->is<safetime_type_name_c>())    {return true;}
   return false;
 }
 
@@ -1294,18 +1419,18 @@ bool get_datatype_info_c::is_TIME_compatible(symbol_c *type_symbol) {
 
 bool get_datatype_info_c::is_ANY_DATE(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(date_type_name_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(tod_type_name_c))         {return true;}
-  if (typeid(*type_symbol) == typeid(dt_type_name_c))          {return true;}
+  if (type_symbol->is<date_type_name_c>())        {return true;}
+  if (type_symbol->is<tod_type_name_c>())         {return true;}
+  if (type_symbol->is<dt_type_name_c>())          {return true;}
   return false;
 }
 
 
 bool get_datatype_info_c::is_ANY_SAFEDATE(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safedate_type_name_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(safetod_type_name_c))     {return true;}
-  if (typeid(*type_symbol) == typeid(safedt_type_name_c))      {return true;}
+  if (type_symbol->is<safedate_type_name_c>())    {return true;}
+  if (type_symbol->is<safetod_type_name_c>())     {return true;}
+  if (type_symbol->is<safedt_type_name_c>())      {return true;}
   return false;
 }
 
@@ -1329,16 +1454,16 @@ bool get_datatype_info_c::is_ANY_DATE_compatible(symbol_c *type_symbol) {
 
 bool get_datatype_info_c::is_ANY_STRING(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(string_type_name_c))      {return true;}
-  if (typeid(*type_symbol) == typeid(wstring_type_name_c))     {return true;}
+  if (type_symbol->is<string_type_name_c>())      {return true;}
+  if (type_symbol->is<wstring_type_name_c>())     {return true;}
   return false;
 }
 
 
 bool get_datatype_info_c::is_ANY_SAFESTRING(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(safestring_type_name_c))  {return true;}
-  if (typeid(*type_symbol) == typeid(safewstring_type_name_c)) {return true;}
+  if (type_symbol->is<safestring_type_name_c>())  {return true;}
+  if (type_symbol->is<safewstring_type_name_c>()) {return true;}
   return false;
 }
 
@@ -1359,7 +1484,7 @@ bool get_datatype_info_c::is_ANY_STRING_compatible(symbol_c *type_symbol) {
 
 bool get_datatype_info_c::is_VOID(symbol_c *type_symbol) {
   if (type_symbol == NULL)                                     {return false;}
-  if (typeid(*type_symbol) == typeid(void_type_name_c))        {return true;}
+  if (type_symbol->is<void_type_name_c>())        {return true;}
   return false;
 }
 
@@ -1374,19 +1499,19 @@ bool get_datatype_info_c::is_VOID(symbol_c *type_symbol) {
 /* Can't we do away with this?? */
 bool get_datatype_info_c::is_ANY_REAL_literal(symbol_c *type_symbol) {
   if (type_symbol == NULL)                              {return true;} /* Please make sure things will work correctly before changing this to false!! */
-  if (typeid(*type_symbol) == typeid(real_c))           {return true;}
-  if (typeid(*type_symbol) == typeid(neg_real_c))       {return true;}
+  if (type_symbol->is<real_c>())           {return true;}
+  if (type_symbol->is<neg_real_c>())       {return true;}
   return false;
 }
 
 /* Can't we do away with this?? */
 bool get_datatype_info_c::is_ANY_INT_literal(symbol_c *type_symbol) {
   if (type_symbol == NULL)                              {return true;} /* Please make sure things will work correctly before changing this to false!! */
-  if (typeid(*type_symbol) == typeid(integer_c))        {return true;}
-  if (typeid(*type_symbol) == typeid(neg_integer_c))    {return true;}
-  if (typeid(*type_symbol) == typeid(binary_integer_c)) {return true;}
-  if (typeid(*type_symbol) == typeid(octal_integer_c))  {return true;}
-  if (typeid(*type_symbol) == typeid(hex_integer_c))    {return true;}
+  if (type_symbol->is<integer_c>())        {return true;}
+  if (type_symbol->is<neg_integer_c>())    {return true;}
+  if (type_symbol->is<binary_integer_c>()) {return true;}
+  if (type_symbol->is<octal_integer_c>())  {return true;}
+  if (type_symbol->is<hex_integer_c>())    {return true;}
   return false;
 }
 
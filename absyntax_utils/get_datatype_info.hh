@@ -55,9 +55,33 @@ class get_datatype_info_c {
      get_datatype_info_c(void) {};
     ~get_datatype_info_c(void) {};
 
-    // A helper method to get_datatype_info_c::is_type_equal()
-    // Assuming the relaxed datatype model, return whether the two array datatypes are equal/equivalent
-    static bool is_arraytype_equal_relaxed(symbol_c *first_type, symbol_c *second_type);
+  public:
+    /* The type id of a datatype (see the comment in get_datatype_info.cc) */
+    typedef int type_id_t;
+
+  private:
+    static const type_id_t invalid_type_id = 0;  /* NULL, invalid_type_name_c: not equal to any datatype */
+    static const type_id_t     any_type_id = 1;  /* the ANY generic datatype: equal to all valid datatypes */
+    static const type_id_t unequal_type_id = 2;  /* datatypes only equal to ANY (e.g. REF_TO an invalid datatype) */
+
+    typedef struct {
+      symbol_c  *canonical_type;  /* the first datatype that got this type id */
+      type_id_t  ref_to;          /* for REF_TO datatypes, the type id of the referenced datatype. -1 otherwise. */
+    } type_id_entry_t;
+
+    typedef struct {
+      std::vector<type_id_entry_t>     type_id_table;  /* indexed by type id */
+      std::map<std::string, type_id_t> type_id_keys;   /* type ids of the datatypes that are not a datatype of their own */
+      side_table_c<type_id_t>          type_ids;       /* type id of each datatype symbol, indexed by symbol_c::id */
+    } type_id_tables_t;
+    /* Each thread hands out type ids of its own (see stage3/pou_executor.hh), so type ids may only be compared with other type ids obtained by the same thread */
+    static per_thread_c<type_id_tables_t> type_id_tables;
+
+    static type_id_t new_type_id    (symbol_c *type, type_id_t ref_to);
+    static type_id_t compute_type_id(symbol_c *type);
+    // A helper method to get_datatype_info_c::compute_type_id()
+    // Assuming the relaxed datatype model, get a key that is the same for all equal/equivalent array datatypes
+    static bool get_arraytype_key_relaxed(symbol_c *type, std::string &key);
   
   public:
     static symbol_c   *get_id    (symbol_c *datatype); /* get the identifier (name) of the datatype); returns NULL if anonymous datatype! Does not work for elementary datatypes!*/
@@ -83,6 +107,14 @@ class get_datatype_info_c {
     static bool is_type_equal(symbol_c *first_type, symbol_c *second_type);
     static bool is_type_valid(symbol_c *type);
 
+    /* Equal/equivalent datatypes (see is_type_equal() ) usually get the same type id, so comparing 
+     * datatypes becomes comparing integers. The exceptions (ANY, REF_TO ANY, ...) are handled by is_type_id_equal().
+     */
+    static type_id_t get_type_id       (symbol_c *type);
+    static bool      is_type_id_equal  (type_id_t first_id, type_id_t second_id);
+    static symbol_c *get_canonical_type(symbol_c *type);  /* the first datatype that got the same type id as type */
+    static void      clear_type_ids    (void);            /* discard all type ids (of the calling thread) */
+
     static bool is_ref_to                          (symbol_c *type_symbol);    // Defined in IEC 61131-3 v3
     static bool is_sfc_initstep                    (symbol_c *type_symbol);
     static bool is_sfc_step                        (symbol_c *type_symbol);
@@ -80,8 +80,8 @@ class get_sizeof_datatype_c: public null_visitor_c {
     ~get_sizeof_datatype_c(void);
 
   private:
-    /* this class is a singleton. So we need a pointer to the single instance... */
-    static get_sizeof_datatype_c *singleton;
+    /* this class is a singleton. So we need a pointer to the single instance... (one per thread) */
+    static __thread get_sizeof_datatype_c *singleton;
 
   private:
 #if 0   /* We no longer need the code for handling numeric literals. But keep it around for a little while longer... */
@@ -0,0 +1,320 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * Hash-consing of the AST.
+ * See the comment in hash_cons.hh
+ */
+
+
+#include <string.h>
+#include "hash_cons.hh"
+#include "../main.hh" // required for ERROR() and ERROR_MSG() macros.
+
+
+
+static unsigned long hash_string(const char *str) {
+  unsigned long hash = 5381;
+  for (; (NULL != str) && ('\0' != *str); str++) hash = hash * 33 + (unsigned char)*str;
+  return hash;
+}
+
+#define HASH_COMBINE(hash, value) ((hash) * 1000003UL ^ (value))
+
+
+
+unsigned long hash_cons_c::hash(symbol_c *symbol) {
+  if (NULL == symbol) return 0;
+  unsigned long hash = symbol->get_kind() + 1;
+
+  switch (symbol->get_kind()) {
+#define SYM_LIST(class_name_c, ...)                                             \
+    case kind_##class_name_c: {                                                 \
+      list_c *list = static_cast<class_name_c *>(symbol);                      \
+      hash = HASH_COMBINE(hash, list->n);                                       \
+      for (int i = 0; i < list->n; i++)                                         \
+        hash = HASH_COMBINE(hash, hash_cons_c::hash(list->get_element(i)));     \
+      break;}
+#define SYM_TOKEN(class_name_c, ...)                                            \
+    case kind_##class_name_c:                                                   \
+      hash = HASH_COMBINE(hash, hash_string(static_cast<class_name_c *>(symbol)->value)); \
+      break;
+#define SYM_REF0(class_name_c, ...)
+#define HASH_REF(ref)                                                           \
+      hash = HASH_COMBINE(hash, hash_cons_c::hash(s->ref));
+#define SYM_REF1(class_name_c, ref1, ...)                                       \
+    case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+      HASH_REF(ref1)                                                            \
+      break;}
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 \
+    case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+      HASH_REF(ref1) HASH_REF(ref2)                                             \
+      break;}
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           \
+    case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+      HASH_REF(ref1) HASH_REF(ref2) HASH_REF(ref3)                              \
+      break;}
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     \
+    case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+      HASH_REF(ref1) HASH_REF(ref2) HASH_REF(ref3) HASH_REF(ref4)               \
+      break;}
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               \
+    case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+      HASH_REF(ref1) HASH_REF(ref2) HASH_REF(ref3) HASH_REF(ref4) HASH_REF(ref5) \
+      break;}
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         \
+    case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+      HASH_REF(ref1) HASH_REF(ref2) HASH_REF(ref3) HASH_REF(ref4) HASH_REF(ref5) \
+      HASH_REF(ref6)                                                            \
+      break;}
+#include "../absyntax/absyntax.def"
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef HASH_REF
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+    default: break;
+  }
+  return hash;
+}
+
+
+
+bool hash_cons_c::is_equal(symbol_c *first, symbol_c *second) {
+  if (first == second)                                return true;
+  if ((NULL == first) || (NULL == second))            return false;
+  if (first->get_kind() != second->get_kind())        return false;
+
+  switch (first->get_kind()) {
+#define SYM_LIST(class_name_c, ...)                                             \
+    case kind_##class_name_c: {                                                 \
+      list_c *list1 = static_cast<class_name_c *>(first);                      \
+      list_c *list2 = static_cast<class_name_c *>(second);                     \
+      if (list1->n != list2->n) return false;                                   \
+      for (int i = 0; i < list1->n; i++)                                        \
+        if (!is_equal(list1->get_element(i), list2->get_element(i))) return false; \
+      return true;}
+#define SYM_TOKEN(class_name_c, ...)                                            \
+    case kind_##class_name_c: {                                                 \
+      const char *value1 = static_cast<class_name_c *>(first )->value;         \
+      const char *value2 = static_cast<class_name_c *>(second)->value;         \
+      if ((NULL == value1) || (NULL == value2)) return (value1 == value2);      \
+      return (strcmp(value1, value2) == 0);}
+#define SYM_REF0(class_name_c, ...)                                             \
+    case kind_##class_name_c: return true;
+#define EQUAL_REF(ref)                                                          \
+      if (!is_equal(s1->ref, s2->ref)) return false;
+#define SYM_REF1(class_name_c, ref1, ...)                                       \
+    case kind_##class_name_c: {class_name_c *s1 = static_cast<class_name_c *>(first), *s2 = static_cast<class_name_c *>(second); \
+      EQUAL_REF(ref1)                                                           \
+      return true;}
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 \
+    case kind_##class_name_c: {class_name_c *s1 = static_cast<class_name_c *>(first), *s2 = static_cast<class_name_c *>(second); \
+      EQUAL_REF(ref1) EQUAL_REF(ref2)                                           \
+      return true;}
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           \
+    case kind_##class_name_c: {class_name_c *s1 = static_cast<class_name_c *>(first), *s2 = static_cast<class_name_c *>(second); \
+      EQUAL_REF(ref1) EQUAL_REF(ref2) EQUAL_REF(ref3)                           \
+      return true;}
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     \
+    case kind_##class_name_c: {class_name_c *s1 = static_cast<class_name_c *>(first), *s2 = static_cast<class_name_c *>(second); \
+      EQUAL_REF(ref1) EQUAL_REF(ref2) EQUAL_REF(ref3) EQUAL_REF(ref4)           \
+      return true;}
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               \
+    case kind_##class_name_c: {class_name_c *s1 = static_cast<class_name_c *>(first), *s2 = static_cast<class_name_c *>(second); \
+      EQUAL_REF(ref1) EQUAL_REF(ref2) EQUAL_REF(ref3) EQUAL_REF(ref4) EQUAL_REF(ref5) \
+      return true;}
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         \
+    case kind_##class_name_c: {class_name_c *s1 = static_cast<class_name_c *>(first), *s2 = static_cast<class_name_c *>(second); \
+      EQUAL_REF(ref1) EQUAL_REF(ref2) EQUAL_REF(ref3) EQUAL_REF(ref4) EQUAL_REF(ref5) \
+      EQUAL_REF(ref6)                                                           \
+      return true;}
+#include "../absyntax/absyntax.def"
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef EQUAL_REF
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+    default: break;
+  }
+  return false;  /* symbol_c, list_c and token_c objects are never equal to a different object */
+}
+
+
+
+symbol_c *hash_cons_c::get_canonical(symbol_c *symbol) {
+  unsigned long symbol_hash = hash(symbol);
+  std::pair<std::multimap<unsigned long, symbol_c *>::iterator, std::multimap<unsigned long, symbol_c *>::iterator> range = table.equal_range(symbol_hash);
+  for (std::multimap<unsigned long, symbol_c *>::iterator iter = range.first; iter != range.second; iter++)
+    if (is_equal(iter->second, symbol)) return iter->second;
+  table.insert(std::pair<unsigned long, symbol_c *>(symbol_hash, symbol));
+  return symbol;
+}
+
+
+
+
+/* Walk through the declarations of an element of the library, replacing each anonymous datatype
+ * by the first identical datatype found in the same element.
+ * NOTE: This is called on (nearly) every symbol of the AST, so it is not a visitor_c, to avoid the cost of the virtual calls.
+ */
+class type_spec_sharer_c {
+  private:
+    hash_cons_c hash_cons;
+    int         shared_count;
+
+  public:
+    type_spec_sharer_c(void): shared_count(0) {}
+
+    int  get_shared_count(void) {return shared_count;}
+
+    void share_library_element(symbol_c *element) {
+      /* A configuration holds several scopes (its own VAR_GLOBAL, and those of each RESOURCE), in which the same
+       * name may refer to distinct constants, so identical datatypes (e.g. INT (1..N)) may not be the same datatype.
+       */
+      if (element->is<configuration_declaration_c>()) return;
+      hash_cons.clear();  /* see the comment in hash_cons.hh, on why we only share within each element of the library */
+      share(element);
+    }
+
+  private:
+    /* Replace the element in position pos of the list by the symbol returned by share() */
+    void share_element(list_c *list, int pos) {
+      symbol_c *element   = list->get_element(pos);
+      symbol_c *canonical = share(element);
+      if (canonical != element) list->set_element(pos, canonical);
+    }
+
+    /* Returns the symbol that must replace symbol in the AST */
+    symbol_c *share(symbol_c *symbol) {
+      switch (symbol->get_kind()) {
+        /* the anonymous datatypes that may be shared */
+        case kind_array_specification_c:
+          if (!runtime_options.relaxed_datatype_model) return symbol;
+          /* fall through */
+        case kind_subrange_specification_c:
+        case kind_single_byte_limited_len_string_spec_c:
+        case kind_double_byte_limited_len_string_spec_c:
+        case kind_ref_spec_c: {
+          symbol_c *canonical = hash_cons.get_canonical(symbol);
+          if (canonical != symbol) shared_count++;
+          return canonical;
+        }
+
+        /* named datatypes are datatypes of their own */
+        case kind_array_type_declaration_c:
+        case kind_subrange_type_declaration_c:
+        case kind_string_type_declaration_c:
+        case kind_ref_type_decl_c:
+        /* the bodies of the POUs do not declare any datatypes */
+        case kind_statement_list_c:
+        case kind_instruction_list_c:
+          return symbol;
+
+        default: break;
+      }
+
+      switch (symbol->get_kind()) {
+#define SYM_LIST(class_name_c, ...)                                             \
+        case kind_##class_name_c: {                                             \
+          list_c *list = static_cast<class_name_c *>(symbol);                  \
+          for (int i = 0; i < list->n; i++)                                     \
+            if (NULL != list->get_element(i)) share_element(list, i);           \
+          break;}
+#define SYM_TOKEN(class_name_c, ...)
+#define SYM_REF0(class_name_c, ...)
+#define SHARE_REF(ref)                                                          \
+          if (NULL != s->ref) s->ref = share(s->ref);
+#define SYM_REF1(class_name_c, ref1, ...)                                       \
+        case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+          SHARE_REF(ref1)                                                       \
+          break;}
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 \
+        case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+          SHARE_REF(ref1) SHARE_REF(ref2)                                       \
+          break;}
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           \
+        case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+          SHARE_REF(ref1) SHARE_REF(ref2) SHARE_REF(ref3)                       \
+          break;}
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     \
+        case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+          SHARE_REF(ref1) SHARE_REF(ref2) SHARE_REF(ref3) SHARE_REF(ref4)       \
+          break;}
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               \
+        case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+          SHARE_REF(ref1) SHARE_REF(ref2) SHARE_REF(ref3) SHARE_REF(ref4)       \
+          SHARE_REF(ref5)                                                       \
+          break;}
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         \
+        case kind_##class_name_c: {class_name_c *s = static_cast<class_name_c *>(symbol); \
+          SHARE_REF(ref1) SHARE_REF(ref2) SHARE_REF(ref3) SHARE_REF(ref4)       \
+          SHARE_REF(ref5) SHARE_REF(ref6)                                       \
+          break;}
+#include "../absyntax/absyntax.def"
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SHARE_REF
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+        default: break;
+      }
+      return symbol;
+    }
+};
+
+
+
+int hash_cons_c::share_type_specs(symbol_c *tree_root) {
+  list_c *library = dynamic_cast<list_c *>(tree_root);
+  if (NULL == library) ERROR;
+
+  type_spec_sharer_c type_spec_sharer;
+  for (int i = 0; i < library->n; i++)
+    type_spec_sharer.share_library_element(library->get_element(i));
+  return type_spec_sharer.get_shared_count();
+}
@@ -0,0 +1,111 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * Hash-consing: share a single (canonical) copy of structurally identical subtrees of the AST.
+ *
+ * Two subtrees are structurally identical if their symbols are of the same classes, the tokens
+ * have the same values, and the lists have the same number of elements, all of them identical.
+ * The location of the symbols in the source code is ignored.
+ *
+ * share_type_specs() uses this to share the anonymous datatypes declared inside a POU, e.g.
+ *         VAR a, b: ARRAY [1..10] OF INT;
+ *             c:    ARRAY [1..10] OF INT;
+ *             s:    STRING[80];
+ *             t:    STRING[80] := 'hello';
+ *         END_VAR
+ * Once shared, c references the same array_specification_c as a and b, and t references the same
+ * single_byte_limited_len_string_spec_c as s. Stage 3 then only annotates a single copy
+ * of each datatype (candidate datatypes, type ids, base types, ...), and the same datatype is used when
+ * generating the C code. The symbols that are no longer referenced remain in the arena (see arena.hh).
+ *   NOTE: Stage 4 already declares a single C type for all the identical anonymous arrays (they map onto the same
+ *         name, e.g. __ARRAY_OF_INT_10, see generate_c_typedecl.cc), so it needs no changes to handle the sharing.
+ *
+ * A shared datatype is the subtree of its first occurrence, which keeps the parent and the location it had there:
+ *   - the parent of the root of the shared datatype is the symbol of the first occurrence that referenced it
+ *     (e.g. its subrange_spec_init_c). No algorithm reads the parent of these datatypes (stage 3 only reads the parents
+ *     of the initial values of structures, and stage 4 those of the dereference operators, none of which are inside
+ *     the shared datatypes).
+ *   - the symbols inside the shared datatype have the same parents as in any other occurrence, as they are all inside
+ *     the datatype itself, and in the same scope, as the datatypes are only shared inside each element of the library.
+ *   - an error found inside a shared datatype (e.g. the subrange of ARRAY [10..1] OF INT) is still reported once for
+ *     each occurrence, as the checkers visit the datatype through each variable declaration that references it,
+ *     but always at the location of the first occurrence.
+ * tests/unit/share_type_specs.cc checks all of the above.
+ *
+ * The datatypes are only shared inside each element of the library (a POU, or a TYPE ... END_TYPE declaration), as
+ * each element may be checked by a distinct thread in stage 3 (see stage3/pou_executor.hh), and the side tables
+ * storing the annotations do not support several threads annotating the same symbol.
+ * The datatypes declared in configurations are never shared, as a configuration holds several scopes (the
+ * configuration, and each of its resources), and the constants used in identical datatypes (e.g. the N in INT (1..N))
+ * may therefore refer to distinct variables.
+ * Only anonymous datatypes whose equality does not depend on their identity are shared:
+ *   - subranges (INT (1..10)) and strings of limited length (STRING[80]), that have the datatype of their base type;
+ *   - REF_TO datatypes, as REF_TO datatypes that reference the same datatype are always equal;
+ *   - arrays, but only in the relaxed datatype model (in the strict datatype model every anonymous array is
+ *     a datatype of its own, see the comment in get_datatype_info.cc).
+ * The datatypes declared in a TYPE ... END_TYPE are never shared, as each one is a datatype of its own.
+ * Literals outside these datatypes (e.g. in expressions, or initial values) are never shared either, as the datatype
+ * of each literal depends on where it is used (see narrow_candidate_datatypes.cc).
+ */
+
+
+#ifndef _HASH_CONS_HH
+#define _HASH_CONS_HH
+
+#include <map>
+#include "../absyntax/absyntax.hh"
+
+
+class hash_cons_c {
+  public:
+    /* The structural hash and equality of two subtrees */
+    static unsigned long hash    (symbol_c *symbol);
+    static bool          is_equal(symbol_c *first, symbol_c *second);
+
+    /* Returns the first symbol given to this hash_cons_c that is structurally identical to symbol,
+     * or symbol itself if there is none (in which case symbol becomes the canonical symbol).
+     */
+    symbol_c *get_canonical(symbol_c *symbol);
+    void      clear(void) {table.clear();}
+
+    /* Share the identical anonymous datatypes declared inside each element of the library tree_root.
+     * Returns the number of datatypes replaced by an identical one.
+     */
+    static int share_type_specs(symbol_c *tree_root);
+
+  private:
+    std::multimap<unsigned long, symbol_c *> table;  /* the canonical symbols, by structural hash */
+};
+
+
+#endif /* _HASH_CONS_HH */
@@ -0,0 +1,460 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * Incremental compilation: determine which POUs have not changed since the previous compilation.
+ * See the comment in incremental_build.hh
+ *
+ * Layout of the state file (<state_directory>/pou_state):
+ *   - magic string and version of the state format
+ *   - build identifier of matiec
+ *   - the hash of the build, options and library elements that are not POUs (environment key)
+ *   - the hash of the global variables declared in the configurations (globals key)
+ *   - for every POU: its name, the hash of its contents, and its key
+ * The names and content hashes are only used to report why a POU is not up to date (-S option).
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>    /* required for getpid() */
+#include <sys/stat.h>  /* required for mkdir()  */
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+#include "absyntax_utils.hh"
+#include "incremental_build.hh"
+#include "../absyntax/visitor.hh"
+#include "../main.hh" // required for ERROR() and ERROR_MSG() macros.
+#include "incremental_build_id.h"  /* generated by the Makefile */
+
+
+
+/* Increment whenever the layout of the state file, or the way the keys are computed, changes! */
+#define STATE_FORMAT_VERSION 2
+#define STATE_MAGIC          "MATIEC-POUSTATE"
+#define STATE_FILENAME       "pou_state"
+
+/* The keys are only valid for the exact same sources of matiec, as the code generated for a POU
+ * (and the kind of each symbol, used in the hash of its contents) may change when the sources change.
+ * NOTE: Unlike the build time, a checksum of the sources does not change when the same sources are simply
+ *       rebuilt, so the state of an incremental compilation survives a rebuild of the compiler.
+ */
+#define STATE_BUILD_ID       INCREMENTAL_BUILD_SOURCES_ID
+
+
+
+/* FNV-1a hash */
+static uint64_t hash_bytes(uint64_t hash, const void *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    hash ^= ((const unsigned char *)data)[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static uint64_t hash_uint(uint64_t hash, uint64_t value) {return hash_bytes(hash, &value, sizeof(value));}
+static uint64_t hash_str (uint64_t hash, const char *str) {return hash_bytes(hash, str, strlen(str) + 1);}
+
+#define HASH_SEED 14695981039346656037ULL
+
+
+
+
+/* Hash of the contents of an AST, ignoring the location of each symbol in the source code (so that
+ * inserting or removing lines before a POU does not change its hash), and the annotations of stage 3 and 4.
+ */
+class hash_ast_c: public null_visitor_c {
+  private:
+    uint64_t hash;
+    bool     has_externals;  /* found a VAR_EXTERN declaration */
+
+    void add_symbol(symbol_c *symbol) {
+      if (NULL == symbol) hash = hash_uint(hash, 0);
+      else                symbol->accept(*this);
+    }
+    void add_kind(symbol_c *symbol) {
+      hash = hash_uint(hash, symbol->get_kind() + 1);
+      if (symbol->is<external_var_declarations_c>()) has_externals = true;
+    }
+
+  public:
+    /* has_externals, if not NULL, returns whether the AST contains any VAR_EXTERN declarations */
+    static uint64_t get_hash(symbol_c *symbol, bool *has_externals = NULL) {
+      hash_ast_c hash_ast;
+      hash_ast.hash          = HASH_SEED;
+      hash_ast.has_externals = false;
+      hash_ast.add_symbol(symbol);
+      if (NULL != has_externals) *has_externals = hash_ast.has_externals;
+      return hash_ast.hash;
+    }
+
+  #define SYM_LIST(class_name_c, ...)                                                                       \
+    void *visit(class_name_c *symbol) {                                                                     \
+      add_kind(symbol); hash = hash_uint(hash, symbol->n);                                                  \
+      for (int i = 0; i < symbol->n; i++) add_symbol(symbol->get_element(i));                               \
+      return NULL;                                                                                          \
+    }
+  #define SYM_TOKEN(class_name_c, ...)                                                                      \
+    void *visit(class_name_c *symbol) {add_kind(symbol); hash = hash_str(hash, symbol->value); return NULL;}
+  #define SYM_REF0(class_name_c, ...)                                                                       \
+    void *visit(class_name_c *symbol) {add_kind(symbol); return NULL;}
+  #define SYM_REF1(class_name_c, ref1, ...)                                                                 \
+    void *visit(class_name_c *symbol) {add_kind(symbol); add_symbol(symbol->ref1); return NULL;}
+  #define SYM_REF2(class_name_c, ref1, ref2, ...)                                                           \
+    void *visit(class_name_c *symbol) {add_kind(symbol); add_symbol(symbol->ref1); add_symbol(symbol->ref2);\
+                                       return NULL;}
+  #define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                                                     \
+    void *visit(class_name_c *symbol) {add_kind(symbol); add_symbol(symbol->ref1); add_symbol(symbol->ref2);\
+                                       add_symbol(symbol->ref3); return NULL;}
+  #define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                                               \
+    void *visit(class_name_c *symbol) {add_kind(symbol); add_symbol(symbol->ref1); add_symbol(symbol->ref2);\
+                                       add_symbol(symbol->ref3); add_symbol(symbol->ref4); return NULL;}
+  #define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)                                         \
+    void *visit(class_name_c *symbol) {add_kind(symbol); add_symbol(symbol->ref1); add_symbol(symbol->ref2);\
+                                       add_symbol(symbol->ref3); add_symbol(symbol->ref4);                  \
+                                       add_symbol(symbol->ref5); return NULL;}
+  #define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)                                   \
+    void *visit(class_name_c *symbol) {add_kind(symbol); add_symbol(symbol->ref1); add_symbol(symbol->ref2);\
+                                       add_symbol(symbol->ref3); add_symbol(symbol->ref4);                  \
+                                       add_symbol(symbol->ref5); add_symbol(symbol->ref6); return NULL;}
+
+  #include "../absyntax/absyntax.def"
+
+  #undef SYM_LIST
+  #undef SYM_TOKEN
+  #undef SYM_REF0
+  #undef SYM_REF1
+  #undef SYM_REF2
+  #undef SYM_REF3
+  #undef SYM_REF4
+  #undef SYM_REF5
+  #undef SYM_REF6
+};
+
+
+
+
+/* Hash of the VAR_GLOBAL declarations of a configuration and of its resources, i.e. of the
+ * variables the POUs may access through VAR_EXTERN.
+ */
+class hash_globals_c: public iterator_visitor_c {
+  private:
+    uint64_t hash;
+
+  public:
+    hash_globals_c(uint64_t hash_): hash(hash_) {}
+    uint64_t get_hash(void) {return hash;}
+
+    void *visit(global_var_declarations_c *symbol) {hash = hash_uint(hash, hash_ast_c::get_hash(symbol)); return NULL;}
+};
+
+
+
+
+/* Why a POU is not up to date */
+typedef enum {
+  up_to_date_rs,
+  changed_rs,            /* the contents of the POU changed (or it is a new POU)                                   */
+  dependency_changed_rs, /* a POU it depends upon changed                                                          */
+  environment_changed_rs,/* the build of matiec, the command line options, or the datatype declarations changed    */
+  globals_changed_rs,    /* it has VAR_EXTERN declarations, and the global variables of the configurations changed */
+  no_key_rs,             /* depends on undeclared POUs, or on itself (an error that will be reported by stage 3)   */
+  not_kept_rs            /* set_out_of_date(), i.e. the code previously generated for the POU is no longer available */
+} reason_t;
+
+typedef struct {
+  const char *name;
+  uint64_t    content_hash;
+  uint64_t    key;
+  bool        has_key;
+  bool        has_externals;
+  reason_t    reason;
+} pou_t;
+
+static bool                         initialised__ = false;
+static std::string                  state_filename__;
+static uint64_t                     environment_key__;
+static uint64_t                     globals_key__;
+static std::map<symbol_c *, pou_t>  pous__;
+
+
+
+/* Read the whole file into memory. Returns NULL on error. */
+static char *read_file(const char *filename, size_t *size) {
+  FILE *file = fopen(filename, "rb");
+  if (NULL == file) return NULL;
+
+  char *buf = NULL;
+  long int len;
+  if ((fseek(file, 0, SEEK_END) == 0) && ((len = ftell(file)) >= 0) && (fseek(file, 0, SEEK_SET) == 0)) {
+    buf = (char *)malloc(len + 1);  /* +1 so we never call malloc(0) */
+    if ((NULL != buf) && (fread(buf, 1, len, file) != (size_t)len)) {free(buf); buf = NULL;}
+    *size = len;
+  }
+  fclose(file);
+  return buf;
+}
+
+
+static bool is_pou(symbol_c *element) {
+  return (   element->is<function_declaration_c>()
+          || element->is<function_block_declaration_c>()
+          || element->is<program_declaration_c>());
+}
+
+
+/* The command line options that change the analysis of a POU, or the code generated for it */
+static uint64_t runtime_options_hash(uint64_t hash) {
+  hash = hash_uint(hash, runtime_options.allow_void_datatype     );
+  hash = hash_uint(hash, runtime_options.allow_missing_var_in    );
+  hash = hash_uint(hash, runtime_options.disable_implicit_en_eno );
+  hash = hash_uint(hash, runtime_options.pre_parsing             );
+  hash = hash_uint(hash, runtime_options.safe_extensions         );
+  hash = hash_uint(hash, runtime_options.conversion_functions    );
+  hash = hash_uint(hash, runtime_options.nested_comments         );
+  hash = hash_uint(hash, runtime_options.ref_standard_extensions );
+  hash = hash_uint(hash, runtime_options.ref_nonstand_extensions );
+  hash = hash_uint(hash, runtime_options.nonliteral_in_array_size);
+  hash = hash_uint(hash, runtime_options.relaxed_datatype_model  );
+  return hash;
+}
+
+
+
+/* The key of a POU, computed recursively from the keys of the POUs it depends upon. */
+class pou_keys_c {
+  private:
+    typedef enum {not_computed_ks, computing_ks, computed_ks, no_key_ks} key_state_t;
+
+    pou_dependency_graph_c   &graph;
+    std::vector<key_state_t>  state;
+    std::vector<uint64_t>     content_hash;
+    std::vector<bool>         has_externals;
+    std::vector<uint64_t>     key;
+
+  public:
+    pou_keys_c(pou_dependency_graph_c &graph_, const std::vector<uint64_t> &content_hash_, const std::vector<bool> &has_externals_)
+      : graph(graph_), state(graph_.get_node_count(), not_computed_ks), content_hash(content_hash_), has_externals(has_externals_),
+        key(graph_.get_node_count()) {}
+
+    /* returns false if the POU has no key, i.e. it must always be analysed and generated */
+    bool get_key(int node, uint64_t *key_) {
+      if (not_computed_ks == state[node]) {
+        state[node] = computing_ks; /* so we detect circular dependencies */
+        bool has_key = is_pou(graph.get_symbol(node)) && graph.get_undeclared_references(node).empty();
+        uint64_t hash = hash_uint(environment_key__, content_hash[node]);
+        if (has_externals[node]) hash = hash_uint(hash, globals_key__);
+        const std::vector<int> &dependencies = graph.get_dependencies(node);
+        for (unsigned int i = 0; has_key && (i < dependencies.size()); i++) {
+          uint64_t dependency_key;
+          has_key = get_key(dependencies[i], &dependency_key);
+          hash = hash_uint(hash, dependency_key);
+        }
+        state[node] = has_key? computed_ks : no_key_ks;
+        key  [node] = hash;
+      }
+      *key_ = key[node];
+      return (computed_ks == state[node]);
+    }
+};
+
+
+
+
+int incremental_build_c::init(const char *state_dir, symbol_c *tree_root, const char *options) {
+  initialised__ = true;
+  pous__.clear();
+
+#ifdef _WIN32
+  if ((mkdir(state_dir)       != 0) && (errno != EEXIST)) return -1;
+#else
+  if ((mkdir(state_dir, 0777) != 0) && (errno != EEXIST)) return -1;
+#endif
+  state_filename__  = state_dir;
+  state_filename__ += "/" STATE_FILENAME;
+
+  library_c *library = tree_root->as<library_c>();
+  if (NULL == library) return 0;  /* nothing is ever up to date */
+
+  /* Hash the contents of each element of the library, and the environment (everything a POU may depend upon, other than other POUs) */
+  std::vector<uint64_t> content_hash (library->n);
+  std::vector<bool>     has_externals(library->n, false);
+  environment_key__ = hash_str(HASH_SEED, STATE_BUILD_ID);
+  environment_key__ = hash_str(environment_key__, (NULL == options)? "" : options);
+  environment_key__ = runtime_options_hash(environment_key__);
+  hash_globals_c hash_globals(HASH_SEED);
+  for (int i = 0; i < library->n; i++) {
+    symbol_c *element = library->get_element(i);
+    if (element->is<configuration_declaration_c>()) {
+      /* Stage 3 and stage 4 always handle the configurations in full. The POUs only depend on their global
+       * variables, through VAR_EXTERN declarations (e.g. the constant value of a VAR_GLOBAL CONSTANT used as
+       * the limit of an ARRAY, see stage3.cc), so these are only included in the key of POUs with VAR_EXTERNs.
+       */
+      element->accept(hash_globals);
+      continue;
+    }
+    bool element_has_externals;
+    content_hash [i] = hash_ast_c::get_hash(element, &element_has_externals);
+    has_externals[i] = element_has_externals;
+    if (!is_pou(element))
+      environment_key__ = hash_uint(environment_key__, content_hash[i]);
+  }
+  globals_key__ = hash_globals.get_hash();
+
+  /* The key of every POU */
+  pou_dependency_graph_c dependency_graph(library);
+  pou_keys_c             pou_keys(dependency_graph, content_hash, has_externals);
+  for (int i = 0; i < library->n; i++) {
+    symbol_c *element = library->get_element(i);
+    if (!is_pou(element)) continue;
+    pou_t &pou = pous__[element];
+    pou.name          = get_datatype_info_c::get_id_str(dependency_graph.get_name(i));
+    pou.content_hash  = content_hash[i];
+    pou.has_externals = has_externals[i];
+    pou.has_key       = pou_keys.get_key(i, &pou.key);
+    pou.reason        = pou.has_key? changed_rs : no_key_rs;
+  }
+
+  /* Load the state saved by the previous compilation */
+  size_t len;
+  char *data = read_file(state_filename__.c_str(), &len);
+  if (NULL == data) return 0;  /* no previous compilation */
+
+  const char *buf = data, *end = data + len;
+  const char *str;
+  uint64_t    uval, saved_environment_key, saved_globals_key, num_pous;
+  std::set<uint64_t> saved_keys, saved_content_hashes;
+
+  #define CHECK(condition) {if (!(condition)) {free(data); return 0;}}
+  CHECK((len >= sizeof(STATE_MAGIC)) && (memcmp(buf, STATE_MAGIC, sizeof(STATE_MAGIC)) == 0));
+  buf += sizeof(STATE_MAGIC);
+  CHECK(serialize_ast_c::get_uint(&buf, end, &uval) && (uval == STATE_FORMAT_VERSION));
+  CHECK(serialize_ast_c::get_str (&buf, end, &str ) && (NULL != str) && (strcmp(str, STATE_BUILD_ID) == 0));
+  CHECK(serialize_ast_c::get_uint(&buf, end, &saved_environment_key));
+  CHECK(serialize_ast_c::get_uint(&buf, end, &saved_globals_key));
+  CHECK(serialize_ast_c::get_uint(&buf, end, &num_pous));
+  for (uint64_t i = 0; i < num_pous; i++) {
+    uint64_t content_hash, key;
+    CHECK(serialize_ast_c::get_str (&buf, end, &str) && (NULL != str));
+    CHECK(serialize_ast_c::get_uint(&buf, end, &content_hash));
+    CHECK(serialize_ast_c::get_uint(&buf, end, &key));
+    saved_content_hashes.insert(content_hash);
+    saved_keys          .insert(key);
+  }
+  #undef CHECK
+  free(data);
+
+  for (std::map<symbol_c *, pou_t>::iterator iter = pous__.begin(); iter != pous__.end(); iter++) {
+    pou_t &pou = iter->second;
+    if      (!pou.has_key)                                              pou.reason = no_key_rs;
+    else if (saved_keys.count(pou.key) > 0)                             pou.reason = up_to_date_rs;
+    else if (saved_environment_key != environment_key__)                pou.reason = environment_changed_rs;
+    else if (pou.has_externals && (saved_globals_key != globals_key__)) pou.reason = globals_changed_rs;
+    else if (saved_content_hashes.count(pou.content_hash) > 0)          pou.reason = dependency_changed_rs;
+    else                                                                pou.reason = changed_rs;
+  }
+  return 0;
+}
+
+
+
+bool incremental_build_c::is_up_to_date(symbol_c *element) {
+  if (!initialised__) return false;
+  std::map<symbol_c *, pou_t>::iterator iter = pous__.find(element);
+  return (iter != pous__.end()) && (up_to_date_rs == iter->second.reason);
+}
+
+
+void incremental_build_c::set_out_of_date(symbol_c *element) {
+  std::map<symbol_c *, pou_t>::iterator iter = pous__.find(element);
+  if ((iter != pous__.end()) && (up_to_date_rs == iter->second.reason))
+    iter->second.reason = not_kept_rs;
+}
+
+
+
+int incremental_build_c::save(bool compilation_succeeded) {
+  if (!initialised__) return 0;
+
+  std::vector<pou_t *> saved_pous;
+  for (std::map<symbol_c *, pou_t>::iterator iter = pous__.begin(); iter != pous__.end(); iter++)
+    if (iter->second.has_key && (compilation_succeeded || (up_to_date_rs == iter->second.reason)))
+      saved_pous.push_back(&iter->second);
+
+  std::string buf;
+  buf.append(STATE_MAGIC, sizeof(STATE_MAGIC));
+  serialize_ast_c::put_uint(buf, STATE_FORMAT_VERSION);
+  serialize_ast_c::put_str (buf, STATE_BUILD_ID);
+  serialize_ast_c::put_uint(buf, environment_key__);
+  serialize_ast_c::put_uint(buf, globals_key__);
+  serialize_ast_c::put_uint(buf, saved_pous.size());
+  for (unsigned int i = 0; i < saved_pous.size(); i++) {
+    serialize_ast_c::put_str (buf, saved_pous[i]->name);
+    serialize_ast_c::put_uint(buf, saved_pous[i]->content_hash);
+    serialize_ast_c::put_uint(buf, saved_pous[i]->key);
+  }
+
+  /* Write to a temporary file first, and then rename it, so the state file is never left half written. */
+  char pid[32];
+  snprintf(pid, sizeof(pid), ".%d.tmp", (int)getpid());
+  std::string tmp_filename = state_filename__ + pid;
+
+  FILE *file = fopen(tmp_filename.c_str(), "wb");
+  int res = -1;
+  if (NULL != file) {
+    bool ok = (fwrite(buf.data(), 1, buf.size(), file) == buf.size());
+    if ((fclose(file) == 0) && ok && (rename(tmp_filename.c_str(), state_filename__.c_str()) == 0))
+      res = 0;
+  }
+  if (res < 0) remove(tmp_filename.c_str());
+  return res;
+}
+
+
+
+void incremental_build_c::print_stats(void) {
+  if (!initialised__) return;
+
+  int count[not_kept_rs + 1] = {0};
+  for (std::map<symbol_c *, pou_t>::iterator iter = pous__.begin(); iter != pous__.end(); iter++)
+    count[iter->second.reason]++;
+  fprintf(stderr, "incremental build: %d of %lu POUs up to date; %d changed, %d affected by changed POUs, "
+                  "%d affected by changed options/datatypes, %d affected by changed global variables, "
+                  "%d with unresolved dependencies, %d with missing generated code\n",
+          count[up_to_date_rs], (unsigned long)pous__.size(), count[changed_rs], count[dependency_changed_rs],
+          count[environment_changed_rs], count[globals_changed_rs], count[no_key_rs], count[not_kept_rs]);
+}
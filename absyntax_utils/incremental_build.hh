@@ -0,0 +1,101 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * Incremental compilation: determine which POUs have not changed since the previous compilation.
+ *
+ * With the -U <state_directory> command line option, the key of every POU (FUNCTION, FUNCTION_BLOCK
+ * and PROGRAM) that was successfully compiled is kept in a file inside the state directory. The key
+ * of a POU is a hash of
+ *   - the contents of the POU (its AST, ignoring the location of each symbol in the source code),
+ *   - the keys of all the POUs it depends upon (see pou_dependency_graph.hh), i.e. the key of a POU
+ *     changes whenever any POU it directly or indirectly depends upon changes,
+ *   - the contents of all the other elements of the library, other than configurations
+ *     (i.e. the derived datatype declarations and pragmas),
+ *   - for POUs with VAR_EXTERN declarations only, the global variables declared in the configurations
+ *     and their resources (e.g. a VAR_GLOBAL CONSTANT may be used as the limit of an ARRAY in the POU),
+ *   - the build of matiec, and the command line options.
+ *
+ * A POU whose key is found in the state saved by the previous compilation is up to date. Stage 4 keeps
+ * the code it generated for an up to date POU in the previous compilation (i.e. the <pou_name>.c and
+ * <pou_name>.h files of the '-O p' option of generate_c), instead of generating it once again.
+ *
+ * Since the state is only saved once the compilation succeeds, an up to date POU has already been
+ * successfully analysed by stage 3, i.e. the cached result of stage 3 is merely 'no errors found'.
+ * Stage 3 therefore does not run the checkers that only report errors on the POUs that are up to date
+ * (print_datatypes_error, and the declaration, lvalue, array range and case elements checks). The
+ * datatype analysis (fill/narrow candidate datatypes) must still annotate them, as the annotations of
+ * an up to date POU are used when analysing the changed POUs that call it, and the configurations.
+ * If the code generator is not able to keep the code of a POU (e.g. its files no longer exist), then
+ * the POU must be marked as out of date (set_out_of_date()) before running stage 3.
+ *
+ * Note that the source code is still parsed in full, and the algorithms of stage 3 that are not run
+ * separately on each POU (flow control analysis, constant folding, ...) still analyse every POU.
+ * The time saved on an up to date POU is therefore mostly that of stage 4.
+ */
+
+
+#ifndef _INCREMENTAL_BUILD_HH
+#define _INCREMENTAL_BUILD_HH
+
+#include "../absyntax/absyntax.hh"
+
+
+class incremental_build_c {
+  public:
+    /* Load the state saved by the previous compilation in state_dir, and determine which POUs of the library are
+     * up to date. options: the command line options (that were not already stored in runtime_options) that change
+     * the code generated for a POU, e.g. the options of stage 4.
+     * Returns -1 if the state directory could not be created, 0 otherwise (a missing or stale state is not an error!).
+     */
+    static int  init(const char *state_dir, symbol_c *tree_root, const char *options);
+
+    /* Whether the element of the library is up to date, and therefore need not be checked for errors (stage 3) nor generated (stage 4).
+     * Always returns false when init() has not been called.
+     */
+    static bool is_up_to_date(symbol_c *element);
+    static void set_out_of_date(symbol_c *element);
+
+    /* Save the keys of the POUs that are up to date. If compilation_succeeded, the keys of all the other POUs are saved too.
+     *   NOTE: This must be called (with compilation_succeeded = false) before stage 4 starts changing the files of any
+     *         POU that is not up to date, so that if the compilation fails the saved state never refers to POUs whose
+     *         files may have been left half written.
+     * Returns 0 on success, -1 on error.
+     */
+    static int  save(bool compilation_succeeded);
+
+    /* print (to stderr) the number of POUs that are up to date, and why the others are not */
+    static void print_stats(void);
+};
+
+
+#endif /* _INCREMENTAL_BUILD_HH */
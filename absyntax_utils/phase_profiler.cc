@@ -0,0 +1,189 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * The phase profiler.
+ * See the comment in phase_profiler.hh
+ */
+
+
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <sys/resource.h>  /* required for getrusage() */
+#endif
+
+#include "phase_profiler.hh"
+#include "../absyntax/absyntax.hh"
+#include "../main.hh" // required for ERROR() and ERROR_MSG() macros.
+
+
+
+typedef struct {
+  const char   *name;
+  std::string   path;         /* the names of the enclosing phases, and of this phase, separated by '/' */
+  int           parent;       /* index of the enclosing phase in phases__ (-1 if none) */
+  int           depth;
+  unsigned long calls;
+  double        wall_time;    /* in seconds */
+  double        cpu_time;     /* in seconds */
+  unsigned long nodes;
+  long          peak_rss;     /* in KB */
+  /* when the phase was last started */
+  double        start_wall_time;
+  double        start_cpu_time;
+  unsigned long start_nodes;
+} phase_t;
+
+
+bool phase_profiler_c::enabled__ = false;
+
+static std::vector<phase_t> phases__;   /* in the order they were first started */
+static std::vector<int>     running__;  /* the phases currently running (indexes into phases__), innermost last */
+
+
+
+static double get_time(clockid_t clock) {
+  struct timespec now;
+  clock_gettime(clock, &now);
+  return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+
+static long get_peak_rss(void) {
+#ifdef _WIN32
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+  #ifdef __APPLE__
+  return usage.ru_maxrss / 1024;  /* in bytes on Mac OS X */
+  #else
+  return usage.ru_maxrss;         /* in KB on linux */
+  #endif
+#endif
+}
+
+
+
+void phase_profiler_c::enable(void) {
+  enabled__ = true;
+  phases__.clear();
+  running__.clear();
+}
+
+
+void phase_profiler_c::start__(const char *name) {
+  int parent = running__.empty()? -1 : running__.back();
+
+  /* has this phase already been run (within the same enclosing phase)? */
+  int index = -1;
+  for (int i = phases__.size() - 1; (i >= 0) && (index < 0); i--)
+    if ((phases__[i].parent == parent) && (strcmp(phases__[i].name, name) == 0))
+      index = i;
+
+  if (index < 0) {
+    phase_t phase;
+    phase.name      = name;
+    phase.path      = (parent < 0)? std::string(name) : phases__[parent].path + "/" + name;
+    phase.parent    = parent;
+    phase.depth     = running__.size();
+    phase.calls     = 0;
+    phase.wall_time = 0;
+    phase.cpu_time  = 0;
+    phase.nodes     = 0;
+    phase.peak_rss  = 0;
+    index = phases__.size();
+    phases__.push_back(phase);
+  }
+
+  phase_t &phase = phases__[index];
+  phase.calls++;
+  phase.start_nodes     = symbol_c::accept_count;
+  phase.start_cpu_time  = get_time(CLOCK_PROCESS_CPUTIME_ID);
+  phase.start_wall_time = get_time(CLOCK_MONOTONIC);
+  running__.push_back(index);
+}
+
+
+void phase_profiler_c::stop__(void) {
+  if (running__.empty()) ERROR;
+
+  phase_t &phase = phases__[running__.back()];
+  running__.pop_back();
+  phase.wall_time += get_time(CLOCK_MONOTONIC) - phase.start_wall_time;
+  phase.cpu_time  += get_time(CLOCK_PROCESS_CPUTIME_ID) - phase.start_cpu_time;
+  phase.nodes     += symbol_c::accept_count - phase.start_nodes;
+  phase.peak_rss   = get_peak_rss();
+}
+
+
+
+void phase_profiler_c::print_table(FILE *file) {
+  fprintf(file, "%-50s %8s %12s %12s %14s %14s\n", "phase", "calls", "wall ms", "cpu ms", "AST nodes", "peak RSS KB");
+  for (unsigned int i = 0; i < phases__.size(); i++) {
+    phase_t &phase = phases__[i];
+    fprintf(file, "%*s%-*s %8lu %12.3f %12.3f %14lu %14ld\n", 2 * phase.depth, "", 50 - 2 * phase.depth, phase.name,
+            phase.calls, phase.wall_time * 1e3, phase.cpu_time * 1e3, phase.nodes, phase.peak_rss);
+  }
+}
+
+
+void phase_profiler_c::print_json(FILE *file) {
+  fprintf(file, "{\"phases\": [");
+  for (unsigned int i = 0; i < phases__.size(); i++) {
+    phase_t &phase = phases__[i];
+    /* NOTE: the names of the phases never contain characters that must be escaped */
+    fprintf(file, "%s\n  {\"name\": \"%s\", \"path\": \"%s\", \"depth\": %d, \"calls\": %lu, \"wall_ms\": %.3f, \"cpu_ms\": %.3f, \"nodes\": %lu, \"peak_rss_kb\": %ld}",
+            (0 == i)? "" : ",", phase.name, phase.path.c_str(), phase.depth, phase.calls,
+            phase.wall_time * 1e3, phase.cpu_time * 1e3, phase.nodes, phase.peak_rss);
+  }
+  fprintf(file, "\n]}\n");
+}
+
+
+int phase_profiler_c::write_report(const char *filename) {
+  /* stop any phases still running (e.g. when bailing out after finding errors) */
+  while (!running__.empty()) stop__();
+
+  bool   json = (strlen(filename) >= 5) && (strcmp(filename + strlen(filename) - 5, ".json") == 0);
+  FILE  *file = (strcmp(filename, "-") == 0)? stderr : fopen(filename, "w");
+  if (NULL == file) return -1;
+
+  if (json) print_json (file);
+  else      print_table(file);
+
+  if (stderr == file) return 0;
+  return (fclose(file) == 0)? 0 : -1;
+}
@@ -0,0 +1,100 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * The phase profiler: where does the compiler spend its time (-P command line option).
+ *
+ * The compiler is divided into phases (stage1_2, stage3, ...), that may themselves be divided into
+ * (nested) phases (e.g. each of the algorithms run by stage3). For each phase the profiler records
+ *   - the wall clock time,
+ *   - the CPU time (of all the threads of the process),
+ *   - the number of AST nodes visited (i.e. the number of calls to accept(), see symbol_c::accept_count),
+ *   - the peak resident set size of the process, at the end of the phase,
+ * and the number of times the phase was run (a phase may be run several times, e.g. once for each POU,
+ * in which case the times and node counts are added up).
+ *
+ * The report is written as a table (for humans), or in JSON format (for tools that track the compile time
+ * of each commit), e.g.
+ *   {"phases": [
+ *      {"name": "stage3", "path": "stage3", "depth": 0, "calls": 1, "wall_ms": 12.345, "cpu_ms": 12.001, "nodes": 123456, "peak_rss_kb": 23456},
+ *      {"name": "fill_candidate_datatypes", "path": "stage3/fill_candidate_datatypes", "depth": 1, ...},
+ *      ...]}
+ *
+ * A phase is started and stopped with start()/stop(), or by declaring a profile_phase_c in the scope to be profiled.
+ * Nothing is recorded (and start()/stop() cost next to nothing) unless the profiler has been enabled.
+ *
+ * NOTE: The phases must be started and stopped by the main thread only. The AST nodes visited by other
+ *       threads are counted by the main thread once it has waited for them (see stage3/pou_executor.cc).
+ */
+
+
+#ifndef _PHASE_PROFILER_HH
+#define _PHASE_PROFILER_HH
+
+#include <stdio.h>
+
+
+class phase_profiler_c {
+  public:
+    static void enable(void);
+    static bool is_enabled(void) {return enabled__;}
+
+    /* start a phase, nested in the phase currently running (if any) */
+    static void start(const char *name) {if (enabled__) start__(name);}
+    /* stop the phase currently running */
+    static void stop (void)             {if (enabled__) stop__();}
+
+    /* Write the report to filename ("-" for stderr). The report is written in JSON format if
+     * the name of the file ends in ".json", as a table otherwise.
+     * Returns 0 on success, -1 on error.
+     */
+    static int  write_report(const char *filename);
+
+  private:
+    static bool enabled__;
+    static void start__(const char *name);
+    static void stop__ (void);
+    static void print_table(FILE *file);
+    static void print_json (FILE *file);
+};
+
+
+
+/* Profile the enclosing scope as a phase */
+class profile_phase_c {
+  public:
+    profile_phase_c(const char *name) {phase_profiler_c::start(name);}
+   ~profile_phase_c(void)             {phase_profiler_c::stop();}
+};
+
+
+#endif /* _PHASE_PROFILER_HH */
@@ -0,0 +1,208 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * The dependency graph of the POUs in a library.
+ * See the comment in pou_dependency_graph.hh
+ */
+
+
+#include "absyntax_utils.hh"
+#include "../main.hh" // required for ERROR() and ERROR_MSG() macros.
+#include <queue>
+
+
+
+
+/* Determine the name of a library element, and all the POU names it references.
+ *
+ * NOTE: Anywhere in the AST that references a PROGRAM, FB type, or FUNCTION name, a poutype_identifier_c
+ *       is used (previously a simple identifier_c was used!), so we merely need to look for these objects.
+ *       However, the name of the POU itself may also be a poutype_identifier_c, so we must only look inside
+ *       the declarations and the body of the POU.
+ */
+class find_pou_references_c: public search_visitor_c {
+  private:
+    symbol_c                *name;
+    std::vector<symbol_c *> *references;
+
+    void *handle_pou(symbol_c *name_, symbol_c *search1, symbol_c *search2, symbol_c *search3 = NULL) {
+      name = name_;
+      if (NULL != search1) search1->accept(*this);
+      if (NULL != search2) search2->accept(*this);
+      if (NULL != search3) search3->accept(*this);
+      return NULL;
+    }
+
+  public:
+    /* returns the name of the POU (or NULL if it is not a POU), and adds every POU name it references to references_ */
+    symbol_c *get_references(symbol_c *library_element, std::vector<symbol_c *> &references_) {
+      name = NULL;
+      references = &references_;
+      library_element->accept(*this);
+      return name;
+    }
+
+    /*******************************************/
+    /* B 1.1 - Letters, digits and identifiers */
+    /*******************************************/
+    void *visit(poutype_identifier_c *symbol) {references->push_back(symbol); return NULL;}
+    /********************************/
+    /* B 1.3.3 - Derived data types */
+    /********************************/
+    /* derived datatypes are not POUs, and therefore do not have dependencies in the graph */
+    void *visit(data_type_declaration_c *symbol) {return NULL;}
+    /**************************************/
+    /* B.1.5 - Program organization units */
+    /**************************************/
+    void *visit(function_declaration_c       *symbol) {return handle_pou(symbol->derived_function_name, symbol->type_name, symbol->var_declarations_list, symbol->function_body);}
+    void *visit(function_block_declaration_c *symbol) {return handle_pou(symbol->fblock_name,           symbol->var_declarations, symbol->fblock_body);}
+    void *visit(program_declaration_c        *symbol) {return handle_pou(symbol->program_type_name,     symbol->var_declarations, symbol->function_block_body);}
+    /********************************/
+    /* B 1.7 Configuration elements */
+    /********************************/
+    void *visit(configuration_declaration_c  *symbol) {return handle_pou(symbol->configuration_name,    symbol->global_var_declarations, symbol->resource_declarations, symbol->access_declarations);}
+};   /* class find_pou_references_c */
+
+
+
+
+const std::vector<int> pou_dependency_graph_c::no_dependents;
+
+
+int pou_dependency_graph_c::get_name_id(symbol_c *name) {
+  token_c *token = dynamic_cast<token_c *>(name);
+  if (NULL == token) ERROR;
+
+  nocase_hashtable_c<int>::iterator iter = name_ids.find(token->value);
+  if (iter != name_ids.end()) return iter->second;
+  int name_id = names.size();
+  names.push_back(name_t());
+  name_ids.insert(token->value, name_id);
+  return name_id;
+}
+
+
+pou_dependency_graph_c::pou_dependency_graph_c(library_c *library) {
+  find_pou_references_c   find_pou_references;
+  std::vector<symbol_c *> references;
+  std::vector<int>        last_referenced_by;  /* the last node found to reference each name, to ignore repeated references */
+
+  if (NULL == library) ERROR;
+  nodes.resize(library->n);
+  /* the first reference to each of the names in referenced_names, of every node */
+  std::vector<std::vector<symbol_c *> > first_references(library->n);
+
+  /* Determine the name of each POU, and the names it references */
+  for (int i = 0; i < library->n; i++) {
+    node_t &node = nodes[i];
+    references.clear();
+    node.symbol  = library->get_element(i);
+    node.name    = find_pou_references.get_references(node.symbol, references);
+    node.name_id = (NULL == node.name)? -1 : get_name_id(node.name);
+    if (node.name_id >= 0)
+      names[node.name_id].declared_by.push_back(i);
+    for (unsigned int j = 0; j < references.size(); j++) {
+      int name_id = get_name_id(references[j]);
+      if (last_referenced_by.size() < names.size())
+        last_referenced_by.resize(names.size(), -1);
+      if (last_referenced_by[name_id] == i)
+        continue; /* name already referenced by this same POU */
+      last_referenced_by[name_id] = i;
+      node.referenced_names.push_back(name_id);
+      names[name_id].referenced_by.push_back(i);
+      first_references[i].push_back(references[j]);
+    }
+  }
+
+  /* Now that all the POU names are known, determine the dependencies of each POU */
+  for (int i = 0; i < library->n; i++) {
+    node_t &node = nodes[i];
+    for (unsigned int j = 0; j < node.referenced_names.size(); j++) {
+      name_t &name = names[node.referenced_names[j]];
+      if (name.declared_by.empty())
+        node.undeclared_references.push_back(first_references[i][j]);
+      node.dependencies.insert(node.dependencies.end(), name.declared_by.begin(), name.declared_by.end());
+    }
+  }
+}
+
+
+pou_dependency_graph_c::~pou_dependency_graph_c(void) {
+}
+
+
+/* This is Kahn's algorithm, in which the nodes that are ready to be placed (i.e. whose references have all been
+ * satisfied) are taken from a priority queue. The priority of each node is given by the iteration (pass) in which
+ * it would be taken if we were repeatedly going through the library, followed by its position in the library.
+ *
+ * When a node at position i, taken in pass p, satisfies a reference of the node at position j, the
+ * node j could be taken in the same pass p if it comes later in the library (j > i), otherwise it must wait for
+ * the following pass (p + 1).
+ */
+bool pou_dependency_graph_c::topological_sort(std::vector<int> &order) {
+  typedef std::pair<int, int> priority_t; /* (pass, node) */
+  std::priority_queue<priority_t, std::vector<priority_t>, std::greater<priority_t> > ready;
+  std::vector<int>  missing_count(nodes.size());  /* number of names referenced by the node that have not yet been satisfied */
+  std::vector<int>  pass         (nodes.size(), 1);
+  std::vector<bool> satisfied    (names.size(), false);
+
+  order.clear();
+  for (unsigned int i = 0; i < nodes.size(); i++) {
+    missing_count[i] = nodes[i].referenced_names.size();
+    if (0 == missing_count[i])
+      ready.push(priority_t(1, i));
+  }
+
+  while (!ready.empty()) {
+    int p = ready.top().first;
+    int i = ready.top().second;
+    ready.pop();
+    order.push_back(i);
+
+    int name_id = nodes[i].name_id;
+    if ((name_id < 0) || satisfied[name_id])
+      continue;  /* not a POU, or an overloaded POU whose name has already been satisfied */
+    satisfied[name_id] = true;
+    std::vector<int> &referenced_by = names[name_id].referenced_by;
+    for (unsigned int k = 0; k < referenced_by.size(); k++) {
+      int j = referenced_by[k];
+      int j_pass = (j > i)? p : p + 1;
+      if (pass[j] < j_pass)
+        pass[j] = j_pass;
+      if (0 == --missing_count[j])
+        ready.push(priority_t(pass[j], j));
+    }
+  }
+
+  return (order.size() == nodes.size());
+}
@@ -0,0 +1,115 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * The dependency graph of the POUs (Functions, FBs, Programs and Configurations) in a library.
+ *
+ * Every element of the library_c (POUs, but also derived datatype declarations and pragmas) is a
+ * node of the graph, identified by its position in the library. A POU depends on all the POUs whose
+ * name it references (i.e. all the poutype_identifier_c found in its declaration). Since functions
+ * may be overloaded, a name may be declared by more than one POU. All of these are dependencies
+ * of the POU referencing that name, although any single one of them is enough to satisfy that reference.
+ *
+ * The graph is built with a single pass over the library. It may then be used to determine an order in
+ * which to place the POUs so that no forward references occur (see topological_sort() ), or to
+ * determine which POUs are affected when a POU is changed (see get_dependents() ).
+ *
+ * NOTE: Derived datatype declarations and pragmas are nodes without any dependencies.
+ */
+
+#ifndef _POU_DEPENDENCY_GRAPH_HH
+#define _POU_DEPENDENCY_GRAPH_HH
+
+#include "../absyntax/absyntax.hh"
+#include "../util/nocase_hashtable.hh"
+#include <vector>
+
+
+
+class pou_dependency_graph_c {
+  private:
+    typedef struct {
+      symbol_c               *symbol;                /* the element of the library                                  */
+      symbol_c               *name;                  /* name of the declared POU, or NULL if not a POU              */
+      int                     name_id;               /* index into names[], or -1 if not a POU                      */
+      std::vector<int>        referenced_names;      /* index into names[] of every (distinct) name it references   */
+      std::vector<int>        dependencies;
+      std::vector<symbol_c *> undeclared_references;
+    } node_t;
+
+    typedef struct {
+      std::vector<int>        declared_by;           /* the POUs declaring this name (more than one if overloaded)  */
+      std::vector<int>        referenced_by;         /* the POUs referencing this name                              */
+    } name_t;
+
+    std::vector<node_t>       nodes;
+    std::vector<name_t>       names;
+    nocase_hashtable_c<int>   name_ids;
+
+    int get_name_id(symbol_c *name);
+
+  public:
+    pou_dependency_graph_c(library_c *library);
+    ~pou_dependency_graph_c(void);
+
+    /* the number of nodes in the graph, i.e. the number of elements in the library */
+    int get_node_count(void) {return nodes.size();}
+
+    /* the element of the library */
+    symbol_c *get_symbol(int node) {return nodes[node].symbol;}
+    /* the name of the POU, or NULL if the element of the library is not a POU */
+    symbol_c *get_name  (int node) {return nodes[node].name;}
+
+    /* The POUs that declare the names referenced by the POU */
+    const std::vector<int>        &get_dependencies(int node) {return nodes[node].dependencies;}
+    /* The POUs that reference the name declared by the POU */
+    const std::vector<int>        &get_dependents  (int node) {return (nodes[node].name_id < 0)? no_dependents : names[nodes[node].name_id].referenced_by;}
+    /* The names referenced by the POU that are not declared by any POU in the library */
+    const std::vector<symbol_c *> &get_undeclared_references(int node) {return nodes[node].undeclared_references;}
+
+    /* Determine an order for the nodes so that every POU comes after (at least one of) the POUs
+     * declaring each of the names it references.
+     * The nodes are kept in their original order whenever possible. More precisely, the resulting order
+     * is the same as would be obtained by repeatedly going through the library, and taking each POU whose
+     * references have all been satisfied by the POUs already taken.
+     * POUs that contain circular references, or references to undeclared POUs (or that depend on such POUs),
+     * are left out of the resulting order.
+     * Returns true if all the nodes were placed in the resulting order.
+     */
+    bool topological_sort(std::vector<int> &order);
+
+  private:
+    static const std::vector<int> no_dependents;
+};
+
+
+#endif /* _POU_DEPENDENCY_GRAPH_HH */
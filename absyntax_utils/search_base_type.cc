@@ -50,7 +50,9 @@
 
 
 /* pointer to singleton instance */
-search_base_type_c *search_base_type_c::search_base_type_singleton = NULL;
+__thread search_base_type_c *search_base_type_c::search_base_type_singleton = NULL;
+
+per_thread_c<search_base_type_c::cache_t> search_base_type_c::caches;
 
 
 
@@ -63,37 +65,61 @@ void search_base_type_c::create_singleton(void) {
 }
 
 /* static method! */
-symbol_c *search_base_type_c::get_equivtype_decl(symbol_c *symbol) {
+/* Get the cached results for symbol, searching for them if not yet in the cache. */
+search_base_type_c::memo_t *search_base_type_c::get_memo(symbol_c *symbol) {
+  cache_t &cache = caches.get();
+  memo_t  *res   = cache.memo.find(symbol->id);
+  if (NULL != res) {cache.stats.hits++; return res;}
+
+  double start_time = runtime_options.print_stats? memo_stats_time() : 0;
   create_singleton();
-  if (NULL == symbol)    return NULL; 
   search_base_type_singleton->current_basetype_name = NULL;
   search_base_type_singleton->current_basetype  = NULL; 
   search_base_type_singleton->current_equivtype = NULL; 
   symbol_c *basetype = (symbol_c *)symbol->accept(*search_base_type_singleton);
-  if (NULL != search_base_type_singleton->current_equivtype)
-    return search_base_type_singleton->current_equivtype;
-  return basetype;
+  res = &cache.memo[symbol->id];
+  res->basetype    = basetype;
+  res->equivtype   = (NULL != search_base_type_singleton->current_equivtype)? search_base_type_singleton->current_equivtype : basetype;
+  res->basetype_id = search_base_type_singleton->current_basetype_name;
+  cache.stats.misses++;
+  if (runtime_options.print_stats) cache.stats.miss_time += memo_stats_time() - start_time;
+  return res;
+}
+
+/* static method! */
+symbol_c *search_base_type_c::get_equivtype_decl(symbol_c *symbol) {
+  if (NULL == symbol)    return NULL; 
+  return get_memo(symbol)->equivtype;
 }
 
 /* static method! */
 symbol_c *search_base_type_c::get_basetype_decl(symbol_c *symbol) {
-  create_singleton();
   if (NULL == symbol)    return NULL; 
-  search_base_type_singleton->current_basetype_name = NULL;
-  search_base_type_singleton->current_basetype  = NULL; 
-  search_base_type_singleton->current_equivtype = NULL; 
-  return (symbol_c *)symbol->accept(*search_base_type_singleton);
+  return get_memo(symbol)->basetype;
 }
 
 /* static method! */
 symbol_c *search_base_type_c::get_basetype_id  (symbol_c *symbol) {
-  create_singleton();
   if (NULL == symbol)    return NULL; 
-  search_base_type_singleton->current_basetype_name = NULL;
-  search_base_type_singleton->current_basetype  = NULL; 
-  search_base_type_singleton->current_equivtype = NULL; 
-  symbol->accept(*search_base_type_singleton);
-  return (symbol_c *)search_base_type_singleton->current_basetype_name;
+  return get_memo(symbol)->basetype_id;
+}
+
+
+/* static method! */
+void search_base_type_c::invalidate(symbol_c *symbol) {
+  if (NULL != symbol) caches.get().memo.erase(symbol->id);
+}
+
+/* static method! */
+void search_base_type_c::invalidate_all(void) {
+  caches.get().memo.clear();
+}
+
+/* static method! */
+void search_base_type_c::reset_stats(void) {
+  memo_stats_t &stats = caches.get().stats;
+  stats.hits = stats.misses = 0;
+  stats.miss_time = 0;
 }
 
 
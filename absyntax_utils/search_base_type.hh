@@ -63,6 +63,21 @@
  * we may have FB instances declared of a specific FB type.
  */
 
+/* Note:
+ *  The base type (as well as the equivalent type, and the base type's identifier) of every
+ * symbol passed to get_basetype_decl(), get_equivtype_decl() or get_basetype_id() is memoized
+ * in a cache, indexed by the symbol_c::id of the symbol, so the chain of derived datatypes only 
+ * needs to be followed the first time a type is searched for.
+ *
+ * The results depend on the type declarations (stored in type_symtable and
+ * function_block_type_symtable), so any code that changes the type declarations after they have
+ * been searched for must call invalidate_all() (or invalidate(symbol) if only the
+ * result of a single symbol may have changed). absyntax_utils_init() clears the cache.
+ *
+ * Each thread has a cache of its own (see stage3/pou_executor.hh), so invalidate_all() only
+ * clears the cache of the calling thread, and get_stats() only covers the searches it made.
+ */
+
 
 class search_base_type_c: public null_visitor_c {
 
@@ -70,10 +85,23 @@ class search_base_type_c: public null_visitor_c {
     symbol_c *current_basetype_name;
     symbol_c *current_basetype;
     symbol_c *current_equivtype;
-    static search_base_type_c *search_base_type_singleton; // Make this a singleton class!
+    static __thread search_base_type_c *search_base_type_singleton; // Make this a singleton class! (one per thread)
+
+    typedef struct {
+      symbol_c *basetype;     /* what get_basetype_decl()  returns */
+      symbol_c *equivtype;    /* what get_equivtype_decl() returns */
+      symbol_c *basetype_id;  /* what get_basetype_id()    returns */
+    } memo_t;
+    typedef struct cache_s {
+      side_table_c<memo_t> memo;  /* the cached results, indexed by the searched symbol's id */
+      memo_stats_t         stats;
+      cache_s(void) {stats.hits = stats.misses = 0; stats.miss_time = 0;}
+    } cache_t;
+    static per_thread_c<cache_t> caches;  /* the cache of each thread */
     
   private:  
     static void create_singleton(void);
+    static memo_t *get_memo(symbol_c *symbol);  /* symbol must not be NULL */
     void *handle_datatype_identifier(token_c *type_name);
 
   public:
@@ -82,6 +110,11 @@ class search_base_type_c: public null_visitor_c {
     static symbol_c *get_basetype_decl (symbol_c *symbol);  /* get the Base       Type declaration */
     static symbol_c *get_basetype_id   (symbol_c *symbol);  /* get the Base       Type identifier  */
 
+    static void invalidate    (symbol_c *symbol);  /* forget the cached results for symbol */
+    static void invalidate_all(void);              /* forget all the cached results */
+    static memo_stats_t get_stats  (void) {return caches.get().stats;}
+    static void         reset_stats(void);
+
   public:
   /*************************/
   /* B.1 - Common elements */
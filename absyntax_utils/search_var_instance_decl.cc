@@ -93,20 +93,68 @@
 
 
 
+per_thread_c<side_table_c<search_var_instance_decl_c::decl_index_t> > search_var_instance_decl_c::decl_indexes;
+
+
 search_var_instance_decl_c::search_var_instance_decl_c(symbol_c *search_scope) {
   this->current_vartype = none_vt;
   this->search_scope = search_scope;
-  this->search_name = NULL;
+  this->current_index = NULL;
   this->current_type_decl = NULL;
   this->current_option = none_opt;
 }
 
+
+void search_var_instance_decl_c::invalidate_index(symbol_c *search_scope) {
+  if (NULL != search_scope) decl_indexes.get().erase(search_scope->id);
+}
+
+void search_var_instance_decl_c::invalidate_all_indexes(void) {
+  decl_indexes.get().clear();
+}
+
+
+search_var_instance_decl_c::decl_index_t *search_var_instance_decl_c::get_index(void) {
+  side_table_c<decl_index_t> &indexes = decl_indexes.get();
+  decl_index_t *index = indexes.find(search_scope->id);
+  if (NULL != index) return index;
+
+  /* First time this search scope is searched. Visit all its declarations (once!), adding every declared name to the index. */
+  current_index   = &indexes[search_scope->id];
+  current_vartype = none_vt;
+  current_option  = none_opt;
+  search_scope->accept(*this);
+  index = current_index;
+  current_index   = NULL;
+  return index;
+}
+
+
+void *search_var_instance_decl_c::add_to_index(symbol_c *name, symbol_c *decl) {
+  token_c *token = dynamic_cast<token_c *>(name);
+  if ((NULL == token) || (NULL == current_index)) return NULL;
+  /* When the same name is declared more than once, the search always returned the first declaration. Keep it that way! */
+  if (current_index->find(token->value) != current_index->end()) return NULL;
+  decl_info_t decl_info = {decl, current_vartype, current_option};
+  current_index->insert(token->value, decl_info);
+  return NULL;
+}
+
+
+const search_var_instance_decl_c::decl_info_t *search_var_instance_decl_c::find_decl(symbol_c *variable) {
+  token_c *search_name = get_var_name_c::get_name(variable);
+  if (NULL == search_name) return NULL;
+  decl_index_t *index = get_index();
+  decl_index_t::iterator iter = index->find(search_name->value);
+  if (iter == index->end()) return NULL;
+  return &(iter->second);
+}
+
+
 symbol_c *search_var_instance_decl_c::get_decl(symbol_c *variable) {
-  this->current_vartype = none_vt;
-  this->current_option  = none_opt;
-  this->search_name = get_var_name_c::get_name(variable);
   if (NULL == search_scope) return NULL; // NOTE: This is not an ERROR! declaration_check_c, for e.g., relies on this returning NULL!
-  return (symbol_c *)search_scope->accept(*this);
+  const decl_info_t *decl_info = find_decl(variable);
+  return (NULL == decl_info)? NULL : decl_info->decl;
 }
 
 symbol_c *search_var_instance_decl_c::get_basetype_decl(symbol_c *variable) {
@@ -114,21 +162,15 @@ symbol_c *search_var_instance_decl_c::get_basetype_decl(symbol_c *variable) {
 }
 
 search_var_instance_decl_c::vt_t search_var_instance_decl_c::get_vartype(symbol_c *variable) {
-  this->current_vartype = none_vt;
-  this->current_option  = none_opt;
-  this->search_name = get_var_name_c::get_name(variable);
   if (NULL == search_scope) ERROR;
-  search_scope->accept(*this);
-  return this->current_vartype;
+  const decl_info_t *decl_info = find_decl(variable);
+  return (NULL == decl_info)? none_vt : decl_info->vartype;
 }
 
 search_var_instance_decl_c::opt_t search_var_instance_decl_c::get_option(symbol_c *variable) {
-  this->current_vartype = none_vt;
-  this->current_option  = none_opt;
-  this->search_name = get_var_name_c::get_name(variable);
   if (NULL == search_scope) ERROR;
-  search_scope->accept(*this);
-  return this->current_option;
+  const decl_info_t *decl_info = find_decl(variable);
+  return (NULL == decl_info)? none_opt : decl_info->option;
 }
 
 
@@ -209,16 +251,12 @@ void *search_var_instance_decl_c::visit(input_output_declarations_c *symbol) {
 
 /* ENO : BOOL */
 void *search_var_instance_decl_c::visit(eno_param_declaration_c *symbol) {
-  if (compare_identifiers(symbol->name, search_name) == 0)
-    return symbol->type;
-  return NULL;
+  return add_to_index(symbol->name, symbol->type);
 }
 
 /* EN : BOOL */
 void *search_var_instance_decl_c::visit(en_param_declaration_c *symbol) {
-  if (compare_identifiers(symbol->name, search_name) == 0)
-    return symbol->type_decl;
-  return NULL;
+  return add_to_index(symbol->name, symbol->type_decl);
 }
 
 /* VAR [CONSTANT] var_init_decl_list END_VAR */
@@ -312,11 +350,9 @@ void *search_var_instance_decl_c::visit(var1_init_decl_c *symbol) {
 // SYM_LIST(var1_list_c)
 void *search_var_instance_decl_c::visit(var1_list_c *symbol) {
   list_c *list = symbol;
-  for(int i = 0; i < list->n; i++) {
-    if (compare_identifiers(list->get_element(i), search_name) == 0)
-   /* by now, current_type_decl should be != NULL */
-      return current_type_decl;
-  }
+  for(int i = 0; i < list->n; i++)
+    /* by now, current_type_decl should be != NULL */
+    add_to_index(list->get_element(i), current_type_decl);
   return NULL;
 }
 
@@ -334,11 +370,9 @@ void *search_var_instance_decl_c::visit(fb_name_decl_c *symbol) {
 /* name_list ',' fb_name */
 void *search_var_instance_decl_c::visit(fb_name_list_c *symbol) {
   list_c *list = symbol;
-  for(int i = 0; i < list->n; i++) {
-    if (compare_identifiers(list->get_element(i), search_name) == 0)
+  for(int i = 0; i < list->n; i++)
     /* by now, current_fb_declaration should be != NULL */
-      return current_type_decl;
-  }
+    add_to_index(list->get_element(i), current_type_decl);
   return NULL;
 }
 
@@ -378,9 +412,7 @@ void *search_var_instance_decl_c::visit(structured_var_declaration_c *symbol) {
 /*  global_var_name ':' (simple_specification|subrange_specification|enumerated_specification|array_specification|prev_declared_structure_type_name|function_block_type_name */
 // SYM_REF2(external_declaration_c, global_var_name, specification)
 void *search_var_instance_decl_c::visit(external_declaration_c *symbol) {
-  if (compare_identifiers(symbol->global_var_name, search_name) == 0)
-      return symbol->specification;
-  return NULL;
+  return add_to_index(symbol->global_var_name, symbol->specification);
 }
 
 /*| global_var_spec ':' [located_var_spec_init|function_block_type_name] */
@@ -398,21 +430,18 @@ void *search_var_instance_decl_c::visit(global_var_decl_c *symbol) {
 /*| global_var_name location */
 //SYM_REF2(global_var_spec_c, global_var_name, location)
 void *search_var_instance_decl_c::visit(global_var_spec_c *symbol) {
-  if (symbol->global_var_name != NULL && compare_identifiers(symbol->global_var_name, search_name) == 0)
-      return current_type_decl;
-  else
-    return symbol->location->accept(*this);
+  if (symbol->global_var_name != NULL)
+    add_to_index(symbol->global_var_name, current_type_decl);
+  return symbol->location->accept(*this);
 }
 
 /*| global_var_list ',' global_var_name */
 //SYM_LIST(global_var_list_c)
 void *search_var_instance_decl_c::visit(global_var_list_c *symbol) {
   list_c *list = symbol;
-  for(int i = 0; i < list->n; i++) {
-    if (compare_identifiers(list->get_element(i), search_name) == 0)
-      /* by now, current_type_decl should be != NULL */
-      return current_type_decl;
-  }
+  for(int i = 0; i < list->n; i++)
+    /* by now, current_type_decl should be != NULL */
+    add_to_index(list->get_element(i), current_type_decl);
   return NULL;
 }
 
@@ -420,12 +449,10 @@ void *search_var_instance_decl_c::visit(global_var_list_c *symbol) {
 /* variable_name -> may be NULL ! */
 //SYM_REF4(located_var_decl_c, variable_name, location, located_var_spec_init, unused)
 void *search_var_instance_decl_c::visit(located_var_decl_c *symbol) {
-  if (symbol->variable_name != NULL && compare_identifiers(symbol->variable_name, search_name) == 0)
-    return symbol->located_var_spec_init;
-  else {
-    current_type_decl = symbol->located_var_spec_init;
-    return symbol->location->accept(*this);
-  }
+  if (symbol->variable_name != NULL)
+    add_to_index(symbol->variable_name, symbol->located_var_spec_init);
+  current_type_decl = symbol->located_var_spec_init;
+  return symbol->location->accept(*this);
 }
 
 /*| global_var_spec ':' [located_var_spec_init|function_block_type_name] */
@@ -436,10 +463,7 @@ void *search_var_instance_decl_c::visit(located_var_decl_c *symbol) {
 /*  AT direct_variable */
 // SYM_REF2(location_c, direct_variable, unused)
 void *search_var_instance_decl_c::visit(location_c *symbol) {
-  if (compare_identifiers(symbol->direct_variable, search_name) == 0)
-    return current_type_decl;
-  else
-    return NULL;
+  return add_to_index(symbol->direct_variable, current_type_decl);
 }
         
 /*| global_var_list ',' global_var_name */
@@ -492,8 +516,7 @@ void *search_var_instance_decl_c::visit(function_declaration_c *symbol) {
   /* functions have a variable named after themselves, to store
    * the variable that will be returned!!
    */
-  if (compare_identifiers(symbol->derived_function_name, search_name) == 0)
-      return symbol->type_name;
+  add_to_index(symbol->derived_function_name, symbol->type_name);
 
   /* no need to search through all the body, so we only
    * visit the variable declarations...!
@@ -512,7 +535,7 @@ void *search_var_instance_decl_c::visit(function_block_declaration_c *symbol) {
   if (NULL != res)
     return res;
   
-  /* not yet found, so we look into the body, to see if it is an SFC step! */
+  /* we also look into the body, for the SFC steps! */
   return symbol->fblock_body->accept(*this);
 }
 
@@ -527,7 +550,7 @@ void *search_var_instance_decl_c::visit(program_declaration_c *symbol) {
   if (NULL != res)
     return res;
   
-  /* not yet found, so we look into the body, to see if it is an SFC step! */
+  /* we also look into the body, for the SFC steps! */
   return symbol->function_block_body->accept(*this);
 }
 
@@ -549,17 +572,13 @@ void *search_var_instance_decl_c::visit(program_declaration_c *symbol) {
 /* INITIAL_STEP step_name ':' action_association_list END_STEP */
 // SYM_REF2(initial_step_c, step_name, action_association_list)
 void *search_var_instance_decl_c::visit(initial_step_c *symbol) {
-  if (compare_identifiers(symbol->step_name, search_name) == 0)
-      return symbol;
-  return NULL;
+  return add_to_index(symbol->step_name, symbol);
 }
 
 /* STEP step_name ':' action_association_list END_STEP */
 // SYM_REF2(step_c, step_name, action_association_list)
 void *search_var_instance_decl_c::visit(step_c *symbol) {
-  if (compare_identifiers(symbol->step_name, search_name) == 0)
-      return symbol;
-  return NULL;
+  return add_to_index(symbol->step_name, symbol);
 }
 
 
@@ -87,6 +87,21 @@
  * we return a reference to the declaration!!
  */
 
+/* Note:
+ *  Stage 3 and stage 4 call get_decl(), get_vartype() and get_option() for
+ * (almost) every variable reference in the code. Instead of walking through all
+ * the VAR .. END_VAR declarations of the search scope on every call, the first
+ * call walks through them only once, and builds an index of every name declared
+ * in the search scope (mapping the name, ignoring case, to its declaration, vartype
+ * and option). This index is cached (one per search scope, i.e. per POU, configuration
+ * or resource), and is shared by every search_var_instance_decl_c object that
+ * is later created for the same search scope.
+ *
+ * If the declarations of a search scope are changed after its index has been built
+ * (e.g. variables are added or removed), the index must be discarded by calling
+ * invalidate_index(). invalidate_all_indexes() discards the indexes of every scope.
+ */
+
 
 class search_var_instance_decl_c: public search_visitor_c {
 
@@ -135,9 +150,35 @@ class search_var_instance_decl_c: public search_visitor_c {
     vt_t      get_vartype       (symbol_c *variable_instance_name);
     opt_t     get_option        (symbol_c *variable_instance_name);
 
+    /* discard the cached index of the declarations in search_scope (it will be rebuilt when next needed) */
+    static void invalidate_index(symbol_c *search_scope);
+    /* discard the cached indexes of all the search scopes */
+    static void invalidate_all_indexes(void);
+
+  private:
+    typedef struct {
+      symbol_c *decl;     /* what get_decl() returns    */
+      vt_t      vartype;  /* what get_vartype() returns */
+      opt_t     option;   /* what get_option() returns  */
+    } decl_info_t;
+
+    /* the names declared in a search scope, mapped to their declarations */
+    typedef nocase_hashtable_c<decl_info_t> decl_index_t;
+    /* the index of each search scope, indexed by the search scope's symbol_c::id.
+     * Each thread builds indexes of its own (see stage3/pou_executor.hh), so the invalidate_xxx() methods only
+     * discard the indexes of the calling thread.
+     */
+    static per_thread_c<side_table_c<decl_index_t> > decl_indexes;
+
+    /* get the index of the search scope, building it if it does not yet exist */
+    decl_index_t      *get_index   (void);
+    const decl_info_t *find_decl   (symbol_c *variable_instance_name);
+    /* add a declared name to the index being built. Always returns NULL, so the visitors continue searching */
+    void              *add_to_index(symbol_c *name, symbol_c *decl);
+
   private:
     symbol_c *search_scope;
-    symbol_c *search_name;
+    decl_index_t *current_index;  /* the index currently being built */
     symbol_c *current_type_decl;
     /* variable used to store the type of variable currently being processed... */
     /* Will contain a single value of generate_c_vardecl_c::XXXX_vt */
@@ -0,0 +1,608 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * Save an AST to (and load it from) a compact binary encoding.
+ *
+ * Layout of the encoding:
+ *
+ *   encoding : <header> <node> <trailer>
+ *   header   : magic string, format version, signature of absyntax.def
+ *   node     : NULL_TAG
+ *            | BACKREF_TAG <node number>      (symbol already stored previously)
+ *            | <class tag> <location> <body> <parent> <token>
+ *   body     : <string>                       (for SYM_TOKEN classes)
+ *            | n { <node> <element key> }     (for SYM_LIST classes)
+ *            | <node>*                        (ref1, ref2, ..., for SYM_REFx classes)
+ *   trailer  : the 'parent' and 'token' pointers that could not be stored
+ *              inside the node itself, because they point to symbols stored later on.
+ *
+ * Symbols are numbered in the order in which they are stored (i.e. the order
+ * in which the loader creates them).
+ *
+ * The location of a symbol is stored relative to the location of the previously
+ * stored symbol (the lines and the order), and the end of a symbol relative to its
+ * start, since these differences are small numbers that fit in a single byte.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <vector>
+#include <algorithm>
+
+#include "absyntax_utils.hh"
+#include "../absyntax/visitor.hh"
+#include "../main.hh" // required for ERROR() and ERROR_MSG() macros.
+
+
+
+/* Increment whenever the encoding changes! */
+#define AST_FORMAT_VERSION 3
+#define AST_MAGIC          "MATIEC-AST"
+
+
+/* One tag for each class of symbol in absyntax.def */
+enum {
+  NULL_TAG    = 0,
+  BACKREF_TAG = 1,
+#define SYM_LIST(class_name_c, ...)                                             class_name_c##_tag,
+#define SYM_TOKEN(class_name_c, ...)                                            class_name_c##_tag,
+#define SYM_REF0(class_name_c, ...)                                             class_name_c##_tag,
+#define SYM_REF1(class_name_c, ref1, ...)                                       class_name_c##_tag,
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 class_name_c##_tag,
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           class_name_c##_tag,
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     class_name_c##_tag,
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               class_name_c##_tag,
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         class_name_c##_tag,
+#include "../absyntax/absyntax.def"
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+  LAST_TAG
+};
+
+
+/* How the 'parent' and 'token' pointers of a symbol are stored */
+enum {
+  PTR_NULL    = 0,  /* pointer is NULL                                      */
+  PTR_IMPLIED = 1,  /* parent: the containing symbol.  token: the symbol itself */
+  PTR_NUMBER  = 2,  /* followed by the number of a symbol already stored    */
+  PTR_TRAILER = 3   /* pointer is stored in the trailer                     */
+};
+
+/* How the token_value of each element in a list is stored */
+enum {
+  KEY_NULL    = 0,  /* token_value is NULL                               */
+  KEY_TOKEN   = 1,  /* token_value is the value of the element's token   */
+  KEY_STRING  = 2   /* followed by the string                            */
+};
+
+/* Which pointer an entry in the trailer refers to */
+enum {
+  TRAILER_PARENT   = 0,
+  TRAILER_TOKEN    = 1
+};
+
+
+
+/* A signature of the list of classes in absyntax.def, so we do not try to load an AST
+ * saved by a version of matiec with a different abstract syntax.
+ */
+static uint64_t absyntax_signature(void) {
+  static const char *class_names =
+#define SYM_LIST(class_name_c, ...)                                             #class_name_c "L"
+#define SYM_TOKEN(class_name_c, ...)                                            #class_name_c "T"
+#define SYM_REF0(class_name_c, ...)                                             #class_name_c "0"
+#define SYM_REF1(class_name_c, ref1, ...)                                       #class_name_c "1"
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 #class_name_c "2"
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           #class_name_c "3"
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     #class_name_c "4"
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               #class_name_c "5"
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         #class_name_c "6"
+#include "../absyntax/absyntax.def"
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+  ;
+
+  /* FNV-1a hash */
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char *c = class_names; *c != '\0'; c++) {
+    hash ^= (unsigned char)*c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+
+
+/***********************************/
+/* Encoding of numbers and strings */
+/***********************************/
+
+void serialize_ast_c::put_uint(std::string &buf, uint64_t value) {
+  while (value >= 0x80) {
+    buf += (char)((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  buf += (char)value;
+}
+
+/* zig-zag encoding, so small negative numbers also use few bytes */
+void serialize_ast_c::put_int(std::string &buf, int64_t value) {
+  put_uint(buf, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+/* 0 for NULL, otherwise (length + 1) followed by the string including the terminating '\0' */
+void serialize_ast_c::put_str(std::string &buf, const char *str) {
+  if (NULL == str) {put_uint(buf, 0); return;}
+  size_t len = strlen(str);
+  put_uint(buf, len + 1);
+  buf.append(str, len + 1);
+}
+
+
+bool serialize_ast_c::get_uint(const char **buf, const char *end, uint64_t *value) {
+  uint64_t res = 0;
+  for (int shift = 0; (*buf < end) && (shift < 64); shift += 7) {
+    unsigned char c = *(*buf)++;
+    res |= (uint64_t)(c & 0x7F) << shift;
+    if ((c & 0x80) == 0) {*value = res; return true;}
+  }
+  return false;
+}
+
+bool serialize_ast_c::get_int(const char **buf, const char *end, int64_t *value) {
+  uint64_t tmp;
+  if (!get_uint(buf, end, &tmp)) return false;
+  *value = (int64_t)(tmp >> 1) ^ -(int64_t)(tmp & 1);
+  return true;
+}
+
+bool serialize_ast_c::get_str(const char **buf, const char *end, const char **str) {
+  uint64_t len;
+  if (!get_uint(buf, end, &len)) return false;
+  if (0 == len) {*str = NULL; return true;}
+  if ((uint64_t)(end - *buf) < len) return false;
+  if ((*buf)[len - 1] != '\0')      return false;
+  *str = *buf;
+  *buf += len;
+  return true;
+}
+
+
+
+
+/***********************************/
+/* Saving the AST...               */
+/***********************************/
+
+class ast_writer_c: public visitor_c {
+  private:
+    std::string &buf;
+    /* The number of each symbol already stored, indexed by the symbol's id (see symbol_c::id).
+     * 0 if the symbol has not been stored, (number + 1) otherwise.
+     */
+    std::vector<uint64_t>             symbol_number;
+    uint64_t                          symbol_count;
+    std::map<const char *, uint64_t>  file_number;  /* file names are shared by many symbols, so we only store them once */
+    const char                       *last_file;    /* the file name stored last, and its number */
+    uint64_t                          last_file_number;
+    int64_t                           prev_line, prev_order;  /* the location of the previously stored symbol */
+    typedef struct {uint64_t symbol; int pointer; symbol_c *target;} trailer_entry_t;
+    std::vector<trailer_entry_t>      trailer;
+
+  public:
+    ast_writer_c(std::string &buf_)
+      : buf(buf_), symbol_count(0), last_file(NULL), last_file_number(0), prev_line(0), prev_order(0) {}
+    virtual ~ast_writer_c(void) {}
+
+    void write(symbol_c *root_symbol) {
+      write_node(root_symbol, NULL);
+      /* the pointers we could not store inline... */
+      serialize_ast_c::put_uint(buf, trailer.size());
+      for (unsigned int i = 0; i < trailer.size(); i++) {
+        uint64_t target;
+        serialize_ast_c::put_uint(buf, trailer[i].symbol);
+        serialize_ast_c::put_uint(buf, trailer[i].pointer);
+        /* pointers to symbols outside the stored AST are stored as NULL */
+        serialize_ast_c::put_uint(buf, get_number(trailer[i].target, &target)? target + 1 : 0);
+      }
+    }
+
+  private:
+    bool get_number(symbol_c *symbol, uint64_t *number) {
+      if ((symbol->id >= symbol_number.size()) || (0 == symbol_number[symbol->id])) return false;
+      if (NULL != number) *number = symbol_number[symbol->id] - 1;
+      return true;
+    }
+
+    uint64_t new_number(symbol_c *symbol) {
+      if (symbol->id >= symbol_number.size())
+        symbol_number.resize(std::max((size_t)symbol->id + 1, 2 * symbol_number.size()), 0);
+      symbol_number[symbol->id] = ++symbol_count;
+      return symbol_count - 1;
+    }
+
+    void write_node(symbol_c *symbol, symbol_c *container) {
+      uint64_t number;
+      if (NULL == symbol) {serialize_ast_c::put_uint(buf, NULL_TAG); return;}
+      if (get_number(symbol, &number)) {
+        serialize_ast_c::put_uint(buf, BACKREF_TAG);
+        serialize_ast_c::put_uint(buf, number);
+        return;
+      }
+      number = new_number(symbol);
+      /* write the class tag, location and body... */
+      symbol->accept(*this);
+      /* ...and the parent and token pointers. */
+      write_pointer(number, TRAILER_PARENT, symbol->parent, container);
+      write_pointer(number, TRAILER_TOKEN,  symbol->token,  symbol);
+    }
+
+    void write_pointer(uint64_t number, int pointer, symbol_c *target, symbol_c *implied) {
+      uint64_t target_number;
+      if (NULL == target)    {serialize_ast_c::put_uint(buf, PTR_NULL);    return;}
+      if (implied == target) {serialize_ast_c::put_uint(buf, PTR_IMPLIED); return;}
+      if (get_number(target, &target_number)) {
+        serialize_ast_c::put_uint(buf, PTR_NUMBER);
+        serialize_ast_c::put_uint(buf, target_number);
+        return;
+      }
+      serialize_ast_c::put_uint(buf, PTR_TRAILER);
+      trailer_entry_t entry = {number, pointer, target};
+      trailer.push_back(entry);
+    }
+
+    void write_file(const char *filename) {
+      /* 0 for NULL, (2*number + 1) for a file name already stored, 2 followed by a new file name */
+      if (NULL == filename) {serialize_ast_c::put_uint(buf, 0); return;}
+      if (filename != last_file) {
+        std::map<const char *, uint64_t>::iterator iter = file_number.find(filename);
+        if (iter == file_number.end()) {
+          uint64_t number = file_number.size();
+          file_number[filename] = number;
+          serialize_ast_c::put_uint(buf, 2);
+          serialize_ast_c::put_str (buf, filename);
+          return;
+        }
+        last_file        = filename;
+        last_file_number = iter->second;
+      }
+      serialize_ast_c::put_uint(buf, 2*last_file_number + 1);
+    }
+
+    void write_header(int tag, symbol_c *symbol) {
+      serialize_ast_c::put_uint(buf, tag);
+      serialize_ast_c::put_int (buf, symbol->first_line  - prev_line);
+      serialize_ast_c::put_int (buf, symbol->first_column);
+      write_file               (     symbol->first_file);
+      serialize_ast_c::put_int (buf, symbol->first_order - prev_order);
+      serialize_ast_c::put_int (buf, (int64_t)symbol->last_line  - symbol->first_line);
+      serialize_ast_c::put_int (buf, symbol->last_column);
+      write_file               (     symbol->last_file);
+      serialize_ast_c::put_int (buf, (int64_t)symbol->last_order - symbol->first_order);
+      prev_line  = symbol->first_line;
+      prev_order = symbol->first_order;
+    }
+
+    void write_list(list_c *list) {
+      serialize_ast_c::put_uint(buf, list->n);
+      for (int i = 0; i < list->n; i++) {
+        symbol_c   *element = list->get_element(i);
+        const char *key     = list->get_element_token_value(i);
+        write_node(element, list);
+        if (NULL == key)
+          serialize_ast_c::put_uint(buf, KEY_NULL);
+        else if (   (NULL != element) && (NULL != element->token) && (key == element->token->value)
+                 && ((element->token == element) || get_number(element->token, NULL)))
+          /* the element's token pointer has already been stored, so the loader will know it when it needs it */
+          serialize_ast_c::put_uint(buf, KEY_TOKEN);
+        else {
+          serialize_ast_c::put_uint(buf, KEY_STRING);
+          serialize_ast_c::put_str (buf, key);
+        }
+      }
+    }
+
+  public:
+#define SYM_LIST(class_name_c, ...)                                             \
+    void *visit(class_name_c *symbol) {write_header(class_name_c##_tag, symbol); write_list(symbol); return NULL;}
+#define SYM_TOKEN(class_name_c, ...)                                            \
+    void *visit(class_name_c *symbol) {write_header(class_name_c##_tag, symbol); serialize_ast_c::put_str(buf, symbol->value); return NULL;}
+#define SYM_REF0(class_name_c, ...)                                             \
+    void *visit(class_name_c *symbol) {write_header(class_name_c##_tag, symbol); return NULL;}
+#define SYM_REF1(class_name_c, ref1, ...)                                       \
+    void *visit(class_name_c *symbol) {write_header(class_name_c##_tag, symbol);                       \
+                                       write_node(symbol->ref1, symbol); return NULL;}
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 \
+    void *visit(class_name_c *symbol) {write_header(class_name_c##_tag, symbol);                       \
+                                       write_node(symbol->ref1, symbol); write_node(symbol->ref2, symbol); \
+                                       return NULL;}
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           \
+    void *visit(class_name_c *symbol) {write_header(class_name_c##_tag, symbol);                       \
+                                       write_node(symbol->ref1, symbol); write_node(symbol->ref2, symbol); \
+                                       write_node(symbol->ref3, symbol); return NULL;}
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     \
+    void *visit(class_name_c *symbol) {write_header(class_name_c##_tag, symbol);                       \
+                                       write_node(symbol->ref1, symbol); write_node(symbol->ref2, symbol); \
+                                       write_node(symbol->ref3, symbol); write_node(symbol->ref4, symbol); \
+                                       return NULL;}
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               \
+    void *visit(class_name_c *symbol) {write_header(class_name_c##_tag, symbol);                       \
+                                       write_node(symbol->ref1, symbol); write_node(symbol->ref2, symbol); \
+                                       write_node(symbol->ref3, symbol); write_node(symbol->ref4, symbol); \
+                                       write_node(symbol->ref5, symbol); return NULL;}
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         \
+    void *visit(class_name_c *symbol) {write_header(class_name_c##_tag, symbol);                       \
+                                       write_node(symbol->ref1, symbol); write_node(symbol->ref2, symbol); \
+                                       write_node(symbol->ref3, symbol); write_node(symbol->ref4, symbol); \
+                                       write_node(symbol->ref5, symbol); write_node(symbol->ref6, symbol); \
+                                       return NULL;}
+#include "../absyntax/absyntax.def"
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+};
+
+
+
+
+/***********************************/
+/* Loading the AST...              */
+/***********************************/
+
+class ast_reader_c {
+  private:
+    const char *buf, *end;
+    bool ok;  /* set to false as soon as we find corrupt data */
+    std::vector<symbol_c *>   symbols;
+    std::vector<const char *> files;
+    int64_t prev_line, prev_order;  /* the location of the previously loaded symbol */
+
+  public:
+    ast_reader_c(const char *buf_, const char *end_)
+      : buf(buf_), end(end_), ok(true), prev_line(0), prev_order(0) {}
+
+    const char *position(void) {return buf;}
+
+    symbol_c *read(void) {
+      symbol_c *root_symbol = read_node(NULL);
+      uint64_t n = get_uint();
+      for (uint64_t i = 0; ok && (i < n); i++) {
+        uint64_t number  = get_uint();
+        uint64_t pointer = get_uint();
+        uint64_t target  = get_uint();
+        if (!ok || (number >= symbols.size()) || (target > symbols.size())) {ok = false; break;}
+        symbol_c *target_symbol = (0 == target)? NULL : symbols[target - 1];
+        if      (TRAILER_PARENT   == pointer) symbols[number]->parent   = target_symbol;
+        else if (TRAILER_TOKEN    == pointer) symbols[number]->token    = (token_c *)target_symbol;
+        else    ok = false;
+      }
+      return ok? root_symbol : NULL;
+    }
+
+  private:
+    uint64_t    get_uint(void) {uint64_t v = 0; if (ok && !serialize_ast_c::get_uint(&buf, end, &v)) ok = false; return v;}
+    int64_t     get_int (void) { int64_t v = 0; if (ok && !serialize_ast_c::get_int (&buf, end, &v)) ok = false; return v;}
+    const char *get_str (void) {const char *v = NULL; if (ok && !serialize_ast_c::get_str(&buf, end, &v)) ok = false; return v;}
+
+    symbol_c *get_symbol(uint64_t number) {
+      if (number < symbols.size()) return symbols[number];
+      ok = false;
+      return NULL;
+    }
+
+    const char *read_file(void) {
+      uint64_t v = get_uint();
+      if (0 == v)      return NULL;
+      if (v & 1)       {if ((v >> 1) < files.size()) return files[v >> 1]; ok = false; return NULL;}
+      const char *filename = get_str();
+      files.push_back(filename);
+      return filename;
+    }
+
+    void read_location(symbol_c *symbol) {
+      symbol->first_line   = prev_line  + get_int();
+      symbol->first_column = get_int();
+      symbol->first_file   = read_file();
+      symbol->first_order  = prev_order + get_int();
+      symbol->last_line    = symbol->first_line  + get_int();
+      symbol->last_column  = get_int();
+      symbol->last_file    = read_file();
+      symbol->last_order   = symbol->first_order + get_int();
+      prev_line  = symbol->first_line;
+      prev_order = symbol->first_order;
+    }
+
+    void start_node(symbol_c *symbol) {
+      symbols.push_back(symbol);
+      read_location(symbol);
+    }
+
+    void read_list(list_c *list) {
+      /* list_c::add_element() changes the location of the list, and may set the parent of
+       * the elements. We therefore restore these after adding the elements.
+       */
+      int         first_line   = list->first_line,   last_line   = list->last_line;
+      int         first_column = list->first_column, last_column = list->last_column;
+      const char *first_file   = list->first_file,  *last_file   = list->last_file;
+      long int    first_order  = list->first_order,  last_order  = list->last_order;
+      uint64_t n = get_uint();
+      for (uint64_t i = 0; ok && (i < n); i++) {
+        symbol_c *element = read_node(list);
+        symbol_c *parent  = (NULL == element)? NULL : element->parent;
+        uint64_t  key     = get_uint();
+        if      (KEY_NULL   == key) list->add_element(element, (const char *)NULL);
+        else if (KEY_STRING == key) list->add_element(element, get_str());
+        else if ((KEY_TOKEN == key) && (NULL != element) && (NULL != element->token))
+                                    list->add_element(element, element->token->value);
+        else    {ok = false; break;}
+        if (NULL != element) element->parent = parent;
+      }
+      list->first_line   = first_line;   list->last_line   = last_line;
+      list->first_column = first_column; list->last_column = last_column;
+      list->first_file   = first_file;   list->last_file   = last_file;
+      list->first_order  = first_order;  list->last_order  = last_order;
+    }
+
+    symbol_c *read_pointer(symbol_c *implied) {
+      switch (get_uint()) {
+        case PTR_NULL:    return NULL;
+        case PTR_IMPLIED: return implied;
+        case PTR_NUMBER:  return get_symbol(get_uint());
+        case PTR_TRAILER: return NULL; /* will be set when reading the trailer */
+      }
+      ok = false;
+      return NULL;
+    }
+
+    symbol_c *read_node(symbol_c *container) {
+      symbol_c *symbol = NULL;
+      uint64_t  tag    = get_uint();
+      if (!ok) return NULL;
+
+      switch (tag) {
+        case NULL_TAG:    return NULL;
+        case BACKREF_TAG: return get_symbol(get_uint());
+#define SYM_LIST(class_name_c, ...)                                             \
+        case class_name_c##_tag: {class_name_c *s = new class_name_c(); start_node(s);                 \
+                                  read_list(s); symbol = s; break;}
+#define SYM_TOKEN(class_name_c, ...)                                            \
+        case class_name_c##_tag: {class_name_c *s = new class_name_c(NULL); start_node(s);             \
+                                  s->value = get_str();                                                \
+                                  if (NULL != s->value) s->value = strpool_c::intern(s->value);        \
+                                  symbol = s; break;}
+#define SYM_REF0(class_name_c, ...)                                             \
+        case class_name_c##_tag: {class_name_c *s = new class_name_c(); start_node(s);                 \
+                                  symbol = s; break;}
+#define SYM_REF1(class_name_c, ref1, ...)                                       \
+        case class_name_c##_tag: {class_name_c *s = new class_name_c(); start_node(s);                 \
+                                  s->ref1 = read_node(s);                                              \
+                                  symbol = s; break;}
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 \
+        case class_name_c##_tag: {class_name_c *s = new class_name_c(); start_node(s);                 \
+                                  s->ref1 = read_node(s); s->ref2 = read_node(s);                      \
+                                  symbol = s; break;}
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           \
+        case class_name_c##_tag: {class_name_c *s = new class_name_c(); start_node(s);                 \
+                                  s->ref1 = read_node(s); s->ref2 = read_node(s);                      \
+                                  s->ref3 = read_node(s);                                              \
+                                  symbol = s; break;}
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     \
+        case class_name_c##_tag: {class_name_c *s = new class_name_c(); start_node(s);                 \
+                                  s->ref1 = read_node(s); s->ref2 = read_node(s);                      \
+                                  s->ref3 = read_node(s); s->ref4 = read_node(s);                      \
+                                  symbol = s; break;}
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               \
+        case class_name_c##_tag: {class_name_c *s = new class_name_c(); start_node(s);                 \
+                                  s->ref1 = read_node(s); s->ref2 = read_node(s);                      \
+                                  s->ref3 = read_node(s); s->ref4 = read_node(s);                      \
+                                  s->ref5 = read_node(s);                                              \
+                                  symbol = s; break;}
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         \
+        case class_name_c##_tag: {class_name_c *s = new class_name_c(); start_node(s);                 \
+                                  s->ref1 = read_node(s); s->ref2 = read_node(s);                      \
+                                  s->ref3 = read_node(s); s->ref4 = read_node(s);                      \
+                                  s->ref5 = read_node(s); s->ref6 = read_node(s);                      \
+                                  symbol = s; break;}
+#include "../absyntax/absyntax.def"
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
+        default: ok = false; return NULL;
+      }
+
+      symbol->parent = read_pointer(container);
+      symbol->token  = (token_c *)read_pointer(symbol);
+      return ok? symbol : NULL;
+    }
+};
+
+
+
+
+/***********************************/
+/* The public interface...         */
+/***********************************/
+
+void serialize_ast_c::save(symbol_c *root_symbol, std::string &buf) {
+  buf.append(AST_MAGIC, sizeof(AST_MAGIC));
+  put_uint(buf, AST_FORMAT_VERSION);
+  put_uint(buf, absyntax_signature());
+
+  ast_writer_c writer(buf);
+  writer.write(root_symbol);
+}
+
+
+symbol_c *serialize_ast_c::load(const char **buf, const char *end) {
+  uint64_t version, signature;
+
+  if ((size_t)(end - *buf) < sizeof(AST_MAGIC))         return NULL;
+  if (memcmp(*buf, AST_MAGIC, sizeof(AST_MAGIC)) != 0)  return NULL;
+  *buf += sizeof(AST_MAGIC);
+  if (!get_uint(buf, end, &version)   || (version   != AST_FORMAT_VERSION))   return NULL;
+  if (!get_uint(buf, end, &signature) || (signature != absyntax_signature())) return NULL;
+
+  ast_reader_c reader(*buf, end);
+  symbol_c *root_symbol = reader.read();
+  if (NULL != root_symbol) *buf = reader.position();
+  return root_symbol;
+}
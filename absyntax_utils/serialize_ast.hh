@@ -0,0 +1,80 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * Save an AST to (and load it from) a compact binary encoding.
+ *
+ * The encoding stores, for every symbol in the AST, the class of the symbol (as
+ * listed in absyntax.def), its location in the source code, the value of tokens,
+ * the elements of lists (together with the token_value used to index the element),
+ * the references to its children, and its 'parent' and 'token' pointers.
+ * Symbols that are referenced from more than one place in the AST are only stored
+ * once, so the loaded AST has exactly the same shape as the saved AST.
+ *
+ * Only the data produced by stage 1_2 is stored. The annotations of stage 3 and
+ * stage 4 (datatype, candidate_datatypes, const_value, ...) are never stored.
+ *
+ * All numbers are stored as variable length integers, and strings are stored
+ * with a terminating '\0', so that the loaded AST may reference the strings
+ * directly inside the buffer it was loaded from. This also means that the
+ * buffer must never be released while the loaded AST is in use!
+ * The only exception are the values of the tokens, which are interned
+ * (see strpool.hh) just like the token values produced by the lexical analyser.
+ *
+ * The AST is loaded in a single pass over the buffer, creating the symbols in
+ * the order in which they were stored.
+ */
+
+
+
+#include <string>
+#include "../absyntax/absyntax.hh"
+
+
+class serialize_ast_c {
+  public:
+    /* Append the encoding of the AST rooted at root_symbol to buf */
+    static void      save(symbol_c *root_symbol, std::string &buf);
+    /* Decode an AST starting at *buf, and advance *buf to the end of the encoded AST.
+     * Returns NULL if the data is corrupt or was produced by an incompatible version of matiec.
+     */
+    static symbol_c *load(const char **buf, const char *end);
+
+    /* Helper functions used to store numbers and strings, using the same encoding used for the AST. */
+    /* The get_xxx() functions return false if the buffer ends before the value is complete. */
+    static void put_uint(std::string &buf, uint64_t value);
+    static void put_int (std::string &buf,  int64_t value);
+    static void put_str (std::string &buf, const char *str);
+    static bool get_uint(const char **buf, const char *end, uint64_t *value);
+    static bool get_int (const char **buf, const char *end,  int64_t *value);
+    static bool get_str (const char **buf, const char *end, const char **str);
+};
@@ -99,9 +99,35 @@ type_initial_value_c::type_initial_value_c(void) {}
 
 
 
+side_table_c<symbol_c *> type_initial_value_c::memo;
+memo_stats_t             type_initial_value_c::stats = {0, 0, 0};
+
+
 symbol_c *type_initial_value_c::get(symbol_c *type) {
   TRACE("type_initial_value_c::get(): called ");
-  return (symbol_c *)type->accept(*type_initial_value_c::instance());
+  symbol_c **res = memo.find(type->id);
+  if (NULL != res) {stats.hits++; return *res;}
+
+  double start_time = runtime_options.print_stats? memo_stats_time() : 0;
+  symbol_c *value = (symbol_c *)type->accept(*type_initial_value_c::instance());
+  memo[type->id] = value;
+  stats.misses++;
+  if (runtime_options.print_stats) stats.miss_time += memo_stats_time() - start_time;
+  return value;
+}
+
+
+void type_initial_value_c::invalidate(symbol_c *type) {
+  if (NULL != type) memo.erase(type->id);
+}
+
+void type_initial_value_c::invalidate_all(void) {
+  memo.clear();
+}
+
+void type_initial_value_c::reset_stats(void) {
+  stats.hits = stats.misses = 0;
+  stats.miss_time = 0;
 }
 
 
@@ -56,12 +56,28 @@
  *       this class of object. This class
  *       is therefore a singleton.
  */
+/* NOTE: The initial value of every type passed to get() is memoized in a cache,
+ *       indexed by the symbol_c::id of the type, so the chain of derived datatypes
+ *       is only followed the first time the initial value of a type is needed.
+ *       Code that changes the type declarations after their initial values
+ *       have been obtained must call invalidate_all() (or invalidate(type)).
+ */
 
 class type_initial_value_c : public null_visitor_c {
 
   public:
     static symbol_c *get(symbol_c *type);
 
+    static void invalidate    (symbol_c *type);  /* forget the cached initial value of type */
+    static void invalidate_all(void);            /* forget all the cached initial values */
+    static memo_stats_t get_stats  (void) {return stats;}
+    static void         reset_stats(void);
+
+  private:
+    /* the cached initial values, indexed by the type's id */
+    static side_table_c<symbol_c *> memo;
+    static memo_stats_t             stats;
+
   private:
     /* constants for the default values of elementary data types... */
     static ref_value_null_literal_c       *null_literal;
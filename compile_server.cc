@@ -0,0 +1,374 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * The compile server.
+ * See the comment in compile_server.hh
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "compile_server.hh"
+
+
+#ifdef _WIN32
+
+int compile_server_run(const char *socket_path, compile_request_t compile_request) {
+  fprintf(stderr, "The compile server is not available on this platform.\n");
+  return -1;
+}
+
+int compile_server_request(const char *socket_path, int argc, char **argv, double *latency) {
+  return -1;
+}
+
+#else
+
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+
+#define MAX_REQUEST_SIZE (1024 * 1024)
+#define FD_COUNT         2  /* the standard output and error of the client */
+
+
+static double now(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+
+/* read/write exactly count bytes. Return false on error, or if the other end closed the connection. */
+static bool read_all(int fd, void *buf, size_t count) {
+  while (count > 0) {
+    ssize_t res = read(fd, buf, count);
+    if ((res < 0) && (EINTR == errno)) continue;
+    if (res <= 0) return false;
+    buf = (char *)buf + res; count -= res;
+  }
+  return true;
+}
+
+static bool write_all(int fd, const void *buf, size_t count) {
+  while (count > 0) {
+    ssize_t res = write(fd, buf, count);
+    if ((res < 0) && (EINTR == errno)) continue;
+    if (res <= 0) return false;
+    buf = (const char *)buf + res; count -= res;
+  }
+  return true;
+}
+
+
+static bool get_address(const char *socket_path, struct sockaddr_un *address) {
+  if (strlen(socket_path) >= sizeof(address->sun_path)) {
+    fprintf(stderr, "Socket path too long: %s\n", socket_path);
+    return false;
+  }
+  memset(address, 0, sizeof(*address));
+  address->sun_family = AF_UNIX;
+  strcpy(address->sun_path, socket_path);
+  return true;
+}
+
+
+
+
+/*************************/
+/* The compile server... */
+/*************************/
+
+typedef struct {
+  int                 fds[FD_COUNT];  /* the standard output and error of the client (-1 if not received) */
+  std::string         cwd;
+  std::vector<char *> argv;
+  std::vector<char>   buffer;         /* the strings pointed to by cwd and argv */
+} request_t;
+
+
+static void close_fds(request_t &request) {
+  for (int i = 0; i < FD_COUNT; i++)
+    if (request.fds[i] >= 0) {close(request.fds[i]); request.fds[i] = -1;}
+}
+
+
+/* Receive a request from the client. Returns false if the request is invalid. */
+static bool receive_request(int fd, request_t &request) {
+  uint32_t      size;
+  struct iovec  iov;
+  struct msghdr msg;
+  union {
+    char           buf[CMSG_SPACE(FD_COUNT * sizeof(int))];
+    struct cmsghdr align;
+  } control;
+
+  for (int i = 0; i < FD_COUNT; i++) request.fds[i] = -1;
+
+  /* The length of the request, along with the file descriptors */
+  memset(&msg, 0, sizeof(msg));
+  iov.iov_base       = &size;
+  iov.iov_len        = sizeof(size);
+  msg.msg_iov        = &iov;
+  msg.msg_iovlen     = 1;
+  msg.msg_control    = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  ssize_t res;
+  while (((res = recvmsg(fd, &msg, 0)) < 0) && (EINTR == errno));
+  if (res <= 0) return false;
+
+  for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); NULL != cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    if ((SOL_SOCKET == cmsg->cmsg_level) && (SCM_RIGHTS == cmsg->cmsg_type)) {
+      int count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      for (int i = 0; i < count; i++) {
+        int received_fd;
+        memcpy(&received_fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+        if (i < FD_COUNT) request.fds[i] = received_fd; else close(received_fd);
+      }
+    }
+  for (int i = 0; i < FD_COUNT; i++)
+    if (request.fds[i] < 0) return false;
+  /* the (very unlikely) case of the length of the request arriving in several pieces */
+  if (!read_all(fd, (char *)&size + res, sizeof(size) - res)) return false;
+
+  /* The request: working directory, and command line arguments */
+  if ((0 == size) || (size > MAX_REQUEST_SIZE)) return false;
+  request.buffer.resize(size);
+  if (!read_all(fd, &request.buffer[0], size)) return false;
+  if ('\0' != request.buffer[size - 1]) return false;
+
+  request.cwd = &request.buffer[0];
+  for (char *str = &request.buffer[0] + request.cwd.size() + 1; str < &request.buffer[0] + size; str += strlen(str) + 1)
+    request.argv.push_back(str);
+  if (request.argv.empty()) return false;
+  request.argv.push_back(NULL);
+  return true;
+}
+
+
+/* Compile the request in a child process. Returns the exit status of the child. */
+static int run_request(int listen_fd, int fd, request_t &request, compile_request_t compile_request) {
+  fflush(NULL);  /* anything left in the buffers of the server would otherwise be written by the child too */
+  pid_t pid = fork();
+  if (pid < 0) {
+    perror("Compile server: could not fork a process for the request");
+    return EXIT_FAILURE;
+  }
+
+  if (0 == pid) {
+    /* the child process */
+    signal(SIGPIPE, SIG_DFL);
+    close(listen_fd);
+    close(fd);
+    dup2(request.fds[0], STDOUT_FILENO);
+    dup2(request.fds[1], STDERR_FILENO);
+    close_fds(request);
+    if (chdir(request.cwd.c_str()) != 0) {
+      fprintf(stderr, "Could not change to the directory %s\n", request.cwd.c_str());
+      exit(EXIT_FAILURE);
+    }
+    exit(compile_request(request.argv.size() - 1, &request.argv[0]));
+  }
+
+  /* the server process */
+  close_fds(request);
+  int status;
+  while ((waitpid(pid, &status, 0) < 0) && (EINTR == errno));
+  if (WIFEXITED(status))   return WEXITSTATUS(status);
+  if (WIFSIGNALED(status)) return 128 + WTERMSIG(status);  /* same as the shell */
+  return EXIT_FAILURE;
+}
+
+
+static int open_server_socket(const char *socket_path) {
+  struct sockaddr_un address;
+  if (!get_address(socket_path, &address)) return -1;
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {perror("Compile server: could not create socket"); return -1;}
+
+  /* remove the socket left behind by a previous server, unless that server is still running */
+  if (connect(fd, (struct sockaddr *)&address, sizeof(address)) == 0) {
+    fprintf(stderr, "Compile server: another server is already listening on %s\n", socket_path);
+    close(fd);
+    return -1;
+  }
+  if (ECONNREFUSED == errno)
+    unlink(socket_path);
+  close(fd);
+
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {perror("Compile server: could not create socket"); return -1;}
+  if ((bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0) || (listen(fd, 16) != 0)) {
+    fprintf(stderr, "Compile server: could not listen on %s: %s\n", socket_path, strerror(errno));
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+
+int compile_server_run(const char *socket_path, compile_request_t compile_request) {
+  int listen_fd = open_server_socket(socket_path);
+  if (listen_fd < 0) return -1;
+
+  /* a client that goes away before reading the reply must not terminate the server */
+  signal(SIGPIPE, SIG_IGN);
+  fprintf(stderr, "Compile server: listening on %s\n", socket_path);
+
+  unsigned long request_count = 0;
+  double        total_latency = 0;
+  while (true) {
+    int fd = accept(listen_fd, NULL, NULL);
+    if (fd < 0) {
+      if ((EINTR == errno) || (ECONNABORTED == errno)) continue;
+      perror("Compile server: could not accept connection");
+      close(listen_fd);
+      return -1;
+    }
+
+    double    start = now();
+    request_t request;
+    int       exit_status = EXIT_FAILURE;
+    bool      valid       = receive_request(fd, request);
+    if (valid)
+      exit_status = run_request(listen_fd, fd, request, compile_request);
+    close_fds(request);
+    double latency = (now() - start) * 1e3;
+
+    char reply[64];
+    snprintf(reply, sizeof(reply), "%d %.3f\n", exit_status, latency);
+    write_all(fd, reply, strlen(reply));
+    close(fd);
+
+    if (!valid) {
+      fprintf(stderr, "Compile server: invalid request\n");
+      continue;
+    }
+    request_count++;
+    total_latency += latency;
+    fprintf(stderr, "Compile server: request %lu (%s): exit status %d, %.3f ms (average %.3f ms)\n",
+            request_count, request.argv[request.argv.size() - 2], exit_status, latency, total_latency / request_count);
+  }
+}
+
+
+
+
+/*************************/
+/* The client...         */
+/*************************/
+
+int compile_server_request(const char *socket_path, int argc, char **argv, double *latency) {
+  struct sockaddr_un address;
+  if (!get_address(socket_path, &address)) return -1;
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+  if (connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0) {close(fd); return -1;}
+
+  /* The request: working directory, and command line arguments */
+  char cwd[PATH_MAX];
+  if (NULL == getcwd(cwd, sizeof(cwd))) {close(fd); return -1;}
+  std::string request(cwd, strlen(cwd) + 1);
+  for (int i = 0; i < argc; i++)
+    request.append(argv[i], strlen(argv[i]) + 1);
+  uint32_t size = request.size();
+
+  /* The length of the request, along with the file descriptors */
+  int           fds[FD_COUNT] = {STDOUT_FILENO, STDERR_FILENO};
+  struct iovec  iov;
+  struct msghdr msg;
+  union {
+    char           buf[CMSG_SPACE(FD_COUNT * sizeof(int))];
+    struct cmsghdr align;
+  } control;
+
+  memset(&msg, 0, sizeof(msg));
+  memset(&control, 0, sizeof(control));
+  iov.iov_base       = &size;
+  iov.iov_len        = sizeof(size);
+  msg.msg_iov        = &iov;
+  msg.msg_iovlen     = 1;
+  msg.msg_control    = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level   = SOL_SOCKET;
+  cmsg->cmsg_type    = SCM_RIGHTS;
+  cmsg->cmsg_len     = CMSG_LEN(FD_COUNT * sizeof(int));
+  memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+  ssize_t res;
+  while (((res = sendmsg(fd, &msg, 0)) < 0) && (EINTR == errno));
+  if (   (res <= 0)
+      || !write_all(fd, (char *)&size + res, sizeof(size) - res)
+      || !write_all(fd, request.data(), request.size())) {
+    close(fd);
+    return -1;
+  }
+
+  /* The reply: "<exit_status> <latency>\n" */
+  char   reply[64];
+  size_t len = 0;
+  while ((len < sizeof(reply) - 1) && ((res = read(fd, reply + len, sizeof(reply) - 1 - len)) != 0)) {
+    if (res < 0) {if (EINTR == errno) continue; break;}
+    len += res;
+  }
+  reply[len] = '\0';
+  close(fd);
+
+  int    exit_status;
+  double reply_latency;
+  if (sscanf(reply, "%d %lf", &exit_status, &reply_latency) != 2) {
+    /* the compilation may already have printed its error messages, so we can not simply compile the file once again */
+    fprintf(stderr, "Compile server: invalid reply\n");
+    return EXIT_FAILURE;
+  }
+  if (NULL != latency) *latency = reply_latency;
+  return exit_status;
+}
+
+
+#endif /* _WIN32 */
@@ -0,0 +1,91 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * The compile server: a resident process that compiles the files it is asked to, over a local (UNIX domain) socket.
+ *
+ * Most of the time spent compiling a small program goes into starting the compiler, parsing the standard
+ * library, and loading its POUs and datatypes into the symbol tables. A tool that compiles very often
+ * (e.g. an IDE that compiles on every save) may instead start a compile server once
+ *     iec2c -D <socket_path> [-I <include_directory>] [<options>]
+ * and then have the server do each compilation
+ *     iec2c -X <socket_path> [<options>] [-O <output_options>] [-T <target_directory>] <input_file>
+ * with exactly the same command line that would be used to compile without the server. The error messages
+ * are printed to the standard output/error of the client, and the files are generated in its target directory.
+ * If the server can not be reached, the client compiles the file itself.
+ *
+ * The server parses the standard library when it starts. Each request is then handled by a child process
+ * forked by the server, that inherits the AST of the standard library and the symbol tables, and only needs
+ * to parse and compile the input file. The child works on its own (copy on write) copy of the memory of the
+ * server, so whatever it adds to the AST, to the symbol tables or to the annotations, is discarded along with
+ * the child, and never seen by the following requests. An internal compiler error (that exits the process)
+ * only terminates the child too.
+ *
+ * The options given to the server apply to every request, and the options of each request are added to them.
+ * The options that change how the standard library is parsed (-I, -b, -i, -e, -s, -c, -n, -r, -R, -a) must however
+ * be the same for the server and the request, otherwise the request fails (see stage1_2_load_library()).
+ *
+ * Protocol (the client and the server run on the same host, so all integers are in host byte order):
+ *   - the client sends its standard output and error (as SCM_RIGHTS ancillary data) along with the length
+ *     (uint32_t) of the request, followed by the request itself: the working directory of the client and
+ *     its command line arguments (argv[0] included), each terminated by a '\0'.
+ *   - once the compilation is over, the server replies with a single line of text: "<exit_status> <latency>\n",
+ *     where the latency (in ms) is measured by the server, from the moment it accepts the connection until
+ *     the child process terminates.
+ *
+ * NOTE: The server handles one request at a time.
+ * NOTE: The server is not available on windows.
+ */
+
+
+#ifndef _COMPILE_SERVER_HH
+#define _COMPILE_SERVER_HH
+
+
+/* Compile the command line of a request. Called in the child process forked for the request,
+ * once it has the working directory and the standard output/error of the client.
+ * Returns the exit status of the compilation.
+ */
+typedef int (*compile_request_t)(int argc, char **argv);
+
+/* Run the compile server, listening on socket_path. The standard library must already have been loaded.
+ * Only returns (-1) if the server could not be started.
+ */
+int compile_server_run(const char *socket_path, compile_request_t compile_request);
+
+/* Have the compile server listening on socket_path compile the command line argc/argv.
+ * Returns the exit status of the compilation (and its latency, in ms), or -1 if the server could not be reached.
+ */
+int compile_server_request(const char *socket_path, int argc, char **argv, double *latency);
+
+
+#endif /* _COMPILE_SERVER_HH */
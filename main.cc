@@ -81,6 +81,7 @@
 #include "stage1_2/stage1_2.hh"
 #include "stage3/stage3.hh"
 #include "stage4/stage4.hh"
+#include "compile_server.hh"
 #include "main.hh"
 
 
@@ -109,7 +110,7 @@ void error_exit(const char *file_name, int line_no, const char *errmsg, ...) {
 
 
 static void printusage(const char *cmd) {
-  printf("\nsyntax: %s [<options>] [-O <output_options>] [-I <include_directory>] [-T <target_directory>] <input_file>\n", cmd);
+  printf("\nsyntax: %s [<options>] [-O <output_options>] [-I <include_directory>] [-T <target_directory>] [-C <cache_file>] [-j <threads>] [-U <state_directory>] [-D|-X <socket>] [-P <profile_file>] [-M <census_file>] <input_file>\n", cmd);
   printf(" -h : show this help message\n");
   printf(" -v : print version number\n");  
   printf(" -f : display full token location on error messages\n");
@@ -125,6 +126,17 @@ static void printusage(const char *cmd) {
   printf(" -b : allow functions returning VOID                 (a non-standard extension!)\n");
   printf(" -e : disable generation of implicit EN and ENO parameters.\n");
   printf(" -c : create conversion functions for enumerated data types\n");
+  printf(" -C : use (and create, if necessary) a cache file of the parsed standard library\n");
+  printf(" -S : print statistics on the caches of the type searches, after each stage\n");
+  printf(" -j : number of threads used to check the POUs in stage 3 (default: 1)\n");
+  printf(" -U : incremental compilation: only analyse and generate the POUs changed since the previous compilation\n");
+  printf("        (keeps its state in <state_directory>; code is only kept for unchanged POUs with the '-O p' option)\n");
+  printf(" -P : report the time, AST nodes visited and memory used by each phase of the compiler\n");
+  printf("        (to <profile_file>, in JSON format if its name ends in '.json', or as a table to stderr with '-P -')\n");
+  printf(" -M : report the number of nodes and the memory used by each class of the AST, and by its annotations, once compiled\n");
+  printf("        (to <census_file>, in JSON format if its name ends in '.json', or as a table to stderr with '-M -')\n");
+  printf(" -D : run as a compile server, listening on the UNIX socket <socket> (no <input_file> required)\n");
+  printf(" -X : have the compile server listening on <socket> do the compilation (compile locally if the server is not running)\n");
   printf(" -O : options for output (code generation) stage. Available options for %s are...\n", cmd);
   runtime_options.allow_missing_var_in    = false; /* disable: allow definition and invocation of POUs with no input, output and in_out parameters! */
   stage4_print_options();
@@ -139,40 +151,34 @@ static void printusage(const char *cmd) {
 runtime_options_t runtime_options;
 
 
-int main(int argc, char **argv) {
-  symbol_c *tree_root, *ordered_tree_root;
-  char * builddir = NULL;
+/* The command line options that are not stored in runtime_options */
+static char        *builddir      = NULL;
+static std::string  stage4_options;        /* all the -O options, used by the incremental compilation */
+static const char  *server_socket = NULL;  /* -D: run as a compile server */
+static const char  *client_socket = NULL;  /* -X: have the compile server do the compilation */
+
+/* Number of elements of the library (i.e. the standard library) already loaded into the symbol tables by the compile server */
+static int library_element_count = 0;
+
+
+/* Parse the command line options, and store them in runtime_options (and the variables above).
+ * Returns 0 if the compilation may go ahead, 1 if there is nothing more to do (-h, -v), and -1 on error.
+ */
+static int parse_options(int argc, char **argv) {
   int optres, errflg = 0;
   int path_len;
 
-  /* Default values for the command line options... */
-  runtime_options.allow_void_datatype     = false; /* disable: allow declaration of functions returning VOID  */
-  runtime_options.allow_missing_var_in    = false; /* disable: allow definition and invocation of POUs with no input, output and in_out parameters! */
-  runtime_options.disable_implicit_en_eno = false; /* disable: do not generate EN and ENO parameters */
-  runtime_options.pre_parsing             = false; /* disable: allow use of forward references (run pre-parsing phase before the definitive parsing phase that builds the AST) */
-  runtime_options.safe_extensions         = false; /* disable: allow use of SAFExxx datatypes */
-  runtime_options.full_token_loc          = false; /* disable: error messages specify full token location */
-  runtime_options.conversion_functions    = false; /* disable: create a conversion function for derived datatype */
-  runtime_options.nested_comments         = false; /* disable: Allow the use of nested comments. */
-  runtime_options.ref_standard_extensions = false; /* disable: Allow the use of REFerences (keywords REF_TO, REF, DREF, ^, NULL). */
-  runtime_options.ref_nonstand_extensions = false; /* disable: Allow the use of non-standard extensions to REF_TO datatypes: REF_TO ANY, and REF_TO in struct elements! */
-  runtime_options.nonliteral_in_array_size= false; /* disable: Allow the use of constant non-literals when specifying size of arrays (ARRAY [1..max] OF INT) */
-  runtime_options.includedir              = NULL;  /* Include directory, where included files will be searched for... */
-
-  /* Default values for the command line options... */
-  runtime_options.relaxed_datatype_model    = false; /* by default use the strict datatype equivalence model */
-  
   /******************************************/
   /*   Parse command line options...        */
   /******************************************/
-  while ((optres = getopt(argc, argv, ":nehvfplsrRabicI:T:O:")) != -1) {
+  while ((optres = getopt(argc, argv, ":nehvfplsrRabicSI:T:O:C:j:U:D:X:P:M:")) != -1) {
     switch(optres) {
     case 'h':
       printusage(argv[0]);
-      return 0;
+      return 1;
     case 'v':
       fprintf(stdout, "%s version %s\n" "changeset id: %s\n", PACKAGE_NAME, PACKAGE_VERSION, HGVERSION);      
-      return 0;
+      return 1;
     case 'l': runtime_options.relaxed_datatype_model   = true;  break;
     case 'p': runtime_options.pre_parsing              = true;  break;
     case 'f': runtime_options.full_token_loc           = true;  break;
@@ -186,6 +192,7 @@ int main(int argc, char **argv) {
     case 'c': runtime_options.conversion_functions     = true;  break;
     case 'n': runtime_options.nested_comments          = true;  break;
     case 'e': runtime_options.disable_implicit_en_eno  = true;  break;
+    case 'S': runtime_options.print_stats              = true;  break;
     case 'I':
       /* NOTE: To improve the usability under windows:
        *       We delete last char's path if it ends with "\".
@@ -203,9 +210,36 @@ int main(int argc, char **argv) {
       builddir = optarg;
       break;
     case 'O':
+      stage4_options += optarg;
+      stage4_options += ";";
       if (stage4_parse_options(optarg) < 0) errflg++;
       break;
-    case ':':       /* -I, -T, or -O without operand */
+    case 'C':
+      runtime_options.library_cache = optarg;
+      break;
+    case 'j':
+      runtime_options.stage3_threads = atoi(optarg);
+      if (runtime_options.stage3_threads < 1) {
+        fprintf(stderr, "Invalid number of threads: %s\n", optarg);
+        errflg++;
+      }
+      break;
+    case 'U':
+      runtime_options.state_dir = optarg;
+      break;
+    case 'D':
+      server_socket = optarg;
+      break;
+    case 'X':
+      client_socket = optarg;
+      break;
+    case 'P':
+      runtime_options.profile_file = optarg;
+      break;
+    case 'M':
+      runtime_options.census_file = optarg;
+      break;
+    case ':':       /* -I, -T, -O, -C, -j, -U, -D, -X, -P, or -M without operand */
       fprintf(stderr, "Option -%c requires an operand\n", optopt);
       errflg++;
       break;
@@ -220,7 +254,7 @@ int main(int argc, char **argv) {
     }
   }
 
-  if (optind == argc) {
+  if ((optind == argc) && (NULL == server_socket)) {
     fprintf(stderr, "Missing input file\n");
     errflg++;
   }
@@ -232,30 +266,75 @@ int main(int argc, char **argv) {
 
   if (errflg) {
     printusage(argv[0]);
-    return EXIT_FAILURE;
+    return -1;
   }
+  return 0;
+}
 
 
+
+/* Compile the input file. Returns the exit status of the compiler.
+ * NOTE: The phases that are still running when bailing out are stopped by phase_profiler_c::write_report().
+ */
+static int run_compiler(const char *filename) {
+  symbol_c *tree_root, *ordered_tree_root;
+
   /***************************/
   /*   Run the compiler...   */
   /***************************/
   /* 1st Pass */
-  if (stage1_2(argv[optind], &tree_root) < 0)
+  phase_profiler_c::start("stage1_2");
+  if (stage1_2(filename, &tree_root) < 0)
     return EXIT_FAILURE;
+  phase_profiler_c::stop();
 
   /* 2nd Pass */
     /* basically loads some symbol tables to speed up look ups later on */
-  absyntax_utils_init(tree_root);  
+  phase_profiler_c::start("absyntax_utils_init");
+  absyntax_utils_init(tree_root, library_element_count);  
+  phase_profiler_c::stop();
     /* moved to bison, although it could perfectly well still be here instead of in bison code. */
   //add_en_eno_param_decl_c::add_to(tree_root);
 
+  /* Determine which POUs have not changed since the previous compilation */
+  if (NULL != runtime_options.state_dir) {
+    profile_phase_c phase("incremental_build");
+    if (incremental_build_c::init(runtime_options.state_dir, tree_root, stage4_options.c_str()) < 0) {
+      fprintf(stderr, "Could not create the state directory %s\n", runtime_options.state_dir);
+      return EXIT_FAILURE;
+    }
+    /* The unchanged POUs whose previously generated code is no longer available must be analysed and generated once again */
+    library_c *library = tree_root->as<library_c>();
+    for (int i = 0; (NULL != library) && (i < library->n); i++)
+      if (incremental_build_c::is_up_to_date(library->get_element(i)) && !stage4_can_keep_pou(library->get_element(i), builddir))
+        incremental_build_c::set_out_of_date(library->get_element(i));
+    /* Forget the changed POUs, until their code has been successfully generated */
+    incremental_build_c::save(false);
+    if (runtime_options.print_stats)
+      incremental_build_c::print_stats();
+  }
+
   /* Do semantic verification of code */
+  phase_profiler_c::start("stage3");
   if (stage3(tree_root, &ordered_tree_root) < 0)
     return EXIT_FAILURE;
+  phase_profiler_c::stop();
+  if (runtime_options.print_stats)
+    absyntax_utils_print_stats("stage 3");
   
   /* 3rd Pass */
+  phase_profiler_c::start("stage4");
   if (stage4(ordered_tree_root, builddir) < 0)
     return EXIT_FAILURE;
+  phase_profiler_c::stop();
+  if (runtime_options.print_stats)
+    absyntax_utils_print_stats("stage 4");
+
+  if ((NULL != runtime_options.census_file) && (debug_c::print_census(tree_root, runtime_options.census_file) < 0))
+    fprintf(stderr, "Could not write the census of the AST to %s\n", runtime_options.census_file);
+
+  if (incremental_build_c::save(true) < 0)
+    fprintf(stderr, "Could not save the state of the incremental compilation in %s\n", runtime_options.state_dir);
 
   /* 4th Pass */
   /* Call gcc, g++, or whatever... */
@@ -265,3 +344,106 @@ int main(int argc, char **argv) {
 }
 
 
+/* Compile the input file, profiling the phases of the compiler (-P option). Returns the exit status of the compiler.
+ *
+ * The AST of the input file, and any node added to the AST by the later stages, is allocated from an arena
+ * of its own, released in a single go once the compilation is over. The standard library is allocated from
+ * the arena kept by stage1_2, so a compile server (which compiles each request in a process of its own)
+ * never touches the pages holding the library it has already loaded.
+ * NOTE: Once the arena has been released, the AST may no longer be used, not even the list of elements of the
+ *       library (which grows into this arena when the POUs of the input file are added to it).
+ *       The symbol tables and the annotations still referencing the released nodes are not cleared, so
+ *       the compiler must not be run again in the same process.
+ */
+static int compile(const char *filename) {
+  if (NULL != runtime_options.profile_file)
+    phase_profiler_c::enable();
+
+  arena_c  compile_arena;
+  arena_c *prev_arena = arena_c::set_current(&compile_arena);
+
+  int exit_status = run_compiler(filename);
+
+  if ((NULL != runtime_options.profile_file) && (phase_profiler_c::write_report(runtime_options.profile_file) < 0))
+    fprintf(stderr, "Could not write the profile report to %s\n", runtime_options.profile_file);
+
+  arena_c::set_current(prev_arena);
+  compile_arena.release();
+  return exit_status;
+}
+
+
+
+/* Compile a request sent to the compile server (runs in a process forked by the server, see compile_server.hh).
+ * The options of the request are added to the options given to the server.
+ */
+static int compile_request(int argc, char **argv) {
+  optind = 1;  /* restart getopt() */
+  int res = parse_options(argc, argv);
+  if (res != 0)
+    return (res < 0)? EXIT_FAILURE : 0;
+  /* NOTE: parse_options() does not complain about a missing input file, since server_socket is set */
+  if (optind == argc) {
+    fprintf(stderr, "Missing input file\n");
+    return EXIT_FAILURE;
+  }
+  return compile(argv[optind]);
+}
+
+
+
+int main(int argc, char **argv) {
+  /* Default values for the command line options... */
+  runtime_options.allow_void_datatype     = false; /* disable: allow declaration of functions returning VOID  */
+  runtime_options.allow_missing_var_in    = false; /* disable: allow definition and invocation of POUs with no input, output and in_out parameters! */
+  runtime_options.disable_implicit_en_eno = false; /* disable: do not generate EN and ENO parameters */
+  runtime_options.pre_parsing             = false; /* disable: allow use of forward references (scan declarations before the parsing phase that builds the AST) */
+  runtime_options.safe_extensions         = false; /* disable: allow use of SAFExxx datatypes */
+  runtime_options.full_token_loc          = false; /* disable: error messages specify full token location */
+  runtime_options.conversion_functions    = false; /* disable: create a conversion function for derived datatype */
+  runtime_options.nested_comments         = false; /* disable: Allow the use of nested comments. */
+  runtime_options.ref_standard_extensions = false; /* disable: Allow the use of REFerences (keywords REF_TO, REF, DREF, ^, NULL). */
+  runtime_options.ref_nonstand_extensions = false; /* disable: Allow the use of non-standard extensions to REF_TO datatypes: REF_TO ANY, and REF_TO in struct elements! */
+  runtime_options.nonliteral_in_array_size= false; /* disable: Allow the use of constant non-literals when specifying size of arrays (ARRAY [1..max] OF INT) */
+  runtime_options.includedir              = NULL;  /* Include directory, where included files will be searched for... */
+  runtime_options.library_cache           = NULL;  /* Cache file of the parsed standard library... */
+  runtime_options.state_dir               = NULL;  /* Directory with the state of the incremental compilation... */
+
+  /* Default values for the command line options... */
+  runtime_options.relaxed_datatype_model    = false; /* by default use the strict datatype equivalence model */
+  runtime_options.stage3_threads            = 1;     /* by default check one POU at a time */
+  runtime_options.print_stats               = false; /* by default do not print any statistics */
+  runtime_options.profile_file              = NULL;  /* by default do not profile the phases of the compiler */
+  runtime_options.census_file               = NULL;  /* by default do not take a census of the AST */
+  
+  int res = parse_options(argc, argv);
+  if (res != 0)
+    return (res < 0)? EXIT_FAILURE : 0;
+
+  /* Have the compile server do the compilation, if it is running */
+  if (NULL != client_socket) {
+    double latency;
+    int exit_status = compile_server_request(client_socket, argc, argv, &latency);
+    if (exit_status >= 0) {
+      if (runtime_options.print_stats)
+        fprintf(stderr, "Compile server: compilation took %.3f ms\n", latency);
+      return exit_status;
+    }
+    /* the server is not running, so compile the file ourselves */
+  }
+
+  /* Run as a compile server: load the standard library once, and have each request compiled by a forked process */
+  if (NULL != server_socket) {
+    symbol_c *library_root = NULL;
+    if (stage1_2_load_library(&library_root) < 0)
+      return EXIT_FAILURE;
+    if ((NULL != library_root) && (library_root->is<library_c>())) {
+      absyntax_utils_init(library_root);
+      library_element_count = library_root->as<library_c>()->n;
+    }
+    compile_server_run(server_socket, compile_request);
+    return EXIT_FAILURE;
+  }
+
+  return compile(argv[optind]);
+}
@@ -43,7 +43,7 @@ typedef struct {
 	bool allow_void_datatype;      /* Allow declaration of functions returning VOID  */
 	bool allow_missing_var_in;     /* Allow definition and invocation of POUs with no input, output and in_out parameters! */
 	bool disable_implicit_en_eno;  /* Disable the generation of implicit EN and ENO parameters on functions and Function Blocks */
-	bool pre_parsing;              /* Support forward references (Run a pre-parsing phase before the defintive parsing phase that builds the AST) */
+	bool pre_parsing;              /* Support forward references (Scan the declarations of POUs and datatypes before the parsing phase that builds the AST) */
 	bool safe_extensions;          /* support SAFE_* datatypes defined in PLCOpen TC5 "Safety Software Technical Specification - Part 1" v1.0 */
 	bool full_token_loc;           /* error messages specify full token location */
 	bool conversion_functions;     /* Create a conversion function for derived datatype */
@@ -52,9 +52,17 @@ typedef struct {
 	bool ref_nonstand_extensions;  /* Allow the use of non-standard extensions to REF_TO datatypes: REF_TO ANY, and REF_TO in struct elements! */
 	bool nonliteral_in_array_size; /* Allow the use of constant non-literals when specifying size of arrays (ARRAY [1..max] OF INT) */
 	const char *includedir;        /* Include directory, where included files will be searched for... */
+	const char *library_cache;     /* Cache file of the parsed standard library (NULL if the cache is not used) */
+	const char *state_dir;         /* Directory with the state of the incremental compilation (NULL if not compiling incrementally) */
 	
    /* options specific to stage3 */
 	bool relaxed_datatype_model;   /* Use the relaxed datatype equivalence model, instead of the default strict equivalence model */
+	int  stage3_threads;           /* Number of threads used to check the POUs concurrently (1 -> check one POU at a time) */
+
+   /* options used by all stages */
+	bool print_stats;              /* Print statistics on the caches of the type searches (search_base_type_c, ...) after each stage */
+	const char *profile_file;      /* File to which the time spent in each phase of the compiler is reported (NULL if not profiling) */
+	const char *census_file;       /* File to which the census of the memory used by the AST is written (NULL if no census) */
 } runtime_options_t;
 
 extern runtime_options_t runtime_options;
@@ -126,6 +126,23 @@ void *create_enumtype_conversion_functions_c::visit(enumerated_value_list_c *sym
     return NULL;
 }
 
+/*
+ * get_function_names function lists the names of the conversion functions generated for
+ * the enumerated datatype enumerateName, in the same order they are generated by the
+ * enumerated_type_declaration_c visitor above.
+ * Used to declare these functions before the source code is parsed (i.e. forward references).
+ */
+void create_enumtype_conversion_functions_c::get_function_names(const std::string &enumerateName, std::list <std::string> &functionNames) {
+    functionNames.push_back("STRING_TO_" + enumerateName);
+    functionNames.push_back(enumerateName + "_TO_STRING");
+    for (size_t s = 8; s <= 64; s*= 2) {
+        functionNames.push_back(getIntegerName(true , s) + "_TO_" + enumerateName);
+        functionNames.push_back(enumerateName + "_TO_" + getIntegerName(true , s));
+        functionNames.push_back(getIntegerName(false, s) + "_TO_" + enumerateName);
+        functionNames.push_back(enumerateName + "_TO_" + getIntegerName(false, s));
+    }
+}
+
 /*
  * getIntegerName function generate a integer data name from signed and size.
  */
@@ -54,6 +54,8 @@ class create_enumtype_conversion_functions_c: public iterator_visitor_c {
     explicit create_enumtype_conversion_functions_c(symbol_c *ignore);
     virtual ~create_enumtype_conversion_functions_c(void);
     static std::string &get_declaration(symbol_c *symbol);
+    /* the names of the conversion functions that get_declaration() creates for the enumerated datatype enumerateName */
+    static void get_function_names(const std::string &enumerateName, std::list <std::string> &functionNames);
 
     void *visit(                 identifier_c *symbol);
     void *visit(         poutype_identifier_c *symbol);
@@ -72,7 +74,7 @@ class create_enumtype_conversion_functions_c: public iterator_visitor_c {
     std::string text;
     std::string currentToken;
     std::list <std::string> currentTokenList;
-    std::string getIntegerName(bool isSigned, size_t size);
+    static std::string getIntegerName(bool isSigned, size_t size);
     void printStringToEnum  (std::string &enumerateName, std::list <std::string> &enumerateValues);
     void printEnumToString  (std::string &enumerateName, std::list <std::string> &enumerateValues);
     void printIntegerToEnum (std::string &enumerateName, std::list <std::string> &enumerateValues, bool isSigned, size_t size);
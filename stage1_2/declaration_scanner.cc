@@ -0,0 +1,345 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * A lightweight scanner of the declarations of library elements (see declaration_scanner.hh).
+ *
+ * The scanner understands just enough of the syntax to find the declarations:
+ *   - whitespace, comments (nested, if the -n option is on), pragmas, and string literals are skipped;
+ *   - FUNCTION, FUNCTION_BLOCK, PROGRAM and CONFIGURATION are followed by the name
+ *     of the POU, and everything else up to the matching END_xxx is ignored;
+ *   - TYPE ... END_TYPE contains a list of '<name> : <specification> ;', where the first
+ *     token(s) of the specification determine the kind of datatype being declared;
+ *   - the {#include "<filename>"} pragma is followed (only outside POUs, just like flex does).
+ *
+ * Datatypes declared as an alias of another datatype (e.g. 'my_int_t: other_int_t;') take on
+ * the kind of the other datatype, which must have been declared before (as was already the case
+ * with the previous two pass parsing).
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>  /* required for strncasecmp() */
+#include <string>
+#include <list>
+
+/* file with declaration of absyntax classes... */
+#include "../absyntax/absyntax.hh"
+
+#include "../main.hh"
+#include "iec_bison.hh"
+#include "stage1_2_priv.hh"
+#include "create_enumtype_conversion_functions.hh"
+#include "declaration_scanner.hh"
+
+
+/* The same limit used by flex */
+#define MAX_INCLUDE_DEPTH 16
+
+extern const char *INCLUDE_DIRECTORIES[];
+
+
+
+/* The elementary datatypes. Any of these may be used in a simple type declaration, and
+ * the integer types may also be used in a subrange type declaration.
+ */
+static const char *elementary_type_names[] = {
+  "BOOL", "SINT", "INT", "DINT", "LINT", "USINT", "UINT", "UDINT", "ULINT", "REAL", "LREAL",
+  "TIME", "DATE", "TIME_OF_DAY", "TOD", "DATE_AND_TIME", "DT", "BYTE", "WORD", "DWORD", "LWORD",
+  "STRING", "WSTRING",
+  "SAFEBOOL", "SAFESINT", "SAFEINT", "SAFEDINT", "SAFELINT", "SAFEUSINT", "SAFEUINT", "SAFEUDINT", "SAFEULINT",
+  "SAFEREAL", "SAFELREAL", "SAFETIME", "SAFEDATE", "SAFETIME_OF_DAY", "SAFETOD", "SAFEDATE_AND_TIME", "SAFEDT",
+  "SAFEBYTE", "SAFEWORD", "SAFEDWORD", "SAFELWORD", "SAFESTRING", "SAFEWSTRING",
+  NULL /* end of array marker! Do not remove! */
+};
+
+
+
+
+class declaration_scanner_c {
+  private:
+    /* the source code being scanned */
+    const char *next;
+    const char *end;
+    /* the current token. Words (identifiers and keywords) have len > 0. Any other character has len == 0. */
+    const char *token;
+    int         len;
+    int         include_depth;
+
+  public:
+    declaration_scanner_c(const char *buf, const char *buf_end, int depth) {
+      next = buf; end = buf_end; token = buf; len = 0; include_depth = depth;
+    }
+
+    void scan(void) {
+      get_token(true);
+      while (!at_eof()) {
+             if (is_word("TYPE"))                       scan_type_declarations();
+        else if (is_word("FUNCTION"))                   scan_pou("END_FUNCTION"      , prev_declared_derived_function_name_token);
+        else if (is_word("FUNCTION_BLOCK"))             scan_pou("END_FUNCTION_BLOCK", prev_declared_derived_function_block_name_token);
+        else if (is_word("PROGRAM"))                    scan_pou("END_PROGRAM"       , prev_declared_program_type_name_token);
+        else if (is_word("CONFIGURATION"))              scan_pou("END_CONFIGURATION" , prev_declared_configuration_name_token);
+        else get_token(true);
+      }
+    }
+
+
+  private:
+    bool at_eof(void)                   {return (token >= end);}
+    bool is_char(char c)                {return (len == 0) && !at_eof() && (*token == c);}
+    bool is_word(const char *keyword)   {return (len > 0) && ((int)strlen(keyword) == len) && (strncasecmp(token, keyword, len) == 0);}
+    std::string word(void)              {return std::string(token, len);}
+
+    static bool is_word_start(char c)   {return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || (c == '_');}
+    static bool is_word_char (char c)   {return is_word_start(c) || ((c >= '0') && (c <= '9'));}
+    static bool is_space     (char c)   {return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') || (c == '\f') || (c == '\v');}
+
+
+    /* Skip a comment, starting at the "(*" */
+    void skip_comment(void) {
+      int depth = 0;
+      while (next < end) {
+        if ((next + 1 < end) && (next[0] == '(') && (next[1] == '*')) {
+          if ((depth == 0) || runtime_options.nested_comments) depth++;
+          next += 2;
+        } else if ((next + 1 < end) && (next[0] == '*') && (next[1] == ')')) {
+          next += 2;
+          if (--depth == 0) return;
+        } else
+          next++;
+      }
+    }
+
+    /* Skip a pragma, starting at the "{". Pragmas starting with "{{" only end with "}}" */
+    void skip_pragma(void) {
+      bool double_brace = (next + 1 < end) && (next[1] == '{');
+      for (next++; next < end; next++) {
+        if ((*next == '}') && (!double_brace || ((next + 1 < end) && (next[1] == '}')))) {
+          next += double_brace? 2 : 1;
+          return;
+        }
+      }
+    }
+
+    /* Skip a string literal, starting at the opening quote. The '$' is the escape character. */
+    void skip_string(void) {
+      char quote = *next;
+      for (next++; next < end; next++) {
+        if (*next == '$') {next++; continue;}
+        if (*next == quote) {next++; return;}
+      }
+    }
+
+    /* Handle the {#include "<filename>"} pragma, starting at the "{".
+     * Returns false if this is not an include pragma.
+     */
+    bool include_pragma(void) {
+      static const char include_beg[] = "{#include";
+      const char *ptr = next + strlen(include_beg);
+      if ((ptr >= end) || (strncmp(next, include_beg, strlen(include_beg)) != 0)) return false;
+      while ((ptr < end) && is_space(*ptr)) ptr++;
+      if ((ptr >= end) || (*ptr != '"')) return false;
+      const char *name_beg = ++ptr;
+      while ((ptr < end) && (*ptr != '"')) ptr++;
+      if (ptr >= end) return false;
+      std::string filename(name_beg, ptr - name_beg);
+      skip_pragma();
+
+      /* Errors are ignored: flex will report them when parsing the file */
+      if (include_depth >= MAX_INCLUDE_DEPTH) return true;
+      for (int i = 0; INCLUDE_DIRECTORIES[i] != NULL; i++) {
+        std::string full_name = std::string(INCLUDE_DIRECTORIES[i]) + "/" + filename;
+        if (scan_file(full_name.c_str(), include_depth + 1) == 0) break;
+      }
+      return true;
+    }
+
+    /* Get the next token. */
+    /* If include_pragmas is true, any {#include ...} pragma will be scanned too. */
+    void get_token(bool include_pragmas = false) {
+      while (next < end) {
+        char c = *next;
+        if (is_space(c))                                        {next++;         continue;}
+        if ((c == '(') && (next + 1 < end) && (next[1] == '*')) {skip_comment(); continue;}
+        if (c == '{') {
+          if (!include_pragmas || !include_pragma()) skip_pragma();
+          continue;
+        }
+        if ((c == '\'') || (c == '"'))                          {skip_string();  continue;}
+
+        token = next;
+        if (is_word_start(c)) {
+          while ((next < end) && is_word_char(*next)) next++;
+          len = next - token;
+        } else if ((c >= '0') && (c <= '9')) {
+          /* numbers are returned as a single non-word token (including the '#' of based literals, '.', etc.) */
+          while ((next < end) && (is_word_char(*next) || (*next == '#') || (*next == '.'))) next++;
+          len = 0;
+        } else {
+          next++;
+          len = 0;
+        }
+        return;
+      }
+      token = end; len = 0;
+    }
+
+    /* Skip all tokens up to and including the token keyword */
+    void skip_to(const char *keyword) {
+      while (!at_eof() && !is_word(keyword)) get_token();
+      get_token(true);
+    }
+
+
+    /* Insert the name into the library_element_symtable.
+     * Names that are already in the symtable are left untouched. If they have been declared twice,
+     * with a different kind of library element, bison will report the error when parsing the source code.
+     */
+    void declare(const std::string &name, int token_id) {
+      if (library_element_symtable.find(name.c_str()) == library_element_symtable.end())
+        library_element_symtable.insert(name.c_str(), token_id);
+    }
+
+
+    /* FUNCTION <name> ... END_FUNCTION, and the other POUs */
+    void scan_pou(const char *end_keyword, int token_id) {
+      get_token();
+      if (len > 0) declare(word(), token_id);
+      skip_to(end_keyword);
+    }
+
+
+    /* TYPE <name> : <specification> ; ... END_TYPE */
+    void scan_type_declarations(void) {
+      get_token();
+      while (!at_eof() && !is_word("END_TYPE")) {
+        if (len == 0) {get_token(); continue;}  /* syntax error! */
+        std::string name = word();
+        get_token();
+        if (!is_char(':')) continue;            /* syntax error! */
+        get_token();
+
+        int token_id = datatype_kind();
+        if (token_id != 0) {
+          declare(name, token_id);
+          if ((token_id == prev_declared_enumerated_type_name_token) && runtime_options.conversion_functions)
+            declare_conversion_functions(name);
+        }
+
+        /* skip the remaining specification (which, for structures, may contain ';' between STRUCT .. END_STRUCT) */
+        int struct_depth = 0;
+        while (!at_eof() && !(is_char(';') && (struct_depth == 0)) && !is_word("END_TYPE")) {
+          if (is_word("STRUCT"))     struct_depth++;
+          if (is_word("END_STRUCT")) struct_depth--;
+          get_token();
+        }
+        if (is_char(';')) get_token();
+      }
+      get_token(true);
+    }
+
+
+    /* Determine the kind of datatype being declared, from the first token(s) of its specification.
+     * Returns the token id to be stored in the library_element_symtable, or 0 if unknown.
+     */
+    int datatype_kind(void) {
+      if (is_char('('))       return prev_declared_enumerated_type_name_token;
+      if (len == 0)           return 0;
+      if (is_word("ARRAY"))   return prev_declared_array_type_name_token;
+      if (is_word("STRUCT"))  return prev_declared_structure_type_name_token;
+      if (is_word("REF_TO"))  return prev_declared_ref_type_name_token;
+
+      /* alias of a previously declared datatype? */
+      library_element_symtable_t::iterator iter = library_element_symtable.find(word().c_str());
+      if (iter != library_element_symtable.end()) {
+        switch (iter->second) {
+          case prev_declared_simple_type_name_token:
+          case prev_declared_subrange_type_name_token:
+          case prev_declared_enumerated_type_name_token:
+          case prev_declared_array_type_name_token:
+          case prev_declared_structure_type_name_token:
+          case prev_declared_string_type_name_token:
+          case prev_declared_ref_type_name_token:
+            return iter->second;
+          default:
+            return 0;
+        }
+      }
+
+      for (int i = 0; elementary_type_names[i] != NULL; i++) {
+        if (is_word(elementary_type_names[i])) {
+          bool is_string = is_word("STRING") || is_word("WSTRING");
+          get_token();
+          if (is_char('[') && is_string) return prev_declared_string_type_name_token;
+          if (is_char('('))              return prev_declared_subrange_type_name_token;
+          return prev_declared_simple_type_name_token;
+        }
+      }
+      return 0;
+    }
+
+
+    /* The conversion functions that bison will create for this enumerated datatype (-c option) */
+    void declare_conversion_functions(const std::string &enumerated_type_name) {
+      std::list <std::string> function_names;
+      create_enumtype_conversion_functions_c::get_function_names(enumerated_type_name, function_names);
+      for (std::list <std::string>::iterator iter = function_names.begin(); iter != function_names.end(); ++iter)
+        declare(*iter, prev_declared_derived_function_name_token);
+    }
+
+
+  public:
+    static int scan_file(const char *filename, int include_depth) {
+      FILE *file = fopen(filename, "rb");
+      if (NULL == file) return -1;
+
+      std::string buf;
+      char block[65536];
+      size_t n;
+      while ((n = fread(block, 1, sizeof(block), file)) > 0)
+        buf.append(block, n);
+      fclose(file);
+
+      declaration_scanner_c scanner(buf.data(), buf.data() + buf.size(), include_depth);
+      scanner.scan();
+      return 0;
+    }
+};
+
+
+
+
+int scan_declarations(const char *filename) {
+  return declaration_scanner_c::scan_file(filename, 0);
+}
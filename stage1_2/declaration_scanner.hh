@@ -0,0 +1,60 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * A lightweight scanner of the declarations of library elements, used to support
+ * forward references (-p command line option).
+ *
+ * The scanner reads the source code (and any file included with the {#include "..."}
+ * pragma), and inserts into the library_element_symtable the names of all the
+ * POUs (Functions, FBs, Programs and Configurations) and derived datatypes declared
+ * in that source code. Since it does not use flex nor bison, it neither builds an
+ * AST nor allocates the token strings, and only looks at the few tokens needed to
+ * find each declared name (and, for datatypes, the kind of datatype being declared).
+ *
+ * Once the scan is complete, the source code may be parsed normally, and
+ * the POUs and datatypes may then be referenced before they are declared.
+ */
+
+
+#ifndef _DECLARATION_SCANNER_HH
+#define _DECLARATION_SCANNER_HH
+
+
+/* Scan the file, and insert the declared library elements into the library_element_symtable.
+ * Returns 0 on success, or -1 on error opening the file (and a valid errno).
+ * NOTE: syntax errors are silently ignored. They will be reported when the file is parsed by bison.
+ */
+int scan_declarations(const char *filename);
+
+
+#endif   /* _DECLARATION_SCANNER_HH */
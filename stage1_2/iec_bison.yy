@@ -101,8 +101,11 @@ void yyerror (const char *error_msg);
 /* The interface through which bison and flex interact. */
 #include "stage1_2_priv.hh"
 #include "create_enumtype_conversion_functions.hh"
+#include "library_cache.hh"
+#include "declaration_scanner.hh"
 
 #include "../absyntax_utils/add_en_eno_param_decl.hh"	/* required for  add_en_eno_param_decl_c */
+#include "../absyntax_utils/phase_profiler.hh"	/* required for  profile_phase_c */
 
 /* an ugly hack!!
  * We will probably not need it when we decide
@@ -286,7 +289,7 @@ typedef struct YYLTYPE {
 %union {
     symbol_c 	*leaf;
     list_c	*list;
-    char 	*ID;	/* token value */
+    const char *ID;	/* token value (interned, see strpool.hh) */
 }
 
 /*
@@ -8748,37 +8751,72 @@ NULL
 extern const char *INCLUDE_DIRECTORIES[];
 
 
-static int parse_files(const char *libfilename, const char *filename) {
+/* Set once the standard library has been parsed (see stage1_2_load_library()),
+ * along with the file and the options with which it was parsed.
+ */
+static bool        library_loaded = false;
+static std::string loaded_libfilename;
+static uint64_t    loaded_library_options;
+
+static int parse_library__(const char *libfilename);
+
+/* The AST of the standard library is allocated from an arena of its own, since it outlives the AST of
+ * the input file, which is released at the end of each compilation (see compile() in main.cc).
+ * NOTE: This arena is never released, as the library is needed until the very end.
+ */
+static int parse_library(const char *libfilename) {
+  static arena_c *library_arena = new arena_c();
+  arena_c *prev_arena = arena_c::set_current(library_arena);
+  int res = parse_library__(libfilename);
+  arena_c::set_current(prev_arena);
+  return res;
+}
+
+
+static int parse_library__(const char *libfilename) {
   /* first parse the standard library file... */  
   /*   Do not debug the standard library, even if debug flag is set!
   #if YYDEBUG
     yydebug = 1;
   #endif
   */
-  FILE *libfile = NULL;
-  if((libfile = parse_file(libfilename)) == NULL) {
-    char *errmsg = strdup2("Error opening library file ", libfilename);
-    perror(errmsg);
-    free(errmsg);
-    /* we give up... */
-    return -1;
-  }
-
-  allow_function_overloading           = true;
-  allow_extensible_function_parameters = true;
-  allow_ref_dereferencing              = runtime_options.ref_standard_extensions;
-  allow_ref_to_any                     = runtime_options.ref_nonstand_extensions;
-  allow_ref_to_in_derived_datatypes    = runtime_options.ref_nonstand_extensions;
-  if (yyparse() != 0) {
-    fprintf (stderr, "\nParsing failed because of too many consecutive syntax errors in standard library. Bailing out!\n");
-    exit(EXIT_FAILURE);
-  }
-  fclose(libfile);
+  /* If a cache of the standard library is available, use it instead of parsing the library.
+   * During the pre-parsing we only need the library_element_symtable, so the AST is not even loaded.
+   */
+  const char *cache_filename = runtime_options.library_cache;
+  if ((cache_filename == NULL) || (library_cache_load(cache_filename, libfilename, get_preparse_state()? NULL : &tree_root) < 0)) {
+    FILE *libfile = NULL;
+    if((libfile = parse_file(libfilename)) == NULL) {
+      char *errmsg = strdup2("Error opening library file ", libfilename);
+      perror(errmsg);
+      free(errmsg);
+      /* we give up... */
+      return -1;
+    }
+
+    allow_function_overloading           = true;
+    allow_extensible_function_parameters = true;
+    allow_ref_dereferencing              = runtime_options.ref_standard_extensions;
+    allow_ref_to_any                     = runtime_options.ref_nonstand_extensions;
+    allow_ref_to_in_derived_datatypes    = runtime_options.ref_nonstand_extensions;
+    library_cache_start_recording();
+    if (yyparse() != 0) {
+      fprintf (stderr, "\nParsing failed because of too many consecutive syntax errors in standard library. Bailing out!\n");
+      exit(EXIT_FAILURE);
+    }
+    library_cache_stop_recording();
+    fclose(libfile);
       
-  if (yynerrs > 0) {  /* NOTE: yynerrs is a global variable */
-    /* Hopefully the libraries do not contain any errors, so this should not occur! */
-    fprintf (stderr, "\n%d error(s) found in %s. Bailing out!\n", yynerrs, libfilename);
-    return -2;
+    if (yynerrs > 0) {  /* NOTE: yynerrs is a global variable */
+      /* Hopefully the libraries do not contain any errors, so this should not occur! */
+      fprintf (stderr, "\n%d error(s) found in %s. Bailing out!\n", yynerrs, libfilename);
+      return -2;
+    }
+
+    /* The AST produced during the pre-parsing is incomplete, so it must never be stored in the cache! */
+    if ((cache_filename != NULL) && !get_preparse_state())
+      if (library_cache_save(cache_filename, libfilename, tree_root) < 0)
+        fprintf (stderr, "Warning: could not write the standard library cache file %s\n", cache_filename);
   }
 
   /* if by any chance the library is not complete, we now add the missing reserved keywords to the list!!!  */
@@ -8787,6 +8825,37 @@ static int parse_files(const char *libfilename, const char *filename) {
         library_element_symtable.end())
       library_element_symtable.insert(standard_function_block_names[i], standard_function_block_name_token);
 
+  library_loaded         = true;
+  loaded_libfilename     = libfilename;
+  loaded_library_options = library_cache_options();
+  return 0;
+}
+
+
+static int parse_files(const char *libfilename, const char *filename) {
+  /* the standard library may already have been parsed by stage1_2_load_library() */
+  if (!library_loaded) {
+    profile_phase_c phase("library_parse");
+    int res = parse_library(libfilename);
+    if (res < 0) return res;
+  } else if ((loaded_libfilename != libfilename) || (loaded_library_options != library_cache_options())) {
+    fprintf (stderr, "The standard library already loaded (%s) was not parsed with the same include directory (-I) and command line options (-b, -i, -e, -s, -c, -n, -r, -R, -a) as %s. Bailing out!\n",
+             loaded_libfilename.c_str(), filename);
+    return -4;
+  }
+
+  profile_phase_c phase("user_parse");
+
+  /* support forward references: insert all the POUs and derived datatypes declared in the input file
+   * into the library_element_symtable, before parsing it...
+   */
+  if (runtime_options.pre_parsing && (scan_declarations(filename) < 0)) {
+    char *errmsg = strdup2("Error opening main file ", filename);
+    perror(errmsg);
+    free(errmsg);
+    return -3;
+  }
+
   /* now parse the input file... */
   #if YYDEBUG
     yydebug = 1;
@@ -8824,41 +8893,32 @@ static int parse_files(const char *libfilename, const char *filename) {
 
 
 
-/* We parse the input source code twice!!
- *  1st pass -->  Pre-parsing
- *  -------------------------
- *  The intention of the first pass is to fill up the library_element_symtable with the names of all
- *  the POUs (Functions, FBs, Programs and Configurations), as well as all the Derived Datatypes.
- * 
- *  During this pass POUs are only parsed until their name is obtained, and the remaining source
- *  code (variable declarations and body) is completely thrown away by flex. Datatype declarations
- *  however are parsed normally!
+/* Support for forward references (-p command line option)
+ * ---------------------------------------------------------
+ *  Before parsing the input file, its declarations are scanned (see declaration_scanner.hh)
+ *  to fill up the library_element_symtable with the names of all the POUs (Functions, FBs,
+ *  Programs and Configurations), as well as all the Derived Datatypes.
  *
- *  At the end of the pre-parsing, the AST will contain only the derived datatype declarations,
- *  and this tree will be trown away (by simply resetting tree_root = NULL).
- *  More importantly, the library_element_symtable will contain the names of all the POUs and 
- *  derived datatypes.
+ *  The scan does not use flex nor bison, and does not build any AST. The source code
+ *  is then parsed only once, and the AST is generated completely.
  *
- *  2st pass -->  Normal parsing
- *  ----------------------------
- *  In this second parse the whole source code is parsed correctly, and the AST is generated
- *  completely.
- *
- *  However, if the pre-parsing has been done before this normal parsing, the POUs may appear
- *  in the source code in any order, as calling a POU (e.g. calling a function) that has not yet
- *  been declared will no longer generate a parsing error because the name of the function being 
- *  called is already in the library_element_symtable.
+ *  Since the names of the POUs and datatypes are already in the library_element_symtable,
+ *  the POUs may appear in the source code in any order, as calling a POU (e.g. calling a function)
+ *  that has not yet been declared will no longer generate a parsing error.
  *
  *  Declaring variables of datatypes that have not yet been declared will also be possible, as the
  *  datatypes will also already be in the library_element_symtable!
+ *
+ *  NOTE: Previously, the whole source code (including the standard library) was parsed twice,
+ *        the first time in the 'preparse' state (see set_preparse_state()), in which POU bodies and 
+ *        var declarations are ignored by flex. The preparse state is no longer used by stage2__(),
+ *        but the rules handling it in flex and bison were kept.
  */
 
-int stage2__(const char *filename, 
-             symbol_c **tree_root_ref
-            ) {             
+/* Determine the full path name of the standard library file... */
+static char *get_libfilename(void) {
   char *libfilename = NULL;
 
-  /* Determine the full path name of the standard library file... */
   if (runtime_options.includedir != NULL)
     INCLUDE_DIRECTORIES[0] = runtime_options.includedir;
 
@@ -8866,24 +8926,24 @@ int stage2__(const char *filename,
     fprintf (stderr, "Out of memory. Bailing out!\n");
     exit(EXIT_FAILURE);
   }
+  return libfilename;
+}
+
+
+int stage2__(const char *filename, 
+             symbol_c **tree_root_ref
+            ) {             
+  char *libfilename = get_libfilename();
 
-  /*******************************/
-  /* Do the  PRE parsing run...! */
-  /*******************************/
-  if (runtime_options.pre_parsing) {
-    // fprintf (stderr, "----> Starting pre-parsing!\n");
-    tree_root = NULL;
-    set_preparse_state();
-    if (parse_files(libfilename, filename) < 0)
-      exit(EXIT_FAILURE);
-    // TODO: delete the current AST. For the moment, we leave all the objects in memory (not much of an issue in a program that always runs to completion).
-  }
   /*******************************/
   /* Do the main parsing run...! */
   /*******************************/
   // fprintf (stderr, "----> Starting normal parsing!\n");
-  tree_root = NULL;
-  rst_preparse_state();
+  if (!library_loaded) {
+    /* (otherwise the elements of the input file are added to the library_c of the standard library already loaded) */
+    tree_root = NULL;
+    rst_preparse_state();
+  }
   if (parse_files(libfilename, filename) < 0)
     exit(EXIT_FAILURE);
   
@@ -8897,15 +8957,21 @@ int stage2__(const char *filename,
 }
 
 
+/* Parse only the standard library, so that the following call to stage2__() only needs to parse the input file.
+ * Used by the compile server (see compile_server.hh), which parses the standard library once, and then forks
+ * a process to compile each of the files it is asked to compile.
+ */
+int stage2__load_library(symbol_c **tree_root_ref) {
+  char *libfilename = get_libfilename();
+  int   res         = 0;
 
-
-
-
-
-
-
-
-
-
-
-
+  if (!library_loaded) {
+    tree_root = NULL;
+    rst_preparse_state();
+    res = parse_library(libfilename);
+  }
+  free(libfilename);
+  if (tree_root_ref != NULL)
+    *tree_root_ref = tree_root;
+  return res;
+}
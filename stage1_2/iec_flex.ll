@@ -166,8 +166,12 @@ const char *current_filename = NULL;
 /*
  *extern YYLTYPE yylloc;
 b*/
+/* Flex is handed whole blocks of the input file (up to max_size bytes, i.e. YY_BUF_SIZE)
+ * at a time. Line and column tracking is unaffected, as it is done on the text of each
+ * matched token (in UpdateTracking()), and not on the characters as they are read.
+ */
 #define YY_INPUT(buf,result,max_size)  {\
-    result = GetNextChar(buf, max_size);\
+    result = GetNextBlock(buf, max_size);\
     if (  result <= 0  )\
       result = YY_NULL;\
     }
@@ -250,7 +254,7 @@ int  isempty_bodystate_buffer(void);
 void     del_bodystate_buffer(void);
 
 
-int GetNextChar(char *b, int maxBuffer);
+int GetNextBlock(char *b, int maxBuffer);
 %}
 
 
@@ -1106,7 +1110,7 @@ CONFIGURATION{st_whitespace}		if (get_preparse_state()) BEGIN(get_pou_name_state
 }
 
 <get_pou_name_state>{
-{identifier}			BEGIN(ignore_pou_state); yylval.ID=strdup(yytext); return identifier_token;
+{identifier}			BEGIN(ignore_pou_state); yylval.ID=strpool_c::intern(yytext); return identifier_token;
 .				BEGIN(ignore_pou_state); unput_text(0);
 }
 
@@ -1357,7 +1361,7 @@ END_CONFIGURATION	BEGIN(INITIAL); return END_CONFIGURATION;
                   *       'MOD' et al must be removed from the 
                   *       library_symbol_table as a default function name!
 		  * //
-		   yylval.ID=strdup(yytext);
+		   yylval.ID=strpool_c::intern(yytext);
 		   // fprintf(stderr, "returning token %d\n", token); 
 		   return token;
 		 }
@@ -1854,33 +1858,33 @@ CONTINUE    return CONTINUE;    /* Keyword */
 	/********************************************/
 	/* B.1.4.1   Directly Represented Variables */
 	/********************************************/
-{direct_variable}   {yylval.ID=strdup(yytext); return get_direct_variable_token(yytext);}
+{direct_variable}   {yylval.ID=strpool_c::intern(yytext); return get_direct_variable_token(yytext);}
 
 
 	/******************************************/
 	/* B 1.4.3 - Declaration & Initialisation */
 	/******************************************/
-{incompl_location}	{yylval.ID=strdup(yytext); return incompl_location_token;}
+{incompl_location}	{yylval.ID=strpool_c::intern(yytext); return incompl_location_token;}
 
 
 	/************************/
 	/* B 1.2.3.1 - Duration */
 	/************************/
-{fixed_point}		{yylval.ID=strdup(yytext); return fixed_point_token;}
+{fixed_point}		{yylval.ID=strpool_c::intern(yytext); return fixed_point_token;}
 {interval}		{/*fprintf(stderr, "entering time_literal_state ##%s##\n", yytext);*/ unput_and_mark('#'); yy_push_state(time_literal_state);}
 {erroneous_interval}	{return erroneous_interval_token;}
 
 <time_literal_state>{
-{integer}d		{yylval.ID=strdup(yytext); yylval.ID[yyleng-1] = '\0'; return integer_d_token;}
-{integer}h		{yylval.ID=strdup(yytext); yylval.ID[yyleng-1] = '\0'; return integer_h_token;}
-{integer}m		{yylval.ID=strdup(yytext); yylval.ID[yyleng-1] = '\0'; return integer_m_token;}
-{integer}s		{yylval.ID=strdup(yytext); yylval.ID[yyleng-1] = '\0'; return integer_s_token;}
-{integer}ms		{yylval.ID=strdup(yytext); yylval.ID[yyleng-2] = '\0'; return integer_ms_token;}
-{fixed_point}d		{yylval.ID=strdup(yytext); yylval.ID[yyleng-1] = '\0'; return fixed_point_d_token;}
-{fixed_point}h		{yylval.ID=strdup(yytext); yylval.ID[yyleng-1] = '\0'; return fixed_point_h_token;}
-{fixed_point}m		{yylval.ID=strdup(yytext); yylval.ID[yyleng-1] = '\0'; return fixed_point_m_token;}
-{fixed_point}s		{yylval.ID=strdup(yytext); yylval.ID[yyleng-1] = '\0'; return fixed_point_s_token;}
-{fixed_point}ms		{yylval.ID=strdup(yytext); yylval.ID[yyleng-2] = '\0'; return fixed_point_ms_token;}
+{integer}d		{yylval.ID=strpool_c::intern(yytext, yyleng-1); return integer_d_token;}
+{integer}h		{yylval.ID=strpool_c::intern(yytext, yyleng-1); return integer_h_token;}
+{integer}m		{yylval.ID=strpool_c::intern(yytext, yyleng-1); return integer_m_token;}
+{integer}s		{yylval.ID=strpool_c::intern(yytext, yyleng-1); return integer_s_token;}
+{integer}ms		{yylval.ID=strpool_c::intern(yytext, yyleng-2); return integer_ms_token;}
+{fixed_point}d		{yylval.ID=strpool_c::intern(yytext, yyleng-1); return fixed_point_d_token;}
+{fixed_point}h		{yylval.ID=strpool_c::intern(yytext, yyleng-1); return fixed_point_h_token;}
+{fixed_point}m		{yylval.ID=strpool_c::intern(yytext, yyleng-1); return fixed_point_m_token;}
+{fixed_point}s		{yylval.ID=strpool_c::intern(yytext, yyleng-1); return fixed_point_s_token;}
+{fixed_point}ms		{yylval.ID=strpool_c::intern(yytext, yyleng-2); return fixed_point_ms_token;}
 
 _			/* do nothing - eat it up!*/
 \#			{/*fprintf(stderr, "popping from time_literal_state (###)\n");*/ yy_pop_state(); return end_interval_token;}
@@ -1890,26 +1894,26 @@ _			/* do nothing - eat it up!*/
 	/*******************************/
 	/* B.1.2.2   Character Strings */
 	/*******************************/
-{double_byte_character_string} {yylval.ID=strdup(yytext); return double_byte_character_string_token;}
-{single_byte_character_string} {yylval.ID=strdup(yytext); return single_byte_character_string_token;}
+{double_byte_character_string} {yylval.ID=strpool_c::intern(yytext); return double_byte_character_string_token;}
+{single_byte_character_string} {yylval.ID=strpool_c::intern(yytext); return single_byte_character_string_token;}
 
 
 	/******************************/
 	/* B.1.2.1   Numeric literals */
 	/******************************/
-{integer}		{yylval.ID=strdup(yytext); return integer_token;}
-{real}			{yylval.ID=strdup(yytext); return real_token;}
-{binary_integer}	{yylval.ID=strdup(yytext); return binary_integer_token;}
-{octal_integer} 	{yylval.ID=strdup(yytext); return octal_integer_token;}
-{hex_integer} 		{yylval.ID=strdup(yytext); return hex_integer_token;}
+{integer}		{yylval.ID=strpool_c::intern(yytext); return integer_token;}
+{real}			{yylval.ID=strpool_c::intern(yytext); return real_token;}
+{binary_integer}	{yylval.ID=strpool_c::intern(yytext); return binary_integer_token;}
+{octal_integer} 	{yylval.ID=strpool_c::intern(yytext); return octal_integer_token;}
+{hex_integer} 		{yylval.ID=strpool_c::intern(yytext); return hex_integer_token;}
 
 
 	/*****************************************/
 	/* B.1.1 Letters, digits and identifiers */
 	/*****************************************/
-<st_state>{identifier}/({st_whitespace_or_pragma_or_comment})"=>"	{yylval.ID=strdup(yytext); return sendto_identifier_token;}
-<il_state>{identifier}/({il_whitespace_or_pragma_or_comment})"=>"	{yylval.ID=strdup(yytext); return sendto_identifier_token;}
-{identifier} 				{yylval.ID=strdup(yytext);
+<st_state>{identifier}/({st_whitespace_or_pragma_or_comment})"=>"	{yylval.ID=strpool_c::intern(yytext); return sendto_identifier_token;}
+<il_state>{identifier}/({il_whitespace_or_pragma_or_comment})"=>"	{yylval.ID=strpool_c::intern(yytext); return sendto_identifier_token;}
+{identifier} 				{yylval.ID=strpool_c::intern(yytext);
 					 // printf("returning identifier...: %s, %d\n", yytext, get_identifier_token(yytext));
 					 return get_identifier_token(yytext);}
 
@@ -1974,13 +1978,30 @@ void UpdateTracking(const char *text) {
 }
 
 
-/* GetNextChar: reads a character from input */
-int GetNextChar(char *b, int maxBuffer) {
-  int res = fgetc(current_tracking->in_file);
-  if ( res == EOF ) 
-    return 0;
-  *b = (char)res;
-  return 1;
+/* GetNextBlock: reads a block of characters from input.
+ * Returns the number of characters read, or 0 on end of file.
+ *
+ * NOTE: We used to read a single character per call (with fgetc()), which meant
+ *       that lexing large files was dominated by the overhead of the stdio calls.
+ *
+ * NOTE: We never fill up more than half of the space flex offers us (maxBuffer).
+ *       The body_state returns all the text of a POU body it has consumed back to flex
+ *       (see unput_bodystate_buffer()), and flex can only push back into the free space
+ *       left in its buffer. Reading a single character at a time left the buffer
+ *       almost empty, so there was always plenty of free space. If we filled up the
+ *       whole buffer we would get a "push-back overflow" on any body that spans two
+ *       consecutive reads. Leaving half of the buffer free keeps the push-back space
+ *       large enough for any reasonable POU body (YY_BUF_SIZE is set in Makefile.am).
+ */
+int GetNextBlock(char *b, int maxBuffer) {
+  int max_read = maxBuffer / 2;
+  if (max_read < 1) max_read = 1;
+  size_t res = fread(b, 1, max_read, current_tracking->in_file);
+  if ((res == 0) && ferror(current_tracking->in_file)) {
+    perror("Error reading input file");
+    exit(EXIT_FAILURE);
+  }
+  return (int)res;
 }
 
 
@@ -2057,6 +2078,7 @@ void include_file(const char *filename) {
       exit( 1 );
     }
     filehandle = fopen(full_name, "r");
+    if (filehandle != NULL) note_input_file(full_name);
     free(full_name);
   }
 
@@ -2240,11 +2262,16 @@ FILE *parse_file(const char *filename) {
     yyin = filehandle;
     current_filename = strdup(filename);
     current_tracking = GetNewTracking(yyin);
+    note_input_file(filename);
   }
   return filehandle;
 }
 
 
+long int get_current_order(void)           {return current_order;}
+void     set_current_order(long int order) {current_order = order;}
+
+
 
 
 
@@ -2255,6 +2282,7 @@ FILE *parse_file(const char *filename) {
 /*************************************/
 #ifdef TEST_MAIN
 
+#include <time.h>
 #include "../util/symtable.hh"
 
 yystype yylval;
@@ -2265,36 +2293,58 @@ YYLTYPE yylloc;
 
 int get_identifier_token(const char *identifier_str) {return 0;}
 int get_direct_variable_token(const char *direct_variable_str) {return 0;}
+void note_input_file(const char *filename) {}
 
 
+/* When called with one or more files, the lexer simply tokenises each file
+ * and reports the lexer throughput (in MB/s), which is useful when benchmarking
+ * the lexical analyser. e.g.:
+ *    ./iec_flex_test AnnexF/pid_st.txt AnnexF/weigh_il.txt big_synthetic_file.st
+ */
 int main(int argc, char **argv) {
 
-  FILE *in_file;
   int res;
 	
   if (argc == 1) {
     /* Work as an interactive (command line) parser... */
+    current_tracking = GetNewTracking(yyin = stdin);
     while((res=yylex()))
       fprintf(stderr, "(line %d)token: %d\n", yylineno, res);
-  } else {
-    /* Work as non-interactive (file) parser... */
-    if((in_file = fopen(argv[1], "r")) == NULL) {
-      char *errmsg = strdup2("Error opening main file ", argv[1]);
+    return 0;
+  }
+
+  /* Work as non-interactive (file) parser... */
+  double total_bytes = 0, total_secs = 0;
+  for (int i = 1; i < argc; i++) {
+    FILE *in_file;
+    long int tokens = 0;
+    
+    if((in_file = parse_file(argv[i])) == NULL) {
+      char *errmsg = strdup2("Error opening main file ", argv[i]);
       perror(errmsg);
       free(errmsg);
       return -1;
     }
+    fseek(in_file, 0, SEEK_END);
+    double bytes = ftell(in_file);
+    rewind(in_file);
+    /* flex keeps the (exhausted) buffer of the previous file, unless told to start reading from the new one */
+    yyrestart(in_file);
 
     /* parse the file... */
-    yyin = in_file;
-    current_filename = argv[1];
-    while(1) {
-      res=yylex();
-      fprintf(stderr, "(line %d)token: %d (%s)\n", yylineno, res, yylval.ID);
-    }
+    clock_t start = clock();
+    while(yylex()) tokens++;
+    double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+    fclose(in_file);
+
+    fprintf(stderr, "%s: %ld tokens, %.0f bytes, %.3f s, %.2f MB/s\n", 
+            argv[i], tokens, bytes, secs, (secs > 0)? bytes / secs / 1e6 : 0);
+    total_bytes += bytes;
+    total_secs  += secs;
   }
+  fprintf(stderr, "total: %.0f bytes, %.3f s, %.2f MB/s\n", 
+          total_bytes, total_secs, (total_secs > 0)? total_bytes / total_secs / 1e6 : 0);
 	
-	return 0;
-
+  return 0;
 }
 #endif
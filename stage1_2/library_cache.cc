@@ -0,0 +1,266 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * A cache of the parsed standard library.
+ *
+ * Layout of the cache file:
+ *   - magic string and version of the cache format
+ *   - identifier of the sources of matiec that determine the contents of the cache (the lexer, the grammar
+ *     and its token ids, the AST classes, the encoding of the AST, ...)
+ *   - command line options that influence the parsing of the library
+ *   - the name, size and hash of every file read while parsing the library
+ *   - the value of flex's token order counter at the end of the library
+ *   - the entries of library_element_symtable
+ *   - the AST of the library (see absyntax_utils/serialize_ast.cc)
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>  /* required for getpid() */
+#include <string>
+#include <vector>
+
+/* file with declaration of absyntax classes... */
+#include "../absyntax/absyntax.hh"
+#include "../absyntax_utils/absyntax_utils.hh"
+
+#include "../main.hh"
+#include "stage1_2.hh"
+#include "iec_bison.hh"
+#include "stage1_2_priv.hh"
+#include "library_cache.hh"
+#include "library_cache_id.h"  /* generated by the Makefile */
+
+
+
+/* Increment whenever the layout of the cache file changes! */
+#define CACHE_FORMAT_VERSION 1
+#define CACHE_MAGIC          "MATIEC-LIBCACHE"
+
+/* The cache is only valid for the sources of matiec that wrote it, since the token ids stored in
+ * library_element_symtable are generated by bison, and the AST produced when parsing the library
+ * (and its encoding) change whenever the lexer, the grammar, or the AST classes are changed.
+ * LIBRARY_CACHE_SOURCES_ID is a checksum of those sources, computed by the Makefile (so it does
+ * not depend on when, or how often, this file was compiled).
+ */
+#define CACHE_BUILD_ID       LIBRARY_CACHE_SOURCES_ID
+
+
+
+/****************************************/
+/* Files the cached library depends on. */
+/****************************************/
+static bool recording__ = false;
+static std::vector<std::string> recorded_files__;
+
+void library_cache_start_recording(void) {recording__ = true; recorded_files__.clear();}
+void library_cache_stop_recording (void) {recording__ = false;}
+
+/* Called by flex whenever it opens a new source file */
+void note_input_file(const char *filename) {
+  if (recording__) recorded_files__.push_back(filename);
+}
+
+
+
+/* The command line options that change the AST produced when parsing the library */
+uint64_t library_cache_options(void) {
+  uint64_t options = 0;
+  if (runtime_options.allow_void_datatype     ) options |= 1 << 0;
+  if (runtime_options.allow_missing_var_in    ) options |= 1 << 1;
+  if (runtime_options.disable_implicit_en_eno ) options |= 1 << 2;
+  if (runtime_options.safe_extensions         ) options |= 1 << 3;
+  if (runtime_options.conversion_functions    ) options |= 1 << 4;
+  if (runtime_options.nested_comments         ) options |= 1 << 5;
+  if (runtime_options.ref_standard_extensions ) options |= 1 << 6;
+  if (runtime_options.ref_nonstand_extensions ) options |= 1 << 7;
+  if (runtime_options.nonliteral_in_array_size) options |= 1 << 8;
+  return options;
+}
+
+
+/* Read the whole file into memory. Returns NULL on error. */
+static char *read_file(const char *filename, size_t *size) {
+  FILE *file = fopen(filename, "rb");
+  if (NULL == file) return NULL;
+
+  char *buf = NULL;
+  long int len;
+  if ((fseek(file, 0, SEEK_END) == 0) && ((len = ftell(file)) >= 0) && (fseek(file, 0, SEEK_SET) == 0)) {
+    buf = (char *)malloc(len + 1);  /* +1 so we never call malloc(0) */
+    if ((NULL != buf) && (fread(buf, 1, len, file) != (size_t)len)) {free(buf); buf = NULL;}
+    *size = len;
+  }
+  fclose(file);
+  return buf;
+}
+
+
+/* FNV-1a hash of the contents of a file. Returns false if the file could not be read. */
+static bool hash_file(const char *filename, uint64_t *size, uint64_t *hash) {
+  size_t len;
+  char *buf = read_file(filename, &len);
+  if (NULL == buf) return false;
+
+  *hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < len; i++) {
+    *hash ^= (unsigned char)buf[i];
+    *hash *= 1099511628211ULL;
+  }
+  *size = len;
+  free(buf);
+  return true;
+}
+
+
+
+
+int library_cache_save(const char *cache_filename, const char *libfilename, symbol_c *library_root) {
+  std::string buf;
+
+  buf.append(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  serialize_ast_c::put_uint(buf, CACHE_FORMAT_VERSION);
+  serialize_ast_c::put_str (buf, CACHE_BUILD_ID);
+  serialize_ast_c::put_uint(buf, library_cache_options());
+  serialize_ast_c::put_str (buf, libfilename);
+
+  /* The files read while parsing the library. Files created by include_string() have no name, and are skipped. */
+  std::vector<std::string> files;
+  for (unsigned int i = 0; i < recorded_files__.size(); i++)
+    if (!recorded_files__[i].empty()) files.push_back(recorded_files__[i]);
+  serialize_ast_c::put_uint(buf, files.size());
+  for (unsigned int i = 0; i < files.size(); i++) {
+    uint64_t size, hash;
+    if (!hash_file(files[i].c_str(), &size, &hash)) return -1;
+    serialize_ast_c::put_str (buf, files[i].c_str());
+    serialize_ast_c::put_uint(buf, size);
+    serialize_ast_c::put_uint(buf, hash);
+  }
+
+  serialize_ast_c::put_int(buf, get_current_order());
+
+  int count = 0;
+  for (library_element_symtable_t::iterator iter = library_element_symtable.begin(); iter != library_element_symtable.end(); iter++) count++;
+  serialize_ast_c::put_uint(buf, count);
+  for (library_element_symtable_t::iterator iter = library_element_symtable.begin(); iter != library_element_symtable.end(); iter++) {
+    serialize_ast_c::put_str(buf, iter->first.c_str());
+    serialize_ast_c::put_int(buf, iter->second);
+  }
+
+  serialize_ast_c::save(library_root, buf);
+
+  /* Write to a temporary file first, and then rename it, so that concurrent compilations
+   * never see a partially written cache file.
+   */
+  char pid[32];
+  snprintf(pid, sizeof(pid), ".%d", (int)getpid());
+  char *tmp_filename = strdup3(cache_filename, pid, ".tmp");
+  if (NULL == tmp_filename) return -1;
+
+  FILE *file = fopen(tmp_filename, "wb");
+  int res = -1;
+  if (NULL != file) {
+    bool ok = (fwrite(buf.data(), 1, buf.size(), file) == buf.size());
+    if ((fclose(file) == 0) && ok && (rename(tmp_filename, cache_filename) == 0))
+      res = 0;
+  }
+  if (res < 0) remove(tmp_filename);
+  free(tmp_filename);
+  return res;
+}
+
+
+
+
+int library_cache_load(const char *cache_filename, const char *libfilename, symbol_c **library_root) {
+  size_t len;
+  char *data = read_file(cache_filename, &len);
+  if (NULL == data) return -1;
+
+  const char *buf = data, *end = data + len;
+  const char *str;
+  uint64_t    uval;
+  int64_t     ival;
+
+  #define CHECK(condition) {if (!(condition)) {free(data); return -1;}}
+  CHECK((len >= sizeof(CACHE_MAGIC)) && (memcmp(buf, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0));
+  buf += sizeof(CACHE_MAGIC);
+  CHECK(serialize_ast_c::get_uint(&buf, end, &uval) && (uval == CACHE_FORMAT_VERSION));
+  CHECK(serialize_ast_c::get_str (&buf, end, &str ) && (NULL != str) && (strcmp(str, CACHE_BUILD_ID) == 0));
+  CHECK(serialize_ast_c::get_uint(&buf, end, &uval) && (uval == library_cache_options()));
+  CHECK(serialize_ast_c::get_str (&buf, end, &str ) && (NULL != str) && (strcmp(str, libfilename) == 0));
+
+  /* Has any of the library files changed since the cache was created? */
+  uint64_t num_files;
+  CHECK(serialize_ast_c::get_uint(&buf, end, &num_files));
+  for (uint64_t i = 0; i < num_files; i++) {
+    uint64_t size, hash, cur_size, cur_hash;
+    CHECK(serialize_ast_c::get_str (&buf, end, &str ) && (NULL != str));
+    CHECK(serialize_ast_c::get_uint(&buf, end, &size));
+    CHECK(serialize_ast_c::get_uint(&buf, end, &hash));
+    CHECK(hash_file(str, &cur_size, &cur_hash) && (size == cur_size) && (hash == cur_hash));
+  }
+
+  int64_t end_order;
+  CHECK(serialize_ast_c::get_int(&buf, end, &end_order));
+
+  /* Decode everything before changing any global state, so a corrupt cache file has no side effects... */
+  uint64_t num_entries;
+  std::vector<const char *> names;
+  std::vector<int>          tokens;
+  CHECK(serialize_ast_c::get_uint(&buf, end, &num_entries));
+  for (uint64_t i = 0; i < num_entries; i++) {
+    CHECK(serialize_ast_c::get_str(&buf, end, &str) && (NULL != str));
+    CHECK(serialize_ast_c::get_int(&buf, end, &ival));
+    names .push_back(str);
+    tokens.push_back((int)ival);
+  }
+
+  symbol_c *root = NULL;
+  if (NULL != library_root)
+    CHECK((root = serialize_ast_c::load(&buf, end)) != NULL);
+  #undef CHECK
+
+  for (unsigned int i = 0; i < names.size(); i++)
+    library_element_symtable.insert(names[i], tokens[i]);
+  /* tokens of the input file must be ordered after the tokens of the library */
+  if (get_current_order() < end_order) set_current_order(end_order);
+
+  if (NULL != library_root) *library_root = root;
+  /* NOTE: the strings in the loaded AST and in library_element_symtable point into data,
+   *       so we must never free() it!
+   */
+  return 0;
+}
@@ -0,0 +1,76 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * A cache of the parsed standard library (ieclib.txt and the files it includes).
+ *
+ * The standard library is parsed before every input file. With the cache enabled
+ * (-C command line option), the AST of the standard library and the contents of the
+ * library_element_symtable are stored in a cache file the first time the library is parsed,
+ * and loaded (with a single read) from that file in any following compilation.
+ *
+ * The cache is only used if it was produced
+ *   - by the same build of matiec,
+ *   - from library files with exactly the same contents (and file names), and
+ *   - with the same command line options that influence the parsing of the library.
+ * Otherwise the library is parsed as usual, and the cache file is rewritten.
+ */
+
+
+#ifndef _LIBRARY_CACHE_HH
+#define _LIBRARY_CACHE_HH
+
+#include <stdint.h>
+
+
+/* The command line options that change the AST produced when parsing the library (one bit per option). */
+uint64_t library_cache_options(void);
+
+/* Start/stop keeping track of the files read by flex, i.e. the files the cached library depends upon. */
+void library_cache_start_recording(void);
+void library_cache_stop_recording (void);
+
+/* Load the standard library from the cache file.
+ * The library_element_symtable is filled in with the library elements, and *library_root
+ * is set to the AST of the library (unless library_root is NULL, in which case the AST is not loaded).
+ * Returns 0 on success, or -1 if the cache file does not exist, is stale, or is corrupt.
+ */
+int library_cache_load(const char *cache_filename, const char *libfilename, symbol_c **library_root);
+
+/* Store the AST of the standard library, the current contents of library_element_symtable,
+ * and the list of files recorded since library_cache_start_recording() into the cache file.
+ * Returns 0 on success, -1 on error.
+ */
+int library_cache_save(const char *cache_filename, const char *libfilename, symbol_c *library_root);
+
+
+#endif   /* _LIBRARY_CACHE_HH */
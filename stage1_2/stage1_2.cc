@@ -233,6 +233,7 @@ char *strdup3(const char *a, const char *b, const char *c) {
 int stage2__(const char *filename, 
              symbol_c **tree_root_ref
             );
+int stage2__load_library(symbol_c **tree_root_ref);
 
 
 int stage1_2(const char *filename, symbol_c **tree_root_ref) {
@@ -249,3 +250,7 @@ int stage1_2(const char *filename, symbol_c **tree_root_ref) {
   return stage2__(filename, tree_root_ref);
 }
 
+
+int stage1_2_load_library(symbol_c **tree_root_ref) {
+  return stage2__load_library(tree_root_ref);
+}
@@ -47,6 +47,11 @@
 
 int stage1_2(const char *filename, symbol_c **tree_root);
 
+/* Parse only the standard library. The following calls to stage1_2() will then only parse the input file,
+ * and add its elements to the library_c holding the standard library (returned in tree_root).
+ */
+int stage1_2_load_library(symbol_c **tree_root);
+
 
 
 
@@ -142,6 +142,27 @@ void include_string(const char *source_code);
 FILE *parse_file(const char *filename);
 
 
+/******************************************************/
+/* Get/set the order counter of the tokens (in flex). */
+/******************************************************/
+/* This is a service that flex provides to bison... */
+/* Used when loading the standard library from a cache file (see library_cache.hh), so that the
+ * tokens of the input file keep getting ordered after the tokens of the standard library.
+ */
+long int get_current_order(void);
+void     set_current_order(long int order);
+
+
+/**************************************************/
+/* Notify that flex has opened a new source file. */
+/**************************************************/
+/* This is a service that bison provides to flex... */
+/* Called by flex for every source file it opens (the main file, as well as any included files).
+ * Used to keep track of the files the cached standard library depends on (see library_cache.hh).
+ */
+void note_input_file(const char *filename);
+
+
 /**********************************************************************************************/
 /* whether bison is doing the pre-parsing, where POU bodies and var declarations are ignored! */
 /**********************************************************************************************/
@@ -41,6 +41,7 @@
 
 
 #include "array_range_check.hh"
+#include "pou_executor.hh"  // required for stage3_error_stream()
 #include <limits>  // required for std::numeric_limits<XXX>
 
 
@@ -49,28 +50,28 @@
 
 #define STAGE3_ERROR(error_level, symbol1, symbol2, ...) {                                                                  \
   if (current_display_error_level >= error_level) {                                                                         \
-    fprintf(stderr, "%s:%d-%d..%d-%d: error: ",                                                                             \
+    fprintf(stage3_error_stream(), "%s:%d-%d..%d-%d: error: ",                                                              \
             FIRST_(symbol1,symbol2)->first_file, FIRST_(symbol1,symbol2)->first_line, FIRST_(symbol1,symbol2)->first_column,\
                                                  LAST_(symbol1,symbol2) ->last_line,  LAST_(symbol1,symbol2) ->last_column);\
-    fprintf(stderr, __VA_ARGS__);                                                                                           \
-    fprintf(stderr, "\n");                                                                                                  \
+    fprintf(stage3_error_stream(), __VA_ARGS__);                                                                            \
+    fprintf(stage3_error_stream(), "\n");                                                                                   \
     error_count++;                                                                                                     \
   }                                                                                                                         \
 }
 
 
 #define STAGE3_WARNING(symbol1, symbol2, ...) {                                                                             \
-    fprintf(stderr, "%s:%d-%d..%d-%d: warning: ",                                                                           \
+    fprintf(stage3_error_stream(), "%s:%d-%d..%d-%d: warning: ",                                                            \
             FIRST_(symbol1,symbol2)->first_file, FIRST_(symbol1,symbol2)->first_line, FIRST_(symbol1,symbol2)->first_column,\
                                                  LAST_(symbol1,symbol2) ->last_line,  LAST_(symbol1,symbol2) ->last_column);\
-    fprintf(stderr, __VA_ARGS__);                                                                                           \
-    fprintf(stderr, "\n");                                                                                                  \
+    fprintf(stage3_error_stream(), __VA_ARGS__);                                                                            \
+    fprintf(stage3_error_stream(), "\n");                                                                                   \
     warning_found = true;                                                                                                   \
 }
 
 
-#define GET_CVALUE(dtype, symbol)             ((symbol)->const_value._##dtype.get())
-#define VALID_CVALUE(dtype, symbol)           ((symbol)->const_value._##dtype.is_valid())
+#define GET_CVALUE(dtype, symbol)             ((symbol)->get_const_value()._##dtype.get())
+#define VALID_CVALUE(dtype, symbol)           ((symbol)->get_const_value()._##dtype.is_valid())
 
 /*  The cmp_unsigned_signed function compares two numbers u and s.
  *  It returns an integer indicating the relationship between the numbers:
@@ -253,7 +254,7 @@ void *array_range_check_c::visit(subrange_c *symbol) {
 	dimension++; 
 	
 	symbol->dimension = dimension;
-	return NULL;
+	return symbol; /* do not visit the limits */
 }
 
 
@@ -269,7 +270,7 @@ void *array_range_check_c::visit(array_initial_elements_c *symbol) {
 
 	/* TODO: check that the total number of 'initial values' does not exceed the size of the array! */
 
-	return NULL;
+	return symbol; /* do not visit the array_initial_element */
 }
 
 
@@ -289,7 +290,7 @@ void *array_range_check_c::visit(array_initial_elements_c *symbol) {
 void *array_range_check_c::visit(array_variable_c *symbol) {
 	check_dimension_count(symbol);
 	check_bounds(symbol);
-	return NULL;
+	return symbol; /* do not visit the subscripts */
 }
 
 
@@ -301,14 +302,12 @@ void *array_range_check_c::visit(array_variable_c *symbol) {
 /***********************/
 // SYM_REF4(function_declaration_c, derived_function_name, type_name, var_declarations_list, function_body)
 void *array_range_check_c::visit(function_declaration_c *symbol) {
-	symbol->var_declarations_list->accept(*this); // required for visiting subrange_c
-	search_varfb_instance_type = new search_varfb_instance_type_c(symbol);
+	// NOTE: the var_declarations_list are also visited, as this is required for visiting subrange_c
+	search_varfb_instance_type = new search_varfb_instance_type_c(symbol); /* deleted in leave() */
+	call_leave();
 	// search_var_instance_decl = new search_var_instance_decl_c(symbol);
-	symbol->function_body->accept(*this);
-	delete search_varfb_instance_type;
-	// delete search_var_instance_decl;
-	search_varfb_instance_type = NULL;
-	// search_var_instance_decl = NULL;
+	skip(symbol->derived_function_name);
+	skip(symbol->type_name);
 	return NULL;
 }
 
@@ -317,14 +316,11 @@ void *array_range_check_c::visit(function_declaration_c *symbol) {
 /*****************************/
 // SYM_REF3(function_block_declaration_c, fblock_name, var_declarations, fblock_body)
 void *array_range_check_c::visit(function_block_declaration_c *symbol) {
-	symbol->var_declarations->accept(*this); // required for visiting subrange_c
-	search_varfb_instance_type = new search_varfb_instance_type_c(symbol);
+	// NOTE: the var_declarations are also visited, as this is required for visiting subrange_c
+	search_varfb_instance_type = new search_varfb_instance_type_c(symbol); /* deleted in leave() */
+	call_leave();
 	// search_var_instance_decl = new search_var_instance_decl_c(symbol);
-	symbol->fblock_body->accept(*this);
-	delete search_varfb_instance_type;
-	// delete search_var_instance_decl;
-	search_varfb_instance_type = NULL;
-	// search_var_instance_decl = NULL;
+	skip(symbol->fblock_name);
 	return NULL;
 }
 
@@ -333,16 +329,24 @@ void *array_range_check_c::visit(function_block_declaration_c *symbol) {
 /**********************/
 // SYM_REF3(program_declaration_c, program_type_name, var_declarations, function_block_body)
 void *array_range_check_c::visit(program_declaration_c *symbol) {
-	symbol->var_declarations->accept(*this); // required for visiting subrange_c
-	search_varfb_instance_type = new search_varfb_instance_type_c(symbol);
+	// NOTE: the var_declarations are also visited, as this is required for visiting subrange_c
+	search_varfb_instance_type = new search_varfb_instance_type_c(symbol); /* deleted in leave() */
+	call_leave();
 	// search_var_instance_decl = new search_var_instance_decl_c(symbol);
-	symbol->function_block_body->accept(*this);
-	delete search_varfb_instance_type;
-	// delete search_var_instance_decl;
-	search_varfb_instance_type = NULL;
-	// search_var_instance_decl = NULL;
+	skip(symbol->program_type_name);
 	return NULL;
 }
 
 
 
+/* Undo the state set up by the visit() methods, once the children of the symbol have been visited */
+void array_range_check_c::leave(symbol_c *symbol) {
+	if (   symbol->is<function_declaration_c>()
+	    || symbol->is<function_block_declaration_c>()
+	    || symbol->is<program_declaration_c>()) {
+		delete search_varfb_instance_type;
+		// delete search_var_instance_decl;
+		search_varfb_instance_type = NULL;
+		// search_var_instance_decl = NULL;
+	}
+}
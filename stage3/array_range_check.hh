@@ -34,10 +34,14 @@
 // #include <vector>
 #include "../absyntax_utils/absyntax_utils.hh"
 // #include "datatype_functions.hh"
+#include "fused_check.hh"
 
 
 
-class array_range_check_c: public iterator_visitor_c {
+/* NOTE: This checker is run by a fused_check_c (see fused_check.hh), together with other checkers,
+ *       so its visit() methods do not visit the children of the symbols.
+ */
+class array_range_check_c: public fused_checker_c {
 
   private:
     search_varfb_instance_type_c *search_varfb_instance_type;
@@ -51,6 +55,7 @@ class array_range_check_c: public iterator_visitor_c {
     array_range_check_c(symbol_c *ignore);
     virtual ~array_range_check_c(void);
     int get_error_count();
+    void leave(symbol_c *symbol);
 
     /*************************/
     /* B.1 - Common elements */
@@ -44,6 +44,7 @@
 
 
 #include "case_elements_check.hh"
+#include "pou_executor.hh"  // required for stage3_error_stream()
 
 
 #define FIRST_(symbol1, symbol2) (((symbol1)->first_order < (symbol2)->first_order)   ? (symbol1) : (symbol2))
@@ -51,28 +52,28 @@
 
 #define STAGE3_ERROR(error_level, symbol1, symbol2, ...) {                                                                  \
   if (current_display_error_level >= error_level) {                                                                         \
-    fprintf(stderr, "%s:%d-%d..%d-%d: error: ",                                                                             \
+    fprintf(stage3_error_stream(), "%s:%d-%d..%d-%d: error: ",                                                              \
             FIRST_(symbol1,symbol2)->first_file, FIRST_(symbol1,symbol2)->first_line, FIRST_(symbol1,symbol2)->first_column,\
                                                  LAST_(symbol1,symbol2) ->last_line,  LAST_(symbol1,symbol2) ->last_column);\
-    fprintf(stderr, __VA_ARGS__);                                                                                           \
-    fprintf(stderr, "\n");                                                                                                  \
+    fprintf(stage3_error_stream(), __VA_ARGS__);                                                                            \
+    fprintf(stage3_error_stream(), "\n");                                                                                   \
     error_count++;                                                                                                     \
   }                                                                                                                         \
 }
 
 
 #define STAGE3_WARNING(symbol1, symbol2, ...) {                                                                             \
-    fprintf(stderr, "%s:%d-%d..%d-%d: warning: ",                                                                           \
+    fprintf(stage3_error_stream(), "%s:%d-%d..%d-%d: warning: ",                                                            \
             FIRST_(symbol1,symbol2)->first_file, FIRST_(symbol1,symbol2)->first_line, FIRST_(symbol1,symbol2)->first_column,\
                                                  LAST_(symbol1,symbol2) ->last_line,  LAST_(symbol1,symbol2) ->last_column);\
-    fprintf(stderr, __VA_ARGS__);                                                                                           \
-    fprintf(stderr, "\n");                                                                                                  \
+    fprintf(stage3_error_stream(), __VA_ARGS__);                                                                            \
+    fprintf(stage3_error_stream(), "\n");                                                                                   \
     warning_found = true;                                                                                                   \
 }
 
 
-#define GET_CVALUE(dtype, symbol)             ((symbol)->const_value._##dtype.get())
-#define VALID_CVALUE(dtype, symbol)           ((symbol)->const_value._##dtype.is_valid())
+#define GET_CVALUE(dtype, symbol)             ((symbol)->get_const_value()._##dtype.get())
+#define VALID_CVALUE(dtype, symbol)           ((symbol)->get_const_value()._##dtype.is_valid())
 
 
 
@@ -120,8 +121,8 @@ static bool less_than(symbol_c *s1, symbol_c *s2) {
 
 
 void case_elements_check_c::check_subr_subr(symbol_c *s1, symbol_c *s2) {
-  subrange_c *sub1 = dynamic_cast<subrange_c *>(s1);
-  subrange_c *sub2 = dynamic_cast<subrange_c *>(s2);
+  subrange_c *sub1 = s1->as<subrange_c>();
+  subrange_c *sub2 = s2->as<subrange_c>();
   
   if ((NULL == sub1) || (NULL == sub2)) return;
   symbol_c *l1 = sub1->lower_limit;
@@ -145,8 +146,8 @@ void case_elements_check_c::check_subr_subr(symbol_c *s1, symbol_c *s2) {
 void case_elements_check_c::check_subr_symb(symbol_c *s1, symbol_c *s2) {
   subrange_c *subr = NULL;
   symbol_c   *symb = NULL;
-  if ((subr = dynamic_cast<subrange_c *>(s1)) != NULL) {symb = s2;}
-  if ((subr = dynamic_cast<subrange_c *>(s2)) != NULL) {symb = s1;}
+  if ((subr = s1->as<subrange_c>()) != NULL) {symb = s2;}
+  if ((subr = s2->as<subrange_c>()) != NULL) {symb = s1;}
   
   if ((NULL == subr) || (NULL == symb)) return;
   symbol_c   *lowl = subr->lower_limit;
@@ -177,13 +178,12 @@ void case_elements_check_c::check_subr_symb(symbol_c *s1, symbol_c *s2) {
 
 
 
-#include <typeinfo>
 void case_elements_check_c::check_symb_symb(symbol_c *s1, symbol_c *s2) {
-  if (   (dynamic_cast<subrange_c *>(s1) != NULL)
-      || (dynamic_cast<subrange_c *>(s2) != NULL)) 
+  if (   (s1->is<subrange_c>())
+      || (s2->is<subrange_c>())) 
     return; // only run this test if neither s1 nor s2 are subranges!
   
-  if (   (s1->const_value.is_const() && s2->const_value.is_const() && (s1->const_value == s2->const_value))  // if const, then compare const values (using overloaded '==' operator!)
+  if (   (s1->get_const_value().is_const() && s2->get_const_value().is_const() && (s1->get_const_value() == s2->get_const_value()))  // if const, then compare const values (using overloaded '==' operator!)
       || (compare_identifiers(s1, s2) == 0))  // if token_c, compare tokens! (compare_identifiers() returns 0 when equal tokens!, -1 when either is not token_c)
     STAGE3_WARNING(s1, s2, "Duplicate element found in CASE options.");
 }
@@ -208,11 +208,22 @@ void case_elements_check_c::check_symb_symb(symbol_c *s1, symbol_c *s2) {
 /* CASE expression OF case_element_list ELSE statement_list END_CASE */
 // SYM_REF3(case_statement_c, expression, case_element_list, statement_list)
 void *case_elements_check_c::visit(case_statement_c *symbol) {
-  std::vector<symbol_c *> case_elements_list_local = case_elements_list; // Required when source code contains CASE inside another CASE !
+  outer_case_elements_lists.push_back(case_elements_list); // Required when source code contains CASE inside another CASE !
 
   case_elements_list.clear();
-  symbol->case_element_list->accept(*this); // will fill up the case_elements_list with all the elements in the case!
-  
+  /* only the case_element_list is visited, and will fill up the case_elements_list with all the elements in the case!
+   * The elements are checked in leave(), once the case_element_list has been visited.
+   */
+  skip(symbol->expression);
+  skip(symbol->statement_list);
+  call_leave();
+  return NULL;
+}
+
+
+void case_elements_check_c::leave(symbol_c *symbol) {
+  if (!symbol->is<case_statement_c>()) return;
+
   // OK, now check whether we have any overlappings...
   std::vector<symbol_c *>::iterator s1 = case_elements_list.begin();
   for (  ; s1 != case_elements_list.end(); s1++) {
@@ -226,8 +237,8 @@ void *case_elements_check_c::visit(case_statement_c *symbol) {
     }
   }
   
-  case_elements_list = case_elements_list_local;
-  return NULL;
+  case_elements_list = outer_case_elements_lists.back();
+  outer_case_elements_lists.pop_back();
 }
 
 /* helper symbol for case_statement */
@@ -243,7 +254,7 @@ void *case_elements_check_c::visit(case_statement_c *symbol) {
 void *case_elements_check_c::visit(case_list_c *symbol) {
   for (int i = 0; i < symbol->n; i++)
     case_elements_list.push_back(symbol->get_element(i));
-  return NULL;
+  return symbol; /* do not visit the elements */
 }
 
 
@@ -43,10 +43,14 @@
  */
 
 #include "../absyntax_utils/absyntax_utils.hh"
+#include "fused_check.hh"
 
 
 
-class case_elements_check_c: public iterator_visitor_c {
+/* NOTE: This checker is run by a fused_check_c (see fused_check.hh), together with other checkers,
+ *       so its visit() methods do not visit the children of the symbols.
+ */
+class case_elements_check_c: public fused_checker_c {
 
   private:
     bool warning_found;
@@ -54,6 +58,7 @@ class case_elements_check_c: public iterator_visitor_c {
     int current_display_error_level;
 
     std::vector<symbol_c *> case_elements_list;
+    std::vector<std::vector<symbol_c *> > outer_case_elements_lists; /* the case_elements_list of the CASE statements containing the current one */
     void check_subr_subr(symbol_c *s1, symbol_c *s2);
     void check_subr_symb(symbol_c *s1, symbol_c *s2);
     void check_symb_symb(symbol_c *s1, symbol_c *s2);
@@ -63,6 +68,7 @@ class case_elements_check_c: public iterator_visitor_c {
     case_elements_check_c(symbol_c *ignore);
     virtual ~case_elements_check_c(void);
     int get_error_count();
+    void leave(symbol_c *symbol);
 
     /***************************************/
     /* B.3 - Language ST (Structured Text) */
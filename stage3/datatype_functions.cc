@@ -25,6 +25,7 @@
 #include "datatype_functions.hh"
 #include "../absyntax_utils/absyntax_utils.hh"
 #include <vector>
+#include <map>
 
 
 
@@ -382,15 +383,70 @@ const struct widen_entry widen_CMP_table[] = {
 };
 
 
+/* Since the widening tables only contain elementary datatypes, each table is indexed by the position of
+ * the elementary datatypes of both operands (see candidate_datatypes_c::get_elementary_index()), 
+ * so searching a table is a simple lookup. The index of a table is only built the first time
+ * the table is searched, and contains the result of the first entry of the table for each (left, right) pair.
+ */
+typedef std::vector<symbol_c *> widen_index_t;
+typedef std::map<const struct widen_entry *, widen_index_t> widen_indexes_t;
+/* Each thread builds indexes of its own (see pou_executor.hh) */
+static per_thread_c<widen_indexes_t> widen_indexes_per_thread;
+
+static widen_index_t &get_widen_index(const struct widen_entry widen_table[]) {
+	widen_indexes_t &widen_indexes = widen_indexes_per_thread.get();
+	widen_indexes_t::iterator iter = widen_indexes.find(widen_table);
+	if (iter != widen_indexes.end())
+		return iter->second;
+
+	int count = candidate_datatypes_c::get_elementary_count();
+	widen_index_t &widen_index = widen_indexes[widen_table];
+	widen_index.assign(count * count, NULL);
+	int k;
+	for (k = 0; NULL != widen_table[k].left; k++);
+	/* go through the table backwards, so the entry that remains in the index is the first one of the table */
+	for (k--; k >= 0; k--) {
+		int left  = candidate_datatypes_c::get_elementary_index(widen_table[k].left);
+		int right = candidate_datatypes_c::get_elementary_index(widen_table[k].right);
+		if ((left < 0) || (right < 0)) ERROR; /* widening tables should only contain elementary datatypes! */
+		widen_index[left * count + right] = widen_table[k].result;
+	}
+	return widen_index;
+}
+
+
+symbol_c *search_in_widen_table(symbol_c *left_type, symbol_c *right_type, const struct widen_entry widen_table[]) {
+	int left  = candidate_datatypes_c::get_elementary_index(left_type);
+	int right = candidate_datatypes_c::get_elementary_index(right_type);
+	if ((left < 0) || (right < 0))
+		return NULL;
+	return get_widen_index(widen_table)[left * candidate_datatypes_c::get_elementary_count() + right];
+}
+
+
 /* Search for a datatype inside a candidate_datatypes list.
  * Returns: position of datatype in the list, or -1 if not found.
  */
-int search_in_candidate_datatype_list(symbol_c *datatype, const std::vector <symbol_c *> &candidate_datatypes) {
+int search_in_candidate_datatype_list(symbol_c *datatype, const symbol_c::candidate_datatypes_t &candidate_datatypes) {
 	if (NULL == datatype) 
 		return -1;
 
+	/* If both the datatype and all the elements of the list are elementary datatypes, they can only be equal if they 
+	 * are the same elementary datatype, so the bitset of the list tells us right away whether the datatype is in the list.
+	 */
+	candidate_datatypes_c::elementary_set_t bit = candidate_datatypes_c::get_elementary_bit(datatype);
+	if ((0 != bit) && (0 == candidate_datatypes.get_other_count())) {
+		if (0 == (bit & candidate_datatypes.get_elementary_set()))
+			return -1;
+		for(unsigned int i = 0; i < candidate_datatypes.size(); i++)
+			if (candidate_datatypes[i]->get_kind() == datatype->get_kind())
+				return i;
+	}
+
+	/* compare the type ids, instead of calling get_datatype_info_c::is_type_equal() for every element in the list */
+	get_datatype_info_c::type_id_t type_id = get_datatype_info_c::get_type_id(datatype);
 	for(unsigned int i = 0; i < candidate_datatypes.size(); i++)
-		if (get_datatype_info_c::is_type_equal(datatype, candidate_datatypes[i]))
+		if (get_datatype_info_c::is_type_id_equal(type_id, get_datatype_info_c::get_type_id(candidate_datatypes[i])))
 			return i;
 	/* Not found ! */
 	return -1;
@@ -399,12 +455,12 @@ int search_in_candidate_datatype_list(symbol_c *datatype, const std::vector <sym
 /* Remove a datatype inside a candidate_datatypes list.
  * Returns: If successful it returns true, false otherwise.
  */
-bool remove_from_candidate_datatype_list(symbol_c *datatype, std::vector <symbol_c *> &candidate_datatypes) {
+bool remove_from_candidate_datatype_list(symbol_c *datatype, symbol_c::candidate_datatypes_t &candidate_datatypes) {
 	int pos = search_in_candidate_datatype_list(datatype, candidate_datatypes);
 	if (pos < 0)
 		return false;
 	
-	candidate_datatypes.erase(candidate_datatypes.begin() + pos);
+	candidate_datatypes.erase(pos);
 	return true;
 }
 
@@ -420,15 +476,31 @@ void intersect_candidate_datatype_list(symbol_c *list1 /*origin, dest.*/, symbol
 		/* In principle, we should never call it with NULL values. Best to abort the compiler just in case! */
 		return;
 
-	for(std::vector<symbol_c *>::iterator i = list1->candidate_datatypes.begin(); i < list1->candidate_datatypes.end(); ) {
-		/* Note that we do _not_ increment i in the for() loop!
-		 * When we erase an element from position i, a new element will take it's place, that must also be tested! 
-		 */
-		if (search_in_candidate_datatype_list(*i, list2->candidate_datatypes) < 0)
-			/* remove this element! This will change the value of candidate_datatypes.size() */
-			list1->candidate_datatypes.erase(i);
-		else i++;
+	symbol_c::candidate_datatypes_t &dest = list1->candidate_datatypes();
+	const symbol_c::candidate_datatypes_t &with = list2->get_candidate_datatypes();
+	symbol_c::candidate_datatypes_t  result;
+	/* the type ids of list2, only determined if (and when) they are needed */
+	std::vector<get_datatype_info_c::type_id_t> with_ids;
+
+	for(unsigned int i = 0; i < dest.size(); i++) {
+		bool found = false;
+		candidate_datatypes_c::elementary_set_t bit = candidate_datatypes_c::get_elementary_bit(dest[i]);
+		if ((0 != bit) && (0 == with.get_other_count())) {
+			/* an elementary datatype, and list2 only contains elementary datatypes => simply check the bitset of list2 */
+			found = (0 != (bit & with.get_elementary_set()));
+		} else {
+			if (with_ids.size() != with.size())
+				for(unsigned int j = 0; j < with.size(); j++)
+					with_ids.push_back(get_datatype_info_c::get_type_id(with[j]));
+			get_datatype_info_c::type_id_t type_id = get_datatype_info_c::get_type_id(dest[i]);
+			for(unsigned int j = 0; (j < with_ids.size()) && !found; j++)
+				found = get_datatype_info_c::is_type_id_equal(type_id, with_ids[j]);
+		}
+		/* keep the elements in the same order they had in list1 */
+		if (found)
+			result.push_back(dest[i]);
 	}
+	dest = result;
 }
 
 
@@ -439,7 +511,7 @@ void intersect_prev_candidate_datatype_lists(il_instruction_c *symbol) {
 	if (symbol->prev_il_instruction.empty())
 		return;
 	
-	symbol->candidate_datatypes = symbol->prev_il_instruction[0]->candidate_datatypes;
+	symbol->candidate_datatypes() = symbol->prev_il_instruction[0]->get_candidate_datatypes();
 	for (unsigned int i = 1; i < symbol->prev_il_instruction.size(); i++) {
 		intersect_candidate_datatype_list(symbol /*origin, dest.*/, symbol->prev_il_instruction[i] /*with*/);
 	}  
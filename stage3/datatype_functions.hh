@@ -74,15 +74,20 @@ extern const struct widen_entry widen_OR_table[];
 extern const struct widen_entry widen_XOR_table[];
 extern const struct widen_entry widen_CMP_table[];
 
+/* Search a widening table for the datatype resulting from an operation on left_type and right_type.
+ * Returns: the resulting datatype, or NULL if the operation is not defined for these datatypes.
+ */
+symbol_c *search_in_widen_table(symbol_c *left_type, symbol_c *right_type, const struct widen_entry widen_table[]);
+
 /* Search for a datatype inside a candidate_datatypes list.
  * Returns: position of datatype in the list, or -1 if not found.
  */
-int search_in_candidate_datatype_list(symbol_c *datatype, const std::vector <symbol_c *> &candidate_datatypes);
+int search_in_candidate_datatype_list(symbol_c *datatype, const symbol_c::candidate_datatypes_t &candidate_datatypes);
 
 /* Remove a datatype inside a candidate_datatypes list.
  * Returns: If successful it returns true, false otherwise.
  */
-bool remove_from_candidate_datatype_list(symbol_c *datatype, std::vector <symbol_c *> &candidate_datatypes);
+bool remove_from_candidate_datatype_list(symbol_c *datatype, symbol_c::candidate_datatypes_t &candidate_datatypes);
 
 /* Intersect two candidate_datatype_lists.
  * Remove from list1 (origin, dest.) all elements that are not found in list2 (with).
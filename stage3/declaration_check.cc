@@ -43,6 +43,7 @@
 
 
 #include "declaration_check.hh"
+#include "pou_executor.hh"  // required for stage3_error_stream()
 #include "datatype_functions.hh"
 
 #define FIRST_(symbol1, symbol2) (((symbol1)->first_order < (symbol2)->first_order)   ? (symbol1) : (symbol2))
@@ -50,22 +51,22 @@
 
 #define STAGE3_ERROR(error_level, symbol1, symbol2, ...) {                                                                  \
   if (current_display_error_level >= error_level) {                                                                         \
-    fprintf(stderr, "%s:%d-%d..%d-%d: error: ",                                                                             \
+    fprintf(stage3_error_stream(), "%s:%d-%d..%d-%d: error: ",                                                              \
             FIRST_(symbol1,symbol2)->first_file, FIRST_(symbol1,symbol2)->first_line, FIRST_(symbol1,symbol2)->first_column,\
                                                  LAST_(symbol1,symbol2) ->last_line,  LAST_(symbol1,symbol2) ->last_column);\
-    fprintf(stderr, __VA_ARGS__);                                                                                           \
-    fprintf(stderr, "\n");                                                                                                  \
+    fprintf(stage3_error_stream(), __VA_ARGS__);                                                                            \
+    fprintf(stage3_error_stream(), "\n");                                                                                   \
     error_count++;                                                                                                     \
   }                                                                                                                         \
 }
 
 
 #define STAGE3_WARNING(symbol1, symbol2, ...) {                                                                             \
-    fprintf(stderr, "%s:%d-%d..%d-%d: warning: ",                                                                           \
+    fprintf(stage3_error_stream(), "%s:%d-%d..%d-%d: warning: ",                                                            \
             FIRST_(symbol1,symbol2)->first_file, FIRST_(symbol1,symbol2)->first_line, FIRST_(symbol1,symbol2)->first_column,\
                                                  LAST_(symbol1,symbol2) ->last_line,  LAST_(symbol1,symbol2) ->last_column);\
-    fprintf(stderr, __VA_ARGS__);                                                                                           \
-    fprintf(stderr, "\n");                                                                                                  \
+    fprintf(stage3_error_stream(), __VA_ARGS__);                                                                            \
+    fprintf(stage3_error_stream(), "\n");                                                                                   \
     warning_found = true;                                                                                                   \
 }
 
@@ -89,9 +90,10 @@ class check_extern_c: public iterator_visitor_c {
   
   
   public:
-    static int error_count;
+    int &error_count;  /* the error_count of the declaration_check_c using this check_extern_c */
     
-    check_extern_c(symbol_c *current_pou, symbol_c *current_resource) {
+    check_extern_c(symbol_c *current_pou, symbol_c *current_resource, int &error_count_)
+      : error_count(error_count_) {
       current_display_error_level = 0;
       current_pou_decl      = current_pou;
       current_resource_decl = current_resource;
@@ -214,7 +216,6 @@ class check_extern_c: public iterator_visitor_c {
     
 };
 
-int check_extern_c::error_count = 0;
 std::set<symbol_c *> check_extern_c::checked_decl;
 
 
@@ -238,7 +239,7 @@ declaration_check_c::~declaration_check_c(void) {
 }
 
 int declaration_check_c::get_error_count() {
-  return check_extern_c::error_count;
+  return error_count;
 }
 
 /*****************************/
@@ -247,7 +248,7 @@ int declaration_check_c::get_error_count() {
 /*  FUNCTION_BLOCK derived_function_block_name io_OR_other_var_declarations function_block_body END_FUNCTION_BLOCK */
 // SYM_REF3(function_block_declaration_c, fblock_name, var_declarations, fblock_body)
 void *declaration_check_c::visit(function_block_declaration_c *symbol)
-  {return NULL;} // We only check the declarations that are used to instantiate variables. This is done in the configuration!
+  {return symbol;} // We only check the declarations that are used to instantiate variables. This is done in the configuration!
 
 /******************************************/
 /* B 1.5.3 - Declaration & Initialisation */
@@ -255,7 +256,7 @@ void *declaration_check_c::visit(function_block_declaration_c *symbol)
 /*  PROGRAM program_type_name program_var_declarations_list function_block_body END_PROGRAM */
 // SYM_REF3(program_declaration_c, program_type_name, var_declarations, function_block_body)
 void *declaration_check_c::visit(program_declaration_c *symbol) 
-  {return NULL;} // We only check the declarations that are used to instantiate variables. This is done in the configuration!
+  {return symbol;} // We only check the declarations that are used to instantiate variables. This is done in the configuration!
 
 
 
@@ -272,11 +273,14 @@ void *declaration_check_c::visit(program_declaration_c *symbol)
  */
 //SYM_REF5(configuration_declaration_c, configuration_name, global_var_declarations, resource_declarations, access_declarations, instance_specific_initializations)
 void *declaration_check_c::visit(configuration_declaration_c *symbol) {
-  current_pou_decl = symbol;
+  current_pou_decl = symbol; /* reset in leave() */
   /* check if any FB declared as a VAR has any incompatible VAR_EXTERNAL declarations */
-  if (NULL != symbol->resource_declarations)
-    symbol->resource_declarations->accept(*this);
-  current_pou_decl = NULL;
+  /* only the resource_declarations are visited */
+  skip(symbol->configuration_name);
+  skip(symbol->global_var_declarations);
+  skip(symbol->access_declarations);
+  skip(symbol->instance_specific_initializations);
+  call_leave();
   return NULL;
 }
 
@@ -290,12 +294,14 @@ END_RESOURCE
 // SYM_REF4(resource_declaration_c, resource_name, resource_type_name, global_var_declarations, resource_declaration, enumvalue_symtable_t enumvalue_symtable;)
 void *declaration_check_c::visit(resource_declaration_c *symbol) {
   // check if any FB instantiated inside this resource (in a VAR_GLOBAL) has any VAR_EXTERNAL declarations incompatible with the configuration's VAR_GLOBALs
-  check_extern_c check_extern(current_pou_decl, current_resource_decl);
+  check_extern_c check_extern(current_pou_decl, current_resource_decl, error_count);
   symbol->global_var_declarations->accept(check_extern);   
-  // Now check the Programs instantiated in this resource
-  current_resource_decl = symbol;
-  symbol->resource_declaration->accept(*this);
-  current_resource_decl = NULL;  
+  // Now check the Programs instantiated in this resource (i.e. only visit the resource_declaration)
+  current_resource_decl = symbol; /* reset in leave() */
+  skip(symbol->resource_name);
+  skip(symbol->resource_type_name);
+  skip(symbol->global_var_declarations);
+  call_leave();
   return NULL;
 }
 
@@ -313,8 +319,16 @@ void *declaration_check_c::visit(program_configuration_c *symbol) {
   if ((iter_f == function_block_type_symtable.end()) && (iter_p == program_type_symtable.end())) 
     ERROR;  // Should never occur! stage1_2 guarantees that we are sure to find a declaration in FB or Program symtable.
 
-  check_extern_c check_extern(current_pou_decl, current_resource_decl);
+  check_extern_c check_extern(current_pou_decl, current_resource_decl, error_count);
   p_decl->accept(check_extern);
-  return NULL;
+  return symbol;
+}
+
+
+
+/* Undo the state set up by the visit() methods, once the children of the symbol have been visited */
+void declaration_check_c::leave(symbol_c *symbol) {
+  if (symbol->is<configuration_declaration_c>())  current_pou_decl      = NULL;
+  if (symbol->is<resource_declaration_c>())       current_resource_decl = NULL;
 }
 
@@ -33,9 +33,13 @@
 #include <vector>
 
 #include "../absyntax_utils/absyntax_utils.hh"
+#include "fused_check.hh"
 
 
-class declaration_check_c : public iterator_visitor_c {
+/* NOTE: This checker is run by a fused_check_c (see fused_check.hh), together with other checkers,
+ *       so its visit() methods do not visit the children of the symbols.
+ */
+class declaration_check_c : public fused_checker_c {
     int error_count;
     int current_display_error_level;
     symbol_c *current_pou_decl;
@@ -45,6 +49,7 @@ public:
     declaration_check_c(symbol_c *ignore);
     virtual ~declaration_check_c(void);
     int get_error_count();
+    void leave(symbol_c *symbol);
 
     /*****************************/
     /* B 1.5.2 - Function Blocks */
@@ -69,9 +69,9 @@
 #include <strings.h>
 
 
-#define GET_CVALUE(dtype, symbol)             ((symbol)->const_value._##dtype.get())
-#define VALID_CVALUE(dtype, symbol)           ((symbol)->const_value._##dtype.is_valid())
-#define IS_OVERFLOW(dtype, symbol)            ((symbol)->const_value._##dtype.is_overflow())
+#define GET_CVALUE(dtype, symbol)             ((symbol)->get_const_value()._##dtype.get())
+#define VALID_CVALUE(dtype, symbol)           ((symbol)->get_const_value()._##dtype.is_valid())
+#define IS_OVERFLOW(dtype, symbol)            ((symbol)->get_const_value()._##dtype.is_overflow())
 
 
 /* set to 1 to see debug info during execution */
@@ -164,7 +164,7 @@ static populate_globalenumvalue_symtable_c populate_globalenumvalue_symtable;
 /*                                                   */
 /*****************************************************/
 
-/* Add to the local_enumerated_value_symtable the local enum value constants */
+/* Add to the local_enumerated_value_symtable (of the fill_candidate_datatypes_c) the local enum value constants */
 /* Notes:
  * Some enumerations are 
  *   (A) declared anonymously inside a VAR ... END_VAR declaration
@@ -199,16 +199,15 @@ static populate_globalenumvalue_symtable_c populate_globalenumvalue_symtable;
  *     GlobalEnumVar := GlobalEnumT#xxx1;
  *     END_FUNCTION_BLOCK
  */
- 
-static enumerated_value_symtable_t local_enumerated_value_symtable;
 
 
 class populate_localenumvalue_symtable_c: public iterator_visitor_c {
   private:
-    symbol_c *current_enumerated_type;
+    symbol_c                    *current_enumerated_type;
+    enumerated_value_symtable_t *local_enumerated_value_symtable;
 
   public:
-     populate_localenumvalue_symtable_c(void) {current_enumerated_type = NULL;};
+     populate_localenumvalue_symtable_c(enumerated_value_symtable_t *symtable) {current_enumerated_type = NULL; local_enumerated_value_symtable = symtable;};
     ~populate_localenumvalue_symtable_c(void) {}
 
   public:
@@ -240,8 +239,8 @@ class populate_localenumvalue_symtable_c: public iterator_visitor_c {
     /* this is really an ERROR! The initial value may use the syntax NUM_TYPE#enum_value, but in that case we should have return'd in the above statement !! */
     if (symbol->type != NULL) ERROR;  
 
-    enumerated_value_symtable_t::iterator lower = local_enumerated_value_symtable.lower_bound(symbol->value);
-    enumerated_value_symtable_t::iterator upper = local_enumerated_value_symtable.upper_bound(symbol->value);
+    enumerated_value_symtable_t::iterator lower = local_enumerated_value_symtable->lower_bound(symbol->value);
+    enumerated_value_symtable_t::iterator upper = local_enumerated_value_symtable->upper_bound(symbol->value);
     for (; lower != upper; lower++)
       if (lower->second == current_enumerated_type) {
         /*  The same identifier is used more than once as an enumerated value/constant inside the same enumerated datat type! */
@@ -249,13 +248,11 @@ class populate_localenumvalue_symtable_c: public iterator_visitor_c {
       }
     
     /* add it to the local symbol table. */
-    local_enumerated_value_symtable.insert(symbol->value, current_enumerated_type);
+    local_enumerated_value_symtable->insert(symbol->value, current_enumerated_type);
     return NULL;
   }
 }; // class populate_enumvalue_symtable_c
 
-static populate_localenumvalue_symtable_c populate_enumvalue_symtable;
-
 
 
 
@@ -266,12 +263,14 @@ static populate_localenumvalue_symtable_c populate_enumvalue_symtable;
 /*****************************************************/
 
 
-fill_candidate_datatypes_c::fill_candidate_datatypes_c(symbol_c *ignore) {
+fill_candidate_datatypes_c::fill_candidate_datatypes_c(symbol_c *tree_root) {
 	il_operand = NULL;
 	prev_il_instruction = NULL;
 	search_var_instance_decl = NULL;
 	current_enumerated_spec_type = NULL;
 	current_scope = NULL;
+	/* NOTE: constructing more than one visitor for the same tree_root does no harm, as the same enumerated values are not inserted twice */
+	if (NULL != tree_root) tree_root->accept(populate_globalenumvalue_symtable);
 }
 
 fill_candidate_datatypes_c::~fill_candidate_datatypes_c(void) {
@@ -284,12 +283,8 @@ fill_candidate_datatypes_c::~fill_candidate_datatypes_c(void) {
 
 
 symbol_c *fill_candidate_datatypes_c::widening_conversion(symbol_c *left_type, symbol_c *right_type, const struct widen_entry widen_table[]) {
-	int k;
 	/* find a widening table entry compatible */
-	for (k = 0; NULL != widen_table[k].left;  k++)
-		if ((typeid(*left_type) == typeid(*widen_table[k].left)) && (typeid(*right_type) == typeid(*widen_table[k].right)))
-                      return widen_table[k].result;
-	return NULL;
+	return search_in_widen_table(left_type, right_type, widen_table);
 }
 
 
@@ -302,12 +297,12 @@ bool fill_candidate_datatypes_c::add_datatype_to_candidate_list(symbol_c *symbol
   if (!get_datatype_info_c::is_type_valid(datatype)) /* checks for NULL and invalid_type_name_c */
     return false;
 
-  if (search_in_candidate_datatype_list(datatype, symbol->candidate_datatypes) >= 0) 
+  if (search_in_candidate_datatype_list(datatype, symbol->get_candidate_datatypes()) >= 0) 
     /* already in the list, Just return! */
     return false;
   
   /* not yet in the candidate data type list, so we insert it now! */
-  symbol->candidate_datatypes.push_back(datatype);
+  symbol->candidate_datatypes().push_back(datatype);
   return true;
 }
     
@@ -325,8 +320,8 @@ void fill_candidate_datatypes_c::remove_incompatible_datatypes(symbol_c *symbol)
     #error __REMOVE__ macro already exists. Choose another name!
   #endif
   #define __REMOVE__(datatype)\
-      remove_from_candidate_datatype_list(&get_datatype_info_c::datatype,       symbol->candidate_datatypes);\
-      remove_from_candidate_datatype_list(&get_datatype_info_c::safe##datatype, symbol->candidate_datatypes);
+      remove_from_candidate_datatype_list(&get_datatype_info_c::datatype,       symbol->candidate_datatypes());\
+      remove_from_candidate_datatype_list(&get_datatype_info_c::safe##datatype, symbol->candidate_datatypes());
   
   {/* Remove unsigned data types */
     uint64_t value = 0;
@@ -370,30 +365,51 @@ void fill_candidate_datatypes_c::remove_incompatible_datatypes(symbol_c *symbol)
  * This means that, for non formal function calls in IL, de current (default value) must be artificially added to the
  * beginning of the parameter list BEFORE calling handle_function_call().
  */
+fill_candidate_datatypes_c::nonformal_signature_t &fill_candidate_datatypes_c::get_nonformal_signature(symbol_c *f_decl) {
+	nonformal_signature_t *signature = nonformal_signatures.find(f_decl->id);
+	if (NULL != signature)
+		return *signature;
+
+	signature = &nonformal_signatures[f_decl->id];
+	signature->extensible = false;
+	function_param_iterator_c fp_iterator(f_decl);
+	identifier_c *param_name;
+	while ((param_name = fp_iterator.next()) != NULL) {
+		/* ignore the EN and ENO parameters */
+		if ((strcmp(param_name->value, "EN") == 0) || (strcmp(param_name->value, "ENO") == 0))
+			continue;
+		signature->param_types.push_back(base_type(fp_iterator.param_type()));
+		/* fp_iterator.next() will keep on returning the extensible parameter, so we stop here */
+		if (fp_iterator.is_extensible_param()) {
+			signature->extensible = true;
+			break;
+		}
+	}
+	return *signature;
+}
+
+
 bool fill_candidate_datatypes_c::match_nonformal_call(symbol_c *f_call, symbol_c *f_decl) {
 	symbol_c *call_param_value,  *param_datatype;
-	identifier_c *param_name;
-	function_param_iterator_c       fp_iterator(f_decl);
 	function_call_param_iterator_c fcp_iterator(f_call);
-	int extensible_parameter_highest_index = -1;
-	unsigned int i;
+	nonformal_signature_t &signature = get_nonformal_signature(f_decl);
+	unsigned int i = 0;
 
 	/* Iterating through the non-formal parameters of the function call */
 	while((call_param_value = fcp_iterator.next_nf()) != NULL) {
-		/* Iterate to the next parameter of the function being called.
-		 * Get the name of that parameter, and ignore if EN or ENO.
+		/* Get the type of the next parameter of the function being called (EN and ENO are not included in the signature). */
+		if (i < signature.param_types.size())
+			param_datatype = signature.param_types[i++];
+		/* If there is no other parameter declared, then we are passing too many parameters... 
+		 * ...unless the last parameter is an extensible parameter, which may be passed any number of times.
 		 */
-		do {
-			param_name = fp_iterator.next();
-			/* If there is no other parameter declared, then we are passing too many parameters... */
-			if(param_name == NULL) return false;
-		} while ((strcmp(param_name->value, "EN") == 0) || (strcmp(param_name->value, "ENO") == 0));
-
-		/* Get the parameter type */
-		param_datatype = base_type(fp_iterator.param_type());
+		else if (signature.extensible)
+			param_datatype = signature.param_types.back();
+		else
+			return false;
 		
 		/* check whether one of the candidate_data_types of the value being passed is the same as the param_type */
-		if (search_in_candidate_datatype_list(param_datatype, call_param_value->candidate_datatypes) < 0)
+		if (search_in_candidate_datatype_list(param_datatype, call_param_value->get_candidate_datatypes()) < 0)
 			return false; /* return false if param_type not in the list! */
 	}
 	/* call is compatible! */
@@ -431,7 +447,7 @@ bool fill_candidate_datatypes_c::match_formal_call(symbol_c *f_call, symbol_c *f
 			return false;
 
 		/* Obtaining the type of the value being passed in the function call */
-		std::vector <symbol_c *>&call_param_types = call_param_value->candidate_datatypes;
+		const symbol_c::candidate_datatypes_t &call_param_types = call_param_value->get_candidate_datatypes();
 
 		/* Find the corresponding parameter in function declaration */
 		param_name = fp_iterator.search(call_param_name);
@@ -493,16 +509,56 @@ void *fill_candidate_datatypes_c::handle_function_call(symbol_c *f_call, symbol_
                                                        std::vector <symbol_c *> *candidate_datatypes,
                                                        std::vector <symbol_c *> *candidate_functions) {
   */
+/* Determine the key with which a non formal function call is stored in the overload_index.
+ * The key contains the function being called (its first declaration in the function symbol table), and the elementary
+ * datatypes (i.e. the bitset of the candidate_datatypes_c) of each parameter being passed, which is all that
+ * match_nonformal_call() depends on when the parameters have no other candidate datatypes.
+ * Returns false if the call may not be indexed.
+ */
+bool fill_candidate_datatypes_c::get_overload_key(symbol_c *fcall, symbol_c *f_decl, overload_key_t &key) {
+	symbol_c *call_param_value;
+	function_call_param_iterator_c fcp_iterator(fcall);
+
+	key.push_back(f_decl->id);
+	while((call_param_value = fcp_iterator.next_nf()) != NULL) {
+		if (0 != call_param_value->get_candidate_datatypes().get_other_count())
+			return false;
+		key.push_back(call_param_value->get_candidate_datatypes().get_elementary_set());
+	}
+	return true;
+}
+
+
+/* Look for all function declarations (in the function symbol table) compatible with the function call */
+void fill_candidate_datatypes_c::search_compatible_functions(symbol_c *fcall, generic_function_call_t &fcall_data, std::vector<function_declaration_c *> &compatible_functions) {
+	function_symtable_t::iterator lower = function_symtable.lower_bound(fcall_data.function_name);
+	function_symtable_t::iterator upper = function_symtable.upper_bound(fcall_data.function_name);
+
+	for(; lower != upper; lower++) {
+		bool compatible = false;
+		
+		function_declaration_c *f_decl = function_symtable.get_value(lower);
+		/* Check if function declaration in symbol_table is compatible with parameters */
+		if (NULL != fcall_data.nonformal_operand_list) compatible=match_nonformal_call(fcall, f_decl);
+		if (NULL != fcall_data.   formal_operand_list) compatible=   match_formal_call(fcall, f_decl);
+		if (compatible)
+			compatible_functions.push_back(f_decl);
+	}
+}
+
+
 void fill_candidate_datatypes_c::handle_function_call(symbol_c *fcall, generic_function_call_t fcall_data) {
 	function_declaration_c *f_decl;
 	list_c *parameter_list;
 	list_c *parameter_candidate_datatypes;
 	symbol_c *returned_parameter_type;
+	std::vector<function_declaration_c *>  compatible_functions_buffer;
+	std::vector<function_declaration_c *> *compatible_functions = &compatible_functions_buffer;
+	overload_key_t overload_key;
 
 	if (debug) std::cout << "function()\n";
 
 	function_symtable_t::iterator lower = function_symtable.lower_bound(fcall_data.function_name);
-	function_symtable_t::iterator upper = function_symtable.upper_bound(fcall_data.function_name);
 	/* If the name of the function being called is not found in the function symbol table, then this is an invalid call */
 	/* Since the lexical parser already checks for this, then if this occurs then we have an internal compiler error. */
 	if (lower == function_symtable.end()) ERROR;
@@ -527,24 +583,34 @@ void fill_candidate_datatypes_c::handle_function_call(symbol_c *fcall, generic_f
 			fcall_data.candidate_functions.push_back(f_decl);
 		
 	}
-	for(; lower != upper; lower++) {
-		bool compatible = false;
-		
-		f_decl = function_symtable.get_value(lower);
-		/* Check if function declaration in symbol_table is compatible with parameters */
-		if (NULL != fcall_data.nonformal_operand_list) compatible=match_nonformal_call(fcall, f_decl);
-		if (NULL != fcall_data.   formal_operand_list) compatible=   match_formal_call(fcall, f_decl);
-		if (compatible) {
-			/* Add the data type returned by the called functions. 
-			 * However, only do this if this data type is not already present in the candidate_datatypes list_c
-			 */
-			returned_parameter_type = base_type(f_decl->type_name);		
-			if (add_datatype_to_candidate_list(fcall, returned_parameter_type))
-				/* we only add it to the function declaration list if this entry was not already present in the candidate datatype list! */
-				fcall_data.candidate_functions.push_back(f_decl);
+
+	/* Many function calls (e.g. ADD(a, b) or INT_TO_REAL(x)) are to functions with many overloaded declarations, but with parameters
+	 * whose candidate datatypes are the same as those of a previous call to the same function. The compatible function 
+	 * declarations are therefore stored in the overload_index, so they need only be searched for once. 
+	 */
+	if (   (NULL != fcall_data.nonformal_operand_list) && (NULL == fcall_data.formal_operand_list) 
+	    && get_overload_key(fcall, function_symtable.get_value(lower), overload_key)) {
+		overload_index_t::iterator iter = overload_index.find(overload_key);
+		if (iter != overload_index.end())
+			compatible_functions = &(iter->second);
+		else {
+			compatible_functions = &(overload_index[overload_key]);
+			search_compatible_functions(fcall, fcall_data, *compatible_functions);
 		}
+	} else
+		search_compatible_functions(fcall, fcall_data, *compatible_functions);
+
+	for(unsigned int i = 0; i < compatible_functions->size(); i++) {
+		f_decl = (*compatible_functions)[i];
+		/* Add the data type returned by the called functions. 
+		 * However, only do this if this data type is not already present in the candidate_datatypes list_c
+		 */
+		returned_parameter_type = base_type(f_decl->type_name);		
+		if (add_datatype_to_candidate_list(fcall, returned_parameter_type))
+			/* we only add it to the function declaration list if this entry was not already present in the candidate datatype list! */
+			fcall_data.candidate_functions.push_back(f_decl);
 	}
-	if (debug) std::cout << "end_function() [" << fcall->candidate_datatypes.size() << "] result.\n";
+	if (debug) std::cout << "end_function() [" << fcall->get_candidate_datatypes().size() << "] result.\n";
 	return;
 }
 
@@ -580,9 +646,9 @@ void *fill_candidate_datatypes_c::handle_implicit_il_fb_call(symbol_c *il_instru
 	 * here).
 	 */
 	if (NULL != prev_il_instruction)
-		il_instruction->candidate_datatypes = prev_il_instruction->candidate_datatypes; 
+		il_instruction->candidate_datatypes() = prev_il_instruction->get_candidate_datatypes(); 
 
-	if (debug) std::cout << "handle_implicit_il_fb_call() [" << prev_il_instruction->candidate_datatypes.size() << "] ==> " << il_instruction->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout << "handle_implicit_il_fb_call() [" << prev_il_instruction->get_candidate_datatypes().size() << "] ==> " << il_instruction->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
@@ -604,10 +670,10 @@ void *fill_candidate_datatypes_c::handle_S_and_R_operator(symbol_c *symbol, cons
 	if (NULL == il_operand)          return NULL;
 
 	/* Try the Set/Reset semantics */
-	for (unsigned int i = 0; i < prev_il_instruction->candidate_datatypes.size(); i++) {
-		for(unsigned int j = 0; j < il_operand->candidate_datatypes.size(); j++) {
-			prev_instruction_type = prev_il_instruction->candidate_datatypes[i];
-			operand_type = il_operand->candidate_datatypes[j];
+	for (unsigned int i = 0; i < prev_il_instruction->get_candidate_datatypes().size(); i++) {
+		for(unsigned int j = 0; j < il_operand->get_candidate_datatypes().size(); j++) {
+			prev_instruction_type = prev_il_instruction->get_candidate_datatypes()[i];
+			operand_type = il_operand->get_candidate_datatypes()[j];
 			/* IEC61131-3, Table 52, Note (e) states that the datatype of the operand must be BOOL!
 			 * IEC61131-3, Table 52, line 3 states that this operator should "Set operand to 1 if current result is Boolean 1"
 			 *     which implies that the prev_instruction_type MUST also be BOOL compatible.
@@ -618,17 +684,17 @@ void *fill_candidate_datatypes_c::handle_S_and_R_operator(symbol_c *symbol, cons
 	}
 
 	/* if the appropriate semantics is not a Set/Reset of a boolean variable, the we try for the FB invocation! */
-	if (symbol->candidate_datatypes.size() == 0) {
+	if (symbol->get_candidate_datatypes().size() == 0) {
 		handle_implicit_il_fb_call(symbol,  operator_str, called_fb_declaration);
 		/* If it is also not a valid FB call, make sure the candidate_datatypes is empty (handle_implicit_il_fb_call may leave it non-empty!!) */
 		/* From here on out, all later code will consider the symbol->called_fb_declaration being NULL as an indication that this operator must use the
 		 * Set/Reset semantics, so we must also guarantee that the remainder of the state of this symbol is compatible with that assumption!
 		 */
 		if (NULL == called_fb_declaration)
-			symbol->candidate_datatypes.clear();
+			symbol->candidate_datatypes().clear();
 	}
 
-	if (debug) std::cout << operator_str << " [" << prev_il_instruction->candidate_datatypes.size() << "," << il_operand->candidate_datatypes.size() << "] ==> "  << symbol->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout << operator_str << " [" << prev_il_instruction->get_candidate_datatypes().size() << "," << il_operand->get_candidate_datatypes().size() << "] ==> "  << symbol->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
@@ -639,12 +705,12 @@ void *fill_candidate_datatypes_c::handle_binary_operator(const struct widen_entr
 	if (NULL == l_expr) return NULL; /* if no prev_il_instruction */
 	if (NULL == r_expr) return NULL; /* if no IL operand!! */
 
-	for(unsigned int i = 0; i < l_expr->candidate_datatypes.size(); i++)
-		for(unsigned int j = 0; j < r_expr->candidate_datatypes.size(); j++)
+	for(unsigned int i = 0; i < l_expr->get_candidate_datatypes().size(); i++)
+		for(unsigned int j = 0; j < r_expr->get_candidate_datatypes().size(); j++)
 			/* NOTE: add_datatype_to_candidate_list() will only really add the datatype if it is != NULL !!! */
-			add_datatype_to_candidate_list(symbol, widening_conversion(l_expr->candidate_datatypes[i], r_expr->candidate_datatypes[j], widen_table));
+			add_datatype_to_candidate_list(symbol, widening_conversion(l_expr->get_candidate_datatypes()[i], r_expr->get_candidate_datatypes()[j], widen_table));
 	remove_incompatible_datatypes(symbol);
-	if (debug) std::cout <<  "[" << l_expr->candidate_datatypes.size() << "," << r_expr->candidate_datatypes.size() << "] ==> "  << symbol->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout <<  "[" << l_expr->get_candidate_datatypes().size() << "," << r_expr->get_candidate_datatypes().size() << "] ==> "  << symbol->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
@@ -652,8 +718,8 @@ void *fill_candidate_datatypes_c::handle_binary_operator(const struct widen_entr
 
 /* handle a binary ST expression, like '+', '-', etc... */
 void *fill_candidate_datatypes_c::handle_binary_expression(const struct widen_entry widen_table[], symbol_c *symbol, symbol_c *l_expr, symbol_c *r_expr) {
-	l_expr->accept(*this);
-	r_expr->accept(*this);
+	dispatch(l_expr);
+	dispatch(r_expr);
 	return handle_binary_operator(widen_table, symbol, l_expr, r_expr);
 }
 
@@ -666,10 +732,10 @@ void *fill_candidate_datatypes_c::handle_binary_expression(const struct widen_en
  */
 void *fill_candidate_datatypes_c::handle_equality_comparison(const struct widen_entry widen_table[], symbol_c *symbol, symbol_c *l_expr, symbol_c *r_expr) {
 	handle_binary_expression(widen_table, symbol, l_expr, r_expr);
-	for(unsigned int i = 0; i < l_expr->candidate_datatypes.size(); i++)
-		for(unsigned int j = 0; j < r_expr->candidate_datatypes.size(); j++) {
-			if (   (get_datatype_info_c::is_enumerated(l_expr->candidate_datatypes[i]) && (l_expr->candidate_datatypes[i] == r_expr->candidate_datatypes[j]))
-			    || (get_datatype_info_c::is_ref_to    (l_expr->candidate_datatypes[i]) && get_datatype_info_c::is_type_equal(l_expr->candidate_datatypes[i], r_expr->candidate_datatypes[j])))   
+	for(unsigned int i = 0; i < l_expr->get_candidate_datatypes().size(); i++)
+		for(unsigned int j = 0; j < r_expr->get_candidate_datatypes().size(); j++) {
+			if (   (get_datatype_info_c::is_enumerated(l_expr->get_candidate_datatypes()[i]) && (l_expr->get_candidate_datatypes()[i] == r_expr->get_candidate_datatypes()[j]))
+			    || (get_datatype_info_c::is_ref_to    (l_expr->get_candidate_datatypes()[i]) && get_datatype_info_c::is_type_equal(l_expr->get_candidate_datatypes()[i], r_expr->get_candidate_datatypes()[j])))   
 				add_datatype_to_candidate_list(symbol, &get_datatype_info_c::bool_type_name);
 		}
 	return NULL;
@@ -685,17 +751,6 @@ symbol_c *fill_candidate_datatypes_c::base_type(symbol_c *symbol) {
 }
 
 
-/***************************/
-/* B 0 - Programming Model */
-/***************************/
-/* main entry function! */
-void *fill_candidate_datatypes_c::visit(library_c *symbol) {
-	symbol->accept(populate_globalenumvalue_symtable);
-	/* Now let the base class iterator_visitor_c iterate through all the library elements */
-	return iterator_visitor_c::visit(symbol);  
-}
-
-
 /*************************/
 /* B.1 - Common elements */
 /*************************/
@@ -717,7 +772,10 @@ void *fill_candidate_datatypes_c::visit(library_c *symbol) {
  * explicitly (assuming we do also implement the visitor for poutype_identifier_c). However, I will leave this code cleanup for some later oportunity.
  */
 void *fill_candidate_datatypes_c::visit(derived_datatype_identifier_c *symbol) {
-  add_datatype_to_candidate_list(symbol, base_type(                type_symtable[symbol->value])); // will only add if datatype is not NULL!
+  /* NOTE: do not use type_symtable[], as it would insert the identifier in the symtable if not found! */
+  type_symtable_t::iterator iter = type_symtable.find(symbol->value);
+  if (iter != type_symtable.end())
+    add_datatype_to_candidate_list(symbol, base_type(iter->second)); // will only add if datatype is not NULL!
   return NULL;
 }
 
@@ -785,7 +843,7 @@ void *fill_candidate_datatypes_c::handle_any_integer(symbol_c *symbol) {
 	add_2datatypes_to_candidate_list(symbol, &get_datatype_info_c::udint_type_name, &get_datatype_info_c::safeudint_type_name);
 	add_2datatypes_to_candidate_list(symbol, &get_datatype_info_c::ulint_type_name, &get_datatype_info_c::safeulint_type_name);
 	remove_incompatible_datatypes(symbol);
-	if (debug) std::cout << "ANY_INT [" << symbol->candidate_datatypes.size()<< "]" << std::endl;
+	if (debug) std::cout << "ANY_INT [" << symbol->get_candidate_datatypes().size()<< "]" << std::endl;
 	return NULL;
 }
 
@@ -795,18 +853,18 @@ void *fill_candidate_datatypes_c::handle_any_real(symbol_c *symbol) {
 	add_2datatypes_to_candidate_list(symbol, &get_datatype_info_c::real_type_name,  &get_datatype_info_c::safereal_type_name);
 	add_2datatypes_to_candidate_list(symbol, &get_datatype_info_c::lreal_type_name, &get_datatype_info_c::safelreal_type_name);
 	remove_incompatible_datatypes(symbol);
-	if (debug) std::cout << "ANY_REAL [" << symbol->candidate_datatypes.size() << "]" << std::endl;
+	if (debug) std::cout << "ANY_REAL [" << symbol->get_candidate_datatypes().size() << "]" << std::endl;
 	return NULL;
 }
 
 
 
 void *fill_candidate_datatypes_c::handle_any_literal(symbol_c *symbol, symbol_c *symbol_value, symbol_c *symbol_type) {
-	symbol_value->accept(*this);
-	if (search_in_candidate_datatype_list(symbol_type, symbol_value->candidate_datatypes) >= 0)
+	dispatch(symbol_value);
+	if (search_in_candidate_datatype_list(symbol_type, symbol_value->get_candidate_datatypes()) >= 0)
 		add_datatype_to_candidate_list(symbol, symbol_type);
 	remove_incompatible_datatypes(symbol);
-	if (debug) std::cout << "ANY_LITERAL [" << symbol->candidate_datatypes.size() << "]\n";
+	if (debug) std::cout << "ANY_LITERAL [" << symbol->get_candidate_datatypes().size() << "]\n";
 	return NULL;
 }
 
@@ -824,7 +882,7 @@ void *fill_candidate_datatypes_c::visit(neg_integer_c *symbol) {
 	add_2datatypes_to_candidate_list(symbol, &get_datatype_info_c::dint_type_name, &get_datatype_info_c::safedint_type_name);
 	add_2datatypes_to_candidate_list(symbol, &get_datatype_info_c::lint_type_name, &get_datatype_info_c::safelint_type_name);
 	remove_incompatible_datatypes(symbol);
-	if (debug) std::cout << "neg ANY_INT [" << symbol->candidate_datatypes.size() << "]" << std::endl;
+	if (debug) std::cout << "neg ANY_INT [" << symbol->get_candidate_datatypes().size() << "]" << std::endl;
 	return NULL;
 }
 
@@ -852,8 +910,8 @@ void *fill_candidate_datatypes_c::visit(bit_string_literal_c *symbol) {return ha
 void *fill_candidate_datatypes_c::visit(   boolean_literal_c *symbol) {
 	if (NULL != symbol->type) return handle_any_literal(symbol, symbol->value, symbol->type);
 
-	symbol->value->accept(*this);
-	symbol->candidate_datatypes = symbol->value->candidate_datatypes;
+	dispatch(symbol->value);
+	symbol->candidate_datatypes() = symbol->value->get_candidate_datatypes();
 	return NULL;
 }
 
@@ -889,7 +947,7 @@ void *fill_candidate_datatypes_c::visit(single_byte_character_string_c *symbol)
 /************************/
 void *fill_candidate_datatypes_c::visit(duration_c *symbol) {
 	add_datatype_to_candidate_list(symbol, symbol->type_name);
-	if (debug) std::cout << "TIME_LITERAL [" << symbol->candidate_datatypes.size() << "]\n";
+	if (debug) std::cout << "TIME_LITERAL [" << symbol->get_candidate_datatypes().size() << "]\n";
 	return NULL;
 }
 
@@ -925,9 +983,9 @@ void *fill_candidate_datatypes_c::fill_type_decl(symbol_c *symbol, symbol_c *typ
    *       declaration. In summary, a top->down algorithm!
    */ 
   add_datatype_to_candidate_list(symbol, base_type(symbol));
-  type_name->candidate_datatypes = symbol->candidate_datatypes;  // use top->down algorithm!!
-  spec_init->candidate_datatypes = symbol->candidate_datatypes;  // use top->down algorithm!!
-  spec_init->accept(*this);
+  type_name->candidate_datatypes() = symbol->get_candidate_datatypes();  // use top->down algorithm!!
+  spec_init->candidate_datatypes() = symbol->get_candidate_datatypes();  // use top->down algorithm!!
+  dispatch(spec_init);
   return NULL;
 }
 
@@ -950,12 +1008,12 @@ void *fill_candidate_datatypes_c::fill_spec_init(symbol_c *symbol, symbol_c *typ
 	 *      This method must handle the above case, as well as the case in which the ***_spec_init_c is called
 	 *      from an ****_type_declaration_c.
 	 */
-	if (symbol->candidate_datatypes.size() == 0) // i.e., if this is an anonymous datatype!
+	if (symbol->get_candidate_datatypes().size() == 0) // i.e., if this is an anonymous datatype!
 		add_datatype_to_candidate_list(symbol, base_type(symbol)); 
 	
 	// use top->down algorithm!!
-	type_spec->candidate_datatypes = symbol->candidate_datatypes;   
-	type_spec->accept(*this);
+	type_spec->candidate_datatypes() = symbol->get_candidate_datatypes();   
+	dispatch(type_spec);
 	
 	// use bottom->up algorithm!!
 	/* NOTE: In special cases we will run a modified bottom->up algorithm, i.e. with a top->down indication of 
@@ -966,7 +1024,7 @@ void *fill_candidate_datatypes_c::fill_spec_init(symbol_c *symbol, symbol_c *typ
 	 *       This implies that we can only run this bottom->up algorithm on the initial values _after_
 	 *       having set the symbol->candidate_datatpes of the type specification (i.e. the symbol parameter)
 	 */
-	if (NULL != init_value)  init_value->accept(*this);
+	if (NULL != init_value)  dispatch(init_value);
 	/* NOTE: Even if the constant and the type are of incompatible data types, we let the
 	 *       ***_spec_init_c object inherit the data type of the type declaration (simple_specification)
 	 *       This will let us produce more informative error messages when checking data type compatibility
@@ -1011,13 +1069,18 @@ void *fill_candidate_datatypes_c::visit(subrange_spec_init_c *symbol) {return fi
 /* dimension will be filled in during stage 3 (array_range_check_c) with the number of elements in this subrange */
 // SYM_REF2(subrange_c, lower_limit, upper_limit, unsigned long long int dimension;)
 void *fill_candidate_datatypes_c::visit(subrange_c *symbol) {
-	symbol->lower_limit->accept(*this);
-	symbol->upper_limit->accept(*this);
+	/* A subrange shared by several identical datatypes (see hash_cons.hh) is visited once for each
+	 * of them, but its candidate datatypes only need to be determined the first time around.
+	 */
+	if (symbol->get_candidate_datatypes().size() > 0) return NULL;
+
+	dispatch(symbol->lower_limit);
+	dispatch(symbol->upper_limit);
 	
-	for (unsigned int u = 0; u < symbol->upper_limit->candidate_datatypes.size(); u++) {
-		for(unsigned int l = 0; l < symbol->lower_limit->candidate_datatypes.size(); l++) {
-			if (get_datatype_info_c::is_type_equal(symbol->upper_limit->candidate_datatypes[u], symbol->lower_limit->candidate_datatypes[l]))
-				add_datatype_to_candidate_list(symbol, symbol->lower_limit->candidate_datatypes[l]);
+	for (unsigned int u = 0; u < symbol->upper_limit->get_candidate_datatypes().size(); u++) {
+		for(unsigned int l = 0; l < symbol->lower_limit->get_candidate_datatypes().size(); l++) {
+			if (get_datatype_info_c::is_type_equal(symbol->upper_limit->get_candidate_datatypes()[u], symbol->lower_limit->get_candidate_datatypes()[l]))
+				add_datatype_to_candidate_list(symbol, symbol->lower_limit->get_candidate_datatypes()[l]);
 		}
 	}
 	return NULL;
@@ -1039,8 +1102,8 @@ void *fill_candidate_datatypes_c::visit(enumerated_spec_init_c *symbol) {return
 /* enumerated_value_list ',' enumerated_value */
 // SYM_LIST(enumerated_value_list_c)
 void *fill_candidate_datatypes_c::visit(enumerated_value_list_c *symbol) {
-  if (symbol->candidate_datatypes.size() != 1) ERROR;
-  symbol_c *current_enumerated_spec_type = symbol->candidate_datatypes[0];
+  if (symbol->get_candidate_datatypes().size() != 1) ERROR;
+  symbol_c *current_enumerated_spec_type = symbol->get_candidate_datatypes()[0];
   
   /* We already know the datatype of the enumerated_value(s) in the list, so we set them directly instead of recursively calling the enumerated_value_c visit method! */
   for(int i = 0; i < symbol->n; i++)
@@ -1118,7 +1181,7 @@ void *fill_candidate_datatypes_c::visit(enumerated_value_c *symbol) {
 	if (NULL != enumerated_type)
 		add_datatype_to_candidate_list(symbol, enumerated_type);
 
-	if (debug) std::cout << "ENUMERATE [" << symbol->candidate_datatypes.size() << "]\n";
+	if (debug) std::cout << "ENUMERATE [" << symbol->get_candidate_datatypes().size() << "]\n";
 	return NULL;
 }
 
@@ -1173,13 +1236,13 @@ void *fill_candidate_datatypes_c::visit(initialized_structure_c *symbol) {return
 // SYM_LIST(structure_element_initialization_list_c)
 void *fill_candidate_datatypes_c::visit(structure_element_initialization_list_c *symbol) {
 	// use bottom->up algorithm -> first let all elements determine their candidate_datatypes
-	iterator_visitor_c::visit(symbol); // call visit(structure_element_initialization_c *) on all elements
+	visit_list(symbol); // call visit(structure_element_initialization_c *) on all elements
 
-	for (unsigned int i = 0; i < symbol->parent->candidate_datatypes.size(); i++) { // size() should always be 1 here -> a single structure or FB type!
+	for (unsigned int i = 0; i < symbol->parent->get_candidate_datatypes().size(); i++) { // size() should always be 1 here -> a single structure or FB type!
 		// assume symbol->parent->candidate_datatypes[i] is a FB type
-		search_varfb_instance_type_c search_varfb_instance_type(symbol->parent->candidate_datatypes[i]);
+		search_varfb_instance_type_c search_varfb_instance_type(symbol->parent->get_candidate_datatypes()[i]);
 		// assume symbol->parent->candidate_datatypes[i] is a STRUCT data type
-		structure_element_declaration_list_c *struct_decl = dynamic_cast<structure_element_declaration_list_c *>(symbol->parent->candidate_datatypes[i]);
+		structure_element_declaration_list_c *struct_decl = dynamic_cast<structure_element_declaration_list_c *>(symbol->parent->get_candidate_datatypes()[i]);
 		// flag indicating all struct_elem->structure_element_name are structure elements found in the symbol->parent->candidate_datatypes[i] datatype
 		int flag_all_elem_ok = 1; // assume all found
 		for (int k = 0; k < symbol->n; k++) {
@@ -1198,14 +1261,14 @@ void *fill_candidate_datatypes_c::visit(structure_element_initialization_list_c
 			if (!get_datatype_info_c::is_ANY_ELEMENTARY(type) && get_datatype_info_c::is_type_valid(type)) {
 				// for non-elementary datatypes, we must use a top->down algorithm!!
 				add_datatype_to_candidate_list(struct_elem, type); 
-				struct_elem->accept(*this);
+				dispatch(struct_elem);
 			}
-			if (search_in_candidate_datatype_list(type, struct_elem->candidate_datatypes) < 0) {
+			if (search_in_candidate_datatype_list(type, struct_elem->get_candidate_datatypes()) < 0) {
 				flag_all_elem_ok = 0; // the necessary datatype for structure init element is not a candidate_datatype of that element
 			}
 		}
 		if (flag_all_elem_ok) {
-			add_datatype_to_candidate_list(symbol, symbol->parent->candidate_datatypes[i]);
+			add_datatype_to_candidate_list(symbol, symbol->parent->get_candidate_datatypes()[i]);
 		}
 	}
 	return NULL;
@@ -1215,8 +1278,8 @@ void *fill_candidate_datatypes_c::visit(structure_element_initialization_list_c
 /*  structure_element_name ASSIGN value */
 // SYM_REF2(structure_element_initialization_c, structure_element_name, value)
 void *fill_candidate_datatypes_c::visit(structure_element_initialization_c *symbol) {
-	symbol->value->accept(*this);
-	symbol->candidate_datatypes = symbol->value->candidate_datatypes;
+	dispatch(symbol->value);
+	symbol->candidate_datatypes() = symbol->value->get_candidate_datatypes();
 	// Note that candidate_datatypes of symbol->structure_element_name are left empty!
 	return NULL;
 }
@@ -1238,9 +1301,9 @@ void *fill_candidate_datatypes_c::visit(ref_spec_c *symbol) {
   
 	// when parsing datatype declarations, fill_candidate_datatypes_c follows a top->down algorithm (see the comment in fill_type_decl() for an explanation)
 	add_datatype_to_candidate_list(symbol->type_name, base_type(symbol->type_name)); 
-	symbol->type_name->accept(*this);  /* The referenced/pointed to datatype! */
+	dispatch(symbol->type_name);  /* The referenced/pointed to datatype! */
 
-	if (symbol->candidate_datatypes.size() == 0) // i.e., if this is an anonymous datatype!
+	if (symbol->get_candidate_datatypes().size() == 0) // i.e., if this is an anonymous datatype!
 		add_datatype_to_candidate_list(symbol, base_type(symbol)); 
 
 	return NULL;
@@ -1266,7 +1329,7 @@ void *fill_candidate_datatypes_c::visit(ref_type_decl_c *symbol) {return fill_ty
 void *fill_candidate_datatypes_c::visit(symbolic_variable_c *symbol) {
 	symbol->scope = current_scope;  // the scope in which this variable was declared!
 	add_datatype_to_candidate_list(symbol, search_var_instance_decl->get_basetype_decl(symbol)); /* will only add if non NULL */
-	if (debug) std::cout << "VAR [" << symbol->candidate_datatypes.size() << "]\n";
+	if (debug) std::cout << "VAR [" << symbol->get_candidate_datatypes().size() << "]\n";
 	return NULL;
 }
 
@@ -1317,21 +1380,21 @@ void *fill_candidate_datatypes_c::visit(array_variable_c *symbol) {
 	 *          structvar: a_s;
 	 *        END_VAR
 	 */
-	symbol->subscripted_variable->accept(*this);
+	dispatch(symbol->subscripted_variable);
 	// the scope in which this variable was declared! It will be the same as the subscripted variable (a symbolic_variable_ !)
 	symbol->scope = symbol->subscripted_variable->scope;
 	if (NULL == symbol->scope) ERROR;
 
 	
-	for (unsigned int i = 0; i < symbol->subscripted_variable->candidate_datatypes.size(); i++) {
+	for (unsigned int i = 0; i < symbol->subscripted_variable->get_candidate_datatypes().size(); i++) {
 	  /* get the declaration of the data type __stored__ in the array... */
-	  add_datatype_to_candidate_list(symbol, search_base_type_c::get_basetype_decl(get_datatype_info_c::get_array_storedtype_id(symbol->subscripted_variable->candidate_datatypes[i])));   /* will only add if non NULL */
+	  add_datatype_to_candidate_list(symbol, search_base_type_c::get_basetype_decl(get_datatype_info_c::get_array_storedtype_id(symbol->subscripted_variable->get_candidate_datatypes()[i])));   /* will only add if non NULL */
 	}
 
 	/* recursively call the subscript list, so we can check the data types of the expressions used for the subscripts */
-	symbol->subscript_list->accept(*this);
+	dispatch(symbol->subscript_list);
 
-	if (debug) std::cout << "ARRAY_VAR [" << symbol->candidate_datatypes.size() << "]\n";	
+	if (debug) std::cout << "ARRAY_VAR [" << symbol->get_candidate_datatypes().size() << "]\n";	
 	return NULL;
 }
 
@@ -1355,12 +1418,12 @@ void *fill_candidate_datatypes_c::visit(structured_variable_c *symbol) {
 	 * The expression, may even contain a function call to an overloaded function!
 	 *      (e.g.  arrayvar[ varx + TRUNC(realvar)].elem1)
 	 */
-	symbol->record_variable->accept(*this);
+	dispatch(symbol->record_variable);
 
-	if (symbol->record_variable->candidate_datatypes.size() == 1) {
+	if (symbol->record_variable->get_candidate_datatypes().size() == 1) {
 	  // set the scope in which this variable is declared (will be a struct datatype declaration!)
 	  // We rely on the fact that if only one candidate datatype exists, then it will be the scope in which the field_variable is declared!
-	  symbol->scope = symbol->record_variable->candidate_datatypes[0];  // the scope in which this variable was declared! Will be used in stage4
+	  symbol->scope = symbol->record_variable->get_candidate_datatypes()[0];  // the scope in which this variable was declared! Will be used in stage4
 	  // Determine candidate datatypes...
 	  add_datatype_to_candidate_list(symbol, search_base_type_c::get_basetype_decl(get_datatype_info_c::get_struct_field_type_id(symbol->scope, symbol->field_selector)));  /* will only add if non NULL */
 	}
@@ -1398,12 +1461,12 @@ void *fill_candidate_datatypes_c::fill_var_declaration(symbol_c *var_list, symbo
    * so we do not need to do anything special here!
    */
   add_datatype_to_candidate_list(type, search_base_type_c::get_basetype_decl(type));  /* will only add if non NULL */
-  type->accept(*this);
+  dispatch(type);
   // handle the extensible_input_parameter_c, etc...
   /* The extensible_input_parameter_c will be visited since this class inherits from the iterator_visitor_c.
    * It needs to be visited in order to handle the datatype of the first_index parameter of that class.
    */
-  var_list->accept(*this);
+  dispatch(var_list);
   return NULL;
 }
 
@@ -1424,7 +1487,7 @@ void *fill_candidate_datatypes_c::visit(incompl_located_var_decl_c   *symbol) {r
 
 // NOTE: this method is not required since fill_candidate_datatypes_c inherits from iterator_visitor_c. TODO: delete this method!
 void *fill_candidate_datatypes_c::visit(var1_list_c *symbol) {
-  for(int i = 0; i < symbol->n; i++) {symbol->get_element(i)->accept(*this);}
+  for(int i = 0; i < symbol->n; i++) {dispatch(symbol->get_element(i));}
   return NULL;
 }  
 
@@ -1461,9 +1524,9 @@ void *fill_candidate_datatypes_c::visit(location_c *symbol) {
   *  For this reason, a location_c may have more allowable data types than a direct_variable_c
   */
 
-	symbol->direct_variable->accept(*this);
-	for (unsigned int i = 0; i < symbol->direct_variable->candidate_datatypes.size(); i++) {
-        symbol_c *candidate_datatype = symbol->direct_variable->candidate_datatypes[i];
+	dispatch(symbol->direct_variable);
+	for (unsigned int i = 0; i < symbol->direct_variable->get_candidate_datatypes().size(); i++) {
+        symbol_c *candidate_datatype = symbol->direct_variable->get_candidate_datatypes()[i];
         if(get_datatype_info_c::is_ANY_generic_type(candidate_datatype)){
             add_datatype_to_candidate_list(symbol, &get_datatype_info_c::any_type_name);
         } else {
@@ -1522,10 +1585,10 @@ void *fill_candidate_datatypes_c::visit(location_c *symbol) {
 /* variable_name -> may be NULL ! */
 // SYM_REF3(located_var_decl_c, variable_name, location, located_var_spec_init)
 void *fill_candidate_datatypes_c::visit(located_var_decl_c *symbol) {
-  symbol->located_var_spec_init->accept(*this);
-  symbol->location->accept(*this);
+  dispatch(symbol->located_var_spec_init);
+  dispatch(symbol->location);
   if (NULL != symbol->variable_name) {
-    symbol->variable_name->candidate_datatypes = symbol->location->candidate_datatypes;
+    symbol->variable_name->candidate_datatypes() = symbol->location->get_candidate_datatypes();
     intersect_candidate_datatype_list(symbol->variable_name /*origin, dest.*/, symbol->located_var_spec_init /*with*/);
   }
   return NULL;
@@ -1543,11 +1606,12 @@ void *fill_candidate_datatypes_c::visit(function_declaration_c *symbol) {
 	if (debug) printf("Filling candidate data types list of function %s\n", ((token_c *)(symbol->derived_function_name))->value);
 	local_enumerated_value_symtable.reset();
 	current_scope = symbol;	
+	populate_localenumvalue_symtable_c populate_enumvalue_symtable(&local_enumerated_value_symtable);
 	symbol->var_declarations_list->accept(populate_enumvalue_symtable);
 
 	search_var_instance_decl = new search_var_instance_decl_c(symbol);
-	symbol->var_declarations_list->accept(*this);
-	symbol->function_body->accept(*this);
+	dispatch(symbol->var_declarations_list);
+	dispatch(symbol->function_body);
 	delete search_var_instance_decl;
 	search_var_instance_decl = NULL;
 
@@ -1563,11 +1627,12 @@ void *fill_candidate_datatypes_c::visit(function_block_declaration_c *symbol) {
 	if (debug) printf("Filling candidate data types list of FB %s\n", ((token_c *)(symbol->fblock_name))->value);
 	local_enumerated_value_symtable.reset();
 	current_scope = symbol;	
+	populate_localenumvalue_symtable_c populate_enumvalue_symtable(&local_enumerated_value_symtable);
 	symbol->var_declarations->accept(populate_enumvalue_symtable);
 
 	search_var_instance_decl = new search_var_instance_decl_c(symbol);
-	symbol->var_declarations->accept(*this);
-	symbol->fblock_body->accept(*this);
+	dispatch(symbol->var_declarations);
+	dispatch(symbol->fblock_body);
 	delete search_var_instance_decl;
 	search_var_instance_decl = NULL;
 
@@ -1589,11 +1654,12 @@ void *fill_candidate_datatypes_c::visit(program_declaration_c *symbol) {
 	if (debug) printf("Filling candidate data types list in program %s\n", ((token_c *)(symbol->program_type_name))->value);
 	local_enumerated_value_symtable.reset();
 	current_scope = symbol;	
+	populate_localenumvalue_symtable_c populate_enumvalue_symtable(&local_enumerated_value_symtable);
 	symbol->var_declarations->accept(populate_enumvalue_symtable);
 	
 	search_var_instance_decl = new search_var_instance_decl_c(symbol);
-	symbol->var_declarations->accept(*this);
-	symbol->function_block_body->accept(*this);
+	dispatch(symbol->var_declarations);
+	dispatch(symbol->function_block_body);
 	delete search_var_instance_decl;
 	search_var_instance_decl = NULL;
 
@@ -1610,17 +1676,17 @@ void *fill_candidate_datatypes_c::visit(transition_condition_c *symbol) {
 	symbol_c *condition_type;
 
 	if (symbol->transition_condition_il != NULL) {
-		symbol->transition_condition_il->accept(*this);
-		for (unsigned int i = 0; i < symbol->transition_condition_il->candidate_datatypes.size(); i++) {
-			condition_type = symbol->transition_condition_il->candidate_datatypes[i];
+		dispatch(symbol->transition_condition_il);
+		for (unsigned int i = 0; i < symbol->transition_condition_il->get_candidate_datatypes().size(); i++) {
+			condition_type = symbol->transition_condition_il->get_candidate_datatypes()[i];
 			if (get_datatype_info_c::is_BOOL_compatible(condition_type))
 				add_datatype_to_candidate_list(symbol, condition_type);
 		}
 	}
 	if (symbol->transition_condition_st != NULL) {
-		symbol->transition_condition_st->accept(*this);
-		for (unsigned int i = 0; i < symbol->transition_condition_st->candidate_datatypes.size(); i++) {
-			condition_type = symbol->transition_condition_st->candidate_datatypes[i];
+		dispatch(symbol->transition_condition_st);
+		for (unsigned int i = 0; i < symbol->transition_condition_st->get_candidate_datatypes().size(); i++) {
+			condition_type = symbol->transition_condition_st->get_candidate_datatypes()[i];
 			if (get_datatype_info_c::is_BOOL_compatible(condition_type))
 				add_datatype_to_candidate_list(symbol, condition_type);
 		}
@@ -1638,10 +1704,10 @@ void *fill_candidate_datatypes_c::visit(configuration_declaration_c *symbol) {
 //	symbol->global_var_declarations->accept(populate_enumvalue_symtable);  // TODO
 	
 	search_var_instance_decl = new search_var_instance_decl_c(symbol);
-	symbol->global_var_declarations          ->accept(*this);
-	symbol->resource_declarations            ->accept(*this); // points to a single_resource_declaration_c or a resource_declaration_list_c
-//	symbol->access_declarations              ->accept(*this); // TODO
-//	symbol->instance_specific_initializations->accept(*this); // TODO
+	dispatch(symbol->global_var_declarations);
+	dispatch(symbol->resource_declarations); // points to a single_resource_declaration_c or a resource_declaration_list_c
+//	dispatch(symbol->access_declarations); // TODO
+//	dispatch(symbol->instance_specific_initializations); // TODO
 
 	delete search_var_instance_decl;
 	search_var_instance_decl = NULL;
@@ -1664,8 +1730,8 @@ void *fill_candidate_datatypes_c::visit(resource_declaration_c *symbol) {
 	
 	search_var_instance_decl_c *prev_search_var_instance_decl = search_var_instance_decl;
 	search_var_instance_decl  = new  search_var_instance_decl_c(symbol);
-	symbol->global_var_declarations->accept(*this);
-	symbol->resource_declaration   ->accept(*this);  // points to a single_resource_declaration_c!
+	dispatch(symbol->global_var_declarations);
+	dispatch(symbol->resource_declaration);  // points to a single_resource_declaration_c!
 
 	delete search_var_instance_decl;
 	search_var_instance_decl = prev_search_var_instance_decl;
@@ -1677,8 +1743,8 @@ void *fill_candidate_datatypes_c::visit(resource_declaration_c *symbol) {
 
 
 void *fill_candidate_datatypes_c::visit(single_resource_declaration_c *symbol) {
-//	symbol->task_configuration_list    ->accept(*this);  // TODO
-//	symbol->program_configuration_list ->accept(*this);  // TODO
+//	dispatch(symbol->task_configuration_list);  // TODO
+//	dispatch(symbol->program_configuration_list);  // TODO
 	return NULL;
 }
 
@@ -1708,7 +1774,7 @@ void *fill_candidate_datatypes_c::visit(instruction_list_c *symbol) {
 	 */
 	for(int j = 0; j < 2; j++) {
 		for(int i = 0; i < symbol->n; i++) {
-			symbol->get_element(i)->accept(*this);
+			dispatch(symbol->get_element(i));
 		}
 	}
 	return NULL;
@@ -1731,11 +1797,11 @@ void *fill_candidate_datatypes_c::visit(il_instruction_c *symbol) {
 
 		if (symbol->prev_il_instruction.size() == 0)  prev_il_instruction = NULL;
 		else                                          prev_il_instruction = &fake_prev_il_instruction;
-		symbol->il_instruction->accept(*this);
+		dispatch(symbol->il_instruction);
 		prev_il_instruction = NULL;
 
 		/* This object has (inherits) the same candidate datatypes as the il_instruction */
-		symbol->candidate_datatypes = symbol->il_instruction->candidate_datatypes;
+		symbol->candidate_datatypes() = symbol->il_instruction->get_candidate_datatypes();
 	}
 
 	return NULL;
@@ -1746,14 +1812,14 @@ void *fill_candidate_datatypes_c::visit(il_instruction_c *symbol) {
 void *fill_candidate_datatypes_c::visit(il_simple_operation_c *symbol) {
 	/* determine the data type of the operand */
 	if (NULL != symbol->il_operand) {
-		symbol->il_operand->accept(*this);
+		dispatch(symbol->il_operand);
 	}
 	/* recursive call to fill the candidate data types list */
 	il_operand = symbol->il_operand;
-	symbol->il_simple_operator->accept(*this);
+	dispatch(symbol->il_simple_operator);
 	il_operand = NULL;
 	/* This object has (inherits) the same candidate datatypes as the il_simple_operator */
-	symbol->candidate_datatypes = symbol->il_simple_operator->candidate_datatypes;
+	symbol->candidate_datatypes() = symbol->il_simple_operator->get_candidate_datatypes();
 	return NULL;
 }
 
@@ -1772,7 +1838,7 @@ void *fill_candidate_datatypes_c::visit(il_function_call_c *symbol) {
 	if (NULL == symbol->il_operand_list)  symbol->il_operand_list = new il_operand_list_c;
 	if (NULL == symbol->il_operand_list)  ERROR;
 
-	symbol->il_operand_list->accept(*this);
+	dispatch(symbol->il_operand_list);
 
 	if (NULL != prev_il_instruction) {
 		((list_c *)symbol->il_operand_list)->insert_element(prev_il_instruction, 0);	
@@ -1799,7 +1865,7 @@ void *fill_candidate_datatypes_c::visit(il_function_call_c *symbol) {
 		symbol->il_operand_list = NULL;
 	}
 	
-	if (debug) std::cout << "il_function_call_c [" << symbol->candidate_datatypes.size() << "] result.\n";
+	if (debug) std::cout << "il_function_call_c [" << symbol->get_candidate_datatypes().size() << "] result.\n";
 	return NULL;
 }
 
@@ -1811,10 +1877,10 @@ void *fill_candidate_datatypes_c::visit(il_expression_c *symbol) {
   
   /* Stage2 will insert an artificial (and equivalent) LD <il_operand> to the simple_instr_list if necessary. We can therefore ignore the 'il_operand' entry! */
   // if (NULL != symbol->il_operand)
-  //   symbol->il_operand->accept(*this);
+  //   dispatch(symbol->il_operand);
 
   if(symbol->simple_instr_list != NULL)
-    symbol->simple_instr_list->accept(*this);
+    dispatch(symbol->simple_instr_list);
 
   /* Since stage2 will insert an artificial (and equivalent) LD <il_operand> to the simple_instr_list when an 'il_operand' exists, we know
    * that if (symbol->il_operand != NULL), then the first IL instruction in the simple_instr_list will be the equivalent and artificial
@@ -1823,16 +1889,16 @@ void *fill_candidate_datatypes_c::visit(il_expression_c *symbol) {
    */
   if ((NULL != symbol->il_operand) && ((NULL == symbol->simple_instr_list) || (0 == ((list_c *)symbol->simple_instr_list)->n))) ERROR; // stage2 is not behaving as we expect it to!
   if  (NULL != symbol->il_operand)
-    symbol->il_operand->candidate_datatypes = ((list_c *)symbol->simple_instr_list)->get_element(0)->candidate_datatypes;
+    symbol->il_operand->candidate_datatypes() = ((list_c *)symbol->simple_instr_list)->get_element(0)->get_candidate_datatypes();
   
   /* Now check the if the data type semantics of operation are correct,  */
   il_operand = symbol->simple_instr_list;
   prev_il_instruction = prev_il_instruction_backup;
-  symbol->il_expr_operator->accept(*this);
+  dispatch(symbol->il_expr_operator);
   il_operand = NULL;
   
   /* This object has the same candidate datatypes as the il_expr_operator. */
-  symbol->candidate_datatypes = symbol->il_expr_operator->candidate_datatypes;
+  symbol->candidate_datatypes() = symbol->il_expr_operator->get_candidate_datatypes();
   return NULL;
 }
 
@@ -1840,10 +1906,10 @@ void *fill_candidate_datatypes_c::visit(il_expression_c *symbol) {
 void *fill_candidate_datatypes_c::visit(il_jump_operation_c *symbol) {
   /* recursive call to fill the candidate data types list */
   il_operand = NULL;
-  symbol->il_jump_operator->accept(*this);
+  dispatch(symbol->il_jump_operator);
   il_operand = NULL;
   /* This object has the same candidate datatypes as the il_jump_operator. */
-  symbol->candidate_datatypes = symbol->il_jump_operator->candidate_datatypes;
+  symbol->candidate_datatypes() = symbol->il_jump_operator->get_candidate_datatypes();
   return NULL;
 }
 
@@ -1863,8 +1929,8 @@ void *fill_candidate_datatypes_c::visit(il_fb_call_c *symbol) {
 	/* Although a call to a non-declared FB is a semantic error, this is currently caught by stage 2! */
 	if (NULL == fb_decl) ERROR;
 
-	if (symbol->  il_param_list != NULL) symbol->il_param_list->accept(*this);
-	if (symbol->il_operand_list != NULL) symbol->il_operand_list->accept(*this);
+	if (symbol->  il_param_list != NULL) dispatch(symbol->il_param_list);
+	if (symbol->il_operand_list != NULL) dispatch(symbol->il_operand_list);
 
 	/* The print_datatypes_error_c does not rely on this called_fb_declaration pointer being != NULL to conclude that
 	 * we have a datat type incompatibility error, so setting it to the correct fb_decl is actually safe,
@@ -1879,10 +1945,10 @@ void *fill_candidate_datatypes_c::visit(il_fb_call_c *symbol) {
 	 *       Doing this is actually safe, as the parameter_list will still contain errors that will be found by
 	 *       print_datatypes_error_c, so the code will never reach stage 4!
 	 */
-	symbol->il_call_operator->accept(*this);
-	symbol->candidate_datatypes = symbol->il_call_operator->candidate_datatypes;
+	dispatch(symbol->il_call_operator);
+	symbol->candidate_datatypes() = symbol->il_call_operator->get_candidate_datatypes();
 
-	if (debug) std::cout << "FB [] ==> "  << symbol->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout << "FB [] ==> "  << symbol->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
@@ -1892,7 +1958,7 @@ void *fill_candidate_datatypes_c::visit(il_fb_call_c *symbol) {
 // SYM_REF2(il_formal_funct_call_c, function_name, il_param_list, symbol_c *called_function_declaration; int extensible_param_count;)
 void *fill_candidate_datatypes_c::visit(il_formal_funct_call_c *symbol) {
 	/* non-standard extension allowing functions with no input parameters => il_param_list may be NULL !!! */
-	if (NULL != symbol->il_param_list) symbol->il_param_list->accept(*this); 
+	if (NULL != symbol->il_param_list) dispatch(symbol->il_param_list); 
 
 	generic_function_call_t fcall_param = {
 		/* fcall_param.function_name               = */ symbol->function_name,
@@ -1905,7 +1971,7 @@ void *fill_candidate_datatypes_c::visit(il_formal_funct_call_c *symbol) {
 	};
 	handle_function_call(symbol, fcall_param);
 
-	if (debug) std::cout << "il_formal_funct_call_c [" << symbol->candidate_datatypes.size() << "] result.\n";
+	if (debug) std::cout << "il_formal_funct_call_c [" << symbol->get_candidate_datatypes().size() << "] result.\n";
 	return NULL;
 }
 
@@ -1920,12 +1986,12 @@ void *fill_candidate_datatypes_c::visit(simple_instr_list_c *symbol) {
     return NULL;  /* List is empty! Nothing to do. */
     
   for(int i = 0; i < symbol->n; i++)
-    symbol->get_element(i)->accept(*this);
+    dispatch(symbol->get_element(i));
 
   /* This object has (inherits) the same candidate datatypes as the last il_instruction */
-  symbol->candidate_datatypes = symbol->get_element(symbol->n-1)->candidate_datatypes;
+  symbol->candidate_datatypes() = symbol->get_element(symbol->n-1)->get_candidate_datatypes();
   
-  if (debug) std::cout << "simple_instr_list_c [" << symbol->candidate_datatypes.size() << "] result.\n";
+  if (debug) std::cout << "simple_instr_list_c [" << symbol->get_candidate_datatypes().size() << "] result.\n";
   return NULL;
 }
 
@@ -1937,11 +2003,11 @@ void *fill_candidate_datatypes_c::visit(il_simple_instruction_c *symbol) {
   if (symbol->prev_il_instruction.size() > 1) ERROR; /* There should be no labeled insructions inside an IL expression! */
   if (symbol->prev_il_instruction.size() == 0)  prev_il_instruction = NULL;
   else                                          prev_il_instruction = symbol->prev_il_instruction[0];
-  symbol->il_simple_instruction->accept(*this);
+  dispatch(symbol->il_simple_instruction);
   prev_il_instruction = NULL;
 
   /* This object has (inherits) the same candidate datatypes as the il_simple_instruction it points to */
-  symbol->candidate_datatypes = symbol->il_simple_instruction->candidate_datatypes;
+  symbol->candidate_datatypes() = symbol->il_simple_instruction->get_candidate_datatypes();
   return NULL;
 }
 
@@ -1957,20 +2023,20 @@ void *fill_candidate_datatypes_c::visit(il_simple_instruction_c *symbol) {
 /*******************/
 void *fill_candidate_datatypes_c::visit(LD_operator_c *symbol) {
 	if (NULL == il_operand)          return NULL;
-	for(unsigned int i = 0; i < il_operand->candidate_datatypes.size(); i++) {
-		add_datatype_to_candidate_list(symbol, il_operand->candidate_datatypes[i]);
+	for(unsigned int i = 0; i < il_operand->get_candidate_datatypes().size(); i++) {
+		add_datatype_to_candidate_list(symbol, il_operand->get_candidate_datatypes()[i]);
 	}
-	if (debug) std::cout << "LD [" <<  il_operand->candidate_datatypes.size() << "] ==> "  << symbol->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout << "LD [" <<  il_operand->get_candidate_datatypes().size() << "] ==> "  << symbol->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
 void *fill_candidate_datatypes_c::visit(LDN_operator_c *symbol) {
 	if (NULL == il_operand)          return NULL;
-	for(unsigned int i = 0; i < il_operand->candidate_datatypes.size(); i++) {
-		if      (get_datatype_info_c::is_ANY_BIT_compatible(il_operand->candidate_datatypes[i]))
-			add_datatype_to_candidate_list(symbol, il_operand->candidate_datatypes[i]);
+	for(unsigned int i = 0; i < il_operand->get_candidate_datatypes().size(); i++) {
+		if      (get_datatype_info_c::is_ANY_BIT_compatible(il_operand->get_candidate_datatypes()[i]))
+			add_datatype_to_candidate_list(symbol, il_operand->get_candidate_datatypes()[i]);
 	}
-	if (debug) std::cout << "LDN [" << il_operand->candidate_datatypes.size() << "] ==> "  << symbol->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout << "LDN [" << il_operand->get_candidate_datatypes().size() << "] ==> "  << symbol->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
@@ -1979,15 +2045,15 @@ void *fill_candidate_datatypes_c::visit(ST_operator_c *symbol) {
 
 	if (NULL == prev_il_instruction) return NULL;
 	if (NULL == il_operand)          return NULL;
-	for (unsigned int i = 0; i < prev_il_instruction->candidate_datatypes.size(); i++) {
-		for(unsigned int j = 0; j < il_operand->candidate_datatypes.size(); j++) {
-			prev_instruction_type = prev_il_instruction->candidate_datatypes[i];
-			operand_type = il_operand->candidate_datatypes[j];
+	for (unsigned int i = 0; i < prev_il_instruction->get_candidate_datatypes().size(); i++) {
+		for(unsigned int j = 0; j < il_operand->get_candidate_datatypes().size(); j++) {
+			prev_instruction_type = prev_il_instruction->get_candidate_datatypes()[i];
+			operand_type = il_operand->get_candidate_datatypes()[j];
 			if (get_datatype_info_c::is_type_equal(prev_instruction_type, operand_type))
 				add_datatype_to_candidate_list(symbol, prev_instruction_type);
 		}
 	}
-	if (debug) std::cout << "ST [" << prev_il_instruction->candidate_datatypes.size() << "," << il_operand->candidate_datatypes.size() << "] ==> "  << symbol->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout << "ST [" << prev_il_instruction->get_candidate_datatypes().size() << "," << il_operand->get_candidate_datatypes().size() << "] ==> "  << symbol->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
@@ -1996,15 +2062,15 @@ void *fill_candidate_datatypes_c::visit(STN_operator_c *symbol) {
 
 	if (NULL == prev_il_instruction) return NULL;
 	if (NULL == il_operand)          return NULL;
-	for (unsigned int i = 0; i < prev_il_instruction->candidate_datatypes.size(); i++) {
-		for(unsigned int j = 0; j < il_operand->candidate_datatypes.size(); j++) {
-			prev_instruction_type = prev_il_instruction->candidate_datatypes[i];
-			operand_type = il_operand->candidate_datatypes[j];
+	for (unsigned int i = 0; i < prev_il_instruction->get_candidate_datatypes().size(); i++) {
+		for(unsigned int j = 0; j < il_operand->get_candidate_datatypes().size(); j++) {
+			prev_instruction_type = prev_il_instruction->get_candidate_datatypes()[i];
+			operand_type = il_operand->get_candidate_datatypes()[j];
 			if (get_datatype_info_c::is_type_equal(prev_instruction_type,operand_type) && get_datatype_info_c::is_ANY_BIT_compatible(operand_type))
 				add_datatype_to_candidate_list(symbol, prev_instruction_type);
 		}
 	}
-	if (debug) std::cout << "STN [" << prev_il_instruction->candidate_datatypes.size() << "," << il_operand->candidate_datatypes.size() << "] ==> "  << symbol->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout << "STN [" << prev_il_instruction->get_candidate_datatypes().size() << "," << il_operand->get_candidate_datatypes().size() << "] ==> "  << symbol->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
@@ -2017,11 +2083,11 @@ void *fill_candidate_datatypes_c::visit(NOT_operator_c *symbol) {
 	 */
 	if (NULL == prev_il_instruction) return NULL;
 	if (NULL != il_operand)          return NULL;
-	for (unsigned int i = 0; i < prev_il_instruction->candidate_datatypes.size(); i++) {
-		if (get_datatype_info_c::is_ANY_BIT_compatible(prev_il_instruction->candidate_datatypes[i]))
-			add_datatype_to_candidate_list(symbol, prev_il_instruction->candidate_datatypes[i]);
+	for (unsigned int i = 0; i < prev_il_instruction->get_candidate_datatypes().size(); i++) {
+		if (get_datatype_info_c::is_ANY_BIT_compatible(prev_il_instruction->get_candidate_datatypes()[i]))
+			add_datatype_to_candidate_list(symbol, prev_il_instruction->get_candidate_datatypes()[i]);
 	}
-	if (debug) std::cout <<  "NOT_operator [" << prev_il_instruction->candidate_datatypes.size() << "] ==> "  << symbol->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout <<  "NOT_operator [" << prev_il_instruction->get_candidate_datatypes().size() << "] ==> "  << symbol->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
@@ -2062,16 +2128,16 @@ void *fill_candidate_datatypes_c::visit(  NE_operator_c *symbol) {return handle_
 
 void *fill_candidate_datatypes_c::handle_conditional_il_flow_control_operator(symbol_c *symbol) {
 	if (NULL == prev_il_instruction) return NULL;
-	for (unsigned int i = 0; i < prev_il_instruction->candidate_datatypes.size(); i++) {
-		if (get_datatype_info_c::is_BOOL_compatible(prev_il_instruction->candidate_datatypes[i]))
-			add_datatype_to_candidate_list(symbol, prev_il_instruction->candidate_datatypes[i]);
+	for (unsigned int i = 0; i < prev_il_instruction->get_candidate_datatypes().size(); i++) {
+		if (get_datatype_info_c::is_BOOL_compatible(prev_il_instruction->get_candidate_datatypes()[i]))
+			add_datatype_to_candidate_list(symbol, prev_il_instruction->get_candidate_datatypes()[i]);
 	}
 	return NULL;
 }
 
-void *fill_candidate_datatypes_c::visit(  CAL_operator_c *symbol) {if (NULL != prev_il_instruction) symbol->candidate_datatypes = prev_il_instruction->candidate_datatypes; return NULL;}
-void *fill_candidate_datatypes_c::visit(  RET_operator_c *symbol) {if (NULL != prev_il_instruction) symbol->candidate_datatypes = prev_il_instruction->candidate_datatypes; return NULL;}
-void *fill_candidate_datatypes_c::visit(  JMP_operator_c *symbol) {if (NULL != prev_il_instruction) symbol->candidate_datatypes = prev_il_instruction->candidate_datatypes; return NULL;}
+void *fill_candidate_datatypes_c::visit(  CAL_operator_c *symbol) {if (NULL != prev_il_instruction) symbol->candidate_datatypes() = prev_il_instruction->get_candidate_datatypes(); return NULL;}
+void *fill_candidate_datatypes_c::visit(  RET_operator_c *symbol) {if (NULL != prev_il_instruction) symbol->candidate_datatypes() = prev_il_instruction->get_candidate_datatypes(); return NULL;}
+void *fill_candidate_datatypes_c::visit(  JMP_operator_c *symbol) {if (NULL != prev_il_instruction) symbol->candidate_datatypes() = prev_il_instruction->get_candidate_datatypes(); return NULL;}
 void *fill_candidate_datatypes_c::visit( CALC_operator_c *symbol) {return handle_conditional_il_flow_control_operator(symbol);}
 void *fill_candidate_datatypes_c::visit(CALCN_operator_c *symbol) {return handle_conditional_il_flow_control_operator(symbol);}
 void *fill_candidate_datatypes_c::visit( RETC_operator_c *symbol) {return handle_conditional_il_flow_control_operator(symbol);}
@@ -2095,12 +2161,12 @@ void *fill_candidate_datatypes_c::visit(JMPCN_operator_c *symbol) {return handle
 /***********************/
 /* SYM_REF1(deref_expression_c, exp)  --> an extension to the IEC 61131-3 standard - based on the IEC 61131-3 v3 standard. Returns address of the varible! */
 void *fill_candidate_datatypes_c::visit(deref_expression_c  *symbol) {
-  symbol->exp->accept(*this);
+  dispatch(symbol->exp);
 
-  for (unsigned int i = 0; i < symbol->exp->candidate_datatypes.size(); i++) {
+  for (unsigned int i = 0; i < symbol->exp->get_candidate_datatypes().size(); i++) {
     /* Determine whether the datatype is a ref_spec_c, as this is the class used as the    */
     /* canonical/base datatype of REF_TO types (see search_base_type_c ...)                */ 
-    ref_spec_c *ref_spec = dynamic_cast<ref_spec_c *>(symbol->exp->candidate_datatypes[i]);
+    ref_spec_c *ref_spec = dynamic_cast<ref_spec_c *>(symbol->exp->get_candidate_datatypes()[i]);
     
     if (NULL != ref_spec)
       add_datatype_to_candidate_list(symbol, search_base_type_c::get_basetype_decl(ref_spec->type_name));
@@ -2112,12 +2178,12 @@ void *fill_candidate_datatypes_c::visit(deref_expression_c  *symbol) {
 
 /* SYM_REF1(deref_operator_c, exp)  --> an extension to the IEC 61131-3 standard - based on the IEC 61131-3 v3 standard. Returns address of the varible! */
 void *fill_candidate_datatypes_c::visit(deref_operator_c  *symbol) {
-  symbol->exp->accept(*this);
+  dispatch(symbol->exp);
 
-  for (unsigned int i = 0; i < symbol->exp->candidate_datatypes.size(); i++) {
+  for (unsigned int i = 0; i < symbol->exp->get_candidate_datatypes().size(); i++) {
     /* Determine whether the datatype is a ref_spec_c, as this is the class used as the    */
     /* canonical/base datatype of REF_TO types (see search_base_type_c ...)                */ 
-    ref_spec_c *ref_spec = dynamic_cast<ref_spec_c *>(symbol->exp->candidate_datatypes[i]);
+    ref_spec_c *ref_spec = dynamic_cast<ref_spec_c *>(symbol->exp->get_candidate_datatypes()[i]);
     
     if (NULL != ref_spec)
       add_datatype_to_candidate_list(symbol, search_base_type_c::get_basetype_decl(ref_spec->type_name));
@@ -2138,16 +2204,16 @@ void *fill_candidate_datatypes_c::visit(  ref_expression_c  *symbol) {
    * expressions that include function calls in their indexes. These complex expressions must also be
    * analysed using the standard fill/narrow algorithm...
    */
-  symbol->exp->accept(*this);
+  dispatch(symbol->exp);
 
   /* Currently the IEC 61131-3 symtax requires that the REF() operator have as a parameter a lvalue (a variable), that will have
    * at most one candidate_datatype. This means that we do not really need the for() loop here, but we use it
    * anyway as it is the correct way of implementing the fill/narrow algorithm! 
    */
-  for (unsigned int i = 0; i < symbol->exp->candidate_datatypes.size(); i++) {
+  for (unsigned int i = 0; i < symbol->exp->get_candidate_datatypes().size(); i++) {
     /* Create a new object of ref_spec_c, as this is the class used as the  */
     /* canonical/base datatype of REF_TO types (see search_base_type_c ...) */ 
-    ref_spec_c *ref_spec = new ref_spec_c(symbol->exp->candidate_datatypes[i]);
+    ref_spec_c *ref_spec = new ref_spec_c(symbol->exp->get_candidate_datatypes()[i]);
     add_datatype_to_candidate_list(symbol, ref_spec);
   }
   return NULL;
@@ -2207,30 +2273,30 @@ void *fill_candidate_datatypes_c::visit(neg_expression_c *symbol) {
    *
    * NOTE: The above argument also applies to the neg_integer_c method!
    */
-	symbol->exp->accept(*this);
-	for (unsigned int i = 0; i < symbol->exp->candidate_datatypes.size(); i++) {
-		if (get_datatype_info_c::is_ANY_signed_MAGNITUDE_compatible(symbol->exp->candidate_datatypes[i]))
-			add_datatype_to_candidate_list(symbol, symbol->exp->candidate_datatypes[i]);
+	dispatch(symbol->exp);
+	for (unsigned int i = 0; i < symbol->exp->get_candidate_datatypes().size(); i++) {
+		if (get_datatype_info_c::is_ANY_signed_MAGNITUDE_compatible(symbol->exp->get_candidate_datatypes()[i]))
+			add_datatype_to_candidate_list(symbol, symbol->exp->get_candidate_datatypes()[i]);
 	}
-	if (debug) std::cout << "neg [" << symbol->exp->candidate_datatypes.size() << "] ==> "  << symbol->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout << "neg [" << symbol->exp->get_candidate_datatypes().size() << "] ==> "  << symbol->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
 
 void *fill_candidate_datatypes_c::visit(not_expression_c *symbol) {
-	symbol->exp->accept(*this);
-	for (unsigned int i = 0; i < symbol->exp->candidate_datatypes.size(); i++) {
-		if      (get_datatype_info_c::is_ANY_BIT_compatible(symbol->exp->candidate_datatypes[i]))
-			add_datatype_to_candidate_list(symbol, symbol->exp->candidate_datatypes[i]);
+	dispatch(symbol->exp);
+	for (unsigned int i = 0; i < symbol->exp->get_candidate_datatypes().size(); i++) {
+		if      (get_datatype_info_c::is_ANY_BIT_compatible(symbol->exp->get_candidate_datatypes()[i]))
+			add_datatype_to_candidate_list(symbol, symbol->exp->get_candidate_datatypes()[i]);
 	}
-	if (debug) std::cout << "not [" << symbol->exp->candidate_datatypes.size() << "] ==> "  << symbol->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout << "not [" << symbol->exp->get_candidate_datatypes().size() << "] ==> "  << symbol->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
 
 void *fill_candidate_datatypes_c::visit(function_invocation_c *symbol) {
-	if      (NULL != symbol->formal_param_list)        symbol->   formal_param_list->accept(*this);
-	else if (NULL != symbol->nonformal_param_list)     symbol->nonformal_param_list->accept(*this);
+	if      (NULL != symbol->formal_param_list)        dispatch(symbol->   formal_param_list);
+	else if (NULL != symbol->nonformal_param_list)     dispatch(symbol->nonformal_param_list);
 	// else ERROR;  NOTE-> We support the non-standard feature of POUS with no in, out and inout parameters, so this is no longer an internal error!
 
 	generic_function_call_t fcall_param = {
@@ -2245,7 +2311,7 @@ void *fill_candidate_datatypes_c::visit(function_invocation_c *symbol) {
 
 	handle_function_call(symbol, fcall_param);
 
-	if (debug) std::cout << "function_invocation_c [" << symbol->candidate_datatypes.size() << "] result.\n";
+	if (debug) std::cout << "function_invocation_c [" << symbol->get_candidate_datatypes().size() << "] result.\n";
 	return NULL;
 }
 
@@ -2266,17 +2332,17 @@ void *fill_candidate_datatypes_c::visit(function_invocation_c *symbol) {
 /*********************************/
 void *fill_candidate_datatypes_c::visit(assignment_statement_c *symbol) {
 	symbol_c *left_type, *right_type;
-	symbol->l_exp->accept(*this);
-	symbol->r_exp->accept(*this);
-	for (unsigned int i = 0; i < symbol->l_exp->candidate_datatypes.size(); i++) {
-		for(unsigned int j = 0; j < symbol->r_exp->candidate_datatypes.size(); j++) {
-			left_type = symbol->l_exp->candidate_datatypes[i];
-			right_type = symbol->r_exp->candidate_datatypes[j];
+	dispatch(symbol->l_exp);
+	dispatch(symbol->r_exp);
+	for (unsigned int i = 0; i < symbol->l_exp->get_candidate_datatypes().size(); i++) {
+		for(unsigned int j = 0; j < symbol->r_exp->get_candidate_datatypes().size(); j++) {
+			left_type = symbol->l_exp->get_candidate_datatypes()[i];
+			right_type = symbol->r_exp->get_candidate_datatypes()[j];
 			if (get_datatype_info_c::is_type_equal(left_type, right_type))
 				add_datatype_to_candidate_list(symbol, left_type);  // NOTE: Must use left_type, as the right_type may be the 'NULL' reference! (see comment in visit(ref_value_null_literal_c)) */
 		}
 	}
-	if (debug) std::cout << ":= [" << symbol->l_exp->candidate_datatypes.size() << "," << symbol->r_exp->candidate_datatypes.size() << "] ==> "  << symbol->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout << ":= [" << symbol->l_exp->get_candidate_datatypes().size() << "," << symbol->r_exp->get_candidate_datatypes().size() << "] ==> "  << symbol->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
@@ -2288,8 +2354,8 @@ void *fill_candidate_datatypes_c::visit(fb_invocation_c *symbol) {
 	if (! get_datatype_info_c::is_function_block(fb_decl )) fb_decl = NULL;
 	if (NULL == fb_decl) ERROR; /* Although a call to a non-declared FB is a semantic error, this is currently caught by stage 2! */
 	
-	if (symbol->   formal_param_list != NULL) symbol->formal_param_list->accept(*this);
-	if (symbol->nonformal_param_list != NULL) symbol->nonformal_param_list->accept(*this);
+	if (symbol->   formal_param_list != NULL) dispatch(symbol->formal_param_list);
+	if (symbol->nonformal_param_list != NULL) dispatch(symbol->nonformal_param_list);
 
 	/* The print_datatypes_error_c does not rely on this called_fb_declaration pointer being != NULL to conclude that
 	 * we have a datat type incompatibility error, so setting it to the correct fb_decl is actually safe,
@@ -2297,7 +2363,7 @@ void *fill_candidate_datatypes_c::visit(fb_invocation_c *symbol) {
 	 */
 	symbol->called_fb_declaration = fb_decl;
 
-	if (debug) std::cout << "FB [] ==> "  << symbol->candidate_datatypes.size() << " result.\n";
+	if (debug) std::cout << "FB [] ==> "  << symbol->get_candidate_datatypes().size() << " result.\n";
 	return NULL;
 }
 
@@ -2307,32 +2373,32 @@ void *fill_candidate_datatypes_c::visit(fb_invocation_c *symbol) {
 /* B 3.2.3 Selection Statements */
 /********************************/
 void *fill_candidate_datatypes_c::visit(if_statement_c *symbol) {
-	symbol->expression->accept(*this);
+	dispatch(symbol->expression);
 	if (NULL != symbol->statement_list)
-		symbol->statement_list->accept(*this);
+		dispatch(symbol->statement_list);
 	if (NULL != symbol->elseif_statement_list)
-		symbol->elseif_statement_list->accept(*this);
+		dispatch(symbol->elseif_statement_list);
 	if (NULL != symbol->else_statement_list)
-		symbol->else_statement_list->accept(*this);
+		dispatch(symbol->else_statement_list);
 	return NULL;
 }
 
 
 void *fill_candidate_datatypes_c::visit(elseif_statement_c *symbol) {
-	symbol->expression->accept(*this);
+	dispatch(symbol->expression);
 	if (NULL != symbol->statement_list)
-		symbol->statement_list->accept(*this);
+		dispatch(symbol->statement_list);
 	return NULL;
 }
 
 /* CASE expression OF case_element_list ELSE statement_list END_CASE */
 // SYM_REF3(case_statement_c, expression, case_element_list, statement_list)
 void *fill_candidate_datatypes_c::visit(case_statement_c *symbol) {
-	symbol->expression->accept(*this);
+	dispatch(symbol->expression);
 	if (NULL != symbol->case_element_list)
-		symbol->case_element_list->accept(*this);
+		dispatch(symbol->case_element_list);
 	if (NULL != symbol->statement_list)
-		symbol->statement_list->accept(*this);
+		dispatch(symbol->statement_list);
 	return NULL;
 }
 
@@ -2353,29 +2419,29 @@ void *fill_candidate_datatypes_c::visit(case_statement_c *symbol) {
 /********************************/
 
 void *fill_candidate_datatypes_c::visit(for_statement_c *symbol) {
-	symbol->control_variable->accept(*this);
-	symbol->beg_expression->accept(*this);
-	symbol->end_expression->accept(*this);
+	dispatch(symbol->control_variable);
+	dispatch(symbol->beg_expression);
+	dispatch(symbol->end_expression);
 	if (NULL != symbol->by_expression)
-		symbol->by_expression->accept(*this);
+		dispatch(symbol->by_expression);
 	if (NULL != symbol->statement_list)
-		symbol->statement_list->accept(*this);
+		dispatch(symbol->statement_list);
 	return NULL;
 }
 
 
 void *fill_candidate_datatypes_c::visit(while_statement_c *symbol) {
-	symbol->expression->accept(*this);
+	dispatch(symbol->expression);
 	if (NULL != symbol->statement_list)
-		symbol->statement_list->accept(*this);
+		dispatch(symbol->statement_list);
 	return NULL;
 }
 
 
 void *fill_candidate_datatypes_c::visit(repeat_statement_c *symbol) {
-	symbol->expression->accept(*this);
+	dispatch(symbol->expression);
 	if (NULL != symbol->statement_list)
-		symbol->statement_list->accept(*this);
+		dispatch(symbol->statement_list);
 	return NULL;
 }
 
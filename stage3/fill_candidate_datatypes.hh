@@ -44,16 +44,21 @@
  *  For example, the very simple literal '0' (as in foo := 0), may represent a:
  *    BOOL, BYTE, WORD, DWORD, LWORD, USINT, SINT, UINT, INT, UDINT, DINT, ULINT, LINT (as well as the SAFE versions of these data tyes too!)
  *
- * WARNING: This visitor class starts off by building a map of all enumeration constants that are defined in the source code (i.e. a library_c symbol),
- *          and this map is later used to determine the datatpe of each use of an enumeration constant. By implication, the fill_candidate_datatypes_c 
- *          visitor class will only work corretly if it is asked to visit a symbol of class library_c!!
+ * WARNING: This visitor class starts off (in the constructor) by building a map of all enumeration constants that are defined in the source code
+ *          (i.e. the library_c symbol passed to the constructor), and this map is later used to determine the datatpe of each use of an
+ *          enumeration constant. By implication, the fill_candidate_datatypes_c visitor class will only work corretly if it is given
+ *          the library_c when it is constructed!!
+ *          Since the map is built when the visitor is constructed, each element of the library may then be visited on its own, which 
+ *          allows several POUs to be visited at the same time, each with a visitor of its own (see pou_executor.hh).
  */
 
 
 #include "../absyntax_utils/absyntax_utils.hh"
+#include "../absyntax/static_visitor.hh"
 #include "datatype_functions.hh"
 
-class fill_candidate_datatypes_c: public iterator_visitor_c {
+/* NOTE: This is a static visitor (see static_visitor.hh) */
+class fill_candidate_datatypes_c: public static_iterator_visitor_c<fill_candidate_datatypes_c> {
 
   private:
     search_var_instance_decl_c *search_var_instance_decl;
@@ -80,16 +85,38 @@ class fill_candidate_datatypes_c: public iterator_visitor_c {
     
     /* pointer to the Function, FB, or Program currently being analysed */
     symbol_c *current_scope;
+    /* The enumerated values declared (in anonymous enumerated datatypes) inside the Function, FB, or Program currently being analysed */
+    dsymtable_c<symbol_c *> local_enumerated_value_symtable;
     /* Pointer to the previous IL instruction, which contains the current data type (actually, the list of candidate data types) of the data stored in the IL stack, i.e. the default variable, a.k.a. accumulator */
     symbol_c *prev_il_instruction;
     /* the current IL operand being analyzed */
     symbol_c *il_operand;
     symbol_c *widening_conversion(symbol_c *left_type, symbol_c *right_type, const struct widen_entry widen_table[]);
 
+    /* The base datatypes of the parameters of a function declaration (excluding EN and ENO), in the order in which
+     * they are matched to the parameters of a non formal function call. Determined only once for each function declaration.
+     */
+    typedef struct {
+      std::vector<symbol_c *> param_types;
+      bool                    extensible;  /* the last parameter is an extensible parameter, and may be passed more than once */
+    } nonformal_signature_t;
+    side_table_c<nonformal_signature_t> nonformal_signatures;  /* indexed by the function declaration's symbol_c::id */
+    nonformal_signature_t &get_nonformal_signature(symbol_c *f_decl);
+
+    /* The function declarations that are compatible with a non formal function call, indexed by the function being called 
+     * and by the candidate datatypes of each parameter passed in the call (see get_overload_key()).
+     * Only calls whose parameters have nothing but elementary datatypes in their candidate datatype lists are indexed.
+     */
+    typedef std::vector<uint64_t>                                          overload_key_t;
+    typedef std::map<overload_key_t, std::vector<function_declaration_c *> > overload_index_t;
+    overload_index_t overload_index;
+    bool get_overload_key(symbol_c *fcall, symbol_c *f_decl, overload_key_t &key);
+
     /* Match a function declaration with a function call through their parameters.*/
     /* returns true if compatible function/FB invocation, otherwise returns false */
     bool  match_nonformal_call(symbol_c *f_call, symbol_c *f_decl);
     bool  match_formal_call   (symbol_c *f_call, symbol_c *f_decl, symbol_c **first_param_datatype = NULL);
+    void  search_compatible_functions(symbol_c *fcall, generic_function_call_t &fcall_data, std::vector<function_declaration_c *> &compatible);
     void  handle_function_call(symbol_c *fcall, generic_function_call_t fcall_data);
     void *handle_implicit_il_fb_call(symbol_c *il_instruction, const char *param_name,   symbol_c *&called_fb_declaration);
     void *handle_S_and_R_operator   (symbol_c *symbol,         const char *operator_str, symbol_c *&called_fb_declaration);
@@ -112,14 +139,10 @@ class fill_candidate_datatypes_c: public iterator_visitor_c {
     
     
   public:
-    fill_candidate_datatypes_c(symbol_c *ignore);
+    fill_candidate_datatypes_c(symbol_c *tree_root);
     virtual ~fill_candidate_datatypes_c(void);
 
-    
-    /***************************/
-    /* B 0 - Programming Model */
-    /***************************/
-    void *visit(library_c *symbol);
+    using static_iterator_visitor_c<fill_candidate_datatypes_c>::visit;
 
     /*************************/
     /* B.1 - Common elements */
@@ -0,0 +1,163 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * Run several independent checkers in a single traversal of the AST.
+ * See the comment in fused_check.hh
+ */
+
+
+#include "fused_check.hh"
+
+
+
+
+fused_check_c::fused_check_c(void) {
+  node_count = 0;
+}
+
+
+fused_check_c::~fused_check_c(void) {
+  for (unsigned int i = 0; i < checkers.size(); i++)
+    delete checkers[i];
+}
+
+
+void fused_check_c::add_checker(fused_checker_c *checker) {
+  checkers.push_back(checker);
+}
+
+
+int fused_check_c::get_error_count(void) {
+  int error_count = 0;
+  for (unsigned int i = 0; i < checkers.size(); i++)
+    error_count += checkers[i]->get_error_count();
+  return error_count;
+}
+
+
+
+/* Call the visit() method of every checker that is not skipping this symbol.
+ * Returns whether any of the checkers must be called for the children of the symbol.
+ */
+bool fused_check_c::enter(symbol_c *symbol) {
+  bool visit_children = false;
+
+  node_count++;
+  for (unsigned int i = 0; i < checkers.size(); i++) {
+    fused_checker_c *checker = checkers[i];
+    if (NULL != checker->skip_root)
+      continue;  /* skipping one of the ancestors of this symbol */
+
+    /* Has the checker asked to skip this symbol, when visiting its parent? */
+    if (!checker->skipped.empty()) {
+      std::vector<symbol_c *>::iterator iter = checker->skipped.begin();
+      while ((iter != checker->skipped.end()) && (*iter != symbol)) iter++;
+      if (iter != checker->skipped.end()) {
+        checker->skipped.erase(iter);
+        checker->skip_root = symbol;
+        continue;
+      }
+    }
+
+    unsigned int skipped_count = checker->skipped.size();
+    checker->leave_requested = false;
+    void *res = symbol->accept(*checker);
+    if (checker->leave_requested)
+      checker->leave_stack.push_back(symbol);
+    if (res == symbol) {
+      /* do not call the checker for the children (so no need to skip any of them either) */
+      checker->skipped.resize(skipped_count);
+      checker->skip_root = symbol;
+    } else
+      visit_children = true;
+  }
+  return visit_children;
+}
+
+
+/* Call the leave() method of every checker that asked for it when this symbol was visited. */
+void fused_check_c::leave(symbol_c *symbol) {
+  for (unsigned int i = 0; i < checkers.size(); i++) {
+    fused_checker_c *checker = checkers[i];
+    if (checker->skip_root == symbol)
+      checker->skip_root = NULL;
+    else if (NULL != checker->skip_root)
+      continue;  /* skipping one of the ancestors of this symbol */
+    if (!checker->leave_stack.empty() && (checker->leave_stack.back() == symbol)) {
+      checker->leave_stack.pop_back();
+      checker->leave(symbol);
+    }
+  }
+}
+
+
+
+
+#define VISIT_METHOD(iterate_children) {  \
+  if (enter(symbol)) {iterate_children;}  \
+  leave(symbol);                          \
+  return NULL;                            \
+}
+
+#define SYM_LIST(class_name_c, ...)                                             \
+  void *fused_check_c::visit(class_name_c *symbol) VISIT_METHOD(visit_list(symbol))
+#define SYM_TOKEN(class_name_c, ...)                                            \
+  void *fused_check_c::visit(class_name_c *symbol) VISIT_METHOD()
+#define SYM_REF0(class_name_c, ...)                                             \
+  void *fused_check_c::visit(class_name_c *symbol) VISIT_METHOD()
+#define SYM_REF1(class_name_c, ref1, ...)                                       \
+  void *fused_check_c::visit(class_name_c *symbol) VISIT_METHOD(iterator_visitor_c::visit(symbol))
+#define SYM_REF2(class_name_c, ref1, ref2, ...)                                 \
+  void *fused_check_c::visit(class_name_c *symbol) VISIT_METHOD(iterator_visitor_c::visit(symbol))
+#define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           \
+  void *fused_check_c::visit(class_name_c *symbol) VISIT_METHOD(iterator_visitor_c::visit(symbol))
+#define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     \
+  void *fused_check_c::visit(class_name_c *symbol) VISIT_METHOD(iterator_visitor_c::visit(symbol))
+#define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               \
+  void *fused_check_c::visit(class_name_c *symbol) VISIT_METHOD(iterator_visitor_c::visit(symbol))
+#define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         \
+  void *fused_check_c::visit(class_name_c *symbol) VISIT_METHOD(iterator_visitor_c::visit(symbol))
+
+#include "../absyntax/absyntax.def"
+
+#undef VISIT_METHOD
+
+#undef SYM_LIST
+#undef SYM_TOKEN
+#undef SYM_REF0
+#undef SYM_REF1
+#undef SYM_REF2
+#undef SYM_REF3
+#undef SYM_REF4
+#undef SYM_REF5
+#undef SYM_REF6
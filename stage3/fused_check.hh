@@ -0,0 +1,141 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * Run several independent checkers in a single traversal of the AST.
+ *
+ * Some of the stage 3 checkers (declaration_check_c, lvalue_check_c, array_range_check_c, case_elements_check_c)
+ * only read the AST (and its annotations) and print error messages. Running each of them with a traversal
+ * of its own means the whole AST is walked (and brought into the cache) once for each checker. Instead, these
+ * checkers are written as fused_checker_c, and are all run by the same fused_check_c, that walks the AST only once.
+ *
+ * A fused_checker_c is a visitor whose visit() methods are callbacks, called by the fused_check_c when it reaches
+ * each node of the AST, before visiting the children of that node. The visit() methods must therefore NOT visit the
+ * children themselves! If visit() calls call_leave(), the fused_check_c will also call the checker's leave() method
+ * for that same node, once all its children have been visited. This is where the checker should undo any state it
+ * set up in visit() (e.g. the search_var_instance_decl_c of the POU being visited).
+ *   NOTE: leave() is only called when requested, as most nodes do not need it, and calling it for every
+ *         node of the AST would double the number of (virtual) calls made by the traversal.
+ *
+ * A checker may ask not to be called for some parts of the AST:
+ *   - if visit() returns the visited symbol, the checker is not called for any of its children
+ *     (leave() is still called for the visited symbol itself, if requested).
+ *   - visit() may call skip() with any of the children of the visited symbol (i.e. one of its references,
+ *     or one of the elements of a list), so the checker is not called for that child nor any of its descendants.
+ * The fused_check_c does not visit the parts of the AST that all its checkers have asked to skip.
+ *
+ * NOTE: Since the checkers share the same traversal, the error messages of the several checkers
+ *       are printed interleaved, in the order the AST nodes are visited.
+ */
+
+
+#ifndef _FUSED_CHECK_HH
+#define _FUSED_CHECK_HH
+
+#include "../absyntax_utils/absyntax_utils.hh"
+#include <vector>
+
+
+
+class fused_check_c;
+
+class fused_checker_c: public null_visitor_c {
+  friend class fused_check_c;
+
+  private:
+    std::vector<symbol_c *> skipped;    /* the children (of the symbols being visited) that must be skipped, and have not yet been reached */
+    symbol_c               *skip_root;  /* the symbol whose subtree is currently being skipped (NULL if none) */
+    std::vector<symbol_c *> leave_stack;  /* the symbols being visited for which leave() must be called */
+    bool                    leave_requested;
+
+  protected:
+    /* do not call this checker for child, nor any of its descendants. child must be a child of the symbol being visited. */
+    void skip(symbol_c *child) {if (NULL != child) skipped.push_back(child);}
+    /* call leave() for the symbol being visited, once all its children have been visited */
+    void call_leave(void) {leave_requested = true;}
+
+  public:
+    fused_checker_c(void) {skip_root = NULL; leave_requested = false;}
+    virtual ~fused_checker_c(void) {}
+
+    /* called once all the children of symbol have been visited, if visit() called call_leave() */
+    virtual void leave(symbol_c *symbol) {}
+    virtual int  get_error_count(void) = 0;
+};
+
+
+
+
+class fused_check_c: public iterator_visitor_c {
+  private:
+    std::vector<fused_checker_c *> checkers;
+    unsigned long int node_count;  /* number of AST nodes visited */
+
+    bool enter(symbol_c *symbol);
+    void leave(symbol_c *symbol);
+
+  public:
+    fused_check_c(void);
+    virtual ~fused_check_c(void);
+
+    /* The checkers are called in the order they were added. The fused_check_c deletes the checkers when it is deleted. */
+    void add_checker(fused_checker_c *checker);
+
+    int get_error_count(void);
+    unsigned long int get_node_count(void) {return node_count;}
+
+  public:
+  #define SYM_LIST(class_name_c, ...)                                             virtual void *visit(class_name_c *symbol);
+  #define SYM_TOKEN(class_name_c, ...)                                            virtual void *visit(class_name_c *symbol);
+  #define SYM_REF0(class_name_c, ...)                                             virtual void *visit(class_name_c *symbol);
+  #define SYM_REF1(class_name_c, ref1, ...)                                       virtual void *visit(class_name_c *symbol);
+  #define SYM_REF2(class_name_c, ref1, ref2, ...)                                 virtual void *visit(class_name_c *symbol);
+  #define SYM_REF3(class_name_c, ref1, ref2, ref3, ...)                           virtual void *visit(class_name_c *symbol);
+  #define SYM_REF4(class_name_c, ref1, ref2, ref3, ref4, ...)                     virtual void *visit(class_name_c *symbol);
+  #define SYM_REF5(class_name_c, ref1, ref2, ref3, ref4, ref5, ...)               virtual void *visit(class_name_c *symbol);
+  #define SYM_REF6(class_name_c, ref1, ref2, ref3, ref4, ref5, ref6, ...)         virtual void *visit(class_name_c *symbol);
+
+  #include "../absyntax/absyntax.def"
+
+  #undef SYM_LIST
+  #undef SYM_TOKEN
+  #undef SYM_REF0
+  #undef SYM_REF1
+  #undef SYM_REF2
+  #undef SYM_REF3
+  #undef SYM_REF4
+  #undef SYM_REF5
+  #undef SYM_REF6
+};
+
+
+#endif /* _FUSED_CHECK_HH */
@@ -43,28 +43,29 @@
 
 
 #include "lvalue_check.hh"
+#include "pou_executor.hh"  // required for stage3_error_stream()
 
 #define FIRST_(symbol1, symbol2) (((symbol1)->first_order < (symbol2)->first_order)   ? (symbol1) : (symbol2))
 #define  LAST_(symbol1, symbol2) (((symbol1)->last_order  > (symbol2)->last_order)    ? (symbol1) : (symbol2))
 
 #define STAGE3_ERROR(error_level, symbol1, symbol2, ...) {                                                                  \
   if (current_display_error_level >= error_level) {                                                                         \
-    fprintf(stderr, "%s:%d-%d..%d-%d: error: ",                                                                             \
+    fprintf(stage3_error_stream(), "%s:%d-%d..%d-%d: error: ",                                                              \
             FIRST_(symbol1,symbol2)->first_file, FIRST_(symbol1,symbol2)->first_line, FIRST_(symbol1,symbol2)->first_column,\
                                                  LAST_(symbol1,symbol2) ->last_line,  LAST_(symbol1,symbol2) ->last_column);\
-    fprintf(stderr, __VA_ARGS__);                                                                                           \
-    fprintf(stderr, "\n");                                                                                                  \
+    fprintf(stage3_error_stream(), __VA_ARGS__);                                                                            \
+    fprintf(stage3_error_stream(), "\n");                                                                                   \
     error_count++;                                                                                                     \
   }                                                                                                                         \
 }
 
 
 #define STAGE3_WARNING(symbol1, symbol2, ...) {                                                                             \
-    fprintf(stderr, "%s:%d-%d..%d-%d: warning: ",                                                                           \
+    fprintf(stage3_error_stream(), "%s:%d-%d..%d-%d: warning: ",                                                            \
             FIRST_(symbol1,symbol2)->first_file, FIRST_(symbol1,symbol2)->first_line, FIRST_(symbol1,symbol2)->first_column,\
                                                  LAST_(symbol1,symbol2) ->last_line,  LAST_(symbol1,symbol2) ->last_column);\
-    fprintf(stderr, __VA_ARGS__);                                                                                           \
-    fprintf(stderr, "\n");                                                                                                  \
+    fprintf(stage3_error_stream(), __VA_ARGS__);                                                                            \
+    fprintf(stage3_error_stream(), "\n");                                                                                   \
     warning_found = true;                                                                                                   \
 }
 
@@ -315,9 +316,10 @@ void lvalue_check_c::check_nonformal_call(symbol_c *f_call, symbol_c *f_decl) {
 			/* If the parameter is either OUT or IN_OUT, we check if 'call_param_value' is a valid lvalue */
 			if ((function_param_iterator_c::direction_out == param_direction) || (function_param_iterator_c::direction_inout == param_direction)) 
 				verify_is_lvalue(call_param_value);
-			/* parameter values to IN  parameters may be expressions with function invocations that must also be checked! */
-			/* parameter values to OUT or IN_OUT parameters may contain arrays, whose subscripts contain expressions that must be checked! */
-			call_param_value->accept(*this);  
+			/* NOTE: parameter values to IN parameters may be expressions with function invocations that must also be checked,
+			 *       and parameter values to OUT or IN_OUT parameters may contain arrays, whose subscripts contain expressions
+			 *       that must be checked! These are visited by the fused_check_c, as they are children of f_call.
+			 */
 		}
 	}
 }
@@ -355,9 +357,7 @@ void lvalue_check_c::check_formal_call(symbol_c *f_call, symbol_c *f_decl) {
 			/* If the parameter is either OUT or IN_OUT, we check if 'call_param_value' is a valid lvalue */
 			if ((function_param_iterator_c::direction_out == param_direction) || (function_param_iterator_c::direction_inout == param_direction)) 
 				verify_is_lvalue(call_param_value);
-			/* parameter values to IN  parameters may be expressions with function invocations that must also be checked! */
-			/* parameter values to OUT or IN_OUT parameters may contain arrays, whose subscripts contain expressions that must be checked! */
-			call_param_value->accept(*this);  
+			/* NOTE: the parameter values are visited by the fused_check_c (see the note in check_nonformal_call() ) */
  		}
 	}
 }
@@ -377,11 +377,10 @@ void lvalue_check_c::check_formal_call(symbol_c *f_call, symbol_c *f_decl) {
 void *lvalue_check_c::visit(function_declaration_c *symbol) {
 	search_varfb_instance_type = new search_varfb_instance_type_c(symbol);
 	search_var_instance_decl = new search_var_instance_decl_c(symbol);
-	symbol->function_body->accept(*this);
-	delete search_varfb_instance_type;
-	delete search_var_instance_decl;
-	search_varfb_instance_type = NULL;
-	search_var_instance_decl = NULL;
+	skip(symbol->derived_function_name);
+	skip(symbol->type_name);
+	skip(symbol->var_declarations_list); /* only the function_body is checked. The searches are deleted in leave() */
+	call_leave();
 	return NULL;
 }
 
@@ -391,11 +390,9 @@ void *lvalue_check_c::visit(function_declaration_c *symbol) {
 void *lvalue_check_c::visit(function_block_declaration_c *symbol) {
 	search_varfb_instance_type = new search_varfb_instance_type_c(symbol);
 	search_var_instance_decl = new search_var_instance_decl_c(symbol);
-	symbol->fblock_body->accept(*this);
-	delete search_varfb_instance_type;
-	delete search_var_instance_decl;
-	search_varfb_instance_type = NULL;
-	search_var_instance_decl = NULL;
+	skip(symbol->fblock_name);
+	skip(symbol->var_declarations); /* only the fblock_body is checked. The searches are deleted in leave() */
+	call_leave();
 	return NULL;
 }
 
@@ -405,11 +402,9 @@ void *lvalue_check_c::visit(function_block_declaration_c *symbol) {
 void *lvalue_check_c::visit(program_declaration_c *symbol) {
 	search_varfb_instance_type = new search_varfb_instance_type_c(symbol);
 	search_var_instance_decl = new search_var_instance_decl_c(symbol);
-	symbol->function_block_body->accept(*this);
-	delete search_varfb_instance_type;
-	delete search_var_instance_decl;
-	search_varfb_instance_type = NULL;
-	search_var_instance_decl = NULL;
+	skip(symbol->program_type_name);
+	skip(symbol->var_declarations); /* only the function_block_body is checked. The searches are deleted in leave() */
+	call_leave();
 	return NULL;
 }
 
@@ -419,21 +414,10 @@ void *lvalue_check_c::visit(program_declaration_c *symbol) {
 /***********************************/
 /* B 2.1 Instructions and Operands */
 /***********************************/
-void *lvalue_check_c::visit(il_instruction_c *symbol) {
-	/* il_instruction will be NULL when parsing a label with no instruction
-	 * e.g.:   label1:          <---- il_instruction = NULL!
-	 *                 LD 33
-	 *                 ...
-	 */
-	if (NULL != symbol->il_instruction)
-		symbol->il_instruction->accept(*this);
-	return NULL;
-}
-
 void *lvalue_check_c::visit(il_simple_operation_c *symbol) {
-	current_il_operand = symbol->il_operand;
-	symbol->il_simple_operator->accept(*this);
-	current_il_operand = NULL;
+	current_il_operand = symbol->il_operand; /* reset in leave() */
+	skip(symbol->il_operand);
+	call_leave();
 	return NULL;
 }
 
@@ -477,7 +461,7 @@ void *lvalue_check_c::visit(il_function_call_c *symbol) {
 		symbol->il_operand_list = NULL;
 	}
 
-	return NULL;
+	return symbol; /* the operands have already been checked */
 }
 
 
@@ -494,6 +478,7 @@ void *lvalue_check_c::visit(il_function_call_c *symbol) {
 /* NOTE: The parameter 'called_fb_declaration'is used to pass data between stage 3 and stage4 (although currently it is not used in stage 4 */
 // SYM_REF4(il_fb_call_c, il_call_operator, fb_name, il_operand_list, il_param_list, symbol_c *called_fb_declaration)
 void *lvalue_check_c::visit(il_fb_call_c *symbol) {
+	if (NULL == symbol->called_fb_declaration) return symbol; /* unable to check the parameters of an unknown FB */
 	if (NULL != symbol->il_operand_list)  check_nonformal_call(symbol, symbol->called_fb_declaration);
 	if (NULL != symbol->  il_param_list)     check_formal_call(symbol, symbol->called_fb_declaration);
 	return NULL;
@@ -504,6 +489,7 @@ void *lvalue_check_c::visit(il_fb_call_c *symbol) {
 /* NOTE: The parameter 'called_function_declaration' is used to pass data between the stage 3 and stage 4. */
 // SYM_REF2(il_formal_funct_call_c, function_name, il_param_list, symbol_c *called_function_declaration; int extensible_param_count;)
 void *lvalue_check_c::visit(il_formal_funct_call_c *symbol) {
+	if (NULL == symbol->called_function_declaration) return symbol; /* unable to check the parameters of an unknown function */
 	check_formal_call(symbol, symbol->called_function_declaration);
 	return NULL;
 }
@@ -545,6 +531,7 @@ void *lvalue_check_c::visit(R_operator_c *symbol) {
 /***********************/
 // SYM_REF3(function_invocation_c, function_name, formal_param_list, nonformal_param_list, symbol_c *called_function_declaration; int extensible_param_count; std::vector <symbol_c *> candidate_functions;)
 void *lvalue_check_c::visit(function_invocation_c *symbol) {
+	if (NULL == symbol->called_function_declaration) return symbol; /* unable to check the parameters of an unknown function */
 	if (NULL != symbol->formal_param_list   )  check_formal_call   (symbol, symbol->called_function_declaration);
 	if (NULL != symbol->nonformal_param_list)  check_nonformal_call(symbol, symbol->called_function_declaration);
 	return NULL;
@@ -555,8 +542,8 @@ void *lvalue_check_c::visit(function_invocation_c *symbol) {
 /*********************************/
 void *lvalue_check_c::visit(assignment_statement_c *symbol) {
 	verify_is_lvalue(symbol->l_exp);
-	/* We call visit r_exp to check function_call */
-	symbol->r_exp->accept(*this);
+	/* Only the r_exp is visited, to check function_call */
+	skip(symbol->l_exp);
 	return NULL;
 }
 
@@ -564,6 +551,7 @@ void *lvalue_check_c::visit(assignment_statement_c *symbol) {
 /* B 3.2.2 Subprogram Control Statements */
 /*****************************************/
 void *lvalue_check_c::visit(fb_invocation_c *symbol) {
+	if (NULL == symbol->called_fb_declaration) return symbol; /* unable to check the parameters of an unknown FB */
 	if (NULL != symbol->formal_param_list   )  check_formal_call   (symbol, symbol->called_fb_declaration);
 	if (NULL != symbol->nonformal_param_list)  check_nonformal_call(symbol, symbol->called_fb_declaration);
 	return NULL;
@@ -574,13 +562,32 @@ void *lvalue_check_c::visit(fb_invocation_c *symbol) {
 /********************************/
 void *lvalue_check_c::visit(for_statement_c *symbol) {
         verify_is_lvalue(symbol->control_variable);
-	control_variables.push_back(get_var_name_c::get_name(symbol->control_variable));
-	symbol->statement_list->accept(*this);
-	control_variables.pop_back();
+	control_variables.push_back(get_var_name_c::get_name(symbol->control_variable)); /* popped in leave() */
+	/* Only the statement_list is visited */
+	skip(symbol->control_variable);
+	skip(symbol->beg_expression);
+	skip(symbol->end_expression);
+	skip(symbol->by_expression);
+	call_leave();
 	return NULL;
 }
 
 
+/* Undo the state set up by the visit() methods, once the children of the symbol have been visited */
+void lvalue_check_c::leave(symbol_c *symbol) {
+	if (   symbol->is<function_declaration_c>()
+	    || symbol->is<function_block_declaration_c>()
+	    || symbol->is<program_declaration_c>()) {
+		delete search_varfb_instance_type;
+		delete search_var_instance_decl;
+		search_varfb_instance_type = NULL;
+		search_var_instance_decl = NULL;
+	}
+	if (symbol->is<il_simple_operation_c>())  current_il_operand = NULL;
+	if (symbol->is<for_statement_c>())        control_variables.pop_back();
+}
+
+
 
 
 
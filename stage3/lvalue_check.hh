@@ -34,6 +34,7 @@
 #include <vector>
 #include "../absyntax_utils/absyntax_utils.hh"
 #include "datatype_functions.hh"
+#include "fused_check.hh"
 
 
 /* Expressions on the left hand side of assignment statements have aditional restrictions on their datatype.
@@ -41,11 +42,14 @@
  * This class wil do those checks.
  * 
  * Note that assignment may also be done when passing variables to OUTPUT or IN_OUT function parameters,so we check those too.
+ *
+ * This checker is run by a fused_check_c (see fused_check.hh), together with other checkers, so its visit()
+ * methods do not visit the children of the symbols.
  */
 
 
 
-class lvalue_check_c: public iterator_visitor_c {
+class lvalue_check_c: public fused_checker_c {
 
   private:
     search_varfb_instance_type_c *search_varfb_instance_type;
@@ -70,6 +74,7 @@ class lvalue_check_c: public iterator_visitor_c {
     lvalue_check_c(symbol_c *ignore);
     virtual ~lvalue_check_c(void);
     int get_error_count();
+    void leave(symbol_c *symbol);
 
     /**************************************/
     /* B 1.5 - Program organisation units */
@@ -95,7 +100,6 @@ class lvalue_check_c: public iterator_visitor_c {
     /***********************************/
     /* B 2.1 Instructions and Operands */
     /***********************************/
-    void *visit(il_instruction_c *symbol);
     void *visit(il_simple_operation_c *symbol);
     void *visit(il_function_call_c *symbol);
     void *visit(il_fb_call_c *symbol);
@@ -88,7 +88,7 @@ static void set_datatype(symbol_c *datatype, symbol_c *symbol) {
  	if ((NULL == datatype) && (NULL != symbol->datatype)) return;
 	if ((NULL == datatype) && (NULL == symbol->datatype)) return;
 	
-	if (search_in_candidate_datatype_list(datatype, symbol->candidate_datatypes) < 0)
+	if (search_in_candidate_datatype_list(datatype, symbol->get_candidate_datatypes()) < 0)
 		symbol->datatype = &(get_datatype_info_c::invalid_type_name);   
 	else {
 		if (NULL == symbol->datatype)   
@@ -177,11 +177,11 @@ void narrow_candidate_datatypes_c::narrow_nonformal_call(symbol_c *f_call, symbo
 		/* NOTE: When we are handling a nonformal function call made from IL, the first parameter is the 'default' or 'current'
 		 *       il value. However, a pointer to a copy of the prev_il_instruction is pre-pended into the operand list, so 
 		 *       the call 
-		 *       call_param_value->accept(*this);
+		 *       dispatch(call_param_value);
 		 *       may actually be calling an object of the base symbol_c .
 		 */
 		set_datatype(desired_datatype, call_param_value);
-		call_param_value->accept(*this);
+		dispatch(call_param_value);
 
 		if (NULL != param_name) 
 			if (extensible_parameter_highest_index < fp_iterator.extensible_param_index())
@@ -234,7 +234,7 @@ void narrow_candidate_datatypes_c::narrow_formal_call(symbol_c *f_call, symbol_c
 		/* set the desired data type for this parameter */
 		set_datatype(desired_datatype, call_param_value);
 		/* And recursively call that parameter/expression, so it can propagate that info */
-		call_param_value->accept(*this);
+		dispatch(call_param_value);
 
 		/* set the extensible_parameter_highest_index, which will be needed in stage 4 */
 		/* This value says how many extensible parameters are being passed to the standard function */
@@ -272,8 +272,8 @@ void narrow_candidate_datatypes_c::narrow_function_invocation(symbol_c *fcall, g
 	fcall_data.called_function_declaration = NULL;
 
 	/* set the called_function_declaration taking into account the datatype that we need to return */
-	for(unsigned int i = 0; i < fcall->candidate_datatypes.size(); i++) {
-		if (get_datatype_info_c::is_type_equal(fcall->candidate_datatypes[i], fcall->datatype)) {
+	for(unsigned int i = 0; i < fcall->get_candidate_datatypes().size(); i++) {
+		if (get_datatype_info_c::is_type_equal(fcall->get_candidate_datatypes()[i], fcall->datatype)) {
 			fcall_data.called_function_declaration = fcall_data.candidate_functions[i];
 			break;
 		}
@@ -287,7 +287,7 @@ void narrow_candidate_datatypes_c::narrow_function_invocation(symbol_c *fcall, g
 	 *       invocation.
 	 */
 	/* if (NULL == symbol->called_function_declaration) ERROR; */
-	if (fcall->candidate_datatypes.size() == 1) {
+	if (fcall->get_candidate_datatypes().size() == 1) {
 		/* If only one function declaration, then we use that (even if symbol->datatypes == NULL)
 		 * so we can check for errors in the expressions used to pass parameters in this
 		 * function invocation.
@@ -323,7 +323,7 @@ void *narrow_candidate_datatypes_c::narrow_implicit_il_fb_call(symbol_c *il_inst
 	/* set the datatype of the il_operand, this is, the FB being called! */
 	if (NULL != il_operand) {
 		set_datatype(called_fb_declaration, il_operand); /* only set it if it is in the candidate datatypes list! */  
-		il_operand->accept(*this);
+		dispatch(il_operand);
 	}
 
 	if (0 == fake_prev_il_instruction->prev_il_instruction.size()) {
@@ -376,7 +376,7 @@ void *narrow_candidate_datatypes_c::narrow_implicit_il_fb_call(symbol_c *il_inst
 	 * correctly set up the il_fb_call.datatype variable!
 	 */
 	il_fb_call.called_fb_declaration = called_fb_declaration;
-	il_fb_call.accept(*this);
+	dispatch(&il_fb_call);
 
 	/* set the required datatype of the previous IL instruction! */
 	/* NOTE:
@@ -439,8 +439,8 @@ void *narrow_candidate_datatypes_c::visit(derived_datatype_identifier_c *symbol)
 	// If this symbol was used (for example) in an ARRAY [1..2] OF <derived_datatype_identifier_c> (i.e. a datatype in an array)
 	// then the symbol->datatype of this derived_datatype_identifier_c has not yet been set by the previous visit() method!
 	// We therefore set the datatype ourselves!
-	if ((NULL == symbol->datatype) && (symbol->candidate_datatypes.size() == 1))
-		symbol->datatype = symbol->candidate_datatypes[0];
+	if ((NULL == symbol->datatype) && (symbol->get_candidate_datatypes().size() == 1))
+		symbol->datatype = symbol->get_candidate_datatypes()[0];
 	return NULL;
 }
 
@@ -451,8 +451,8 @@ void *narrow_candidate_datatypes_c::visit(         poutype_identifier_c *symbol)
 	// If this symbol was used (for example) in an ARRAY [1..2] OF <derived_datatype_identifier_c> (i.e. a datatype in an array)
 	// then the symbol->datatype of this derived_datatype_identifier_c has not yet been set by the previous visit() method!
 	// We therefore set the datatype ourselves!
-	if ((NULL == symbol->datatype) && (symbol->candidate_datatypes.size() == 1))
-		symbol->datatype = symbol->candidate_datatypes[0];
+	if ((NULL == symbol->datatype) && (symbol->get_candidate_datatypes().size() == 1))
+		symbol->datatype = symbol->get_candidate_datatypes()[0];
 	return NULL;
 }
 */
@@ -523,27 +523,27 @@ void *narrow_candidate_datatypes_c::narrow_spec_init(symbol_c *symbol, symbol_c
 	// If we are handling an anonymous datatype (i.e. a datatype implicitly declared inside a VAR ... END_VAR declaration)
 	// then the symbol->datatype has not yet been set by the previous visit(type_decl) method, because it does not exist!
 	// So we set the datatype ourselves!
-	if ((NULL == symbol->datatype) && (symbol->candidate_datatypes.size() == 1))
-		symbol->datatype = symbol->candidate_datatypes[0];
+	if ((NULL == symbol->datatype) && (symbol->get_candidate_datatypes().size() == 1))
+		symbol->datatype = symbol->get_candidate_datatypes()[0];
   
 	set_datatype(symbol->datatype, type_decl);
-	type_decl->accept(*this);
+	dispatch(type_decl);
 
 	if (NULL != init_value) {
 		set_datatype(symbol->datatype, init_value);
-		init_value->accept(*this);
+		dispatch(init_value);
 	}
 	return NULL;
 }
 
 
 void *narrow_candidate_datatypes_c::narrow_type_decl(symbol_c *symbol, symbol_c *type_name, symbol_c *spec_init) {
-	if (symbol->candidate_datatypes.size() == 1) {
-		symbol->datatype = symbol->candidate_datatypes[0];
+	if (symbol->get_candidate_datatypes().size() == 1) {
+		symbol->datatype = symbol->get_candidate_datatypes()[0];
   
 		set_datatype(symbol->datatype, type_name);
 		set_datatype(symbol->datatype, spec_init);
-		spec_init->accept(*this);
+		dispatch(spec_init);
 	}
 	return NULL;
 }
@@ -577,9 +577,9 @@ void *narrow_candidate_datatypes_c::visit(subrange_spec_init_c *symbol) {return
 // SYM_REF2(subrange_specification_c, integer_type_name, subrange)
 void *narrow_candidate_datatypes_c::visit(subrange_specification_c *symbol) {
 	set_datatype(symbol->datatype, symbol->integer_type_name);
-	symbol->integer_type_name->accept(*this);
+	dispatch(symbol->integer_type_name);
 	set_datatype(symbol->datatype, symbol->integer_type_name);
-	symbol->integer_type_name->accept(*this);
+	dispatch(symbol->integer_type_name);
 	return NULL;
 }
 
@@ -588,9 +588,9 @@ void *narrow_candidate_datatypes_c::visit(subrange_specification_c *symbol) {
 // SYM_REF2(subrange_c, lower_limit, upper_limit, unsigned long long int dimension;)
 void *narrow_candidate_datatypes_c::visit(subrange_c *symbol) {
 	set_datatype(symbol->datatype, symbol->lower_limit);
-	symbol->lower_limit->accept(*this);
+	dispatch(symbol->lower_limit);
 	set_datatype(symbol->datatype, symbol->upper_limit);
-	symbol->upper_limit->accept(*this);
+	dispatch(symbol->upper_limit);
 	return NULL;
 }
 
@@ -697,7 +697,7 @@ void *narrow_candidate_datatypes_c::visit(structure_element_initialization_list_
 				type = search_base_type_c::get_basetype_decl(struct_decl->find_element(struct_elem->structure_element_name));
 			}
 			set_datatype(type, struct_elem);
-			struct_elem->accept(*this);
+			dispatch(struct_elem);
 			/* We do best effort narrowing, even in the presence of errors, to reduce number of error messages
 			 * so the following two assertions are not always met.
 			 */
@@ -710,7 +710,7 @@ void *narrow_candidate_datatypes_c::visit(structure_element_initialization_list_
 
 /*  structure_element_name ASSIGN value */
 // SYM_REF2(structure_element_initialization_c, structure_element_name, value)
-void *narrow_candidate_datatypes_c::visit(structure_element_initialization_c *symbol) {set_datatype(symbol->datatype, symbol->value); symbol->value->accept(*this); return NULL;}
+void *narrow_candidate_datatypes_c::visit(structure_element_initialization_c *symbol) {set_datatype(symbol->datatype, symbol->value); dispatch(symbol->value); return NULL;}
 
 /*  string_type_name ':' elementary_string_type_name string_type_declaration_size string_type_declaration_init */
 // SYM_REF4(string_type_declaration_c, string_type_name, elementary_string_type_name, string_type_declaration_size, string_type_declaration_init/* may be == NULL! */) 
@@ -726,17 +726,17 @@ void *narrow_candidate_datatypes_c::visit(fb_spec_init_c *symbol) {return narrow
 // SYM_REF1(ref_spec_c, type_name)
 void *narrow_candidate_datatypes_c::visit(ref_spec_c *symbol) {
 	/* First handle the datatype being referenced (pointed to) */
-	if (symbol->type_name->candidate_datatypes.size() == 1) {
-		symbol->type_name->datatype = symbol->type_name->candidate_datatypes[0];
-		symbol->type_name->accept(*this);
+	if (symbol->type_name->get_candidate_datatypes().size() == 1) {
+		symbol->type_name->datatype = symbol->type_name->get_candidate_datatypes()[0];
+		dispatch(symbol->type_name);
 	}
 
 	/* Now handle the reference datatype itself (i.e. the pointer) */
 	// If we are handling an anonymous datatype (i.e. a datatype implicitly declared inside a VAR ... END_VAR declaration)
 	// then the symbol->datatype has not yet been set by the previous visit(type_decl) method, because it does not exist!
 	// So we set the datatype ourselves!
-	if ((NULL == symbol->datatype) && (symbol->candidate_datatypes.size() == 1))
-		symbol->datatype = symbol->candidate_datatypes[0];
+	if ((NULL == symbol->datatype) && (symbol->get_candidate_datatypes().size() == 1))
+		symbol->datatype = symbol->get_candidate_datatypes()[0];
 
 	return NULL;
 }
@@ -772,13 +772,13 @@ void *narrow_candidate_datatypes_c::visit(symbolic_variable_c *symbol) {
 // SYM_REF2(array_variable_c, subscripted_variable, subscript_list)
 void *narrow_candidate_datatypes_c::visit(array_variable_c *symbol) {
 	/* we need to check the data types of the expressions used for the subscripts... */
-	symbol->subscript_list->accept(*this);
+	dispatch(symbol->subscript_list);
 
 	/* Set the datatype of the subscripted variable and visit it recursively. For the reason why we do this,                                                 */
 	/* Please read the comments in the array_variable_c and structured_variable_c visitors in the fill_candidate_datatypes.cc file! */
-	if (symbol->subscripted_variable->candidate_datatypes.size() == 1)
-	  symbol->subscripted_variable->datatype = symbol->subscripted_variable->candidate_datatypes[0]; // set the datatype
-	symbol->subscripted_variable->accept(*this); // visit recursively
+	if (symbol->subscripted_variable->get_candidate_datatypes().size() == 1)
+	  symbol->subscripted_variable->datatype = symbol->subscripted_variable->get_candidate_datatypes()[0]; // set the datatype
+	dispatch(symbol->subscripted_variable); // visit recursively
 
 	return NULL;
 }
@@ -788,11 +788,11 @@ void *narrow_candidate_datatypes_c::visit(array_variable_c *symbol) {
 // SYM_LIST(subscript_list_c)
 void *narrow_candidate_datatypes_c::visit(subscript_list_c *symbol) {
 	for (int i = 0; i < symbol->n; i++) {
-		for (unsigned int k = 0; k < symbol->get_element(i)->candidate_datatypes.size(); k++) {
-			if (get_datatype_info_c::is_ANY_INT(symbol->get_element(i)->candidate_datatypes[k]))
-				symbol->get_element(i)->datatype = symbol->get_element(i)->candidate_datatypes[k];
+		for (unsigned int k = 0; k < symbol->get_element(i)->get_candidate_datatypes().size(); k++) {
+			if (get_datatype_info_c::is_ANY_INT(symbol->get_element(i)->get_candidate_datatypes()[k]))
+				symbol->get_element(i)->datatype = symbol->get_element(i)->get_candidate_datatypes()[k];
 		}
-		symbol->get_element(i)->accept(*this);
+		dispatch(symbol->get_element(i));
 	}
 	return NULL;  
 }
@@ -809,9 +809,9 @@ void *narrow_candidate_datatypes_c::visit(subscript_list_c *symbol) {
 void *narrow_candidate_datatypes_c::visit(structured_variable_c *symbol) {
 	/* Set the datatype of the record_variable and visit it recursively. For the reason why we do this,                                                      */
 	/* Please read the comments in the array_variable_c and structured_variable_c visitors in the fill_candidate_datatypes.cc file! */
-	if (symbol->record_variable->candidate_datatypes.size() == 1)
-	  symbol->record_variable->datatype = symbol->record_variable->candidate_datatypes[0]; // set the datatype
-	symbol->record_variable->accept(*this); // visit recursively
+	if (symbol->record_variable->get_candidate_datatypes().size() == 1)
+	  symbol->record_variable->datatype = symbol->record_variable->get_candidate_datatypes()[0]; // set the datatype
+	dispatch(symbol->record_variable); // visit recursively
 
 	return NULL;
 }
@@ -838,9 +838,9 @@ void *narrow_candidate_datatypes_c::visit(structured_variable_c *symbol) {
  *  symbol->datatype annotation filled by the fill/narrow algorithm)
  */
 void *narrow_candidate_datatypes_c::narrow_var_declaration(symbol_c *type) {
-  if (type->candidate_datatypes.size() == 1)
-    type->datatype = type->candidate_datatypes[0];
-  type->accept(*this); 
+  if (type->get_candidate_datatypes().size() == 1)
+    type->datatype = type->get_candidate_datatypes()[0];
+  dispatch(type); 
   return NULL;
 }
 
@@ -862,8 +862,8 @@ void *narrow_candidate_datatypes_c::visit(incompl_located_var_decl_c   *symbol)
 void *narrow_candidate_datatypes_c::visit(var1_list_c *symbol) {
 #if 0   /* We don't really need to set the datatype of each variable. We just check the declaration itself! */
   for(int i = 0; i < symbol->n; i++) {
-    if (symbol->get_element(i)->candidate_datatypes.size() == 1)
-      symbol->get_element(i)->datatype = symbol->get_element(i)->candidate_datatypes[0];
+    if (symbol->get_element(i)->get_candidate_datatypes().size() == 1)
+      symbol->get_element(i)->datatype = symbol->get_element(i)->get_candidate_datatypes()[0];
   }
 #endif
   return NULL;
@@ -874,7 +874,7 @@ void *narrow_candidate_datatypes_c::visit(var1_list_c *symbol) {
 // SYM_REF1(location_c, direct_variable)
 void *narrow_candidate_datatypes_c::visit(location_c *symbol) {
   set_datatype(symbol->datatype, symbol->direct_variable);
-  symbol->direct_variable->accept(*this); /* currently does nothing! */
+  dispatch(symbol->direct_variable); /* currently does nothing! */
   return NULL;
 }
 
@@ -884,13 +884,13 @@ void *narrow_candidate_datatypes_c::visit(location_c *symbol) {
 // SYM_REF3(located_var_decl_c, variable_name, location, located_var_spec_init)
 void *narrow_candidate_datatypes_c::visit(located_var_decl_c *symbol) {
   /* let the var_spec_init set its own symbol->datatype value */
-  symbol->located_var_spec_init->accept(*this);
+  dispatch(symbol->located_var_spec_init);
   
   if (NULL != symbol->variable_name)
     set_datatype(symbol->located_var_spec_init->datatype, symbol->variable_name);
     
   set_datatype(symbol->located_var_spec_init->datatype, symbol->location);
-  symbol->location->accept(*this);
+  dispatch(symbol->location);
   return NULL;
 }
 
@@ -908,9 +908,9 @@ void *narrow_candidate_datatypes_c::visit(function_declaration_c *symbol) {
 	symbol->datatype = symbol->type_name->datatype;
 	
 	search_varfb_instance_type = new search_varfb_instance_type_c(symbol);
-	symbol->var_declarations_list->accept(*this);
+	dispatch(symbol->var_declarations_list);
 	if (debug) printf("Narrowing candidate data types list in body of function %s\n", ((token_c *)(symbol->derived_function_name))->value);
-	symbol->function_body->accept(*this);
+	dispatch(symbol->function_body);
 	delete search_varfb_instance_type;
 	search_varfb_instance_type = NULL;
 	return NULL;
@@ -921,15 +921,15 @@ void *narrow_candidate_datatypes_c::visit(function_declaration_c *symbol) {
 /***************************/
 void *narrow_candidate_datatypes_c::visit(function_block_declaration_c *symbol) {
 	search_varfb_instance_type = new search_varfb_instance_type_c(symbol);
-	symbol->var_declarations->accept(*this);
+	dispatch(symbol->var_declarations);
 	if (debug) printf("Narrowing candidate data types list in body of FB %s\n", ((token_c *)(symbol->fblock_name))->value);
-	symbol->fblock_body->accept(*this);
+	dispatch(symbol->fblock_body);
 	delete search_varfb_instance_type;
 	search_varfb_instance_type = NULL;
 
 	// A FB declaration can also be used as a Datatype! We now do the narrow algorithm considering it as such!
-	if (symbol->candidate_datatypes.size() == 1)
-		symbol->datatype = symbol->candidate_datatypes[0];
+	if (symbol->get_candidate_datatypes().size() == 1)
+		symbol->datatype = symbol->get_candidate_datatypes()[0];
 	return NULL;
 }
 
@@ -938,9 +938,9 @@ void *narrow_candidate_datatypes_c::visit(function_block_declaration_c *symbol)
 /********************/
 void *narrow_candidate_datatypes_c::visit(program_declaration_c *symbol) {
 	search_varfb_instance_type = new search_varfb_instance_type_c(symbol);
-	symbol->var_declarations->accept(*this);
+	dispatch(symbol->var_declarations);
 	if (debug) printf("Narrowing candidate data types list in body of program %s\n", ((token_c *)(symbol->program_type_name))->value);
-	symbol->function_block_body->accept(*this);
+	dispatch(symbol->function_block_body);
 	delete search_varfb_instance_type;
 	search_varfb_instance_type = NULL;
 	return NULL;
@@ -955,11 +955,11 @@ void *narrow_candidate_datatypes_c::visit(transition_condition_c *symbol) {
 
 	if (symbol->transition_condition_il != NULL) {
 		set_datatype(symbol->datatype, symbol->transition_condition_il);
-		symbol->transition_condition_il->accept(*this);
+		dispatch(symbol->transition_condition_il);
 	}
 	if (symbol->transition_condition_st != NULL) {
 		set_datatype(symbol->datatype, symbol->transition_condition_st);
-		symbol->transition_condition_st->accept(*this);
+		dispatch(symbol->transition_condition_st);
 	}
 	return NULL;
 }
@@ -967,13 +967,13 @@ void *narrow_candidate_datatypes_c::visit(transition_condition_c *symbol) {
 
 void *narrow_candidate_datatypes_c::visit(action_qualifier_c *symbol) {
 	if (symbol->action_time) {
-		for(unsigned int i = 0; i < symbol->action_time->candidate_datatypes.size(); i++) {
-			if (get_datatype_info_c::is_TIME_compatible(symbol->action_time->candidate_datatypes[i]))
-				symbol->action_time->datatype = symbol->action_time->candidate_datatypes[i];
+		for(unsigned int i = 0; i < symbol->action_time->get_candidate_datatypes().size(); i++) {
+			if (get_datatype_info_c::is_TIME_compatible(symbol->action_time->get_candidate_datatypes()[i]))
+				symbol->action_time->datatype = symbol->action_time->get_candidate_datatypes()[i];
 		}
-		symbol->action_time->accept(*this);
+		dispatch(symbol->action_time);
 	}
-	symbol->action_qualifier->accept(*this); // Not really necessary for now...
+	dispatch(symbol->action_qualifier); // Not really necessary for now...
 	return NULL;
 }
     
@@ -984,10 +984,10 @@ void *narrow_candidate_datatypes_c::visit(action_qualifier_c *symbol) {
 void *narrow_candidate_datatypes_c::visit(configuration_declaration_c *symbol) {
 	if (debug) printf("Narrowing candidate data types list in configuration %s\n", ((token_c *)(symbol->configuration_name))->value);
 	search_varfb_instance_type = new search_varfb_instance_type_c(symbol);
-	symbol->global_var_declarations->accept(*this);
-	symbol->resource_declarations            ->accept(*this); // points to a single_resource_declaration_c or a resource_declaration_list_c
-//	symbol->access_declarations              ->accept(*this); // TODO
-//	symbol->instance_specific_initializations->accept(*this); // TODO
+	dispatch(symbol->global_var_declarations);
+	dispatch(symbol->resource_declarations); // points to a single_resource_declaration_c or a resource_declaration_list_c
+//	dispatch(symbol->access_declarations); // TODO
+//	dispatch(symbol->instance_specific_initializations); // TODO
 	delete search_varfb_instance_type;
 	search_varfb_instance_type = NULL;
 	return NULL;
@@ -998,8 +998,8 @@ void *narrow_candidate_datatypes_c::visit(resource_declaration_c *symbol) {
 	if (debug) printf("Narrowing candidate data types list in resource %s\n", ((token_c *)(symbol->resource_name))->value);
 	search_varfb_instance_type_c *prev_search_varfb_instance_type = search_varfb_instance_type;
 	search_varfb_instance_type  =  new search_varfb_instance_type_c(symbol);
-	symbol->global_var_declarations->accept(*this);
-	symbol->resource_declaration   ->accept(*this);  // points to a single_resource_declaration_c!
+	dispatch(symbol->global_var_declarations);
+	dispatch(symbol->resource_declaration);  // points to a single_resource_declaration_c!
 	delete search_varfb_instance_type;
 	search_varfb_instance_type = prev_search_varfb_instance_type;
 	return NULL;
@@ -1007,8 +1007,8 @@ void *narrow_candidate_datatypes_c::visit(resource_declaration_c *symbol) {
 
 
 void *narrow_candidate_datatypes_c::visit(single_resource_declaration_c *symbol) {
-//	symbol->task_configuration_list    ->accept(*this);  // TODO
-//	symbol->program_configuration_list ->accept(*this);  // TODO
+//	dispatch(symbol->task_configuration_list);  // TODO
+//	dispatch(symbol->program_configuration_list);  // TODO
 	return NULL;
 }
 
@@ -1042,7 +1042,7 @@ void *narrow_candidate_datatypes_c::visit(instruction_list_c *symbol) {
 	 */
 	for(int j = 0; j < 2; j++) {
 		for(int i = symbol->n-1; i >= 0; i--) {
-			symbol->get_element(i)->accept(*this);
+			dispatch(symbol->get_element(i));
 		}
 	}
 	return NULL;
@@ -1068,7 +1068,7 @@ void *narrow_candidate_datatypes_c::visit(il_instruction_c *symbol) {
 		fake_prev_il_instruction = &tmp_prev_il_instruction;
 		current_il_instruction   = symbol;
 		symbol->il_instruction->datatype = symbol->datatype;
-		symbol->il_instruction->accept(*this);
+		dispatch(symbol->il_instruction);
 		fake_prev_il_instruction = NULL;
 		current_il_instruction   = NULL;
 	}
@@ -1084,7 +1084,7 @@ void *narrow_candidate_datatypes_c::visit(il_simple_operation_c *symbol) {
 	symbol->il_simple_operator->datatype = symbol->datatype;
 	/* recursive call to see whether data types are compatible */
 	il_operand = symbol->il_operand;
-	symbol->il_simple_operator->accept(*this);
+	dispatch(symbol->il_simple_operator);
 	il_operand = NULL;
 	return NULL;
 }
@@ -1142,12 +1142,12 @@ void *narrow_candidate_datatypes_c::visit(il_expression_c *symbol) {
   /* first handle the operation (il_expr_operator) that will use the result coming from the parenthesised IL list (i.e. simple_instr_list) */
   symbol->il_expr_operator->datatype = symbol->datatype;
   il_operand = symbol->simple_instr_list; /* This is not a bug! The parenthesised expression will be used as the operator! */
-  symbol->il_expr_operator->accept(*this);
+  dispatch(symbol->il_expr_operator);
 
   /* now give the parenthesised IL list a chance to narrow the datatypes */
-  /* The datatype that is must return was set by the call symbol->il_expr_operator->accept(*this) */
+  /* The datatype that is must return was set by the call dispatch(symbol->il_expr_operator) */
   il_instruction_c *save_fake_prev_il_instruction = fake_prev_il_instruction; /*this is not really necessary, but lets play it safe */
-  symbol->simple_instr_list->accept(*this);
+  dispatch(symbol->simple_instr_list);
   fake_prev_il_instruction = save_fake_prev_il_instruction;
   
   /* Since stage2 will insert an artificial (and equivalent) LD <il_operand> to the simple_instr_list when an 'il_operand' exists, we know
@@ -1169,7 +1169,7 @@ void *narrow_candidate_datatypes_c::visit(il_expression_c *symbol) {
 void *narrow_candidate_datatypes_c::visit(il_jump_operation_c *symbol) {
   /* recursive call to fill the datatype */
   symbol->il_jump_operator->datatype = symbol->datatype;
-  symbol->il_jump_operator->accept(*this);
+  dispatch(symbol->il_jump_operator);
   return NULL;
 }
 
@@ -1197,7 +1197,7 @@ void *narrow_candidate_datatypes_c::visit(il_fb_call_c *symbol) {
 
 	/* Let the il_call_operator (CAL, CALC, or CALCN) set the datatype of prev_il_instruction... */
 	symbol->il_call_operator->datatype = symbol->datatype;
-	symbol->il_call_operator->accept(*this);
+	dispatch(symbol->il_call_operator);
 	return NULL;
 }
 
@@ -1232,7 +1232,7 @@ void *narrow_candidate_datatypes_c::visit(simple_instr_list_c *symbol) {
 		symbol->get_element(symbol->n - 1)->datatype = symbol->datatype;
 
 	for(int i = symbol->n-1; i >= 0; i--) {
-		symbol->get_element(i)->accept(*this);
+		dispatch(symbol->get_element(i));
 	}
 	return NULL;
 }
@@ -1249,13 +1249,13 @@ void *narrow_candidate_datatypes_c::visit(il_simple_instruction_c *symbol)	{
    * and shove that data into this single variable.
    */
   if (symbol->prev_il_instruction.size() > 0)
-    tmp_prev_il_instruction.candidate_datatypes = symbol->prev_il_instruction[0]->candidate_datatypes;
+    tmp_prev_il_instruction.candidate_datatypes() = symbol->prev_il_instruction[0]->get_candidate_datatypes();
   tmp_prev_il_instruction.prev_il_instruction = symbol->prev_il_instruction;
   
    /* copy the candidate_datatypes list */
   fake_prev_il_instruction = &tmp_prev_il_instruction;
   symbol->il_simple_instruction->datatype = symbol->datatype;
-  symbol->il_simple_instruction->accept(*this);
+  dispatch(symbol->il_simple_instruction);
   fake_prev_il_instruction = NULL;
   return NULL;
 }
@@ -1276,10 +1276,10 @@ void *narrow_candidate_datatypes_c::visit(il_simple_instruction_c *symbol)	{
  *            OR 56
  *            )
  *       When we handle the first 'AND' IL_operator, the il_operand will point to an simple_instr_list_c.
- *       In this case, when we call il_operand->accept(*this);, the prev_il_instruction pointer will be overwritten!
+ *       In this case, when we call dispatch(il_operand);, the prev_il_instruction pointer will be overwritten!
  *
  *       So, if yoy wish to set the prev_il_instruction->datatype = symbol->datatype;
- *       do it __before__ calling set_il_operand_datatype() (which in turn calls il_operand->accept(*this)) !!
+ *       do it __before__ calling set_il_operand_datatype() (which in turn calls dispatch(il_operand)) !!
  */
 int  count = 0;
 void *narrow_candidate_datatypes_c::set_il_operand_datatype(symbol_c *il_operand, symbol_c *datatype) {
@@ -1312,7 +1312,7 @@ void *narrow_candidate_datatypes_c::set_il_operand_datatype(symbol_c *il_operand
 	 * to give a chance of any complex expressions embedded in the il_operand (e.g. expressions inside array subscripts!) 
 	 * to be narrowed too.
 	 */
-	il_operand->accept(*this);
+	dispatch(il_operand);
 	return NULL;
 }
 
@@ -1334,20 +1334,20 @@ void *narrow_candidate_datatypes_c::narrow_binary_operator(const struct widen_en
 	 *            OR 56
 	 *            )
 	 *       When we handle the first 'AND' IL_operator, the il_operand will point to an simple_instr_list_c.
-	 *       In this case, when we call il_operand->accept(*this);, the prev_il_instruction pointer will be overwritten!
+	 *       In this case, when we call dispatch(il_operand);, the prev_il_instruction pointer will be overwritten!
 	 *
 	 *       We must therefore set the prev_il_instruction->datatype = symbol->datatype;
-	 *       __before__ calling il_operand->accept(*this) !!
+	 *       __before__ calling dispatch(il_operand) !!
 	 *
-	 * NOTE 2: We do not need to call prev_il_instruction->accept(*this), as the object to which prev_il_instruction
+	 * NOTE 2: We do not need to call dispatch(prev_il_instruction), as the object to which prev_il_instruction
 	 *         is pointing to will be later narrowed by the call from the for() loop of the instruction_list_c
 	 *         (or simple_instr_list_c), which iterates backwards.
 	 */
 	if (NULL != symbol->datatype) { // next IL instructions were able to determine the datatype this instruction should produce
-		for(unsigned int i = 0; i < fake_prev_il_instruction->candidate_datatypes.size(); i++) {
-			for(unsigned int j = 0; j < il_operand->candidate_datatypes.size(); j++) {
-				prev_instruction_type = fake_prev_il_instruction->candidate_datatypes[i];
-				operand_type = il_operand->candidate_datatypes[j];
+		for(unsigned int i = 0; i < fake_prev_il_instruction->get_candidate_datatypes().size(); i++) {
+			for(unsigned int j = 0; j < il_operand->get_candidate_datatypes().size(); j++) {
+				prev_instruction_type = fake_prev_il_instruction->get_candidate_datatypes()[i];
+				operand_type = il_operand->get_candidate_datatypes()[j];
 				if (is_widening_compatible(widen_table, prev_instruction_type, operand_type, symbol->datatype, deprecated_operation)) {
 					/* set the desired datatype of the previous il instruction */
 					set_datatype_in_prev_il_instructions(prev_instruction_type, fake_prev_il_instruction);
@@ -1423,16 +1423,16 @@ void *narrow_candidate_datatypes_c::narrow_S_and_R_operator(symbol_c *symbol, co
 	/* Set/Reset semantics */  
 	narrow_conditional_operator(symbol);
 	/* set the datatype for the il_operand */
-	if ((NULL != il_operand) && (il_operand->candidate_datatypes.size() > 0))
-		set_il_operand_datatype(il_operand, il_operand->candidate_datatypes[0]);
+	if ((NULL != il_operand) && (il_operand->get_candidate_datatypes().size() > 0))
+		set_il_operand_datatype(il_operand, il_operand->get_candidate_datatypes()[0]);
 	return NULL;
 }
 
 
 
 void *narrow_candidate_datatypes_c::narrow_store_operator(symbol_c *symbol) {
-	if (symbol->candidate_datatypes.size() == 1) {
-		symbol->datatype = symbol->candidate_datatypes[0];
+	if (symbol->get_candidate_datatypes().size() == 1) {
+		symbol->datatype = symbol->get_candidate_datatypes()[0];
 		/* set the desired datatype of the previous il instruction */
 		set_datatype_in_prev_il_instructions(symbol->datatype, fake_prev_il_instruction);
 		/* In the case of the ST operator, we must set the datatype of the il_instruction_c object that points to this ST_operator_c ourselves,
@@ -1496,7 +1496,7 @@ void *narrow_candidate_datatypes_c::visit(  LE_operator_c *symbol)  {return narr
 void *narrow_candidate_datatypes_c::visit(  NE_operator_c *symbol)  {return narrow_binary_operator(widen_CMP_table, symbol);}
 
 
-/* visitors to CAL_operator_c, CALC_operator_c and CALCN_operator_c are called from visit(il_fb_call_c *) {symbol->il_call_operator->accept(*this)} */
+/* visitors to CAL_operator_c, CALC_operator_c and CALCN_operator_c are called from visit(il_fb_call_c *) {dispatch(symbol->il_call_operator)} */
 /* NOTE: The CAL, JMP and RET instructions simply set the desired datatype of the previous il instruction since they do not change the value in the current/default IL variable */
 void *narrow_candidate_datatypes_c::visit(  CAL_operator_c *symbol) {set_datatype_in_prev_il_instructions(symbol->datatype, fake_prev_il_instruction); return NULL;}
 void *narrow_candidate_datatypes_c::visit(  RET_operator_c *symbol) {set_datatype_in_prev_il_instructions(symbol->datatype, fake_prev_il_instruction); return NULL;}
@@ -1522,8 +1522,8 @@ void *narrow_candidate_datatypes_c::visit(JMPCN_operator_c *symbol) {return narr
 /***********************/
 /* SYM_REF1(deref_expression_c, exp)  --> an extension to the IEC 61131-3 standard - based on the IEC 61131-3 v3 standard. Returns address of the varible! */
 void *narrow_candidate_datatypes_c::visit(deref_expression_c  *symbol) {
-  for (unsigned int i = 0; i < symbol->exp->candidate_datatypes.size(); i++) {
-    symbol_c *typ = symbol->exp->candidate_datatypes[i];
+  for (unsigned int i = 0; i < symbol->exp->get_candidate_datatypes().size(); i++) {
+    symbol_c *typ = symbol->exp->get_candidate_datatypes()[i];
     symbol_c *ref = get_datatype_info_c::get_ref_to(typ);
     if (   (get_datatype_info_c::is_ref_to(typ)) 
         && (get_datatype_info_c::is_type_equal(search_base_type_c::get_basetype_decl(ref), symbol->datatype))
@@ -1532,15 +1532,15 @@ void *narrow_candidate_datatypes_c::visit(deref_expression_c  *symbol) {
       symbol->exp->datatype = typ;
   }
   
-  symbol->exp->accept(*this);
+  dispatch(symbol->exp);
   return NULL;
 }
 
 
 /* SYM_REF1(deref_operator_c, exp)  --> an extension to the IEC 61131-3 standard - based on the IEC 61131-3 v3 standard. Returns address of the varible! */
 void *narrow_candidate_datatypes_c::visit(deref_operator_c  *symbol) {
-  for (unsigned int i = 0; i < symbol->exp->candidate_datatypes.size(); i++) {
-    symbol_c *typ = symbol->exp->candidate_datatypes[i];
+  for (unsigned int i = 0; i < symbol->exp->get_candidate_datatypes().size(); i++) {
+    symbol_c *typ = symbol->exp->get_candidate_datatypes()[i];
     symbol_c *ref = get_datatype_info_c::get_ref_to(typ);
     if (   (get_datatype_info_c::is_ref_to(typ)) 
         && (get_datatype_info_c::is_type_equal(search_base_type_c::get_basetype_decl(ref), symbol->datatype))
@@ -1549,17 +1549,17 @@ void *narrow_candidate_datatypes_c::visit(deref_operator_c  *symbol) {
       symbol->exp->datatype = typ;
   }
   
-  symbol->exp->accept(*this);
+  dispatch(symbol->exp);
   return NULL;
 }
 
 
 /* SYM_REF1(ref_expression_c, exp)  --> an extension to the IEC 61131-3 standard - based on the IEC 61131-3 v3 standard. Returns address of the varible! */
 void *narrow_candidate_datatypes_c::visit(  ref_expression_c  *symbol) {
-  if (symbol->exp->candidate_datatypes.size() > 0) {
-    symbol->exp->datatype = symbol->exp->candidate_datatypes[0]; /* just use the first possible datatype */
+  if (symbol->exp->get_candidate_datatypes().size() > 0) {
+    symbol->exp->datatype = symbol->exp->get_candidate_datatypes()[0]; /* just use the first possible datatype */
   }
-  symbol->exp->accept(*this);
+  dispatch(symbol->exp);
   return NULL;
 }
 
@@ -1579,11 +1579,11 @@ void *narrow_candidate_datatypes_c::narrow_binary_expression(const struct widen_
 	if (NULL != deprecated_operation)
 		*deprecated_operation = false;
 
-	for(unsigned int i = 0; i < l_expr->candidate_datatypes.size(); i++) {
-		for(unsigned int j = 0; j < r_expr->candidate_datatypes.size(); j++) {
+	for(unsigned int i = 0; i < l_expr->get_candidate_datatypes().size(); i++) {
+		for(unsigned int j = 0; j < r_expr->get_candidate_datatypes().size(); j++) {
 			/* test widening compatibility */
-			l_type = l_expr->candidate_datatypes[i];
-			r_type = r_expr->candidate_datatypes[j];
+			l_type = l_expr->get_candidate_datatypes()[i];
+			r_type = r_expr->get_candidate_datatypes()[j];
 			if        (is_widening_compatible(widen_table, l_type, r_type, symbol->datatype, deprecated_operation)) {
 				l_expr->datatype = l_type;
 				r_expr->datatype = r_type;
@@ -1603,8 +1603,8 @@ void *narrow_candidate_datatypes_c::narrow_binary_expression(const struct widen_
 // 	if (count > 1) ERROR; /* Since we also support SAFE data types, this assertion is not necessarily always tru! */
 	if (get_datatype_info_c::is_type_valid(symbol->datatype) && (count <= 0)) ERROR;
 	
-	l_expr->accept(*this);
-	r_expr->accept(*this);
+	dispatch(l_expr);
+	dispatch(r_expr);
 	return NULL;
 }
 
@@ -1635,14 +1635,14 @@ void *narrow_candidate_datatypes_c::visit( power_expression_c *symbol) {return n
 
 void *narrow_candidate_datatypes_c::visit(neg_expression_c *symbol) {
 	symbol->exp->datatype = symbol->datatype;
-	symbol->exp->accept(*this);
+	dispatch(symbol->exp);
 	return NULL;
 }
 
 
 void *narrow_candidate_datatypes_c::visit(not_expression_c *symbol) {
 	symbol->exp->datatype = symbol->datatype;
-	symbol->exp->accept(*this);
+	dispatch(symbol->exp);
 	return NULL;
 }
 
@@ -1670,6 +1670,8 @@ void *narrow_candidate_datatypes_c::visit(function_invocation_c *symbol) {
 /********************/
 /* B 3.2 Statements */
 /********************/
+/* Only required so forced_narrow_candidate_datatypes_c may override it */
+void *narrow_candidate_datatypes_c::visit(statement_list_c *symbol) {return visit_list(symbol);}
 
 
 /*********************************/
@@ -1677,14 +1679,14 @@ void *narrow_candidate_datatypes_c::visit(function_invocation_c *symbol) {
 /*********************************/
 
 void *narrow_candidate_datatypes_c::visit(assignment_statement_c *symbol) {
-	if (symbol->candidate_datatypes.size() == 1) {
-		symbol->datatype = symbol->candidate_datatypes[0];
+	if (symbol->get_candidate_datatypes().size() == 1) {
+		symbol->datatype = symbol->get_candidate_datatypes()[0];
 		symbol->l_exp->datatype = symbol->datatype;
 		symbol->r_exp->datatype = symbol->datatype;
 	}
 	/* give the chance of any expressions inside array subscripts to be narrowed correctly */
-	symbol->l_exp->accept(*this);
-	symbol->r_exp->accept(*this);
+	dispatch(symbol->l_exp);
+	dispatch(symbol->r_exp);
 	return NULL;
 }
 
@@ -1717,46 +1719,46 @@ void *narrow_candidate_datatypes_c::visit(fb_invocation_c *symbol) {
 /********************************/
 
 void *narrow_candidate_datatypes_c::visit(if_statement_c *symbol) {
-	for(unsigned int i = 0; i < symbol->expression->candidate_datatypes.size(); i++) {
-		if (get_datatype_info_c::is_BOOL_compatible(symbol->expression->candidate_datatypes[i]))
-			symbol->expression->datatype = symbol->expression->candidate_datatypes[i];
+	for(unsigned int i = 0; i < symbol->expression->get_candidate_datatypes().size(); i++) {
+		if (get_datatype_info_c::is_BOOL_compatible(symbol->expression->get_candidate_datatypes()[i]))
+			symbol->expression->datatype = symbol->expression->get_candidate_datatypes()[i];
 	}
-	symbol->expression->accept(*this);
+	dispatch(symbol->expression);
 	if (NULL != symbol->statement_list)
-		symbol->statement_list->accept(*this);
+		dispatch(symbol->statement_list);
 	if (NULL != symbol->elseif_statement_list)
-		symbol->elseif_statement_list->accept(*this);
+		dispatch(symbol->elseif_statement_list);
 	if (NULL != symbol->else_statement_list)
-		symbol->else_statement_list->accept(*this);
+		dispatch(symbol->else_statement_list);
 	return NULL;
 }
 
 
 void *narrow_candidate_datatypes_c::visit(elseif_statement_c *symbol) {
-	for (unsigned int i = 0; i < symbol->expression->candidate_datatypes.size(); i++) {
-		if (get_datatype_info_c::is_BOOL_compatible(symbol->expression->candidate_datatypes[i]))
-			symbol->expression->datatype = symbol->expression->candidate_datatypes[i];
+	for (unsigned int i = 0; i < symbol->expression->get_candidate_datatypes().size(); i++) {
+		if (get_datatype_info_c::is_BOOL_compatible(symbol->expression->get_candidate_datatypes()[i]))
+			symbol->expression->datatype = symbol->expression->get_candidate_datatypes()[i];
 	}
-	symbol->expression->accept(*this);
+	dispatch(symbol->expression);
 	if (NULL != symbol->statement_list)
-		symbol->statement_list->accept(*this);
+		dispatch(symbol->statement_list);
 	return NULL;
 }
 
 /* CASE expression OF case_element_list ELSE statement_list END_CASE */
 // SYM_REF3(case_statement_c, expression, case_element_list, statement_list)
 void *narrow_candidate_datatypes_c::visit(case_statement_c *symbol) {
-	for (unsigned int i = 0; i < symbol->expression->candidate_datatypes.size(); i++) {
-		if ((get_datatype_info_c::is_ANY_INT(symbol->expression->candidate_datatypes[i]))
-				 || (get_datatype_info_c::is_enumerated(symbol->expression->candidate_datatypes[i])))
-			symbol->expression->datatype = symbol->expression->candidate_datatypes[i];
+	for (unsigned int i = 0; i < symbol->expression->get_candidate_datatypes().size(); i++) {
+		if ((get_datatype_info_c::is_ANY_INT(symbol->expression->get_candidate_datatypes()[i]))
+				 || (get_datatype_info_c::is_enumerated(symbol->expression->get_candidate_datatypes()[i])))
+			symbol->expression->datatype = symbol->expression->get_candidate_datatypes()[i];
 	}
-	symbol->expression->accept(*this);
+	dispatch(symbol->expression);
 	if (NULL != symbol->statement_list)
-		symbol->statement_list->accept(*this);
+		dispatch(symbol->statement_list);
 	if (NULL != symbol->case_element_list) {
 		symbol->case_element_list->datatype = symbol->expression->datatype;
-		symbol->case_element_list->accept(*this);
+		dispatch(symbol->case_element_list);
 	}
 	return NULL;
 }
@@ -1766,7 +1768,7 @@ void *narrow_candidate_datatypes_c::visit(case_statement_c *symbol) {
 void *narrow_candidate_datatypes_c::visit(case_element_list_c *symbol) {
 	for (int i = 0; i < symbol->n; i++) {
 		symbol->get_element(i)->datatype = symbol->datatype;
-		symbol->get_element(i)->accept(*this);
+		dispatch(symbol->get_element(i));
 	}
 	return NULL;
 }
@@ -1775,20 +1777,20 @@ void *narrow_candidate_datatypes_c::visit(case_element_list_c *symbol) {
 // SYM_REF2(case_element_c, case_list, statement_list)
 void *narrow_candidate_datatypes_c::visit(case_element_c *symbol) {
 	symbol->case_list->datatype = symbol->datatype;
-	symbol->case_list->accept(*this);
-	symbol->statement_list->accept(*this);
+	dispatch(symbol->case_list);
+	dispatch(symbol->statement_list);
 	return NULL;
 }
 
 // SYM_LIST(case_list_c)
 void *narrow_candidate_datatypes_c::visit(case_list_c *symbol) {
 	for (int i = 0; i < symbol->n; i++) {
-		for (unsigned int k = 0; k < symbol->get_element(i)->candidate_datatypes.size(); k++) {
-			if (get_datatype_info_c::is_type_equal(symbol->datatype, symbol->get_element(i)->candidate_datatypes[k]))
-				symbol->get_element(i)->datatype = symbol->get_element(i)->candidate_datatypes[k];
+		for (unsigned int k = 0; k < symbol->get_element(i)->get_candidate_datatypes().size(); k++) {
+			if (get_datatype_info_c::is_type_equal(symbol->datatype, symbol->get_element(i)->get_candidate_datatypes()[k]))
+				symbol->get_element(i)->datatype = symbol->get_element(i)->get_candidate_datatypes()[k];
 		}
 		/* NOTE: this may be an integer, a subrange_c, or a enumerated value! */
-		symbol->get_element(i)->accept(*this);
+		dispatch(symbol->get_element(i));
 	}
 	return NULL;
 }
@@ -1799,62 +1801,62 @@ void *narrow_candidate_datatypes_c::visit(case_list_c *symbol) {
 /********************************/
 void *narrow_candidate_datatypes_c::visit(for_statement_c *symbol) {
 	/* Control variable */
-	for(unsigned int i = 0; i < symbol->control_variable->candidate_datatypes.size(); i++) {
-		if (get_datatype_info_c::is_ANY_INT(symbol->control_variable->candidate_datatypes[i])) {
-			symbol->control_variable->datatype = symbol->control_variable->candidate_datatypes[i];
+	for(unsigned int i = 0; i < symbol->control_variable->get_candidate_datatypes().size(); i++) {
+		if (get_datatype_info_c::is_ANY_INT(symbol->control_variable->get_candidate_datatypes()[i])) {
+			symbol->control_variable->datatype = symbol->control_variable->get_candidate_datatypes()[i];
 		}
 	}
-	symbol->control_variable->accept(*this);
+	dispatch(symbol->control_variable);
 	/* BEG expression */
-	for(unsigned int i = 0; i < symbol->beg_expression->candidate_datatypes.size(); i++) {
-		if (get_datatype_info_c::is_type_equal(symbol->control_variable->datatype,symbol->beg_expression->candidate_datatypes[i]) &&
-				get_datatype_info_c::is_ANY_INT(symbol->beg_expression->candidate_datatypes[i])) {
-			symbol->beg_expression->datatype = symbol->beg_expression->candidate_datatypes[i];
+	for(unsigned int i = 0; i < symbol->beg_expression->get_candidate_datatypes().size(); i++) {
+		if (get_datatype_info_c::is_type_equal(symbol->control_variable->datatype,symbol->beg_expression->get_candidate_datatypes()[i]) &&
+				get_datatype_info_c::is_ANY_INT(symbol->beg_expression->get_candidate_datatypes()[i])) {
+			symbol->beg_expression->datatype = symbol->beg_expression->get_candidate_datatypes()[i];
 		}
 	}
-	symbol->beg_expression->accept(*this);
+	dispatch(symbol->beg_expression);
 	/* END expression */
-	for(unsigned int i = 0; i < symbol->end_expression->candidate_datatypes.size(); i++) {
-		if (get_datatype_info_c::is_type_equal(symbol->control_variable->datatype,symbol->end_expression->candidate_datatypes[i]) &&
-				get_datatype_info_c::is_ANY_INT(symbol->end_expression->candidate_datatypes[i])) {
-			symbol->end_expression->datatype = symbol->end_expression->candidate_datatypes[i];
+	for(unsigned int i = 0; i < symbol->end_expression->get_candidate_datatypes().size(); i++) {
+		if (get_datatype_info_c::is_type_equal(symbol->control_variable->datatype,symbol->end_expression->get_candidate_datatypes()[i]) &&
+				get_datatype_info_c::is_ANY_INT(symbol->end_expression->get_candidate_datatypes()[i])) {
+			symbol->end_expression->datatype = symbol->end_expression->get_candidate_datatypes()[i];
 		}
 	}
-	symbol->end_expression->accept(*this);
+	dispatch(symbol->end_expression);
 	/* BY expression */
 	if (NULL != symbol->by_expression) {
-		for(unsigned int i = 0; i < symbol->by_expression->candidate_datatypes.size(); i++) {
-			if (get_datatype_info_c::is_type_equal(symbol->control_variable->datatype,symbol->by_expression->candidate_datatypes[i]) &&
-					get_datatype_info_c::is_ANY_INT(symbol->by_expression->candidate_datatypes[i])) {
-				symbol->by_expression->datatype = symbol->by_expression->candidate_datatypes[i];
+		for(unsigned int i = 0; i < symbol->by_expression->get_candidate_datatypes().size(); i++) {
+			if (get_datatype_info_c::is_type_equal(symbol->control_variable->datatype,symbol->by_expression->get_candidate_datatypes()[i]) &&
+					get_datatype_info_c::is_ANY_INT(symbol->by_expression->get_candidate_datatypes()[i])) {
+				symbol->by_expression->datatype = symbol->by_expression->get_candidate_datatypes()[i];
 			}
 		}
-		symbol->by_expression->accept(*this);
+		dispatch(symbol->by_expression);
 	}
 	if (NULL != symbol->statement_list)
-		symbol->statement_list->accept(*this);
+		dispatch(symbol->statement_list);
 	return NULL;
 }
 
 void *narrow_candidate_datatypes_c::visit(while_statement_c *symbol) {
-	for (unsigned int i = 0; i < symbol->expression->candidate_datatypes.size(); i++) {
-		if(get_datatype_info_c::is_BOOL(symbol->expression->candidate_datatypes[i]))
-			symbol->expression->datatype = symbol->expression->candidate_datatypes[i];
+	for (unsigned int i = 0; i < symbol->expression->get_candidate_datatypes().size(); i++) {
+		if(get_datatype_info_c::is_BOOL(symbol->expression->get_candidate_datatypes()[i]))
+			symbol->expression->datatype = symbol->expression->get_candidate_datatypes()[i];
 	}
-	symbol->expression->accept(*this);
+	dispatch(symbol->expression);
 	if (NULL != symbol->statement_list)
-		symbol->statement_list->accept(*this);
+		dispatch(symbol->statement_list);
 	return NULL;
 }
 
 void *narrow_candidate_datatypes_c::visit(repeat_statement_c *symbol) {
-	for (unsigned int i = 0; i < symbol->expression->candidate_datatypes.size(); i++) {
-		if(get_datatype_info_c::is_BOOL(symbol->expression->candidate_datatypes[i]))
-			symbol->expression->datatype = symbol->expression->candidate_datatypes[i];
+	for (unsigned int i = 0; i < symbol->expression->get_candidate_datatypes().size(); i++) {
+		if(get_datatype_info_c::is_BOOL(symbol->expression->get_candidate_datatypes()[i]))
+			symbol->expression->datatype = symbol->expression->get_candidate_datatypes()[i];
 	}
-	symbol->expression->accept(*this);
+	dispatch(symbol->expression);
 	if (NULL != symbol->statement_list)
-		symbol->statement_list->accept(*this);
+		dispatch(symbol->statement_list);
 	return NULL;
 }
 
@@ -59,9 +59,13 @@
 
 
 #include "../absyntax_utils/absyntax_utils.hh"
+#include "../absyntax/static_visitor.hh"
 #include "datatype_functions.hh"
 
-class narrow_candidate_datatypes_c: public iterator_visitor_c {
+/* NOTE: This is a static visitor (see static_visitor.hh). The visit() methods overridden
+ *       by forced_narrow_candidate_datatypes_c must therefore be declared virtual.
+ */
+class narrow_candidate_datatypes_c: public static_iterator_visitor_c<narrow_candidate_datatypes_c> {
 
   private:
     search_varfb_instance_type_c *search_varfb_instance_type;
@@ -97,6 +101,8 @@ class narrow_candidate_datatypes_c: public iterator_visitor_c {
     narrow_candidate_datatypes_c(symbol_c *ignore);
     virtual ~narrow_candidate_datatypes_c(void);
 
+    using static_iterator_visitor_c<narrow_candidate_datatypes_c>::visit;
+
     symbol_c *base_type(symbol_c *symbol);
 
     /*************************/
@@ -268,8 +274,8 @@ class narrow_candidate_datatypes_c: public iterator_visitor_c {
     /***********************************/
     /* B 2.1 Instructions and Operands */
     /***********************************/
-    void *visit(instruction_list_c *symbol);
-    void *visit(il_instruction_c *symbol);
+    virtual void *visit(instruction_list_c *symbol);
+    virtual void *visit(il_instruction_c *symbol);
     void *visit(il_simple_operation_c *symbol);
     void *visit(il_function_call_c *symbol);
     void *visit(il_expression_c *symbol);
@@ -278,7 +284,7 @@ class narrow_candidate_datatypes_c: public iterator_visitor_c {
     void *visit(il_formal_funct_call_c *symbol);
 //  void *visit(il_operand_list_c *symbol);
     void *visit(simple_instr_list_c *symbol);
-    void *visit(il_simple_instruction_c*symbol);
+    virtual void *visit(il_simple_instruction_c*symbol);
 //  void *visit(il_param_list_c *symbol);
 //  void *visit(il_param_assignment_c *symbol);
 //  void *visit(il_param_out_assignment_c *symbol);
@@ -359,6 +365,11 @@ class narrow_candidate_datatypes_c: public iterator_visitor_c {
     void *visit(     not_expression_c *symbol);
     void *visit(function_invocation_c *symbol);
 
+    /********************/
+    /* B 3.2 Statements */
+    /********************/
+    virtual void *visit(statement_list_c *symbol);
+
     /*********************************/
     /* B 3.2.1 Assignment Statements */
     /*********************************/
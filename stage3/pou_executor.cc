@@ -0,0 +1,273 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * Run a stage 3 algorithm over the POUs of a library, using several threads.
+ * See the comment in pou_executor.hh
+ */
+
+
+#include "pou_executor.hh"
+#include "../main.hh" // required for ERROR() and ERROR_MSG() macros.
+
+
+
+
+/* Where the error messages of the element being visited by the calling thread are kept.
+ * NULL when the calling thread is not visiting an element for a pou_executor_c, in which case
+ * the error messages go directly to stderr.
+ */
+static __thread FILE **current_errors = NULL;
+
+
+FILE *stage3_error_stream(void) {
+  if (NULL == current_errors)
+    return stderr;
+  if (NULL == *current_errors) {
+    *current_errors = tmpfile();
+    /* If we can not keep the messages aside, print them right away. They may come out of order, but are not lost. */
+    if (NULL == *current_errors) return stderr;
+  }
+  return *current_errors;
+}
+
+
+/* copy the error messages kept aside to stderr */
+static void print_errors(FILE *errors) {
+  char   buffer[4096];
+  size_t count;
+
+  if ((NULL == errors) || (stderr == errors)) return;
+  rewind(errors);
+  while ((count = fread(buffer, 1, sizeof(buffer), errors)) > 0)
+    fwrite(buffer, 1, count, stderr);
+  fclose(errors);
+}
+
+
+
+
+pou_executor_c::pou_executor_c(int thread_count) {
+  this->thread_count = (thread_count < 1)? 1 : thread_count;
+  visitors    = NULL;
+  job         = 0;
+  busy_count  = 0;
+  terminate   = false;
+  steal_count = 0;
+  worker_accept_count = 0;
+
+  pthread_mutex_init(&lock, NULL);
+  pthread_cond_init (&start_cond, NULL);
+  pthread_cond_init (&done_cond,  NULL);
+
+  for (int i = 0; i < this->thread_count; i++) {
+    queue_t *queue = new queue_t;
+    pthread_mutex_init(&queue->lock, NULL);
+    queues.push_back(queue);
+  }
+
+  /* thread 0 is the calling thread. */
+  for (int i = 1; i < this->thread_count; i++) {
+    worker_t *worker = new worker_t;
+    worker->executor = this;
+    worker->index    = i;
+    worker->arena    = new arena_c();
+    if (pthread_create(&worker->thread, NULL, worker_main, worker) != 0) {
+      /* carry on with the threads we already have */
+      delete worker->arena;
+      delete worker;
+      this->thread_count = i;
+      break;
+    }
+    workers.push_back(worker);
+  }
+}
+
+
+pou_executor_c::~pou_executor_c(void) {
+  pthread_mutex_lock(&lock);
+  terminate = true;
+  pthread_cond_broadcast(&start_cond);
+  pthread_mutex_unlock(&lock);
+
+  for (unsigned int i = 0; i < workers.size(); i++) {
+    pthread_join(workers[i]->thread, NULL);
+    /* The AST nodes the thread allocated have already been handed over to the calling thread's arena. */
+    delete workers[i]->arena;
+    delete workers[i];
+  }
+  for (unsigned int i = 0; i < queues.size(); i++) {
+    pthread_mutex_destroy(&queues[i]->lock);
+    delete queues[i];
+  }
+
+  pthread_cond_destroy (&done_cond);
+  pthread_cond_destroy (&start_cond);
+  pthread_mutex_destroy(&lock);
+}
+
+
+
+void *pou_executor_c::worker_main(void *arg) {
+  worker_t       *worker   = (worker_t *)arg;
+  pou_executor_c *executor = worker->executor;
+  unsigned long   last_job = 0;
+
+  arena_c::set_current(worker->arena);
+  while (true) {
+    pthread_mutex_lock(&executor->lock);
+    while (!executor->terminate && (executor->job == last_job))
+      pthread_cond_wait(&executor->start_cond, &executor->lock);
+    if (executor->terminate) {
+      pthread_mutex_unlock(&executor->lock);
+      return NULL;
+    }
+    last_job = executor->job;
+    pthread_mutex_unlock(&executor->lock);
+
+    executor->run_tasks(worker->index);
+
+    pthread_mutex_lock(&executor->lock);
+    if (0 == --executor->busy_count)
+      pthread_cond_signal(&executor->done_cond);
+    pthread_mutex_unlock(&executor->lock);
+  }
+}
+
+
+
+/* Get the next POU to be visited by the thread. First from its own queue, and then from the queues of the other threads. */
+bool pou_executor_c::get_task(int thread, int &task) {
+  queue_t *queue = queues[thread];
+
+  pthread_mutex_lock(&queue->lock);
+  bool found = !queue->tasks.empty();
+  if (found) {task = queue->tasks.front(); queue->tasks.pop_front();}
+  pthread_mutex_unlock(&queue->lock);
+  if (found) return true;
+
+  for (int i = 1; i < thread_count; i++) {
+    queue = queues[(thread + i) % thread_count];
+    pthread_mutex_lock(&queue->lock);
+    found = !queue->tasks.empty();
+    if (found) {task = queue->tasks.back(); queue->tasks.pop_back();}
+    pthread_mutex_unlock(&queue->lock);
+    if (found) {__sync_fetch_and_add(&steal_count, 1); return true;}
+  }
+  return false;
+}
+
+
+void pou_executor_c::run_task(int task, visitor_c *visitor) {
+  current_errors = &tasks[task].errors;
+  tasks[task].element->accept(*visitor);
+  current_errors = NULL;
+}
+
+
+void pou_executor_c::run_tasks(int thread) {
+  unsigned long accept_count = symbol_c::accept_count;
+  int task;
+  while (get_task(thread, task))
+    run_task(task, (*visitors)[thread]);
+  if (0 != thread)
+    __sync_fetch_and_add(&worker_accept_count, symbol_c::accept_count - accept_count);
+}
+
+
+
+void pou_executor_c::run(symbol_c *tree_root, std::vector<visitor_c *> &visitors, bool skip_up_to_date) {
+  if ((int)visitors.size() < thread_count) ERROR;
+
+  library_c *library = dynamic_cast<library_c *>(tree_root);
+  if (NULL == library) {
+    tree_root->accept(*visitors[0]);
+    return;
+  }
+  if (thread_count <= 1) {
+    for (int i = 0; i < library->n; i++)
+      if (!skip_up_to_date || !incremental_build_c::is_up_to_date(library->get_element(i)))
+        library->get_element(i)->accept(*visitors[0]);
+    return;
+  }
+
+  this->visitors = &visitors;
+  tasks.resize(library->n);
+  std::vector<int> pous;
+  for (int i = 0; i < library->n; i++) {
+    tasks[i].element = library->get_element(i);
+    tasks[i].errors  = NULL;
+    if (skip_up_to_date && incremental_build_c::is_up_to_date(tasks[i].element))
+      continue;  /* unchanged since the previous compilation (see incremental_build.hh) */
+    if (   tasks[i].element->is<function_declaration_c>()
+        || tasks[i].element->is<function_block_declaration_c>()
+        || tasks[i].element->is<program_declaration_c>())
+      pous.push_back(i);
+    else
+      /* datatypes, configurations, pragmas: visit them right away, in this thread */
+      run_task(i, visitors[0]);
+  }
+
+  /* split the POUs into runs of consecutive POUs, one per thread */
+  for (int t = 0; t < thread_count; t++) {
+    unsigned int first = (pous.size() *  t     ) / thread_count;
+    unsigned int last  = (pous.size() * (t + 1)) / thread_count;
+    queues[t]->tasks.assign(pous.begin() + first, pous.begin() + last);
+  }
+
+  pthread_mutex_lock(&lock);
+  job++;
+  busy_count = workers.size();
+  pthread_cond_broadcast(&start_cond);
+  pthread_mutex_unlock(&lock);
+
+  run_tasks(0);
+
+  pthread_mutex_lock(&lock);
+  while (busy_count > 0)
+    pthread_cond_wait(&done_cond, &lock);
+  pthread_mutex_unlock(&lock);
+
+  /* count the AST nodes visited by the other threads as visited by the calling thread (see phase_profiler.hh) */
+  symbol_c::accept_count += worker_accept_count;
+  worker_accept_count = 0;
+
+  /* hand over any AST nodes allocated by the other threads to the arena of the calling thread */
+  for (unsigned int i = 0; i < workers.size(); i++)
+    arena_c::get_current()->adopt(workers[i]->arena);
+
+  /* print the error messages in the order the elements appear in the library */
+  for (unsigned int i = 0; i < tasks.size(); i++)
+    print_errors(tasks[i].errors);
+  tasks.clear();
+  this->visitors = NULL;
+}
@@ -0,0 +1,146 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+/*
+ * Run a stage 3 algorithm (i.e. a visitor) over the elements of a library, checking several POUs at the same time.
+ *
+ * Once the global symbol tables have been populated (absyntax_utils_init()), and the constant folding algorithm
+ * has completed, most of the work done by the semantic checkers (fill/narrow candidate datatypes, lvalue check, ...)
+ * is independent for each FUNCTION, FUNCTION_BLOCK and PROGRAM. The pou_executor_c keeps a pool of threads
+ * (the calling thread being one of them), each with a visitor of its own, that visit these POUs concurrently.
+ *
+ * The POUs are initially split into equal sized runs of consecutive POUs, one per thread. Each thread takes
+ * the POUs from the front of its own run, and once it has no more POUs it steals the POUs from the back of
+ * the runs of the other threads (work stealing), so threads that happen to get the smaller POUs do not sit idle.
+ *
+ * The other elements of the library (data type declarations, configurations, pragmas) are visited first,
+ * in order, by the calling thread.
+ *
+ * The checkers that only report errors may skip the POUs that are up to date (i.e. have not changed since the
+ * previous compilation, see incremental_build.hh), as these were free of errors when last compiled. The algorithms
+ * that annotate the AST (fill/narrow candidate datatypes, ...) must still visit them, as the annotations of an
+ * up to date POU are used when analysing the POUs that call it, the configurations, and by stage 4.
+ *
+ * Errors and warnings must be printed to stage3_error_stream(), instead of stderr. The output of each element
+ * of the library is kept aside, and only printed to stderr (in the order of the elements in the library)
+ * once all the elements have been visited, so the output is the same no matter how many threads are used.
+ *
+ * Visiting several POUs at the same time relies on the following:
+ *   - the visitors only change the annotations of the symbols inside the POU being visited, and only read
+ *     (but do not change) the declarations of the other POUs and datatypes, and the global symbol tables.
+ *   - the annotations are stored in side tables that support concurrent access to distinct symbols (see side_table.hh),
+ *     and new symbols get their ids atomically.
+ *   - the caches of the type searches (search_base_type_c, search_var_instance_decl_c, get_datatype_info_c, ...)
+ *     are kept per thread (see util/per_thread.hh).
+ *   - each thread allocates new AST nodes from an arena of its own (see arena.hh). Once all the elements have
+ *     been visited, these arenas are handed over to the arena of the calling thread.
+ *
+ * NOTE: Since the threads keep their caches while the pou_executor_c exists, the declarations may not be changed
+ *       (e.g. by the constant folding algorithm, which changes the type ids of array datatypes in the relaxed
+ *       datatype model) while a pou_executor_c exists.
+ */
+
+
+#ifndef _POU_EXECUTOR_HH
+#define _POU_EXECUTOR_HH
+
+#include "../absyntax_utils/absyntax_utils.hh"
+#include <pthread.h>
+#include <stdio.h>
+#include <vector>
+#include <deque>
+
+
+/* The stream to which the stage 3 algorithms must print their error and warning messages (instead of stderr) */
+FILE *stage3_error_stream(void);
+
+
+
+class pou_executor_c {
+  private:
+    typedef struct {
+      symbol_c *element;  /* the element of the library */
+      FILE     *errors;   /* the error messages printed while visiting the element (NULL if none) */
+    } task_t;
+
+    typedef struct {
+      pthread_mutex_t  lock;
+      std::deque<int>  tasks;  /* index into tasks[] of the POUs not yet visited */
+    } queue_t;
+
+    typedef struct {
+      pou_executor_c  *executor;
+      int              index;   /* the index of this thread's queue and visitor */
+      pthread_t        thread;
+      arena_c         *arena;   /* the arena from which this thread allocates new AST nodes */
+    } worker_t;
+
+    int                        thread_count;
+    std::vector<worker_t *>    workers;    /* the threads other than the calling thread (i.e. thread_count - 1 threads) */
+    std::vector<queue_t *>     queues;     /* one per thread */
+    std::vector<task_t>        tasks;      /* one per element of the library */
+    std::vector<visitor_c *>  *visitors;   /* one per thread */
+
+    pthread_mutex_t            lock;       /* protects the following variables */
+    pthread_cond_t             start_cond; /* signaled when a new job is started (or the threads must terminate) */
+    pthread_cond_t             done_cond;  /* signaled when the last worker thread completes the current job */
+    unsigned long              job;        /* incremented whenever a new job is started */
+    int                        busy_count; /* number of worker threads still running the current job */
+    bool                       terminate;
+
+    unsigned long              steal_count;
+    unsigned long              worker_accept_count; /* number of AST nodes visited by the worker threads during the current job */
+
+    static void *worker_main(void *arg);
+    bool  get_task (int thread, int &task);
+    void  run_task (int task, visitor_c *visitor);
+    void  run_tasks(int thread);
+
+  public:
+    /* thread_count: the total number of threads used, including the calling thread. 1 -> do not use any other thread */
+    pou_executor_c(int thread_count);
+   ~pou_executor_c(void);
+
+    int get_thread_count(void) {return thread_count;}
+    /* number of POUs that were visited by a thread other than the one they were initially assigned to */
+    unsigned long get_steal_count(void) {return steal_count;}
+
+    /* Visit tree_root, using visitors[i] on thread i. visitors must contain get_thread_count() visitors.
+     * If tree_root is not a library_c, tree_root is simply visited with visitors[0]. If only one thread is used,
+     * the elements of the library are visited in order, with visitors[0].
+     * skip_up_to_date: do not visit the elements that are up to date (see incremental_build.hh).
+     */
+    void run(symbol_c *tree_root, std::vector<visitor_c *> &visitors, bool skip_up_to_date = false);
+};
+
+
+#endif /* _POU_EXECUTOR_HH */
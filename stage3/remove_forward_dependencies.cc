@@ -81,39 +81,6 @@
 
 
 
-/* NOTE: We create an independent visitor for this task instead of having this done by the remove_forward_dependencies_c
- *       because we do not want to handle the ***_pragma_c classes while doing this search.
- *      (remove_forward_dependencies_c needs to visit those classes when handling all the possible entries in
- *       library_c, and must have those visitors)
- * 
- * NOTE:
- *      This class could have been written by visiting all the AST objects that could _reference_ a
- *          - FB type
- *          - Program type
- *          - Function type
- *      and by checking whether those references are in the declared_identifiers list.
- *      However, one of those objects, the ref_spec_c, may reference an FB type, or any other datatype, so we must have a way
- *      of knowing what is being referenced in this case. I have opted to introduce a new object type in the AST, the
- *      poutype_identifier_c, that will be used anywhere in the AST that references either a PROGRAM name or a FB type name
- *      or a FUNCTION name (previously a simple identifier_c was used!).
- *      This means that we merely need to visit the new poutype_identifier_c object in this visitor.
- */
-class find_forward_dependencies_c: public search_visitor_c {
-  private:
-    identifiers_symbtable_t *declared_identifiers; // list of identifiers already declared by the symbols in the new tree
-  public:
-    find_forward_dependencies_c(identifiers_symbtable_t *declared_identifiers_) {declared_identifiers = declared_identifiers_;}
-  /*******************************************/
-  /* B 1.1 - Letters, digits and identifiers */
-  /*******************************************/
-  // return NULL if the symbol is already in the declared_identifiers symbol table, otherwise return the missing symbol!
-  void *visit(            poutype_identifier_c *symbol)
-    {if (declared_identifiers->find(symbol) != declared_identifiers->end()) return NULL; else return symbol;}
-};   /* class find_forward_dependencies_c */
-
-
-
-
 /* A class to count the number of POUs (Function, FBs Programs and Configurations) in a library.
  * This will be used to make sure whether we have copied all the POUs from the original AST (abstract
  * syntax tree) to the new AST.
@@ -160,13 +127,12 @@ symbol_c remove_forward_dependencies_c_null_symbol;
 
 // constructor & destructor
 remove_forward_dependencies_c:: remove_forward_dependencies_c(void) {
-  find_forward_dependencies      = new find_forward_dependencies_c(&declared_identifiers);
   current_display_error_level = error_level_default;
   error_count = 0;
+  inserting   = false;
 }
 
 remove_forward_dependencies_c::~remove_forward_dependencies_c(void) {
-  delete find_forward_dependencies;
 }
 
 
@@ -188,14 +154,8 @@ library_c *remove_forward_dependencies_c::create_new_tree(symbol_c *tree) {
 
 
 
-void *remove_forward_dependencies_c::handle_library_symbol(symbol_c *symbol, symbol_c *name, symbol_c *search1, symbol_c *search2, symbol_c *search3) {
-  if (inserted_symbols.find(symbol) != inserted_symbols.end())                 return NULL; // already previously inserted into new_tree and declared_identifiers. Do not handle again!
-  if ((search1 != NULL) && (search1->accept(*find_forward_dependencies) != NULL)) return NULL; // A forward depency has not yet been satisfied. Wait for a later iteration to try again! 
-  if ((search2 != NULL) && (search2->accept(*find_forward_dependencies) != NULL)) return NULL; // A forward depency has not yet been satisfied. Wait for a later iteration to try again!
-  if ((search3 != NULL) && (search3->accept(*find_forward_dependencies) != NULL)) return NULL; // A forward depency has not yet been satisfied. Wait for a later iteration to try again!
-  /* no forward dependencies found => insert into new AST, and add to the 'defined identifiers' and 'inserted symbol' lists */
-  if (declared_identifiers.find(name) == declared_identifiers.end())
-      declared_identifiers.insert(name, NULL);  // only add if not yet in the symbol table (an overloaded version of this same POU could have been inderted previously!)
+void *remove_forward_dependencies_c::handle_library_symbol(symbol_c *symbol) {
+  /* The POUs are visited in an order in which all their dependencies have already been inserted into the new AST (see visit(library_c *)) */
   inserted_symbols.insert(symbol);
   new_tree->add_element(current_code_generation_pragma);  
   new_tree->add_element(symbol);  
@@ -233,16 +193,29 @@ void *remove_forward_dependencies_c::visit(library_c *symbol) {
 
   /* now do the POUs, in whatever order is necessary to guarantee no forward references. */    
   long long int old_tree_pou_count = pou_count_c::get_count(symbol);
+  /* The POUs are placed in the order determined by a topological sort of the graph of the dependencies between POUs.
+   * Whenever possible, this keeps the POUs in the order they were declared in the original AST (see pou_dependency_graph.hh)
+   */
+  pou_dependency_graph_c dependency_graph(symbol);
+  std::vector<int> order;
+  dependency_graph.topological_sort(order);
+
+  /* Each POU must be inserted into the new AST preceded by the code generation pragma that was active where it was declared. */
     // if no code generation pragma exists before the first entry in the library, the default is to enable code generation.
   enable_code_generation_pragma_c *default_code_generation_pragma = new enable_code_generation_pragma_c; 
-  int prev_n;
-  cycle_count = 0;
-  do {
-    cycle_count++;
-    prev_n = new_tree->n;
-    current_code_generation_pragma = default_code_generation_pragma;
-    for (int i = 0; i < symbol->n; i++)  symbol->get_element(i)->accept(*this);
-  } while (prev_n != new_tree->n); // repeat while new elementns are still being added to the new AST
+  std::vector<symbol_c *> code_generation_pragma(symbol->n);
+  current_code_generation_pragma = default_code_generation_pragma;
+  for (int i = 0; i < symbol->n; i++) {
+    code_generation_pragma[i] = current_code_generation_pragma;
+    symbol->get_element(i)->accept(*this); // will only change current_code_generation_pragma
+  }
+
+  inserting = true;
+  for (unsigned int k = 0; k < order.size(); k++) {
+    current_code_generation_pragma = code_generation_pragma[order[k]];
+    symbol->get_element(order[k])->accept(*this);
+  }
+  inserting = false;
   
   if (old_tree_pou_count != pou_count_c::get_count(new_tree)) 
     print_circ_error(symbol);
@@ -259,40 +232,40 @@ void *remove_forward_dependencies_c::visit(library_c *symbol) {
 /***********************/
 // SYM_REF4(function_declaration_c, derived_function_name, type_name, var_declarations_list, function_body, enumvalue_symtable_t enumvalue_symtable;)
 void *remove_forward_dependencies_c::visit(function_declaration_c *symbol) 
-  {return handle_library_symbol(symbol, symbol->derived_function_name, symbol->type_name, symbol->var_declarations_list, symbol->function_body);}
+  {return inserting? handle_library_symbol(symbol) : NULL;}
 /*****************************/
 /* B 1.5.2 - Function Blocks */
 /*****************************/
 /*  FUNCTION_BLOCK derived_function_block_name io_OR_other_var_declarations function_block_body END_FUNCTION_BLOCK */
 // SYM_REF3(function_block_declaration_c, fblock_name, var_declarations, fblock_body, enumvalue_symtable_t enumvalue_symtable;)
 void *remove_forward_dependencies_c::visit(function_block_declaration_c *symbol) 
-  {return handle_library_symbol(symbol, symbol->fblock_name, symbol->var_declarations, symbol->fblock_body);}
+  {return inserting? handle_library_symbol(symbol) : NULL;}
 /**********************/
 /* B 1.5.3 - Programs */
 /**********************/
 /*  PROGRAM program_type_name program_var_declarations_list function_block_body END_PROGRAM */
 // SYM_REF3(program_declaration_c, program_type_name, var_declarations, function_block_body, enumvalue_symtable_t enumvalue_symtable;)
 void *remove_forward_dependencies_c::visit(program_declaration_c *symbol) 
-  {return handle_library_symbol(symbol, symbol->program_type_name, symbol->var_declarations, symbol->function_block_body);}
+  {return inserting? handle_library_symbol(symbol) : NULL;}
 /********************************/
 /* B 1.7 Configuration elements */
 /********************************/
 /* CONFIGURATION configuration_name (...) END_CONFIGURATION */
 // SYM_REF5(configuration_declaration_c, configuration_name, global_var_declarations, resource_declarations, access_declarations, instance_specific_initializations, enumvalue_symtable_t enumvalue_symtable;)
 void *remove_forward_dependencies_c::visit(configuration_declaration_c *symbol) 
-  {return handle_library_symbol(symbol, symbol->configuration_name, symbol->global_var_declarations, symbol->resource_declarations, symbol->access_declarations);}
+  {return inserting? handle_library_symbol(symbol) : NULL;}
 /********************/
 /* 2.1.6 - Pragmas  */
 /********************/
-void *remove_forward_dependencies_c::visit(disable_code_generation_pragma_c *symbol) {current_code_generation_pragma = symbol; return NULL;}
-void *remove_forward_dependencies_c::visit( enable_code_generation_pragma_c *symbol) {current_code_generation_pragma = symbol; return NULL;}
+void *remove_forward_dependencies_c::visit(disable_code_generation_pragma_c *symbol) {if (!inserting) current_code_generation_pragma = symbol; return NULL;}
+void *remove_forward_dependencies_c::visit( enable_code_generation_pragma_c *symbol) {if (!inserting) current_code_generation_pragma = symbol; return NULL;}
 /* I have no ideia what this pragma is. Where should we place it in the re-ordered tree? 
  * Without knowing the semantics of the pragma, it is not possible to hande it correctly.
  * We therefore print out an error message, and abort!
  */
 // TODO: print error message!
 void *remove_forward_dependencies_c::visit(pragma_c *symbol) {
-  if (1 != cycle_count) return NULL; // only handle unknown pragmas in the first cycle!
+  if (!inserting) return NULL; // only handle unknown pragmas when inserting elements into the new AST!
   STAGE3_WARNING(symbol, symbol, "Unrecognized pragma. Including the pragma when using the '-p' command line option for 'allow use of forward references' may result in unwanted behaviour.");
   new_tree->add_element(symbol);
   return NULL;
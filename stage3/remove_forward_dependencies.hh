@@ -47,14 +47,9 @@
 
 #include "../absyntax/absyntax.hh"
 #include "../absyntax/visitor.hh"
-#include "../util/symtable.hh"
 #include <set>
 
 
-class   find_forward_dependencies_c;
-typedef symtable_c<symbol_c *> identifiers_symbtable_t;
-
-
 
 
 
@@ -70,12 +65,9 @@ class remove_forward_dependencies_c: public search_visitor_c {
     int             error_count;
     bool            warning_found;
     library_c      *new_tree;
-    int             cycle_count; // main algorithm runs in a loop. The nuber of the current cycle...
-    // NOTE: we need two lists in order to correctly handle overloaded functions
-    identifiers_symbtable_t      declared_identifiers; // list of identifiers already declared by the symbols in the new tree
+    bool            inserting;   // true while inserting the library elements into the new tree (in the order without forward references)
     std::set <symbol_c *>        inserted_symbols;     // list of symbols already inserted in the new tree 
     symbol_c       *current_code_generation_pragma;    // points to any currently 'active' enable_code_generation_pragma_c
-    find_forward_dependencies_c    *find_forward_dependencies;  
 
   public:
      remove_forward_dependencies_c(void);
@@ -84,7 +76,7 @@ class remove_forward_dependencies_c: public search_visitor_c {
     int        get_error_count(void);
 
   private:
-    void *handle_library_symbol(symbol_c *symbol, symbol_c *name, symbol_c *search1, symbol_c *search2 = NULL, symbol_c *search3 = NULL);
+    void *handle_library_symbol(symbol_c *symbol);
     void  print_circ_error(library_c *symbol);
 
     /***************************/
@@ -46,33 +46,33 @@
 #include "declaration_check.hh"
 #include "enum_declaration_check.hh"
 #include "remove_forward_dependencies.hh"
+#include "pou_executor.hh"
+#include "fused_check.hh"
+#include <vector>
 
 
 
+/* Share the identical anonymous datatypes declared inside each POU (see hash_cons.hh),
+ * so each one of them is only annotated once by the following algorithms.
+ */
+static void share_type_specs(symbol_c *tree_root){
+    profile_phase_c phase("share_type_specs");
+    int shared_count = hash_cons_c::share_type_specs(tree_root);
+    if (runtime_options.print_stats)
+      fprintf(stderr, "stage 3: %d anonymous datatype declarations shared with an identical datatype\n", shared_count);
+}
+
+
 static int enum_declaration_check(symbol_c *tree_root){
+    profile_phase_c phase("enum_declaration_check");
     enum_declaration_check_c enum_declaration_check(NULL);
     tree_root->accept(enum_declaration_check);
     return enum_declaration_check.get_error_count();
 }
 
 
-/* In order to correctly handle variable sized arrays
- * declaration_safety() must only be run after constant folding!
- *   NOTE that the dependency does not resides directly in declaration_check_c,
- *        but rather indirectly in the call to get_datatype_info_c::is_type_equal()
- *        which may in turn call get_datatype_info_c::is_arraytype_equal_relaxed()
- *
- * Example of a variable sized array:
- *   VAR_EXTERN CONSTANT max: INT; END_VAR;
- *   VAR_EXTERN xx: ARRAY [1..max] OF INT; END_VAR;
- */
-static int declaration_safety(symbol_c *tree_root){
-    declaration_check_c declaration_check(tree_root);
-    tree_root->accept(declaration_check);
-    return declaration_check.get_error_count();
-}
-
 static int flow_control_analysis(symbol_c *tree_root){
+    profile_phase_c phase("flow_control_analysis");
     flow_control_analysis_c flow_control_analysis(tree_root);
     tree_root->accept(flow_control_analysis);
     return 0;
@@ -83,57 +83,134 @@ static int flow_control_analysis(symbol_c *tree_root){
  * so be sure to call flow_control_analysis() before calling this function!
  */
 static int constant_propagation(symbol_c *tree_root){
+    profile_phase_c phase("constant_propagation");
     constant_propagation_c constant_propagation(tree_root);
     tree_root->accept(constant_propagation);
+    /* type ids of array datatypes determined before the subrange limits were constant folded are no longer valid */
+    get_datatype_info_c::clear_type_ids();
     return constant_propagation.get_error_count();
 }
 
 
+/* Run one of the stage 3 checkers on all the threads of the executor, each thread with a checker of its own.
+ * The checker must print its error messages to stage3_error_stream() (see pou_executor.hh).
+ */
+template<typename checker_t> class stage3_pass_c {
+  private:
+    std::vector<checker_t *> checkers;
+    std::vector<visitor_c *> visitors;
+    symbol_c                *tree_root;
+    pou_executor_c          *executor;
+
+  public:
+    stage3_pass_c(symbol_c *tree_root, pou_executor_c *executor) {
+      this->tree_root = tree_root;
+      this->executor  = executor;
+      for (int i = 0; i < executor->get_thread_count(); i++) {
+        checkers.push_back(new checker_t(tree_root));
+        visitors.push_back(as_visitor(checkers.back()));
+      }
+    }
+   ~stage3_pass_c(void) {
+      for (unsigned int i = 0; i < checkers.size(); i++)
+        delete checkers[i];
+    }
+
+    /* phase_name: the name under which the pass is profiled (see phase_profiler.hh)
+     * skip_up_to_date: the checker only reports errors, so it need not visit the POUs that are up to date (see pou_executor.hh)
+     */
+    void run(const char *phase_name, bool skip_up_to_date = false) {
+      profile_phase_c phase(phase_name);
+      executor->run(tree_root, visitors, skip_up_to_date);
+    }
+
+    checker_t *get_checker(int thread) {return checkers[thread];}
+
+  private:
+    /* the static visitors (see static_visitor.hh) are not visitor_c's themselves */
+    static visitor_c *as_visitor(visitor_c *checker) {return checker;}
+    template<typename visitor_t>
+    static visitor_c *as_visitor(static_iterator_visitor_c<visitor_t> *checker) {return checker->get_visitor();}
+
+  public:
+
+    int get_error_count(void) {
+      int error_count = 0;
+      for (unsigned int i = 0; i < checkers.size(); i++)
+        error_count += checkers[i]->get_error_count();
+      return error_count;
+    }
+};
+
+
 /* Type safety analysis assumes that 
  *    - flow control analysis 
  *    - constant folding (constant check)
  * has already been completed, so be sure to call those semantic checkers
  * before calling this function
  */
-static int type_safety(symbol_c *tree_root){
-	fill_candidate_datatypes_c fill_candidate_datatypes(tree_root);
-	tree_root->accept(fill_candidate_datatypes);
-	narrow_candidate_datatypes_c narrow_candidate_datatypes(tree_root);
-	tree_root->accept(narrow_candidate_datatypes);
-	print_datatypes_error_c print_datatypes_error(tree_root);
-	tree_root->accept(print_datatypes_error);
-	forced_narrow_candidate_datatypes_c forced_narrow_candidate_datatypes(tree_root);
-	tree_root->accept(forced_narrow_candidate_datatypes);
+static int type_safety(symbol_c *tree_root, pou_executor_c *executor){
+	/* NOTE: each algorithm must complete on all the POUs before the next one is started, as the
+	 *       narrow algorithm uses the candidate datatypes of the called functions and FBs.
+	 */
+	stage3_pass_c<fill_candidate_datatypes_c> fill_candidate_datatypes(tree_root, executor);
+	stage3_pass_c<narrow_candidate_datatypes_c> narrow_candidate_datatypes(tree_root, executor);
+	stage3_pass_c<forced_narrow_candidate_datatypes_c> forced_narrow_candidate_datatypes(tree_root, executor);
+	stage3_pass_c<print_datatypes_error_c> print_datatypes_error(tree_root, executor);
+	/* The fill and narrow algorithms are static visitors, that skip the subtrees in which they have nothing to do.
+	 * The subtrees they have nothing to do in may only be determined once both have been created (see static_visitor.hh).
+	 */
+	{ profile_phase_c phase("subtree_kinds");
+	  subtree_kinds_c::compute(tree_root);
+	}
+	fill_candidate_datatypes.run("fill_candidate_datatypes");
+	narrow_candidate_datatypes.run("narrow_candidate_datatypes");
+	print_datatypes_error.run("print_datatypes_error", true);
+	forced_narrow_candidate_datatypes.run("forced_narrow_candidate_datatypes");
 	return print_datatypes_error.get_error_count();
 }
 
 
-/* Left value checking assumes that data type analysis has already been completed,
- * so be sure to call type_safety() before calling this function
- */
-static int lvalue_check(symbol_c *tree_root){
-	lvalue_check_c lvalue_check(tree_root);
-	tree_root->accept(lvalue_check);
-	return lvalue_check.get_error_count();
-}
-
-/* Array range check assumes that constant folding has been completed!
+/* The checkers that only read the AST (and its annotations), run in a single traversal of the AST (see fused_check.hh).
+ *
+ * In order to correctly handle variable sized arrays
+ * declaration checking must only be run after constant folding!
+ *   NOTE that the dependency does not resides directly in declaration_check_c,
+ *        but rather indirectly in the call to get_datatype_info_c::is_type_equal()
+ *        which compares the type ids of the datatypes, and in the relaxed datatype model
+ *        the type id of an array datatype depends on the (constant folded) values of its subrange limits.
+ *
+ * Example of a variable sized array:
+ *   VAR_EXTERN CONSTANT max: INT; END_VAR;
+ *   VAR_EXTERN xx: ARRAY [1..max] OF INT; END_VAR;
+ *
+ * Left value checking assumes that data type analysis has already been completed,
+ * so be sure to call type_safety() before calling this function.
+ *
+ * Array range check and case options check assume that constant folding has been completed!
  * so be sure to call constant_folding() before calling this function!
  */
-static int array_range_check(symbol_c *tree_root){
-	array_range_check_c array_range_check(tree_root);
-	tree_root->accept(array_range_check);
-	return array_range_check.get_error_count();
-}
+class post_type_safety_check_c: public fused_check_c {
+  public:
+    post_type_safety_check_c(symbol_c *tree_root) {
+      add_checker(new declaration_check_c  (tree_root));
+      add_checker(new lvalue_check_c       (tree_root));
+      add_checker(new array_range_check_c  (tree_root));
+      add_checker(new case_elements_check_c(tree_root));
+    }
+};
 
 
-/* Case options check assumes that constant folding has been completed!
- * so be sure to call constant_folding() before calling this function!
- */
-static int case_elements_check(symbol_c *tree_root){
-	case_elements_check_c case_elements_check(tree_root);
-	tree_root->accept(case_elements_check);
-	return case_elements_check.get_error_count();
+static int post_type_safety_check(symbol_c *tree_root, pou_executor_c *executor){
+	stage3_pass_c<post_type_safety_check_c> post_type_safety_check(tree_root, executor);
+	post_type_safety_check.run("post_type_safety_check", true);
+	if (runtime_options.print_stats) {
+	  unsigned long int node_count = 0;
+	  for (int i = 0; i < executor->get_thread_count(); i++)
+	    node_count += post_type_safety_check.get_checker(i)->get_node_count();
+	  fprintf(stderr, "stage 3: declaration, lvalue, array range and case elements checks visited %lu AST nodes in a single traversal\n", node_count);
+	}
+	return post_type_safety_check.get_error_count();
 }
 
 
@@ -146,6 +223,7 @@ static int remove_forward_dependencies(symbol_c *tree_root, symbol_c **ordered_t
 	if (NULL != ordered_tree_root)    *ordered_tree_root = tree_root; // by default, consider tree_root already ordered
 	if (!runtime_options.pre_parsing)  return 0;                      // No re-ordering necessary, just return
 	  
+	profile_phase_c phase("remove_forward_dependencies");
 	/* We need to re-order the elements in the library, to fix any forward references! */
 	remove_forward_dependencies_c remove_forward_dependencies;
 	symbol_c *new_tree_root = remove_forward_dependencies.create_new_tree(tree_root);
@@ -157,14 +235,18 @@ static int remove_forward_dependencies(symbol_c *tree_root, symbol_c **ordered_t
 
 int stage3(symbol_c *tree_root, symbol_c **ordered_tree_root) {
 	int error_count = 0;
+	share_type_specs(tree_root);
 	error_count += enum_declaration_check(tree_root);
 	error_count += flow_control_analysis(tree_root);
 	error_count += constant_propagation(tree_root);
-	error_count += declaration_safety(tree_root);
-	error_count += type_safety(tree_root);
-	error_count += lvalue_check(tree_root);
-	error_count += array_range_check(tree_root);
-	error_count += case_elements_check(tree_root);
+	{ /* The POUs may only be checked concurrently once constant folding has been completed (see pou_executor.hh) */
+	  pou_executor_c executor(runtime_options.stage3_threads);
+	  error_count += type_safety(tree_root, &executor);
+	  error_count += post_type_safety_check(tree_root, &executor);
+	  if (runtime_options.print_stats)
+	    fprintf(stderr, "stage 3: %d thread(s) checking the POUs, %lu POUs stolen by idle threads\n",
+	            executor.get_thread_count(), executor.get_steal_count());
+	}
 	error_count += remove_forward_dependencies(tree_root, ordered_tree_root);
 	
 	if (error_count > 0) {
@@ -53,8 +53,8 @@
 
 
 /* Macros to access the constant value of each expression (if it exists) from the annotation introduced to the symbol_c object by constant_folding_c in stage3! */
-#define VALID_CVALUE(dtype, symbol)           ((symbol)->const_value._##dtype.is_valid())
-#define GET_CVALUE(dtype, symbol)             ((symbol)->const_value._##dtype.get()) 
+#define VALID_CVALUE(dtype, symbol)           ((symbol)->get_const_value()._##dtype.is_valid())
+#define GET_CVALUE(dtype, symbol)             ((symbol)->get_const_value()._##dtype.get()) 
 
 
 
@@ -225,6 +225,41 @@ void stage4_print_options(void) {}
 int  stage4_parse_options(char *options) {return 0;}
 #endif 
 
+
+/* The name of the POU, as used in the names of the <pou_name>.c and <pou_name>.h files */
+static symbol_c *pou_filename(symbol_c *pou) {
+  if (pou->is<function_declaration_c>())       return pou->as<function_declaration_c>()      ->derived_function_name;
+  if (pou->is<function_block_declaration_c>()) return pou->as<function_block_declaration_c>()->fblock_name;
+  if (pou->is<program_declaration_c>())        return pou->as<program_declaration_c>()       ->program_type_name;
+  return NULL;
+}
+
+static bool file_exists(const char *dir, const char *radix, const char *extension) {
+  std::string filepath("");
+  if (dir != NULL) {
+    filepath += dir;
+    filepath += "/";
+  }
+  filepath += radix;
+  filepath += ".";
+  filepath += extension;
+  FILE *file = fopen(filepath.c_str(), "r");
+  if (NULL == file) return false;
+  fclose(file);
+  return true;
+}
+
+/* The <pou_name>.c and <pou_name>.h files of an unchanged POU are kept as they are, unless
+ * they contain #line directives, which depend on the (possibly changed) location of the POU in the source code.
+ */
+bool stage4_can_keep_pou(symbol_c *pou, const char *builddir) {
+  if (!generate_pou_filepairs__ || generate_line_directives__) return false;
+  symbol_c *pou_name = pou_filename(pou);
+  if (NULL == pou_name) return false;
+  const char *name = get_datatype_info_c::get_id_str(pou_name);
+  return file_exists(builddir, name, "c") && file_exists(builddir, name, "h");
+}
+
 /***********************************************************************/
 /***********************************************************************/
 /***********************************************************************/
@@ -2596,15 +2631,21 @@ class generate_c_c: public iterator_visitor_c {
 
       pous_incl_s4o.print("#endif //__POUS_H\n");
       
-      generate_var_list_c generate_var_list(&variables_s4o, symbol);
-      generate_var_list.generate_programs(symbol);
-      generate_var_list.generate_variables(symbol);
-      variables_s4o.print("\n// Ticktime\n");
-      variables_s4o.print_long_long_integer(common_ticktime, false);
-      variables_s4o.print("\n");
+      {
+        profile_phase_c phase("variables_list");
+        generate_var_list_c generate_var_list(&variables_s4o, symbol);
+        generate_var_list.generate_programs(symbol);
+        generate_var_list.generate_variables(symbol);
+        variables_s4o.print("\n// Ticktime\n");
+        variables_s4o.print_long_long_integer(common_ticktime, false);
+        variables_s4o.print("\n");
+      }
 
-      generate_location_list_c generate_location_list(&located_variables_s4o);
-      symbol->accept(generate_location_list);
+      {
+        profile_phase_c phase("located_variables");
+        generate_location_list_c generate_location_list(&located_variables_s4o);
+        symbol->accept(generate_location_list);
+      }
       return NULL;
     }
 
@@ -2628,6 +2669,7 @@ class generate_c_c: public iterator_visitor_c {
 
     /* helper symbol for data_type_declaration */
     void *visit(type_declaration_list_c *symbol) {
+      profile_phase_c phase("datatypes");
       for(int i = 0; i < symbol->n; i++) {
         symbol->get_element(i)->accept(generate_c_implicit_typedecl);
         symbol->get_element(i)->accept(generate_c_typedecl);
@@ -2645,16 +2687,22 @@ class generate_c_c: public iterator_visitor_c {
       if (!allow_output) return NULL;\
       if (generate_pou_filepairs__) {\
         const char *pou_name = get_datatype_info_c::get_id_str(pname);\
-        stage4out_c s4o_c(current_builddir, pou_name, "c");\
-        stage4out_c s4o_h(current_builddir, pou_name, "h");\
-        s4o_c.print("#include \""); s4o_c.print(pou_name); s4o_c.print(".h\"\n");\
-        s4o_h.print("#ifndef __");  s4o_h.print(pou_name); s4o_h.print("_H\n");\
-        s4o_h.print("#define __");  s4o_h.print(pou_name); s4o_h.print("_H\n");\
-        generate_c_implicit_typedecl_c generate_c_implicit_typedecl__(&s4o_h);\
-        symbol->accept(generate_c_implicit_typedecl__); /* generate implicitly delcared datatypes (arrays and ref_to) */\
-        generate_c_pous_c::fname(symbol, s4o_h, true); /* generate the <pou_name>.h file */\
-        generate_c_pous_c::fname(symbol, s4o_c, false);/* generate the <pou_name>.c file */\
-        s4o_h.print("#endif /* __");  s4o_h.print(pou_name); s4o_h.print("_H */\n");\
+        if (!incremental_build_c::is_up_to_date(symbol)) {\
+          stage4out_c s4o_c(current_builddir, pou_name, "c");\
+          stage4out_c s4o_h(current_builddir, pou_name, "h");\
+          s4o_c.print("#include \""); s4o_c.print(pou_name); s4o_c.print(".h\"\n");\
+          s4o_h.print("#ifndef __");  s4o_h.print(pou_name); s4o_h.print("_H\n");\
+          s4o_h.print("#define __");  s4o_h.print(pou_name); s4o_h.print("_H\n");\
+          generate_c_implicit_typedecl_c generate_c_implicit_typedecl__(&s4o_h);\
+          symbol->accept(generate_c_implicit_typedecl__); /* generate implicitly delcared datatypes (arrays and ref_to) */\
+          generate_c_pous_c::fname(symbol, s4o_h, true); /* generate the <pou_name>.h file */\
+          generate_c_pous_c::fname(symbol, s4o_c, false);/* generate the <pou_name>.c file */\
+          s4o_h.print("#endif /* __");  s4o_h.print(pou_name); s4o_h.print("_H */\n");\
+        } else {\
+          /* keep the files generated by the previous compilation (see incremental_build.hh), but still list them */\
+          s4o.print(pou_name); s4o.print(".c\n");\
+          s4o.print(pou_name); s4o.print(".h\n");\
+        }\
         /* add #include directives to the POUS.h and POUS.c files... */\
         pous_incl_s4o.print("#include \"");\
         pous_s4o.     print("#include \"");\
@@ -2672,6 +2720,7 @@ class generate_c_c: public iterator_visitor_c {
 /* B 1.5.1 - Functions */
 /***********************/      
     void *visit(function_declaration_c *symbol) {
+      profile_phase_c phase("functions");
       handle_pou(handle_function,symbol->derived_function_name)
       return NULL;
     }
@@ -2680,6 +2729,7 @@ class generate_c_c: public iterator_visitor_c {
 /* B 1.5.2 - Function Blocks */
 /*****************************/
     void *visit(function_block_declaration_c *symbol) {
+      profile_phase_c phase("function_blocks");
       handle_pou(handle_function_block,symbol->fblock_name)
       return NULL;
     }
@@ -2688,6 +2738,7 @@ class generate_c_c: public iterator_visitor_c {
 /* B 1.5.3 - Programs */
 /**********************/    
     void *visit(program_declaration_c *symbol) {
+      profile_phase_c phase("programs");
       handle_pou(handle_program,symbol->program_type_name)
       return NULL;
     }
@@ -2697,6 +2748,7 @@ class generate_c_c: public iterator_visitor_c {
 /* B 1.7 Configuration elements */
 /********************************/
     void *visit(configuration_declaration_c *symbol) {
+      profile_phase_c phase("configuration");
       if (symbol->global_var_declarations != NULL)
         symbol->global_var_declarations->accept(generate_c_implicit_typedecl);
       static int configuration_count = 0;
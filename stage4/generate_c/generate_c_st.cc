@@ -1222,7 +1222,7 @@ void *visit(case_list_c *symbol) {
      */
     if (0 != i)  s4o.print(" ||\n" + s4o.indent_spaces + "         ");
     s4o.print("(");
-    subrange_c *subrange = dynamic_cast<subrange_c *>(symbol->get_element(i));
+    subrange_c *subrange = symbol->get_element(i)->as<subrange_c>();
     if (NULL == subrange) {
       s4o.print("__case_expression == ");
       symbol->get_element(i)->accept(*this);
@@ -1307,8 +1307,8 @@ void *visit(for_statement_c *symbol) {
     integer_c              integer_oneval("1");
     add_expression_c       add_expression(symbol->control_variable, &integer_oneval);
     assignment_statement_c inc_assignment(symbol->control_variable, &add_expression);
-    integer_oneval.const_value._int64 .set(1);                    // set the stage3 anottation we need 
-    integer_oneval.const_value._uint64.set(1);                    // set the stage3 anottation we need
+    integer_oneval.const_value()._int64 .set(1);                    // set the stage3 anottation we need 
+    integer_oneval.const_value()._uint64.set(1);                    // set the stage3 anottation we need
     integer_oneval.datatype = symbol->control_variable->datatype; // set the stage3 anottation we need
     add_expression.datatype = symbol->control_variable->datatype; // set the stage3 anottation we need
     inc_assignment.accept(*this);
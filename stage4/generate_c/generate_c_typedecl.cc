@@ -568,9 +568,9 @@ void *visit(array_type_declaration_c *symbol) {
   current_typedefinition = none_td;
 
 end:  
-  symbol                 ->anotations_map["generate_c_annotaton__implicit_type_id"] = id;
-  symbol->datatype       ->anotations_map["generate_c_annotaton__implicit_type_id"] = id;
-  symbol->array_spec_init->anotations_map["generate_c_annotaton__implicit_type_id"] = id; // probably not needed, bu let's play safe.
+  symbol                 ->set_anotation(symbol_c::generate_c_annotaton__implicit_type_id, id);
+  symbol->datatype       ->set_anotation(symbol_c::generate_c_annotaton__implicit_type_id, id);
+  symbol->array_spec_init->set_anotation(symbol_c::generate_c_annotaton__implicit_type_id, id); // probably not needed, bu let's play safe.
   
   return NULL;
 }
@@ -1068,7 +1068,7 @@ class generate_c_implicit_typedecl_c: public iterator_visitor_c {
       ref_spec_init_c   ref_spec(symbol, NULL);
       ref_type_decl_c   ref_decl(id, &ref_spec);
       ref_decl.accept(*generate_c_typedecl_);
-      symbol->anotations_map["generate_c_annotaton__implicit_type_id"] = id;
+      symbol->set_anotation(symbol_c::generate_c_annotaton__implicit_type_id, id);
       return NULL;
     }
 
@@ -1078,10 +1078,9 @@ class generate_c_implicit_typedecl_c: public iterator_visitor_c {
     // SYM_REF2(ref_spec_init_c, ref_spec, ref_initialization)
     void *visit(ref_spec_init_c *symbol) {
       symbol->ref_spec->accept(*this); //--> always calls ref_spec_c or derived_datatype_identifier_c
-      int implicit_id_count = symbol->ref_spec->anotations_map.count("generate_c_annotaton__implicit_type_id");
-      if (implicit_id_count  > 1) ERROR;
-      if (implicit_id_count == 1)
-        symbol->anotations_map["generate_c_annotaton__implicit_type_id"] = symbol->ref_spec->anotations_map["generate_c_annotaton__implicit_type_id"];
+      symbol_c *implicit_id = symbol->ref_spec->get_anotation(symbol_c::generate_c_annotaton__implicit_type_id);
+      if (NULL != implicit_id)
+        symbol->set_anotation(symbol_c::generate_c_annotaton__implicit_type_id, implicit_id);
       return NULL;
     }
 
@@ -1099,10 +1098,9 @@ class generate_c_implicit_typedecl_c: public iterator_visitor_c {
     /* array_initialization may be NULL ! */
     void *visit(array_spec_init_c *symbol) {
       symbol->array_specification->accept(*this); //--> always calls array_specification_c or derived_datatype_identifier_c
-      int implicit_id_count = symbol->array_specification->anotations_map.count("generate_c_annotaton__implicit_type_id");
-      if (implicit_id_count  > 1) ERROR;
-      if (implicit_id_count == 1)
-        symbol->anotations_map["generate_c_annotaton__implicit_type_id"] = symbol->array_specification->anotations_map["generate_c_annotaton__implicit_type_id"];
+      symbol_c *implicit_id = symbol->array_specification->get_anotation(symbol_c::generate_c_annotaton__implicit_type_id);
+      if (NULL != implicit_id)
+        symbol->set_anotation(symbol_c::generate_c_annotaton__implicit_type_id, implicit_id);
       return NULL;
     }
 
@@ -1119,7 +1117,7 @@ class generate_c_implicit_typedecl_c: public iterator_visitor_c {
       array_decl.datatype = symbol->datatype;
       array_spec.datatype = symbol->datatype;
       array_decl.accept(*generate_c_typedecl_);
-      symbol->anotations_map["generate_c_annotaton__implicit_type_id"] = id;
+      symbol->set_anotation(symbol_c::generate_c_annotaton__implicit_type_id, id);
       return NULL;
     }
     
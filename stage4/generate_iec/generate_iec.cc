@@ -74,6 +74,9 @@ void stage4_print_options(void) {
   printf("          (no options available when generating IEC 61131-3 code)\n"); 
 }
 
+/* All the IEC 61131-3 code is generated to stdout, so it is always generated in full. */
+bool stage4_can_keep_pou(symbol_c *pou, const char *builddir) {return false;}
+
 /***********************************************************************/
 /***********************************************************************/
 /***********************************************************************/
@@ -107,5 +107,10 @@ int stage4(symbol_c *tree_root, const char *builddir);
 /* Functions to be implemented by each generate_XX version of stage 4 */
 int  stage4_parse_options(char *options);
 void stage4_print_options(void);
+/* Whether the code generated for the POU by a previous compilation may be kept, instead of being generated
+ * once again, if the POU has not changed (see absyntax_utils/incremental_build.hh). This is only possible
+ * if the code of each POU is placed in files of its own, and these files still exist in builddir.
+ */
+bool stage4_can_keep_pou(symbol_c *pou, const char *builddir);
 
 #endif /* _STAGE4_HH */
@@ -0,0 +1,150 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+
+/*
+ * Unit test of running the read-only checkers of stage 3 in a single fused traversal (see stage3/fused_check.hh).
+ *
+ * The fused traversal must report the same errors as running each checker with a traversal of its own
+ * (which is how the checkers were run before being fused), although the messages of the several checkers
+ * come out interleaved, in the order the AST nodes are visited, instead of grouped by checker.
+ * The messages are therefore compared after being sorted.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
+
+#include "unit_test.hh"
+#include "stage3/stage3.hh"
+#include "stage3/fused_check.hh"
+#include "stage3/declaration_check.hh"
+#include "stage3/lvalue_check.hh"
+#include "stage3/array_range_check.hh"
+#include "stage3/case_elements_check.hh"
+
+
+#define POU_COUNT 30
+
+
+/* The checkers print their error messages to stderr. Keep them aside in a temporary file while a traversal runs. */
+static FILE *capture_file;
+static int   saved_stderr;
+
+static void start_capture(void) {
+  fflush(stderr);
+  capture_file = tmpfile();
+  if (NULL == capture_file) {perror("tmpfile"); exit(EXIT_FAILURE);}
+  saved_stderr = dup(fileno(stderr));
+  dup2(fileno(capture_file), fileno(stderr));
+}
+
+/* returns the lines printed since start_capture() */
+static std::vector<std::string> stop_capture(void) {
+  fflush(stderr);
+  dup2(saved_stderr, fileno(stderr));
+  close(saved_stderr);
+
+  std::vector<std::string> lines;
+  char line[1024];
+  rewind(capture_file);
+  while (NULL != fgets(line, sizeof(line), capture_file))
+    lines.push_back(line);
+  fclose(capture_file);
+  return lines;
+}
+
+
+/* run the given checkers in a single traversal, returning the lines they printed */
+static std::vector<std::string> run_checkers(library_c *library, std::vector<fused_checker_c *> checkers, int *error_count) {
+  fused_check_c fused_check;
+  for (size_t i = 0; i < checkers.size(); i++)
+    fused_check.add_checker(checkers[i]);
+  start_capture();
+  library->accept(fused_check);
+  std::vector<std::string> lines = stop_capture();
+  *error_count = fused_check.get_error_count();
+  return lines;
+}
+
+
+static std::vector<fused_checker_c *> new_checkers(library_c *library, int which /* -1: all of them */) {
+  std::vector<fused_checker_c *> checkers;
+  if ((which < 0) || (which == 0)) checkers.push_back(new declaration_check_c  (library));
+  if ((which < 0) || (which == 1)) checkers.push_back(new lvalue_check_c       (library));
+  if ((which < 0) || (which == 2)) checkers.push_back(new array_range_check_c  (library));
+  if ((which < 0) || (which == 3)) checkers.push_back(new case_elements_check_c(library));
+  return checkers;
+}
+
+
+
+int main(int argc, char **argv) {
+  memset(&runtime_options, 0, sizeof(runtime_options));
+  runtime_options.stage3_threads = 1;
+  library_c *library = new_test_library(POU_COUNT, true);
+  absyntax_utils_init(library);
+
+  /* annotate the AST (the checkers depend on the datatypes and constant values) */
+  symbol_c *ordered_library;
+  start_capture();
+  stage3(library, &ordered_library);
+  stop_capture();
+
+  int fused_error_count;
+  std::vector<std::string> fused_lines = run_checkers(library, new_checkers(library, -1), &fused_error_count);
+
+  int separate_error_count = 0;
+  std::vector<std::string> separate_lines;
+  for (int i = 0; i < 4; i++) {
+    int error_count;
+    std::vector<std::string> lines = run_checkers(library, new_checkers(library, i), &error_count);
+    separate_lines.insert(separate_lines.end(), lines.begin(), lines.end());
+    separate_error_count += error_count;
+  }
+
+  /* make sure the test library does contain errors, or we would not be testing much... */
+  CHECK(fused_error_count > 0);
+  CHECK(fused_error_count == separate_error_count);
+  CHECK(fused_lines.size() == separate_lines.size());
+  std::sort(fused_lines   .begin(), fused_lines   .end());
+  std::sort(separate_lines.begin(), separate_lines.end());
+  CHECK(fused_lines == separate_lines);
+
+  for (size_t i = 0; i < fused_lines.size(); i++)
+    printf("%s", fused_lines[i].c_str());
+  return unit_test_result();
+}
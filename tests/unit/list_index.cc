@@ -0,0 +1,159 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+
+/*
+ * Unit test of the name index of list_c (see list_c::find_element() in absyntax/absyntax.cc).
+ *
+ * Lists with more than a few elements are searched using a hash index of the token values
+ * of their elements, that must be kept up to date when elements are added, inserted,
+ * replaced or removed. This test applies a long (pseudo random, but always the same) sequence
+ * of these changes to a list, and after each one compares what find_element() returns with
+ * what a linear search of the list would return (i.e. the first element with the same
+ * token value, ignoring case).
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <vector>
+
+#include "unit_test.hh"
+
+
+#define NUM_NAMES 48
+#define NUM_STEPS 3000
+
+static const char *names[NUM_NAMES];
+
+static unsigned int seed = 1;
+static int random_int(int max) {  /* 0 <= result < max */
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 16) % max;
+}
+
+
+/* The elements are lists, so their token value is only the one given when adding them to the list. */
+static symbol_c *new_element(void) {return new var1_list_c();}
+
+
+/* the list being tested, and what it should contain */
+static list_c                  *list;
+static std::vector<symbol_c *>   model_symbols;
+static std::vector<const char *> model_names;
+
+
+static symbol_c *model_find(const char *name) {
+  for (size_t i = 0; i < model_symbols.size(); i++)
+    if ((NULL != model_names[i]) && (strcasecmp(model_names[i], name) == 0))
+      return model_symbols[i];
+  return NULL;
+}
+
+
+static void check_list(int step) {
+  CHECK(list->n == (int)model_symbols.size());
+  if (list->n != (int)model_symbols.size()) return;
+
+  for (int i = 0; i < list->n; i++) {
+    CHECK(list->get_element(i) == model_symbols[i]);
+    CHECK(list->get_element_token_value(i) == model_names[i]);
+  }
+  for (int i = 0; i < NUM_NAMES; i++) {
+    char lower_case[32];
+    for (int k = 0; (k == 0) || (names[i][k-1] != '\0'); k++) lower_case[k] = tolower(names[i][k]);
+    if (list->find_element(names[i]) != model_find(names[i]))
+      {fprintf(stderr, "step %d, list with %d elements: wrong element found for %s\n", step, list->n, names[i]); CHECK(false);}
+    CHECK(list->find_element(lower_case) == model_find(names[i]));
+  }
+  CHECK(list->find_element("NOT_IN_THE_LIST") == NULL);
+}
+
+
+
+int main(int argc, char **argv) {
+  for (int i = 0; i < NUM_NAMES; i++) {
+    char name[32];
+    snprintf(name, sizeof(name), "VAR_%d", i);
+    names[i] = strdup(name);
+  }
+
+  list = new var_init_decl_list_c();
+  for (int step = 0; step < NUM_STEPS; step++) {
+    int         op   = random_int(100);
+    const char *name = (random_int(10) == 0)? NULL : names[random_int(NUM_NAMES)];
+    symbol_c   *elem = new_element();
+
+    if ((op < 35) || (list->n == 0)) {
+      list->add_element(elem, name);
+      model_symbols.push_back(elem);
+      model_names  .push_back(name);
+    } else if (op < 65) {
+      /* insert anywhere, including at the start and at the end of the list */
+      int pos = (op < 40)? 0 : (op < 45)? list->n : random_int(list->n + 1);
+      list->insert_element(elem, name, pos);
+      model_symbols.insert(model_symbols.begin() + pos, elem);
+      model_names  .insert(model_names  .begin() + pos, name);
+    } else if (op < 75) {
+      /* replace an element, keeping its token value */
+      int pos = random_int(list->n);
+      list->set_element(pos, elem);
+      model_symbols[pos] = elem;
+    } else if (op < 99) {
+      int pos = (op < 80)? 0 : (op < 85)? list->n - 1 : random_int(list->n);
+      list->remove_element(pos);
+      model_symbols.erase(model_symbols.begin() + pos);
+      model_names  .erase(model_names  .begin() + pos);
+    } else {
+      list->clear();
+      model_symbols.clear();
+      model_names  .clear();
+    }
+    check_list(step);
+  }
+
+  /* A copy of the list finds the same elements (using an index of its own). */
+  list_c *copy = new var_init_decl_list_c(*(var_init_decl_list_c *)list);
+  for (int i = 0; i < NUM_NAMES; i++)
+    CHECK(copy->find_element(names[i]) == model_find(names[i]));
+
+  /* the token value of an element inserted at the end of the list is the one given to insert_element() */
+  while (list->n <= 16) list->add_element(new_element(), names[0]);
+  symbol_c *last = new_element();
+  list->insert_element(last, "LAST_ELEMENT", list->n);
+  CHECK(list->find_element("LAST_ELEMENT") == last);
+  CHECK(strcmp(list->get_element_token_value(list->n - 1), "LAST_ELEMENT") == 0);
+
+  return unit_test_result();
+}
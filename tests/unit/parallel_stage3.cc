@@ -0,0 +1,122 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+
+/*
+ * Unit test of checking the POUs concurrently in stage 3 (the -j option, see stage3/pou_executor.hh).
+ *
+ * Checking the POUs with several threads must give the same result as checking them one at a time:
+ * the same error messages, printed in the same order, and the same annotations left on the AST.
+ *
+ * Stage 3 may only be run once in each process (it fills the global symbol tables), so it is run
+ * in a child process for each number of threads, on the same AST (built again by each child).
+ * The output of each child (the error messages, followed by the annotations) is then compared.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "unit_test.hh"
+#include "stage3/stage3.hh"
+
+
+#define POU_COUNT 60
+
+
+/* Check the test library with the given number of threads, in a child process. Returns what the child printed. */
+static std::string run_stage3(int threads) {
+  FILE *output = tmpfile();
+  if (NULL == output) {perror("tmpfile"); exit(EXIT_FAILURE);}
+  fflush(stderr);
+
+  pid_t pid = fork();
+  if (pid < 0) {perror("fork"); exit(EXIT_FAILURE);}
+  if (pid == 0) {
+    dup2(fileno(output), fileno(stderr));
+    memset(&runtime_options, 0, sizeof(runtime_options));
+    runtime_options.stage3_threads = threads;
+    library_c *library = new_test_library(POU_COUNT, true);
+    absyntax_utils_init(library);
+    symbol_c *ordered_library;
+    int result = stage3(library, &ordered_library);
+    fprintf(stderr, "stage3() returned %d\n", result);
+    print_annotations(stderr);
+    fflush(stderr);
+    _exit(EXIT_SUCCESS);
+  }
+
+  int status;
+  waitpid(pid, &status, 0);
+  CHECK(WIFEXITED(status) && (WEXITSTATUS(status) == EXIT_SUCCESS));
+
+  std::string result;
+  char buffer[4096];
+  size_t len;
+  rewind(output);
+  while ((len = fread(buffer, 1, sizeof(buffer), output)) > 0)
+    result.append(buffer, len);
+  fclose(output);
+  return result;
+}
+
+
+static int count_lines(const std::string &text, const char *substring) {
+  int count = 0;
+  for (size_t pos = text.find(substring); pos != std::string::npos; pos = text.find(substring, pos + 1))
+    count++;
+  return count;
+}
+
+
+
+int main(int argc, char **argv) {
+  std::string one_thread = run_stage3(1);
+
+  /* make sure the test library does contain errors, or we would not be testing much... */
+  CHECK(one_thread.find("stage3() returned -1") != std::string::npos);
+  CHECK(count_lines(one_thread, "error: ") >= POU_COUNT / 4);
+
+  for (int threads = 2; threads <= 8; threads *= 2) {
+    std::string several_threads = run_stage3(threads);
+    if (several_threads != one_thread)
+      fprintf(stderr, "checking with %d threads gave a different result than with 1 thread\n", threads);
+    CHECK(several_threads == one_thread);
+  }
+
+  printf("%s", one_thread.c_str());
+  return unit_test_result();
+}
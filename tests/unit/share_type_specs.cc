@@ -0,0 +1,227 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+
+/*
+ * Unit test of sharing the identical anonymous datatypes declared inside each POU (see absyntax_utils/hash_cons.hh).
+ *
+ * Besides checking which datatypes are shared, this test checks what the rest of the compiler may expect
+ * of a shared datatype:
+ *   - the symbols inside a shared datatype have the parents of its first occurrence, which are all inside the datatype;
+ *   - the errors found inside a shared datatype are reported for each occurrence, but all at the location of the first one.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "unit_test.hh"
+#include "stage3/stage3.hh"
+#include "absyntax_utils/hash_cons.hh"
+
+
+/* The anonymous datatypes declared by each POU, twice each, in this order */
+#define SUBRANGE    0   /* INT (1..100)          */
+#define STRING      1   /* STRING[80]            */
+#define REF         2   /* REF_TO INT            */
+#define ARRAY       3   /* ARRAY [1..10] OF INT  */
+#define BAD_ARRAY   4   /* ARRAY [10..1] OF INT  */
+#define SPEC_COUNT  5
+
+
+static symbol_c *new_subrange(const char *lower, const char *upper) {
+  return LOC(new subrange_c(LOC(new integer_c(lower)), LOC(new integer_c(upper))));
+}
+
+static var1_list_c *new_var1_list(const char *name) {
+  var1_list_c *var1_list = LOC(new var1_list_c());
+  var1_list->add_element(LOC(new identifier_c(name)));
+  return var1_list;
+}
+
+static symbol_c *new_declaration(int spec, const char *name) {
+  array_subrange_list_c *subranges;
+  switch (spec) {
+    case SUBRANGE:
+      return LOC(new var1_init_decl_c(new_var1_list(name), 
+                   LOC(new subrange_spec_init_c(LOC(new subrange_specification_c(LOC(new int_type_name_c()), new_subrange("1", "100"))), NULL))));
+    case STRING:
+      return LOC(new single_byte_string_var_declaration_c(new_var1_list(name), 
+                   LOC(new single_byte_string_spec_c(LOC(new single_byte_limited_len_string_spec_c(LOC(new string_type_name_c()), LOC(new integer_c("80")))), NULL))));
+    case REF:
+      return LOC(new var1_init_decl_c(new_var1_list(name), LOC(new ref_spec_init_c(LOC(new ref_spec_c(LOC(new int_type_name_c()))), NULL))));
+    case ARRAY:
+    case BAD_ARRAY:
+      subranges = LOC(new array_subrange_list_c());
+      subranges->add_element((spec == ARRAY)? new_subrange("1", "10") : new_subrange("10", "1"));
+      return LOC(new array_var_init_decl_c(new_var1_list(name), 
+                   LOC(new array_spec_init_c(LOC(new array_specification_c(subranges, LOC(new int_type_name_c()))), NULL))));
+  }
+  return NULL;
+}
+
+/* the anonymous datatype declared by a declaration created by new_declaration() */
+static symbol_c *get_spec(symbol_c *declaration) {
+  if (declaration->is<var1_init_decl_c>()) {
+    symbol_c *spec_init = declaration->as<var1_init_decl_c>()->spec_init;
+    if (spec_init->is<subrange_spec_init_c>()) return spec_init->as<subrange_spec_init_c>()->subrange_specification;
+    if (spec_init->is<ref_spec_init_c>())      return spec_init->as<ref_spec_init_c>()->ref_spec;
+  }
+  if (declaration->is<single_byte_string_var_declaration_c>())
+    return declaration->as<single_byte_string_var_declaration_c>()->single_byte_string_spec->as<single_byte_string_spec_c>()->string_spec;
+  if (declaration->is<array_var_init_decl_c>())
+    return declaration->as<array_var_init_decl_c>()->array_spec_init->as<array_spec_init_c>()->array_specification;
+  return NULL;
+}
+
+
+/* A library with pou_count programs, each declaring every datatype twice, in its own VAR ... END_VAR.
+ * declarations[pou][spec][0..1] are the declarations of each program.
+ */
+#define POU_COUNT 2
+static symbol_c *declarations[POU_COUNT][SPEC_COUNT][2];
+
+static library_c *new_library(void) {
+  library_c *library = LOC(new library_c());
+  for (int pou = 0; pou < POU_COUNT; pou++) {
+    var_init_decl_list_c *var_list = LOC(new var_init_decl_list_c());
+    for (int i = 0; i < 2; i++)
+      for (int spec = 0; spec < SPEC_COUNT; spec++) {
+        char name[32];
+        snprintf(name, sizeof(name), "V%d_%d", spec, i);
+        declarations[pou][spec][i] = new_declaration(spec, strdup(name));
+        var_list->add_element(declarations[pou][spec][i]);
+      }
+    var_declarations_list_c *decl_list = LOC(new var_declarations_list_c());
+    decl_list->add_element(LOC(new var_declarations_c(NULL, var_list)));
+    library->add_element(LOC(new program_declaration_c(LOC(new identifier_c((pou == 0)? "P0" : "P1")), decl_list, LOC(new statement_list_c()))));
+  }
+  return library;
+}
+
+
+static bool is_shared(int pou, int spec) {return get_spec(declarations[pou][spec][0]) == get_spec(declarations[pou][spec][1]);}
+
+
+/* Every symbol inside the datatype has the symbol that references it as its parent */
+class check_parents_c: public iterator_visitor_c {
+  private:
+    symbol_c *expected_parent;
+  public:
+    check_parents_c(void): expected_parent(NULL) {}
+    void *visit(subrange_c *symbol) {
+      CHECK(symbol->parent == expected_parent);
+      CHECK(symbol->lower_limit->parent == symbol);
+      CHECK(symbol->upper_limit->parent == symbol);
+      return NULL;
+    }
+    void *visit(array_subrange_list_c *symbol) {
+      CHECK(symbol->parent == expected_parent);
+      expected_parent = symbol;
+      iterator_visitor_c::visit(symbol);
+      return NULL;
+    }
+    void *visit(array_specification_c *symbol) {
+      expected_parent = symbol;
+      return iterator_visitor_c::visit(symbol);
+    }
+    void *visit(subrange_specification_c *symbol) {
+      expected_parent = symbol;
+      return iterator_visitor_c::visit(symbol);
+    }
+};
+
+
+
+int main(int argc, char **argv) {
+  memset(&runtime_options, 0, sizeof(runtime_options));
+  runtime_options.stage3_threads = 1;
+
+  /* In the strict datatype model, every anonymous array is a datatype of its own */
+  runtime_options.relaxed_datatype_model = false;
+  hash_cons_c::share_type_specs(new_library());
+  for (int pou = 0; pou < POU_COUNT; pou++) {
+    CHECK( is_shared(pou, SUBRANGE));
+    CHECK( is_shared(pou, STRING));
+    CHECK( is_shared(pou, REF));
+    CHECK(!is_shared(pou, ARRAY));
+    CHECK(!is_shared(pou, BAD_ARRAY));
+  }
+  /* only within each POU */
+  for (int spec = 0; spec < SPEC_COUNT; spec++)
+    CHECK(get_spec(declarations[0][spec][0]) != get_spec(declarations[1][spec][0]));
+
+  /* In the relaxed datatype model, the arrays are shared too. Check the whole library with stage 3. */
+  runtime_options.relaxed_datatype_model = true;
+  library_c *library = new_library();
+  absyntax_utils_init(library);
+  FILE *errors = tmpfile();
+  int saved_stderr = dup(fileno(stderr));
+  fflush(stderr);
+  dup2(fileno(errors), fileno(stderr));
+  symbol_c *ordered_library;
+  stage3(library, &ordered_library);
+  fflush(stderr);
+  dup2(saved_stderr, fileno(stderr));
+
+  for (int pou = 0; pou < POU_COUNT; pou++)
+    for (int spec = 0; spec < SPEC_COUNT; spec++) {
+      CHECK(is_shared(pou, spec));
+      /* the shared datatype is the one of the first declaration, with the parents it had there */
+      symbol_c *spec_symbol = get_spec(declarations[pou][spec][0]);
+      CHECK(spec_symbol->parent->parent == declarations[pou][spec][0]);
+      check_parents_c check_parents;
+      spec_symbol->accept(check_parents);
+    }
+
+  /* The subrange 10..1 is reported for both occurrences, at the location of the first one */
+  int error_count[POU_COUNT] = {0};
+  char line[1024];
+  rewind(errors);
+  while (NULL != fgets(line, sizeof(line), errors)) {
+    if (NULL == strstr(line, "Subrange has lower limit")) continue;
+    printf("%s", line);
+    for (int pou = 0; pou < POU_COUNT; pou++) {
+      symbol_c *subrange = get_spec(declarations[pou][BAD_ARRAY][0])->as<array_specification_c>()->array_subrange_list->as<array_subrange_list_c>()->get_element(0);
+      char location[64];
+      snprintf(location, sizeof(location), "unit_test.st:%d-", subrange->first_line);
+      if (strncmp(line, location, strlen(location)) == 0) error_count[pou]++;
+    }
+  }
+  fclose(errors);
+  for (int pou = 0; pou < POU_COUNT; pou++)
+    CHECK(error_count[pou] == 2);
+
+  return unit_test_result();
+}
@@ -0,0 +1,142 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+
+/*
+ * Unit test of the static visitors (see absyntax/static_visitor.hh).
+ *
+ * A static visitor must visit the same symbols, in the same order, as an iterator_visitor_c with
+ * the same visit() methods, whether or not the subtree summaries (subtree_kinds_c) have been computed.
+ * With the summaries it should, however, skip the subtrees that contain nothing it handles.
+ */
+
+
+#include <stdio.h>
+#include <vector>
+
+#include "unit_test.hh"
+#include "absyntax/static_visitor.hh"
+
+
+#define POU_COUNT 12
+
+
+/* Visitors that keep the symbols they handle, in the order they are visited.
+ * The ones for case_statement_c also visit the children of the CASE statement.
+ */
+class static_recorder_c: public static_iterator_visitor_c<static_recorder_c> {
+  public:
+    std::vector<symbol_c *> visited;
+
+    using static_iterator_visitor_c<static_recorder_c>::visit;
+    void *visit(integer_c        *symbol) {visited.push_back(symbol); return NULL;}
+    void *visit(identifier_c     *symbol) {visited.push_back(symbol); return NULL;}
+    void *visit(case_statement_c *symbol) {visited.push_back(symbol); return static_iterator_visitor_c<static_recorder_c>::visit(symbol);}
+};
+
+class recorder_c: public iterator_visitor_c {
+  public:
+    std::vector<symbol_c *> visited;
+
+    void *visit(integer_c        *symbol) {visited.push_back(symbol); return NULL;}
+    void *visit(identifier_c     *symbol) {visited.push_back(symbol); return NULL;}
+    void *visit(case_statement_c *symbol) {visited.push_back(symbol); return iterator_visitor_c::visit(symbol);}
+};
+
+
+/* Only REAL literals, that appear in few places of the test library, so most subtrees may be skipped. */
+class static_real_recorder_c: public static_iterator_visitor_c<static_real_recorder_c> {
+  public:
+    std::vector<symbol_c *> visited;
+
+    using static_iterator_visitor_c<static_real_recorder_c>::visit;
+    void *visit(real_c *symbol) {visited.push_back(symbol); return NULL;}
+};
+
+class real_recorder_c: public iterator_visitor_c {
+  public:
+    std::vector<symbol_c *> visited;
+
+    void *visit(real_c *symbol) {visited.push_back(symbol); return NULL;}
+};
+
+
+
+/* Visit the tree with the static visitor, and with the equivalent iterator visitor.
+ * Returns the number of symbols the static visitor visited.
+ */
+template <typename static_visitor_t, typename visitor_t>
+static unsigned long int compare_visits(symbol_c *tree_root, unsigned long int *iterator_visit_count) {
+  static_visitor_t static_visitor;
+  visitor_t        visitor;
+
+  unsigned long int count0 = symbol_c::accept_count;
+  static_visitor.dispatch(tree_root);
+  unsigned long int count1 = symbol_c::accept_count;
+  tree_root->accept(visitor);
+  unsigned long int count2 = symbol_c::accept_count;
+
+  CHECK(static_visitor.visited.size() > 0);
+  CHECK(static_visitor.visited == visitor.visited);
+  *iterator_visit_count = count2 - count1;
+  return count1 - count0;
+}
+
+
+
+int main(int argc, char **argv) {
+  library_c *library = new_test_library(POU_COUNT, true);
+  unsigned long int static_count, iterator_count;
+
+  /* Before computing the summaries, nothing is skipped. */
+  static_count = compare_visits<static_recorder_c,      recorder_c>     (library, &iterator_count);
+  CHECK(static_count == iterator_count);
+  static_count = compare_visits<static_real_recorder_c, real_recorder_c>(library, &iterator_count);
+  CHECK(static_count == iterator_count);
+
+  /* With the summaries, the subtrees with nothing to do are skipped. */
+  subtree_kinds_c::compute(library);
+  static_count = compare_visits<static_recorder_c,      recorder_c>     (library, &iterator_count);
+  CHECK(static_count <= iterator_count);
+  static_count = compare_visits<static_real_recorder_c, real_recorder_c>(library, &iterator_count);
+  CHECK(static_count < iterator_count / 2);
+
+  /* The symbols created after computing the summaries are never skipped. */
+  library_c *new_library = new_test_library(2 * POU_COUNT, true);
+  for (int i = POU_COUNT; i < new_library->n; i++)
+    library->add_element(new_library->get_element(i));
+  compare_visits<static_recorder_c,      recorder_c>     (library, &iterator_count);
+  compare_visits<static_real_recorder_c, real_recorder_c>(library, &iterator_count);
+
+  printf("%lu of %lu symbols visited when only visiting REAL literals\n", static_count, iterator_count);
+  return unit_test_result();
+}
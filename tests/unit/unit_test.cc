@@ -0,0 +1,227 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "unit_test.hh"
+
+
+/* The global data and functions that the compiler's libraries expect main.cc to provide. */
+runtime_options_t runtime_options;
+
+void error_exit(const char *file_name, int line_no, const char *errmsg, ...) {
+  va_list argptr;
+  va_start(argptr, errmsg); /* second argument is last fixed pamater of error_exit() */
+
+  fprintf(stderr, "\nInternal compiler error in file %s at line %d", file_name, line_no);
+  if (errmsg != NULL) {
+    fprintf(stderr, ": ");
+    vfprintf(stderr, errmsg, argptr);
+  } else {
+    fprintf(stderr, ".");
+  }
+  fprintf(stderr, "\n");
+  va_end(argptr);
+    
+  exit(EXIT_FAILURE);
+}
+
+
+
+static int failed_checks = 0;
+
+void unit_test_failed(const char *file_name, int line_no, const char *condition) {
+  fprintf(stderr, "%s:%d: check failed: %s\n", file_name, line_no, condition);
+  failed_checks++;
+}
+
+
+int unit_test_result(void) {
+  if (failed_checks > 0) fprintf(stderr, "%d check(s) failed.\n", failed_checks);
+  return (failed_checks > 0)? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+
+
+std::vector<symbol_c *> unit_test_symbols;
+
+void unit_test_loc(symbol_c *symbol) {
+  int line = unit_test_symbols.size() + 1;
+  symbol->first_file   = symbol->last_file   = "unit_test.st";
+  symbol->first_line   = symbol->last_line   = line;
+  symbol->first_order  = symbol->last_order  = line;
+  symbol->first_column = 1;
+  symbol->last_column  = 10;
+  unit_test_symbols.push_back(symbol);
+}
+
+
+void print_annotations(FILE *file) {
+  for (size_t i = 0; i < unit_test_symbols.size(); i++) {
+    symbol_c *symbol = unit_test_symbols[i];
+    fprintf(file, "%lu %s: %s (%lu candidates)\n", (unsigned long)i, symbol->absyntax_cname(),
+            (NULL == symbol->datatype)? "-" : symbol->datatype->absyntax_cname(),
+            (unsigned long)symbol->get_candidate_datatypes().size());
+  }
+}
+
+
+
+static const char *numbered(const char *prefix, int number) {
+  char name[32];
+  snprintf(name, sizeof(name), "%s%d", prefix, number);
+  return strdup(name);
+}
+
+
+symbol_c *new_variable(const char *name) {
+  return LOC(new symbolic_variable_c(LOC(new identifier_c(name))));
+}
+
+
+symbol_c *new_var_init_decl(const char *name, symbol_c *type) {
+  var1_list_c *var1_list = LOC(new var1_list_c());
+  var1_list->add_element(LOC(new identifier_c(name)));
+  return LOC(new var1_init_decl_c(var1_list, LOC(new simple_spec_init_c(type, NULL))));
+}
+
+
+symbol_c *new_assignment(const char *name, symbol_c *value) {
+  return LOC(new assignment_statement_c(new_variable(name), value));
+}
+
+
+symbol_c *new_call(const char *function_name, symbol_c *a, symbol_c *b) {
+  param_assignment_list_c *param_list = LOC(new param_assignment_list_c());
+  param_list->add_element(LOC(new input_variable_param_assignment_c(LOC(new identifier_c("A")), a)));
+  param_list->add_element(LOC(new input_variable_param_assignment_c(LOC(new identifier_c("B")), b)));
+  return LOC(new function_invocation_c(LOC(new poutype_identifier_c(function_name)), param_list, NULL));
+}
+
+
+
+static symbol_c *new_function(int number) {
+  input_declaration_list_c *input_list = LOC(new input_declaration_list_c());
+  input_list->add_element(new_var_init_decl("A", LOC(new int_type_name_c())));
+  input_list->add_element(new_var_init_decl("B", LOC(new int_type_name_c())));
+  var_declarations_list_c *decl_list = LOC(new var_declarations_list_c());
+  decl_list->add_element(LOC(new input_declarations_c(NULL, input_list, LOC(new explicit_definition_c()))));
+
+  /* F<i> := (A * B + 3) * B + 3 ... ; F<i> := F<i> + F<i-1>(A := A, B := B); */
+  const char *name = numbered("F", number);
+  statement_list_c *body = LOC(new statement_list_c());
+  symbol_c *expression = new_variable("A");
+  for (int i = 0; i < 4; i++)
+    expression = LOC(new add_expression_c(LOC(new mul_expression_c(expression, new_variable("B"))), LOC(new integer_c("3"))));
+  body->add_element(new_assignment(name, expression));
+  if (number > 0)
+    body->add_element(new_assignment(name, LOC(new add_expression_c(new_variable(name), new_call(numbered("F", number - 1), new_variable("A"), new_variable("B"))))));
+  return LOC(new function_declaration_c(LOC(new identifier_c(name)), LOC(new int_type_name_c()), decl_list, body));
+}
+
+
+static symbol_c *new_program(int number, int function_count, bool with_errors) {
+  /* VAR X, Y, I: INT; R: REAL; AR: ARRAY [1..10] OF INT; END_VAR */
+  var_init_decl_list_c *var_list = LOC(new var_init_decl_list_c());
+  var_list->add_element(new_var_init_decl("X", LOC(new int_type_name_c())));
+  var_list->add_element(new_var_init_decl("Y", LOC(new int_type_name_c())));
+  var_list->add_element(new_var_init_decl("I", LOC(new int_type_name_c())));
+  var_list->add_element(new_var_init_decl("R", LOC(new real_type_name_c())));
+  var1_list_c *array_var1_list = LOC(new var1_list_c());
+  array_var1_list->add_element(LOC(new identifier_c("AR")));
+  array_subrange_list_c *array_subranges = LOC(new array_subrange_list_c());
+  array_subranges->add_element(LOC(new subrange_c(LOC(new integer_c("1")), LOC(new integer_c("10")))));
+  var_list->add_element(LOC(new array_var_init_decl_c(array_var1_list, 
+                              LOC(new array_spec_init_c(LOC(new array_specification_c(array_subranges, LOC(new int_type_name_c()))), NULL)))));
+  var_declarations_list_c *decl_list = LOC(new var_declarations_list_c());
+  decl_list->add_element(LOC(new var_declarations_c(NULL, var_list)));
+
+  statement_list_c *body = LOC(new statement_list_c());
+  for (int i = 0; i < 2; i++) {
+    /* FOR I := 1 TO 10 DO X := X + F<n>(A := X, B := Y) * 2; Y := Y + I; END_FOR */
+    statement_list_c *loop_body = LOC(new statement_list_c());
+    symbol_c *call = new_call(numbered("F", (number + i) % function_count), new_variable("X"), new_variable("Y"));
+    loop_body->add_element(new_assignment("X", LOC(new add_expression_c(new_variable("X"), LOC(new mul_expression_c(call, LOC(new integer_c("2"))))))));
+    loop_body->add_element(new_assignment("Y", LOC(new add_expression_c(new_variable("Y"), new_variable("I")))));
+    if (with_errors && (number % 5 == 0) && (i == 0))
+      loop_body->add_element(new_assignment("I", LOC(new integer_c("3"))));
+    body->add_element(LOC(new for_statement_c(new_variable("I"), LOC(new integer_c("1")), LOC(new integer_c("10")), NULL, loop_body)));
+    /* IF X > Y THEN Y := X; ELSE R := R * 2.0; END_IF */
+    statement_list_c *then_list = LOC(new statement_list_c());
+    statement_list_c *else_list = LOC(new statement_list_c());
+    then_list->add_element(new_assignment("Y", new_variable("X")));
+    else_list->add_element(new_assignment("R", LOC(new mul_expression_c(new_variable("R"), LOC(new real_c("2.0"))))));
+    body->add_element(LOC(new if_statement_c(LOC(new gt_expression_c(new_variable("X"), new_variable("Y"))), then_list, LOC(new elseif_statement_list_c()), else_list)));
+  }
+  /* CASE X OF 2: Y := X; 1..3: Y := X; END_CASE */
+  case_element_list_c *case_elements = LOC(new case_element_list_c());
+  for (int i = 0; i < 2; i++) {
+    case_list_c *case_list = LOC(new case_list_c());
+    if (i == 0)                                         case_list->add_element(LOC(new integer_c("2")));
+    else if (with_errors && (number % 3 == 0))          case_list->add_element(LOC(new subrange_c(LOC(new integer_c("1")), LOC(new integer_c("3")))));
+    else                                                case_list->add_element(LOC(new subrange_c(LOC(new integer_c("3")), LOC(new integer_c("5")))));
+    statement_list_c *statements = LOC(new statement_list_c());
+    statements->add_element(new_assignment("Y", new_variable("X")));
+    case_elements->add_element(LOC(new case_element_c(case_list, statements)));
+  }
+  body->add_element(LOC(new case_statement_c(new_variable("X"), case_elements, NULL)));
+
+  if (with_errors && (number % 7 == 0))
+    body->add_element(new_assignment("X", new_variable("R")));
+  if (with_errors && (number % 4 == 0))
+    body->add_element(new_assignment("X", new_call(numbered("F", number % function_count), new_variable("R"), new_variable("Y"))));
+  if (with_errors && (number % 6 == 0)) {
+    /* AR[20] := X; */
+    subscript_list_c *subscripts = LOC(new subscript_list_c());
+    subscripts->add_element(LOC(new integer_c("20")));
+    body->add_element(LOC(new assignment_statement_c(LOC(new array_variable_c(new_variable("AR"), subscripts)), new_variable("X"))));
+  }
+
+  if (number % 2)
+    return LOC(new function_block_declaration_c(LOC(new identifier_c(numbered("FB", number))), decl_list, body));
+  return LOC(new program_declaration_c(LOC(new identifier_c(numbered("P", number))), decl_list, body));
+}
+
+
+library_c *new_test_library(int pou_count, bool with_errors) {
+  library_c *library = LOC(new library_c());
+  int function_count = pou_count / 4 + 1;
+  for (int i = 0; i < function_count; i++)
+    library->add_element(new_function(i));
+  for (int i = function_count; i < pou_count; i++)
+    library->add_element(new_program(i, function_count, with_errors));
+  return library;
+}
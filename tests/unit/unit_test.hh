@@ -0,0 +1,91 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * An IEC 61131-3 compiler.
+ *
+ * Based on the
+ * FINAL DRAFT - IEC 61131-3, 2nd Ed. (2001-12-10)
+ *
+ */
+
+
+
+/*
+ * Helpers shared by the unit tests.
+ *
+ * Each unit test is a program that builds by hand the abstract syntax tree it needs
+ * (as stage 1_2 would have built it when parsing some source code), runs the part of
+ * the compiler being tested on that AST, and checks the results with CHECK().
+ *
+ * A check that fails is printed to stderr, and the test goes on with the remaining checks.
+ * main() should return unit_test_result(), which is non zero if any of the checks failed.
+ *
+ * The symbols created with LOC() are placed each on a line of its own of a (non existing)
+ * source file, so the error messages about them may be told apart. They are also kept in
+ * unit_test_symbols, in the order they were created, so the annotations left by stage 3
+ * may be printed (print_annotations()) and compared between runs that build the same AST.
+ */
+
+
+#ifndef _UNIT_TEST_HH
+#define _UNIT_TEST_HH
+
+#include <stdio.h>
+#include <vector>
+#include "absyntax_utils/absyntax_utils.hh"
+
+
+#define CHECK(condition) {if (!(condition)) unit_test_failed(__FILE__, __LINE__, #condition);}
+
+void unit_test_failed(const char *file_name, int line_no, const char *condition);
+int  unit_test_result(void);
+
+
+extern std::vector<symbol_c *> unit_test_symbols;
+
+void unit_test_loc(symbol_c *symbol);
+template <typename symbol_type> symbol_type *LOC(symbol_type *symbol) {unit_test_loc(symbol); return symbol;}
+
+/* print the datatype and number of candidate datatypes of each of the unit_test_symbols */
+void print_annotations(FILE *file);
+
+
+symbol_c *new_variable     (const char *name);                    /* name            */
+symbol_c *new_var_init_decl(const char *name, symbol_c *type);    /* name: type;     */
+symbol_c *new_assignment   (const char *name, symbol_c *value);   /* name := value;  */
+symbol_c *new_call         (const char *function_name, symbol_c *a, symbol_c *b);  /* function_name(A := a, B := b) */
+
+/* A library with pou_count POUs (at least 2): functions F<i>(A, B: INT): INT that call the previous function,
+ * followed by programs and function blocks with FOR, IF and CASE statements that call those functions.
+ * If with_errors is set, some of these POUs also contain one of the errors that stage 3 reports:
+ *   - assigning a REAL to an INT variable
+ *   - passing a REAL to an INT parameter of a function
+ *   - assigning to the control variable inside a FOR loop
+ *   - an array subscript outside the subrange of the array
+ *   - CASE elements with overlapping values
+ */
+library_c *new_test_library(int pou_count, bool with_errors);
+
+
+#endif /* _UNIT_TEST_HH */
@@ -47,8 +47,7 @@ void dsymtable_c<value_type>::reset(void) {
 template<typename value_type>
 void dsymtable_c<value_type>::insert(const char *identifier_str, value_t new_value) {
   // std::cout << "store_identifier(" << identifier_str << "): \n";
-  std::pair<const char *, value_t> new_element(identifier_str, new_value);
-  /* iterator res = */ _base.insert(new_element);
+  /* iterator res = */ _base.insert(identifier_str, new_value);
 }
 
 
@@ -0,0 +1,203 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *  Copyright (C) 2007-2011  Laurent Bessard and Edouard Tisserant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+
+/*
+ * A hash table with case insensitive string keys, that allows duplicate keys.
+ *
+ * This is the container used by the symbol tables (symtable_c and dsymtable_c).
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>  /* required for strcasecmp() */
+#include "nocase_hashtable.hh"
+#include "../main.hh" // required for ERROR() and ERROR_MSG() macros.
+
+
+
+#define NOCASE_HASHTABLE_INIT_SIZE 16  /* Must be a power of 2! */
+
+
+/* FNV-1a of the upper case version of the key */
+template<typename value_type>
+unsigned int nocase_hashtable_c<value_type>::hash_nocase(const char *key) {
+  unsigned int hash = 2166136261U;
+  for (; *key != '\0'; key++) {
+    unsigned char c = *key;
+    if ((c >= 'a') && (c <= 'z')) c -= 'a' - 'A';
+    hash ^= c;
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+
+
+template<typename value_type>
+nocase_hashtable_c<value_type>::nocase_hashtable_c(void) {
+  buckets = NULL; buckets_size = 0; buckets_used = 0;
+}
+
+template<typename value_type>
+nocase_hashtable_c<value_type>::nocase_hashtable_c(const nocase_hashtable_c &other): elements(other.elements) {
+  buckets = NULL; buckets_size = 0; buckets_used = 0;
+  rebuild_index();
+}
+
+template<typename value_type>
+nocase_hashtable_c<value_type> &nocase_hashtable_c<value_type>::operator=(const nocase_hashtable_c &other) {
+  if (this == &other) return *this;
+  elements = other.elements;
+  rebuild_index();
+  return *this;
+}
+
+template<typename value_type>
+nocase_hashtable_c<value_type>::~nocase_hashtable_c(void) {
+  free(buckets);
+}
+
+
+ /* clear all entries... */
+template<typename value_type>
+void nocase_hashtable_c<value_type>::clear(void) {
+  elements.clear();
+  free(buckets);
+  buckets = NULL; buckets_size = 0; buckets_used = 0;
+}
+
+
+
+template<typename value_type>
+typename nocase_hashtable_c<value_type>::bucket_t *nocase_hashtable_c<value_type>::find_bucket(const char *key, unsigned int hash) {
+  size_t pos = hash & (buckets_size - 1);
+  while (buckets[pos].key != NULL) {
+    if ((buckets[pos].hash == hash) && ((buckets[pos].key == key) || (strcasecmp(buckets[pos].key, key) == 0)))
+      return &buckets[pos];
+    pos = (pos + 1) & (buckets_size - 1);
+  }
+  return &buckets[pos];
+}
+
+
+template<typename value_type>
+void nocase_hashtable_c<value_type>::grow(void) {
+  bucket_t *old_buckets = buckets;
+  size_t    old_size    = buckets_size;
+
+  buckets_size = (old_size == 0)? NOCASE_HASHTABLE_INIT_SIZE : 2*old_size;
+  buckets      = (bucket_t *)calloc(buckets_size, sizeof(bucket_t));
+  if (buckets == NULL) ERROR_MSG("Out of memory. Bailing out!\n");
+
+  for (size_t i = 0; i < old_size; i++) {
+    if (old_buckets[i].key == NULL) continue;
+    size_t pos = old_buckets[i].hash & (buckets_size - 1);
+    while (buckets[pos].key != NULL) pos = (pos + 1) & (buckets_size - 1);
+    buckets[pos] = old_buckets[i];
+  }
+  free(old_buckets);
+}
+
+
+/* (re)build the index of the entries currently in the list */
+template<typename value_type>
+void nocase_hashtable_c<value_type>::rebuild_index(void) {
+  free(buckets);
+  buckets = NULL; buckets_size = 0; buckets_used = 0;
+
+  for (iterator i = elements.begin(); i != elements.end(); i++) {
+    if (4*(buckets_used + 1) > 3*buckets_size) grow();
+    unsigned int hash   = hash_nocase(i->first.c_str());
+    bucket_t    *bucket = find_bucket(i->first.c_str(), hash);
+    if (bucket->key != NULL) {bucket->count++; continue;}  /* entries with the same key are always consecutive */
+    bucket->key   = strpool_c::intern(i->first.c_str());
+    bucket->hash  = hash;
+    bucket->count = 1;
+    bucket->first = i;
+    buckets_used++;
+  }
+}
+
+
+
+template<typename value_type>
+typename nocase_hashtable_c<value_type>::iterator nocase_hashtable_c<value_type>::insert(const char *key, value_t value) {
+  if (4*(buckets_used + 1) > 3*buckets_size) grow();
+
+  unsigned int hash   = hash_nocase(key);
+  bucket_t    *bucket = find_bucket(key, hash);
+
+  if (bucket->key == NULL) {
+    /* new key */
+    bucket->key   = strpool_c::intern(key);
+    bucket->hash  = hash;
+    bucket->count = 1;
+    bucket->first = elements.insert(elements.end(), element_t(key, value));
+    buckets_used++;
+    return bucket->first;
+  }
+
+  /* key already in the table. Insert after the last entry with the same key */
+  iterator pos = bucket->first;
+  for (int i = 0; i < bucket->count; i++) pos++;
+  bucket->count++;
+  return elements.insert(pos, element_t(key, value));
+}
+
+
+template<typename value_type>
+int nocase_hashtable_c<value_type>::count(const char *key) {
+  if (buckets_used == 0) return 0;
+  bucket_t *bucket = find_bucket(key, hash_nocase(key));
+  return (bucket->key == NULL)? 0 : bucket->count;
+}
+
+
+template<typename value_type>
+typename nocase_hashtable_c<value_type>::iterator nocase_hashtable_c<value_type>::find(const char *key) {
+  if (buckets_used == 0) return elements.end();
+  bucket_t *bucket = find_bucket(key, hash_nocase(key));
+  return (bucket->key == NULL)? elements.end() : bucket->first;
+}
+
+
+template<typename value_type>
+typename nocase_hashtable_c<value_type>::iterator nocase_hashtable_c<value_type>::upper_bound(const char *key) {
+  if (buckets_used == 0) return elements.end();
+  bucket_t *bucket = find_bucket(key, hash_nocase(key));
+  if (bucket->key == NULL) return elements.end();
+  iterator pos = bucket->first;
+  for (int i = 0; i < bucket->count; i++) pos++;
+  return pos;
+}
+
+
+template<typename value_type>
+typename nocase_hashtable_c<value_type>::value_t &nocase_hashtable_c<value_type>::operator[](const char *key) {
+  iterator i = find(key);
+  if (i == elements.end()) i = insert(key, value_t());
+  return i->second;
+}
@@ -0,0 +1,130 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2003-2011  Mario de Sousa (msousa@fe.up.pt)
+ *  Copyright (C) 2007-2011  Laurent Bessard and Edouard Tisserant
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+
+/*
+ * A hash table with case insensitive string keys, that allows duplicate keys.
+ *
+ * This is the container used by the symbol tables (symtable_c and dsymtable_c).
+ *
+ * The (key, value) pairs are stored in a std::list, and all the entries with the same key
+ * (ignoring case) are always kept next to each other in that list, in the order in which
+ * they were inserted. The entries with a given key may therefore be iterated over just like
+ * in a std::multimap, going from find(key) up to (but not including) upper_bound(key).
+ *
+ * The list is indexed by an open addressing hash table (linear probing), holding for each key
+ * the case-folded hash of the key, the key itself (interned, see strpool.hh), an iterator to the
+ * first entry with that key, and the number of entries with that key. A lookup therefore costs
+ * one pass over the key being searched (to compute the hash), and usually a single string
+ * comparison, that is skipped altogether when the key being searched is the interned string.
+ *
+ * NOTE: Entries can not be removed individually. Use clear() to remove all the entries.
+ */
+
+
+
+#ifndef _NOCASE_HASHTABLE_HH
+#define _NOCASE_HASHTABLE_HH
+
+#include "../absyntax/absyntax.hh"
+
+#include <list>
+#include <string>
+
+
+
+
+template<typename value_type> class nocase_hashtable_c {
+  public:
+    typedef value_type value_t;
+    typedef std::pair<const std::string, value_t> element_t;
+
+  private:
+    typedef std::list<element_t> elements_t;
+
+  public:
+    typedef typename elements_t::iterator iterator;
+    typedef typename elements_t::const_iterator const_iterator;
+    typedef typename elements_t::reverse_iterator reverse_iterator;
+    typedef typename elements_t::const_reverse_iterator const_reverse_iterator;
+
+  private:
+    typedef struct {
+      const char  *key;    /* interned. NULL if bucket is empty */
+      unsigned int hash;   /* hash of the key, ignoring case    */
+      int          count;  /* number of entries with this key   */
+      iterator     first;  /* the first entry with this key     */
+    } bucket_t;
+
+    elements_t elements;
+    bucket_t  *buckets;
+    size_t     buckets_size;  /* always 0 or a power of 2 */
+    size_t     buckets_used;
+
+    static unsigned int hash_nocase(const char *key);
+    bucket_t *find_bucket(const char *key, unsigned int hash);  /* returns the empty bucket where key should go, if not found */
+    void      grow(void);
+    void      rebuild_index(void);
+
+  public:
+    nocase_hashtable_c(void);
+    nocase_hashtable_c(const nocase_hashtable_c &other);
+    nocase_hashtable_c &operator=(const nocase_hashtable_c &other);
+    ~nocase_hashtable_c(void);
+
+    void clear(void); /* clear all entries... */
+
+    /* Insert a new (key, value) pair, after any other entries already associated to key.
+     * Returns an iterator to the new entry.
+     */
+    iterator insert(const char *key, value_t value);
+
+    /* Determine how many entries are associated to key */
+    int count(const char *key);
+
+    /* Search for the first entry associated with key. Returns end() if not found */
+    iterator find(const char *key);
+    /* Search for the entry following the last entry associated with key. Returns end() if not found */
+    iterator upper_bound(const char *key);
+
+    /* Returns the value associated with key, inserting a new entry with a default value if not found */
+    value_t &operator[](const char *key);
+
+    /* iterators pointing to beg/end of the table... */
+    iterator begin() 			{return elements.begin();}
+    const_iterator begin() const	{return elements.begin();}
+    iterator end()			{return elements.end();}
+    const_iterator end() const 		{return elements.end();}
+    reverse_iterator rbegin()		{return elements.rbegin();}
+    const_reverse_iterator rbegin() const {return elements.rbegin();}
+    reverse_iterator rend() 		{return elements.rend();}
+    const_reverse_iterator rend() const	{return elements.rend();}
+};
+
+
+
+/* Templates must include the source into the code! */
+#include "nocase_hashtable.cc"
+
+#endif /*  _NOCASE_HASHTABLE_HH */
@@ -0,0 +1,75 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2014  Mario de Sousa (msousa@fe.up.pt)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+
+/*
+ * An object of which each thread has its own copy.
+ *
+ * The copy of each thread is created (using the default constructor) the first time
+ * that thread calls get(), and is deleted when the thread terminates.
+ *
+ * This is used to keep the caches of the type searches (search_base_type_c, ...)
+ * private to each thread, so that stage 3 may check several POUs at the same time
+ * (see stage3/pou_executor.hh) without having to lock those caches on every access.
+ *
+ * NOTE: the copy belonging to the main thread is never deleted.
+ */
+
+
+#ifndef _PER_THREAD_HH
+#define _PER_THREAD_HH
+
+#include <pthread.h>
+#include <stdio.h>   // required for fprintf()
+#include <stdlib.h>  // required for exit()
+
+
+
+template<typename value_type> class per_thread_c {
+  private:
+    pthread_key_t key;
+
+    static void destroy(void *value) {delete (value_type *)value;}
+
+  public:
+    per_thread_c(void) {
+      if (pthread_key_create(&key, destroy) != 0) {
+        fprintf(stderr, "Could not create thread specific data. Bailing out!\n");
+        exit(EXIT_FAILURE);
+      }
+    }
+   ~per_thread_c(void) {pthread_key_delete(key);}
+
+    /* The copy belonging to the calling thread */
+    value_type &get(void) {
+      value_type *value = (value_type *)pthread_getspecific(key);
+      if (NULL == value) {
+        value = new value_type();
+        pthread_setspecific(key, value);
+      }
+      return *value;
+    }
+};
+
+
+#endif /* _PER_THREAD_HH */
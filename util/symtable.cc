@@ -120,9 +120,7 @@ void symtable_c<value_type>::insert(const char *identifier_str, value_t new_valu
   if ((i != _base.end()) && (i->second != new_value)) {ERROR;}  /* error inserting new identifier: identifier already in map associated to a different value */
   if ((i != _base.end()) && (i->second == new_value)) {return;} /* identifier already in map associated with the same value */
 
-  std::pair<const char *, value_t> new_element(identifier_str, new_value);
-  std::pair<iterator, bool> res = _base.insert(new_element);
-  if (!res.second) {ERROR;} /* unknown error inserting new identifier */
+  _base.insert(identifier_str, new_value);
 }
 
 template<typename value_type>
@@ -144,14 +142,14 @@ void symtable_c<value_type>::insert(const symbol_c *symbol, value_t new_value) {
 template<typename value_type>
 int symtable_c<value_type>::count(const       char *identifier_str) {return _base.count(identifier_str)+((inner_scope == NULL)?0:inner_scope->count(identifier_str));}
 template<typename value_type>
-int symtable_c<value_type>::count(const std::string identifier_str) {return _base.count(identifier_str)+((inner_scope == NULL)?0:inner_scope->count(identifier_str));}
+int symtable_c<value_type>::count(const std::string identifier_str) {return count(identifier_str.c_str());}
 
 
 // in the operator[] we delegate to find(), since that method will also search in the inner scopes!
 template<typename value_type>
 typename symtable_c<value_type>::value_t& symtable_c<value_type>::operator[] (const       char *identifier_str) {iterator i = find(identifier_str); return (i!=end())?i->second:_base[identifier_str];}
 template<typename value_type>
-typename symtable_c<value_type>::value_t& symtable_c<value_type>::operator[] (const std::string identifier_str) {iterator i = find(identifier_str); return (i!=end())?i->second:_base[identifier_str];}
+typename symtable_c<value_type>::value_t& symtable_c<value_type>::operator[] (const std::string identifier_str) {return (*this)[identifier_str.c_str()];}
 
 
 template<typename value_type>
@@ -173,11 +171,7 @@ typename symtable_c<value_type>::iterator symtable_c<value_type>::find(const
 
 template<typename value_type>
 typename symtable_c<value_type>::iterator symtable_c<value_type>::find(const std::string identifier_str) {
-  iterator i;
-  if ((inner_scope != NULL) && ((i = inner_scope->find(identifier_str)) != inner_scope->end()))  // NOTE: must use the end() value of the inner scope!
-      return i;  // found in the lower level
-  /* if no lower level, or not found in lower level... */
-  return _base.find(identifier_str);
+  return find(identifier_str.c_str());
 }
 
 